@@ -0,0 +1,268 @@
+/**************************************************************************************************************************************
+ Module      : Clock
+ Name        : Clock.c
+ Author      : Salma Hamdy
+ Description : Source file for the system clock configuration (PIOSC, MOSC or PLL up to 80 MHz) and its change listeners
+
+ The device leaves reset on the 16 MHz PIOSC with the PLL powered down, which is the state every driver assumed. Clock_SetFrequency
+ moves the system clock to an integer division of the PIOSC, of the MOSC or of the 400 MHz PLL through RCC2. The core runs from
+ the undivided oscillator (BYPASS2) while the dividers are changed and the PLL locks, then the new clock is selected in one write.
+ The modules whose timing is counted in core cycles (SysTick reload, CPU load window) register a listener and rescale their
+ values once the new frequency runs. The 16 MHz of the bypass is a frequency change of its own, notified as well, otherwise the
+ MOSC start-up and PLL lock time would be counted at the old rate. The switch is done with the interrupts disabled, so no
+ handler sees a half-rescaled state.
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Clock.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Reset state of the device */
+static uint32 g_Clock_FrequencyHz = CLOCK_PIOSC_HZ;
+static Clock_SourceType g_Clock_Source = CLOCK_SOURCE_PIOSC;
+
+static Clock_ListenerType g_Clock_Listeners[CLOCK_MAX_LISTENERS];
+static uint8 g_Clock_ListenerCount = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static boolean Clock_WaitMoscReady(void)
+{
+    uint32 polls;
+
+    for (polls = 0; polls < CLOCK_READY_TIMEOUT_POLLS; polls++)
+    {
+        if (SYSCTL_RIS_REG & CLOCK_RIS_MOSCPUPRIS_MASK)
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static boolean Clock_WaitPllLock(void)
+{
+    uint32 polls;
+
+    for (polls = 0; polls < CLOCK_READY_TIMEOUT_POLLS; polls++)
+    {
+        if (SYSCTL_PLLSTAT_REG & CLOCK_PLLSTAT_LOCK_MASK)
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Record the clock now running and notify the listeners in registration order */
+static void Clock_Notify(Clock_SourceType a_Source, uint32 a_FrequencyHz)
+{
+    uint32 old_frequency = g_Clock_FrequencyHz;
+    uint8 index;
+
+    g_Clock_Source      = a_Source;
+    g_Clock_FrequencyHz = a_FrequencyHz;
+
+    if (old_frequency != a_FrequencyHz)
+    {
+        for (index = 0; index < g_Clock_ListenerCount; index++)
+        {
+            g_Clock_Listeners[index](old_frequency, a_FrequencyHz);
+        }
+    }
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: Clock_SetFrequency
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Source - CLOCK_SOURCE_PIOSC, CLOCK_SOURCE_MOSC or CLOCK_SOURCE_PLL
+ *                  a_FrequencyHz - System clock, the source frequency divided by an integer (5 to 128 for the PLL, so at
+ *                                  most 80 MHz, 1 to 64 for the oscillators)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the clock runs at the requested frequency, FALSE if the frequency is not reachable from the
+ *                         source or the MOSC / PLL did not become ready (the clock is then the undivided PIOSC)
+ * Description: Function to switch the system clock and notify the listeners of every frequency change, the 16 MHz used
+ *              during the switch included. It must be called with the interrupts enabled, from thread mode or from a handler,
+ *              they are disabled during the switch (up to the MOSC start-up and PLL lock time).
+****************************************************************************************************************************************/
+boolean Clock_SetFrequency(Clock_SourceType a_Source, uint32 a_FrequencyHz)
+{
+    uint32 source_frequency;
+    uint32 divisor;
+    boolean ready = TRUE;
+
+    switch (a_Source)
+    {
+    case CLOCK_SOURCE_PIOSC:
+    case CLOCK_SOURCE_MOSC:
+        source_frequency = (a_Source == CLOCK_SOURCE_PIOSC) ? CLOCK_PIOSC_HZ : CLOCK_MOSC_HZ;
+        divisor = (a_FrequencyHz == 0) ? 0 : (source_frequency / a_FrequencyHz);
+        if ((divisor == 0) || (divisor > CLOCK_OSC_DIVISOR_MAX) || ((divisor * a_FrequencyHz) != source_frequency))
+        {
+            return FALSE;
+        }
+        break;
+    case CLOCK_SOURCE_PLL:
+        divisor = (a_FrequencyHz == 0) ? 0 : (CLOCK_PLL_HZ / a_FrequencyHz);
+        if ((divisor < CLOCK_PLL_DIVISOR_MIN) || (divisor > CLOCK_PLL_DIVISOR_MAX) || ((divisor * a_FrequencyHz) != CLOCK_PLL_HZ))
+        {
+            return FALSE;
+        }
+        break;
+    default:
+        return FALSE;
+    }
+
+    if ((a_Source == g_Clock_Source) && (a_FrequencyHz == g_Clock_FrequencyHz))
+    {
+        return TRUE;
+    }
+
+    Disable_Exceptions();
+
+    /* Run from the undivided oscillator while the dividers and the PLL are reprogrammed, the PLL reference is the MOSC */
+    SYSCTL_RCC2_REG |= CLOCK_RCC2_USERCC2_MASK | CLOCK_RCC2_BYPASS2_MASK;
+    SYSCTL_RCC_REG  &= ~CLOCK_RCC_USESYSDIV_MASK;
+    if (g_Clock_Source == CLOCK_SOURCE_PIOSC)
+    {
+        Clock_Notify(CLOCK_SOURCE_PIOSC, CLOCK_PIOSC_HZ);
+    }
+    else
+    {
+        Clock_Notify(CLOCK_SOURCE_MOSC, CLOCK_MOSC_HZ);
+    }
+
+    if (a_Source != CLOCK_SOURCE_PIOSC)
+    {
+        SYSCTL_RCC_REG = (SYSCTL_RCC_REG & ~(CLOCK_RCC_XTAL_MASK | CLOCK_RCC_MOSCDIS_MASK)) | CLOCK_RCC_XTAL_16MHZ;
+        ready = Clock_WaitMoscReady();
+    }
+
+    if (ready)
+    {
+        SYSCTL_RCC2_REG = (SYSCTL_RCC2_REG & ~CLOCK_RCC2_OSCSRC2_MASK) |
+                          ((a_Source == CLOCK_SOURCE_PIOSC) ? CLOCK_RCC2_OSCSRC2_PIOSC : CLOCK_RCC2_OSCSRC2_MOSC);
+
+        if (a_Source == CLOCK_SOURCE_PLL)
+        {
+            /* A PLL already running keeps its lock across a divisor change */
+            SYSCTL_RCC2_REG = (SYSCTL_RCC2_REG & ~(CLOCK_RCC2_SYSDIV400_MASK | CLOCK_RCC2_PWRDN2_MASK)) |
+                              CLOCK_RCC2_DIV400_MASK | ((divisor - 1) << CLOCK_RCC2_SYSDIV400_POS);
+            ready = Clock_WaitPllLock();
+            if (ready)
+            {
+                SYSCTL_RCC2_REG &= ~CLOCK_RCC2_BYPASS2_MASK;      /* The divisor always applies to the PLL */
+                SYSCTL_RCC_REG  |= CLOCK_RCC_USESYSDIV_MASK;
+            }
+        }
+        else
+        {
+            SYSCTL_RCC2_REG = (SYSCTL_RCC2_REG & ~(CLOCK_RCC2_DIV400_MASK | CLOCK_RCC2_SYSDIV400_MASK)) |
+                              CLOCK_RCC2_PWRDN2_MASK | ((divisor - 1) << CLOCK_RCC2_SYSDIV2_POS);
+            if (divisor > 1)
+            {
+                SYSCTL_RCC_REG |= CLOCK_RCC_USESYSDIV_MASK;
+            }
+            if (a_Source == CLOCK_SOURCE_PIOSC)
+            {
+                SYSCTL_RCC_REG |= CLOCK_RCC_MOSCDIS_MASK;         /* Nothing uses the MOSC any more */
+            }
+        }
+    }
+
+    if (!ready)
+    {
+        /* The MOSC did not start or the PLL did not lock: stay on the undivided PIOSC with the PLL off */
+        SYSCTL_RCC2_REG = (SYSCTL_RCC2_REG & ~CLOCK_RCC2_OSCSRC2_MASK) | CLOCK_RCC2_OSCSRC2_PIOSC | CLOCK_RCC2_PWRDN2_MASK;
+        a_Source      = CLOCK_SOURCE_PIOSC;
+        a_FrequencyHz = CLOCK_PIOSC_HZ;
+    }
+
+    Clock_Notify(a_Source, a_FrequencyHz);
+    Enable_Exceptions();
+
+    return ready;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Clock_GetFrequency
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - System clock frequency in Hz
+ * Description: Function to read the frequency of the core and SysTick clock.
+****************************************************************************************************************************************/
+uint32 Clock_GetFrequency(void)
+{
+    return g_Clock_FrequencyHz;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Clock_GetSource
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Clock_SourceType - Source of the system clock
+ * Description: Function to read the source of the system clock.
+****************************************************************************************************************************************/
+Clock_SourceType Clock_GetSource(void)
+{
+    return g_Clock_Source;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Clock_AddListener
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Listener - Function called with the old and the new frequency after every change (twice for a switch
+ *                               that goes through the 16 MHz oscillator)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the listener is registered (or already was), FALSE if the table is full
+ * Description: Function to register a clock change listener. The listeners run in registration order with the interrupts
+ *              disabled, they must only rescale their own state.
+****************************************************************************************************************************************/
+boolean Clock_AddListener(Clock_ListenerType a_Listener)
+{
+    uint8 index;
+
+    if (a_Listener == NULL_PTR)
+    {
+        return FALSE;
+    }
+
+    for (index = 0; index < g_Clock_ListenerCount; index++)
+    {
+        if (g_Clock_Listeners[index] == a_Listener)
+        {
+            return TRUE;
+        }
+    }
+
+    if (g_Clock_ListenerCount == CLOCK_MAX_LISTENERS)
+    {
+        return FALSE;
+    }
+    g_Clock_Listeners[g_Clock_ListenerCount++] = a_Listener;
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
@@ -0,0 +1,88 @@
+/***********************************************************************************************************************************
+ Module      : Clock
+ Name        : Clock.h
+ Author      : Salma Hamdy
+ Description : Header file for the system clock configuration (PIOSC, MOSC or PLL up to 80 MHz) and its change listeners
+ ************************************************************************************************************************************/
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* System clock sources */
+#define CLOCK_SOURCE_PIOSC                   0            /* Precision internal oscillator, reset state */
+#define CLOCK_SOURCE_MOSC                    1            /* Main oscillator (16 MHz crystal of the LaunchPad) */
+#define CLOCK_SOURCE_PLL                     2            /* 400 MHz PLL referenced to the MOSC */
+
+/* Oscillator and PLL frequencies, the system clock is one of them divided by an integer */
+#define CLOCK_PIOSC_HZ                       16000000UL
+#define CLOCK_MOSC_HZ                        16000000UL
+#define CLOCK_PLL_HZ                         400000000UL
+#define CLOCK_MAX_HZ                         80000000UL
+
+/* Divisor range of SYSDIV2 (oscillators) and SYSDIV2:SYSDIV2LSB with DIV400 (PLL) */
+#define CLOCK_OSC_DIVISOR_MAX                64
+#define CLOCK_PLL_DIVISOR_MIN                (CLOCK_PLL_HZ / CLOCK_MAX_HZ)
+#define CLOCK_PLL_DIVISOR_MAX                128
+
+/* Polls of the MOSC ready and PLL lock flags before the switch is abandoned */
+#define CLOCK_READY_TIMEOUT_POLLS            100000
+
+/* Functions notified after every frequency change, SysTick, Idle, CpuLoad and TimeConv take 4, the rest is for the application */
+#define CLOCK_MAX_LISTENERS                  8
+
+/* Run-Mode Clock Configuration register (RCC) */
+#define CLOCK_RCC_MOSCDIS_MASK               0x00000001   /* Main oscillator disabled */
+#define CLOCK_RCC_XTAL_MASK                  0x000007C0
+#define CLOCK_RCC_XTAL_16MHZ                 0x00000540   /* Crystal value used by the PLL */
+#define CLOCK_RCC_USESYSDIV_MASK             0x00400000   /* Divide the system clock by SYSDIV2 */
+
+/* Run-Mode Clock Configuration 2 register (RCC2), overrides the RCC fields once USERCC2 is set */
+#define CLOCK_RCC2_USERCC2_MASK              0x80000000
+#define CLOCK_RCC2_DIV400_MASK               0x40000000   /* Divide the 400 MHz PLL output instead of 200 MHz */
+#define CLOCK_RCC2_SYSDIV2_MASK              0x1F800000
+#define CLOCK_RCC2_SYSDIV2_POS               23
+#define CLOCK_RCC2_SYSDIV400_MASK            0x1FC00000   /* SYSDIV2:SYSDIV2LSB with DIV400 */
+#define CLOCK_RCC2_SYSDIV400_POS             22
+#define CLOCK_RCC2_PWRDN2_MASK               0x00002000   /* PLL powered down */
+#define CLOCK_RCC2_BYPASS2_MASK              0x00000800   /* System clock from the oscillator, PLL bypassed */
+#define CLOCK_RCC2_OSCSRC2_MASK              0x00000070
+#define CLOCK_RCC2_OSCSRC2_MOSC              0x00000000
+#define CLOCK_RCC2_OSCSRC2_PIOSC             0x00000010
+
+/* Raw interrupt status and PLL status registers */
+#define CLOCK_RIS_MOSCPUPRIS_MASK            0x00000100   /* MOSC powered up and stable */
+#define CLOCK_PLLSTAT_LOCK_MASK              0x00000001
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Clock_SourceType;  /* CLOCK_SOURCE_xxx */
+
+/* Called with the interrupts disabled once the new clock runs */
+typedef void (*Clock_ListenerType)(uint32 a_OldFrequencyHz, uint32 a_NewFrequencyHz);
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean Clock_SetFrequency(Clock_SourceType a_Source, uint32 a_FrequencyHz);
+
+uint32 Clock_GetFrequency(void);
+
+Clock_SourceType Clock_GetSource(void);
+
+boolean Clock_AddListener(Clock_ListenerType a_Listener);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,252 @@
+/**************************************************************************************************************************************
+ Module      : CpuLoad
+ Name        : CpuLoad.c
+ Author      : Salma Hamdy
+ Description : Source file for the CPU load meter splitting the utilization between ISR, thread and idle time
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Dwt.h"
+#include "SysTick.h"
+#include "Idle.h"
+#include "Clock.h"
+#include "CpuLoad.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Number of SysTick ticks of one window and ticks left in the current window */
+static uint16 g_CpuLoad_WindowTicks = 1;
+static uint16 g_CpuLoad_TicksLeft = 1;
+
+/* Nesting level of the wrapped ISRs, only the outermost ISR is timed so nested time is not counted twice */
+static volatile uint32 g_CpuLoad_IsrNesting = 0;
+static uint32 g_CpuLoad_IsrStart = 0;
+
+/* ISR cycles accumulated in the current window */
+static volatile uint32 g_CpuLoad_IsrCycles = 0;
+
+/* Sleep cycles reported by the Idle module at the start of the current window */
+static uint64 g_CpuLoad_WindowSleepStart = 0;
+static uint32 g_CpuLoad_WindowCycles = 0;
+
+/* History of the 1 second samples and the running sums of the last 10 and 60 samples */
+static uint16 g_CpuLoad_IsrHistory[CPULOAD_HISTORY_SAMPLES];
+static uint16 g_CpuLoad_IdleHistory[CPULOAD_HISTORY_SAMPLES];
+static uint32 g_CpuLoad_IsrSum10 = 0;
+static uint32 g_CpuLoad_IdleSum10 = 0;
+static uint32 g_CpuLoad_IsrSum60 = 0;
+static uint32 g_CpuLoad_IdleSum60 = 0;
+static uint8 g_CpuLoad_HistoryIndex = 0;
+
+/* Published report, Sequence is odd while the SysTick ISR updates it */
+static volatile uint32 g_CpuLoad_Sequence = 0;
+static CpuLoad_ReportType g_CpuLoad_Report;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Convert a busy per mille sum over a number of samples into a split, thread time is what is left */
+static void CpuLoad_MakeSplit(CpuLoad_SplitType *a_Split, uint32 a_IsrSum, uint32 a_IdleSum, uint32 a_Samples)
+{
+    a_Split->Isr    = (uint16)(a_IsrSum / a_Samples);
+    a_Split->Idle   = (uint16)(a_IdleSum / a_Samples);
+    a_Split->Thread = CPULOAD_FULL_SCALE - a_Split->Isr - a_Split->Idle;
+}
+
+/* Clock change listener: the window keeps its length in time, the sample in progress mixes cycles of both clocks */
+static void CpuLoad_ClockChanged(uint32 a_OldFrequencyHz, uint32 a_NewFrequencyHz)
+{
+    g_CpuLoad_WindowCycles = (uint32)(((uint64)g_CpuLoad_WindowCycles * a_NewFrequencyHz) / a_OldFrequencyHz);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CpuLoad_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_WindowTicks - SysTick ticks in one 1 second sample window
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the window follows the system clock changes, FALSE if the Clock listener table is full
+ * Description: Function to start the load accounting and measure the cost of the ISR wrappers. CpuLoad_Tick must be called
+ *              from the SysTick call back function and the main loop must sleep through Idle_Sleep.
+****************************************************************************************************************************************/
+boolean CpuLoad_Init(uint16 a_WindowTicks)
+{
+    Idle_StatsType idle;
+    uint32 start_cycles;
+    uint8 sample;
+
+    Dwt_EnableCycleCounter();
+
+    g_CpuLoad_WindowTicks = (a_WindowTicks == 0) ? 1 : a_WindowTicks;
+    g_CpuLoad_TicksLeft   = g_CpuLoad_WindowTicks;
+
+    for (sample = 0; sample < CPULOAD_HISTORY_SAMPLES; sample++)
+    {
+        g_CpuLoad_IsrHistory[sample]  = 0;
+        g_CpuLoad_IdleHistory[sample] = 0;
+    }
+    g_CpuLoad_IsrSum10 = g_CpuLoad_IdleSum10 = 0;
+    g_CpuLoad_IsrSum60 = g_CpuLoad_IdleSum60 = 0;
+    g_CpuLoad_HistoryIndex = 0;
+
+    /* Wrapper overhead: one enter / exit pair measured with the interrupts disabled */
+    Disable_Exceptions();
+    start_cycles = Dwt_GetCycles();
+    CpuLoad_IsrEnter();
+    CpuLoad_IsrExit();
+    g_CpuLoad_Report.IsrWrapperCycles = Dwt_GetCycles() - start_cycles;
+    g_CpuLoad_IsrCycles = 0;
+    Enable_Exceptions();
+
+    g_CpuLoad_Report.Samples       = 0;
+    g_CpuLoad_Report.MaxTickCycles = 0;
+
+    Idle_GetStats(&idle);
+    g_CpuLoad_WindowSleepStart = idle.SleepCycles;
+    g_CpuLoad_WindowCycles     = g_CpuLoad_WindowTicks * SysTick_GetPeriodCycles();
+    return Clock_AddListener(CpuLoad_ClockChanged);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CpuLoad_IsrEnter
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to call at the start of an ISR whose time is accounted as ISR load (optional wrapper).
+****************************************************************************************************************************************/
+void CpuLoad_IsrEnter(void)
+{
+    /* A nested ISR completes its enter / exit pair before the preempted one resumes, so the counter stays consistent */
+    if (g_CpuLoad_IsrNesting++ == 0)
+    {
+        g_CpuLoad_IsrStart = Dwt_GetCycles();
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CpuLoad_IsrExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to call at the end of an ISR wrapped with CpuLoad_IsrEnter.
+****************************************************************************************************************************************/
+void CpuLoad_IsrExit(void)
+{
+    if (--g_CpuLoad_IsrNesting == 0)
+    {
+        g_CpuLoad_IsrCycles += Dwt_GetCycles() - g_CpuLoad_IsrStart;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CpuLoad_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to close the sample window every a_WindowTicks SysTick ticks and publish the 1 s, 10 s and 60 s
+ *              utilization, it must be called from the SysTick call back function. Idle time comes from the sleep cycles
+ *              measured by Idle_Sleep, ISR time from the wrappers and thread time is the rest of the window.
+****************************************************************************************************************************************/
+void CpuLoad_Tick(void)
+{
+    Idle_StatsType idle;
+    uint32 start_cycles = Dwt_GetCycles();
+    uint32 cycles_per_mille;
+    uint32 isr_load;
+    uint32 idle_load;
+    uint8 oldest;
+    uint8 samples;
+
+    if (--g_CpuLoad_TicksLeft != 0)
+    {
+        return;
+    }
+    g_CpuLoad_TicksLeft = g_CpuLoad_WindowTicks;
+
+    Idle_GetStats(&idle);
+    cycles_per_mille = g_CpuLoad_WindowCycles / CPULOAD_FULL_SCALE;
+
+    idle_load = (uint32)(idle.SleepCycles - g_CpuLoad_WindowSleepStart) / cycles_per_mille;
+    isr_load  = g_CpuLoad_IsrCycles / cycles_per_mille;
+    g_CpuLoad_WindowSleepStart = idle.SleepCycles;
+    g_CpuLoad_IsrCycles = 0;
+
+    if (idle_load > CPULOAD_FULL_SCALE)
+    {
+        idle_load = CPULOAD_FULL_SCALE;
+    }
+    if (isr_load > (CPULOAD_FULL_SCALE - idle_load))
+    {
+        isr_load = CPULOAD_FULL_SCALE - idle_load;
+    }
+
+    /* Running sums: drop the sample leaving each horizon and add the new one */
+    oldest = (g_CpuLoad_HistoryIndex + CPULOAD_HISTORY_SAMPLES - CPULOAD_SHORT_SAMPLES) % CPULOAD_HISTORY_SAMPLES;
+    g_CpuLoad_IsrSum10  += isr_load  - g_CpuLoad_IsrHistory[oldest];
+    g_CpuLoad_IdleSum10 += idle_load - g_CpuLoad_IdleHistory[oldest];
+    g_CpuLoad_IsrSum60  += isr_load  - g_CpuLoad_IsrHistory[g_CpuLoad_HistoryIndex];
+    g_CpuLoad_IdleSum60 += idle_load - g_CpuLoad_IdleHistory[g_CpuLoad_HistoryIndex];
+    g_CpuLoad_IsrHistory[g_CpuLoad_HistoryIndex]  = (uint16)isr_load;
+    g_CpuLoad_IdleHistory[g_CpuLoad_HistoryIndex] = (uint16)idle_load;
+    g_CpuLoad_HistoryIndex = (g_CpuLoad_HistoryIndex + 1) % CPULOAD_HISTORY_SAMPLES;
+
+    g_CpuLoad_Sequence++;                                    /* Odd: report update in progress */
+
+    g_CpuLoad_Report.Samples++;
+    CpuLoad_MakeSplit(&g_CpuLoad_Report.Load1s, isr_load, idle_load, 1);
+
+    samples = (g_CpuLoad_Report.Samples < CPULOAD_SHORT_SAMPLES) ? (uint8)g_CpuLoad_Report.Samples : CPULOAD_SHORT_SAMPLES;
+    CpuLoad_MakeSplit(&g_CpuLoad_Report.Load10s, g_CpuLoad_IsrSum10, g_CpuLoad_IdleSum10, samples);
+
+    samples = (g_CpuLoad_Report.Samples < CPULOAD_HISTORY_SAMPLES) ? (uint8)g_CpuLoad_Report.Samples : CPULOAD_HISTORY_SAMPLES;
+    CpuLoad_MakeSplit(&g_CpuLoad_Report.Load60s, g_CpuLoad_IsrSum60, g_CpuLoad_IdleSum60, samples);
+
+    start_cycles = Dwt_GetCycles() - start_cycles;
+    if (start_cycles > g_CpuLoad_Report.MaxTickCycles)
+    {
+        g_CpuLoad_Report.MaxTickCycles = start_cycles;
+    }
+
+    g_CpuLoad_Sequence++;                                    /* Even: report consistent */
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CpuLoad_GetReport
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Report - Copy of the last published utilization figures and the meter overhead
+ * Return value: None
+ * Description: Function to read the CPU load report without masking interrupts, the copy is retried if the SysTick ISR
+ *              published a new sample while it was being read.
+****************************************************************************************************************************************/
+void CpuLoad_GetReport(CpuLoad_ReportType *a_Report)
+{
+    uint32 sequence;
+
+    if (a_Report == NULL_PTR)
+    {
+        return;
+    }
+
+    do
+    {
+        sequence  = g_CpuLoad_Sequence;
+        *a_Report = g_CpuLoad_Report;
+    } while ((sequence & 1) || (sequence != g_CpuLoad_Sequence));
+}
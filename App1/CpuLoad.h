@@ -0,0 +1,64 @@
+/***********************************************************************************************************************************
+ Module      : CpuLoad
+ Name        : CpuLoad.h
+ Author      : Salma Hamdy
+ Description : Header file for the CPU load meter splitting the utilization between ISR, thread and idle time
+ ************************************************************************************************************************************/
+
+#ifndef CPULOAD_H_
+#define CPULOAD_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* One sample is published per window (1 second), the 10 s and 60 s figures are rolling averages of the samples */
+#define CPULOAD_HISTORY_SAMPLES              60
+#define CPULOAD_SHORT_SAMPLES                10
+
+/* Utilization figures are in per mille of the wall-clock time */
+#define CPULOAD_FULL_SCALE                   1000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint16 Isr;       /* Time in the wrapped ISRs */
+    uint16 Thread;    /* Time in thread mode outside Idle_Sleep */
+    uint16 Idle;      /* Time asleep in Idle_Sleep */
+}CpuLoad_SplitType;
+
+typedef struct
+{
+    CpuLoad_SplitType Load1s;
+    CpuLoad_SplitType Load10s;
+    CpuLoad_SplitType Load60s;
+    uint32 Samples;                 /* Number of published windows */
+    uint32 IsrWrapperCycles;        /* Measured cost of one CpuLoad_IsrEnter / CpuLoad_IsrExit pair */
+    uint32 MaxTickCycles;           /* Longest measured CpuLoad_Tick */
+}CpuLoad_ReportType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean CpuLoad_Init(uint16 a_WindowTicks);
+
+void CpuLoad_IsrEnter(void);
+
+void CpuLoad_IsrExit(void);
+
+void CpuLoad_Tick(void);
+
+void CpuLoad_GetReport(CpuLoad_ReportType *a_Report);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* CPULOAD_H_ */
@@ -0,0 +1,122 @@
+/**************************************************************************************************************************************
+ Module      : CyclicExec
+ Name        : CyclicExec.c
+ Author      : Salma Hamdy
+ Description : Source file for the static time-triggered cyclic executive dispatched from the SysTick interrupt
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "Clock.h"
+#include "SysTick.h"
+#include "TimeConv.h"
+#include "CyclicExec.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Index of the frame dispatched by the next SysTick interrupt */
+static uint16 g_CyclicExec_Frame = 0;
+
+static CyclicExec_StatsType g_CyclicExec_Stats = {0, 0, 0};
+
+/***************************************************************************************************************************************
+ * Service Name: CyclicExec_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the executive is started, FALSE if the frame does not fit in the counter at its clock
+ * Description: Function to start the SysTick timer with the generated frame period and dispatch the frame table from its interrupt.
+ *              The table must be generated for a counter clock (--counter-hz) at least as fast as the running one, and the
+ *              system clock must not be raised above it while the executive runs.
+****************************************************************************************************************************************/
+boolean CyclicExec_Start(void)
+{
+    /* Clock the counter will run from, SysTick_GetCounterFrequency still reads the one active before SysTick_Init */
+    uint32 counter_hz = (SysTick_GetClockSource() == SYSTICK_CLOCK_PIOSC_DIV4) ? SYSTICK_PIOSC_DIV4_HZ : Clock_GetFrequency();
+
+    if ((counter_hz > CYCLIC_EXEC_COUNTER_HZ) ||
+        (((uint64)counter_hz * CYCLIC_EXEC_FRAME_MS) > (CYCLIC_EXEC_COUNTER_RANGE * 1000ULL)))
+    {
+        return FALSE;                                           /* SysTick would clamp the reload and shorten every frame */
+    }
+
+    g_CyclicExec_Frame = 0;
+    SysTick_SetCallBack(CyclicExec_FrameHandler);
+    SysTick_Init(CYCLIC_EXEC_FRAME_MS);
+    TimeConv_Init();                                            /* Budgets in microseconds to counter clocks at the running clock */
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CyclicExec_FrameHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: SysTick call back that runs the jobs of the current frame in table order without any scheduling decision.
+ *              The jobs are timed with the CURRENT register sampled before the first and after the last one, a set COUNTFLAG
+ *              means the counter wrapped while the jobs were running, so the frame overran into the next one.
+****************************************************************************************************************************************/
+void CyclicExec_FrameHandler(void)
+{
+    uint16 job;
+    uint32 start_count;
+    uint32 frame_cycles;
+
+    (void)HW_READ32(SYSTICK_CTRL_REG);                          /* Reading CTRL clears the COUNTFLAG of the wrap that started this frame */
+    start_count = HW_READ32(SYSTICK_CURRENT_REG);
+
+    for (job = g_CyclicExec_FrameStart[g_CyclicExec_Frame]; job < g_CyclicExec_FrameStart[g_CyclicExec_Frame + 1]; job++)
+    {
+        (*g_CyclicExec_Jobs[job])();
+    }
+
+    /* RELOAD may already hold the period after this one (fractional periods), so the start of the frame is sampled instead */
+    frame_cycles = start_count - HW_READ32(SYSTICK_CURRENT_REG);
+
+    if (HW_READ32(SYSTICK_CTRL_REG) & SYSTICK_COUNTFLAG_MASK)
+    {
+        g_CyclicExec_Stats.FrameOverruns++;
+        /* Down to zero, the reload, then the period loaded from RELOAD at the wrap, at least one full period elapsed */
+        frame_cycles = start_count + 1 + HW_READ32(SYSTICK_RELOAD_REG) - HW_READ32(SYSTICK_CURRENT_REG);
+    }
+
+    if (frame_cycles > TimeConv_UsToCounts(g_CyclicExec_FrameBudgetUs[g_CyclicExec_Frame]))
+    {
+        g_CyclicExec_Stats.BudgetOverruns++;
+    }
+
+    if (frame_cycles > g_CyclicExec_Stats.MaxFrameCycles)
+    {
+        g_CyclicExec_Stats.MaxFrameCycles = frame_cycles;
+    }
+
+    g_CyclicExec_Frame++;
+    if (g_CyclicExec_Frame == CYCLIC_EXEC_FRAME_COUNT)
+    {
+        g_CyclicExec_Frame = 0;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: CyclicExec_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the frame overrun statistics
+ * Return value: None
+ * Description: Function to read the frame and budget overrun counters and the longest measured frame.
+****************************************************************************************************************************************/
+void CyclicExec_GetStats(CyclicExec_StatsType *a_Stats)
+{
+    if (a_Stats != NULL_PTR)
+    {
+        *a_Stats = g_CyclicExec_Stats;
+    }
+}
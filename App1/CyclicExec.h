@@ -0,0 +1,60 @@
+/***********************************************************************************************************************************
+ Module      : CyclicExec
+ Name        : CyclicExec.h
+ Author      : Salma Hamdy
+ Description : Header file for the static time-triggered cyclic executive dispatched from the SysTick interrupt
+ ************************************************************************************************************************************/
+
+#ifndef CYCLICEXEC_H_
+#define CYCLICEXEC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "CyclicExec_Cfg.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define SYSTICK_COUNTFLAG_MASK               0x00010000
+
+/* Counter clocks of the longest SysTick period (24-bit counter) */
+#define CYCLIC_EXEC_COUNTER_RANGE            0x01000000UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*CyclicExec_TaskFuncType)(void);
+
+typedef struct
+{
+    uint32 FrameOverruns;     /* Frames whose jobs were still running when the next frame started */
+    uint32 BudgetOverruns;    /* Frames that used more cycles than their WCET budget from the schedule table */
+    uint32 MaxFrameCycles;    /* Longest measured frame in SysTick counter clocks, from the first job to the end of the last one */
+}CyclicExec_StatsType;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+
+/* Frame table generated by Tools/cyclic_exec_gen.py in CyclicExec_Cfg.c */
+extern const CyclicExec_TaskFuncType g_CyclicExec_Jobs[CYCLIC_EXEC_JOB_COUNT];
+extern const uint16 g_CyclicExec_FrameStart[CYCLIC_EXEC_FRAME_COUNT + 1];
+extern const uint32 g_CyclicExec_FrameBudgetUs[CYCLIC_EXEC_FRAME_COUNT];
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean CyclicExec_Start(void);
+
+void CyclicExec_FrameHandler(void);
+
+void CyclicExec_GetStats(CyclicExec_StatsType *a_Stats);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* CYCLICEXEC_H_ */
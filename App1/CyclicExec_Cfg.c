@@ -0,0 +1,33 @@
+/**************************************************************************************************************************************
+ Module      : CyclicExec
+ Name        : CyclicExec_Cfg.c
+ Author      : Generated by Tools/cyclic_exec_gen.py from CyclicExec_Schedule.txt, do not edit
+ Description : Static frame table of the time-triggered cyclic executive
+ ***************************************************************************************************************************************/
+
+#include "CyclicExec.h"
+
+/*
+ * Task                 Period(ms)  WCET(us)
+ * Leds_RotateTask            1000        50
+ *
+ * Hyperperiod 1000 ms, frame 1000 ms, worst frame load 50 us
+ */
+
+/* Jobs of all the frames in dispatch order */
+const CyclicExec_TaskFuncType g_CyclicExec_Jobs[CYCLIC_EXEC_JOB_COUNT] =
+{
+    Leds_RotateTask,               /* Frame 0 */
+};
+
+/* Index of the first job of each frame, the extra entry closes the last frame */
+const uint16 g_CyclicExec_FrameStart[CYCLIC_EXEC_FRAME_COUNT + 1] =
+{
+    0, 1
+};
+
+/* WCET budget of each frame in microseconds */
+const uint32 g_CyclicExec_FrameBudgetUs[CYCLIC_EXEC_FRAME_COUNT] =
+{
+    50
+};
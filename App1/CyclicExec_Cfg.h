@@ -0,0 +1,22 @@
+/***********************************************************************************************************************************
+ Module      : CyclicExec
+ Name        : CyclicExec_Cfg.h
+ Author      : Generated by Tools/cyclic_exec_gen.py from CyclicExec_Schedule.txt, do not edit
+ Description : Static frame table configuration of the time-triggered cyclic executive
+ ************************************************************************************************************************************/
+
+#ifndef CYCLICEXEC_CFG_H_
+#define CYCLICEXEC_CFG_H_
+
+#define CYCLIC_EXEC_HYPERPERIOD_MS           1000
+#define CYCLIC_EXEC_FRAME_MS                 1000
+#define CYCLIC_EXEC_FRAME_COUNT              1
+#define CYCLIC_EXEC_JOB_COUNT                1
+
+/* Highest SysTick counter clock the frame was sized for, CyclicExec_Start refuses a faster one */
+#define CYCLIC_EXEC_COUNTER_HZ               16000000UL
+
+/* Tasks of the schedule table */
+void Leds_RotateTask(void);
+
+#endif /* CYCLICEXEC_CFG_H_ */
@@ -0,0 +1,107 @@
+/**************************************************************************************************************************************
+ Module      : EventFlags
+ Name        : EventFlags.c
+ Author      : Salma Hamdy
+ Description : Source file for the event flags group signalled from ISRs and waited on from the main context with a timeout
+ ***************************************************************************************************************************************/
+
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Idle.h"
+#include "Atomic.h"
+#include "EventFlags.h"
+
+/***************************************************************************************************************************************
+ * Service Name: EventFlags_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): a_Group - Event flags group
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to initialize an event flags group with all the flags cleared.
+****************************************************************************************************************************************/
+void EventFlags_Init(EventFlags_Type *a_Group)
+{
+    a_Group->Flags = 0;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: EventFlags_Set
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (ISRs at any priority and the main loop)
+ * Parameters (in): a_Mask - Flags to set
+ * Parameters (inout): a_Group - Event flags group
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to signal events with a single atomic OR, the waiting main context wakes up on the ISR exit.
+****************************************************************************************************************************************/
+void EventFlags_Set(EventFlags_Type *a_Group, uint32 a_Mask)
+{
+    Atomic_FetchOr(&a_Group->Flags, a_Mask);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: EventFlags_Clear
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (ISRs at any priority and the main loop)
+ * Parameters (in): a_Mask - Flags to clear
+ * Parameters (inout): a_Group - Event flags group
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear events with a single atomic AND.
+****************************************************************************************************************************************/
+void EventFlags_Clear(EventFlags_Type *a_Group, uint32 a_Mask)
+{
+    Atomic_FetchAnd(&a_Group->Flags, ~a_Mask);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: EventFlags_Wait
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (thread mode only, with the interrupts enabled)
+ * Parameters (in): a_Mask - Flags to wait for, a_Mode - Wait for any or all of them
+ *                  a_ClearOnExit - Clear the matched flags before returning
+ *                  a_TimeoutTicks - Timeout in SysTick ticks, EVENTFLAGS_WAIT_FOREVER to wait without timeout
+ * Parameters (inout): a_Group - Event flags group
+ * Parameters (out): None
+ * Return value: uint32 - The matched flags, zero on timeout
+ * Description: Function to wait for events. Between checks the processor sleeps with WFI instead of polling, it is woken
+ *              up by the ISR that sets the flags or by the SysTick tick that advances the timeout. The SysTick interrupt
+ *              must be running when a timeout is used. It returns with the interrupts enabled whatever the PRIMASK was on
+ *              entry, so it must not be called from an ISR or inside a Disable_Exceptions section, where the ISR that sets
+ *              the flags could not run anyway.
+****************************************************************************************************************************************/
+uint32 EventFlags_Wait(EventFlags_Type *a_Group, uint32 a_Mask, EventFlags_WaitModeType a_Mode,
+                       boolean a_ClearOnExit, uint32 a_TimeoutTicks)
+{
+    uint32 start_tick = SysTick_GetTickCount();
+    uint32 flags;
+
+    while(1)
+    {
+        /* Check and sleep with the I-bit set, so a signal between the check and the WFI still wakes the processor up */
+        Disable_Exceptions();
+
+        flags = a_Group->Flags & a_Mask;
+
+        if (((a_Mode == EVENTFLAGS_WAIT_ALL) && (flags == a_Mask)) ||
+            ((a_Mode == EVENTFLAGS_WAIT_ANY) && (flags != 0)))
+        {
+            if (a_ClearOnExit)
+            {
+                a_Group->Flags &= ~flags;
+            }
+            Enable_Exceptions();
+            return flags;
+        }
+
+        if ((a_TimeoutTicks != EVENTFLAGS_WAIT_FOREVER) && ((SysTick_GetTickCount() - start_tick) >= a_TimeoutTicks))
+        {
+            Enable_Exceptions();
+            return 0;
+        }
+
+        Idle_Sleep();                        /* Returns with the interrupts enabled */
+    }
+}
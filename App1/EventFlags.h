@@ -0,0 +1,51 @@
+/***********************************************************************************************************************************
+ Module      : EventFlags
+ Name        : EventFlags.h
+ Author      : Salma Hamdy
+ Description : Header file for the event flags group signalled from ISRs and waited on from the main context with a timeout
+ ************************************************************************************************************************************/
+
+#ifndef EVENTFLAGS_H_
+#define EVENTFLAGS_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define EVENTFLAGS_WAIT_FOREVER              0xFFFFFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    EVENTFLAGS_WAIT_ANY,      /* Return when at least one of the requested flags is set */
+    EVENTFLAGS_WAIT_ALL       /* Return when all the requested flags are set */
+}EventFlags_WaitModeType;
+
+typedef struct
+{
+    volatile uint32 Flags;
+}EventFlags_Type;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void EventFlags_Init(EventFlags_Type *a_Group);
+
+void EventFlags_Set(EventFlags_Type *a_Group, uint32 a_Mask);
+
+void EventFlags_Clear(EventFlags_Type *a_Group, uint32 a_Mask);
+
+uint32 EventFlags_Wait(EventFlags_Type *a_Group, uint32 a_Mask, EventFlags_WaitModeType a_Mode,
+                       boolean a_ClearOnExit, uint32 a_TimeoutTicks);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* EVENTFLAGS_H_ */
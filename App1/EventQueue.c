@@ -0,0 +1,109 @@
+/**************************************************************************************************************************************
+ Module      : EventQueue
+ Name        : EventQueue.c
+ Author      : Salma Hamdy
+ Description : Source file for the bounded lock-free multi-producer single-consumer event queue (ISRs to main loop)
+ ***************************************************************************************************************************************/
+
+#include "Atomic.h"
+#include "EventQueue.h"
+
+/***************************************************************************************************************************************
+ * Service Name: EventQueue_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Slots - Storage of the queue, a_SlotsNum - Number of slots, must be a power of two
+ * Parameters (inout): a_Queue - Event queue object
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the queue is initialized, FALSE if the number of slots is not a power of two
+ * Description: Function to initialize an empty event queue, must be called before any producer posts.
+****************************************************************************************************************************************/
+boolean EventQueue_Init(EventQueue_Type *a_Queue, EventQueue_SlotType *a_Slots, uint32 a_SlotsNum)
+{
+    uint32 slot;
+
+    if ((a_SlotsNum == 0) || ((a_SlotsNum & (a_SlotsNum - 1)) != 0))
+    {
+        return FALSE;
+    }
+
+    for (slot = 0; slot < a_SlotsNum; slot++)
+    {
+        a_Slots[slot].Sequence = slot;      /* Free for the producer claiming position slot */
+    }
+
+    a_Queue->Slots      = a_Slots;
+    a_Queue->Mask       = a_SlotsNum - 1;
+    a_Queue->EnqueuePos = 0;
+    a_Queue->DequeuePos = 0;
+    a_Queue->Dropped    = 0;
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: EventQueue_Post
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (any ISR priority and the main loop may post concurrently)
+ * Parameters (in): a_Event - Event value
+ * Parameters (inout): a_Queue - Event queue object
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the event is queued, FALSE if the queue is full
+ * Description: Function to post an event without masking interrupts. A producer claims a position with an exclusive
+ *              compare-exchange; a preempting ISR makes the claim fail and retry on the next position instead of blocking.
+****************************************************************************************************************************************/
+boolean EventQueue_Post(EventQueue_Type *a_Queue, uint32 a_Event)
+{
+    EventQueue_SlotType *slot;
+    uint32 pos;
+    sint32 diff;
+
+    do
+    {
+        pos  = a_Queue->EnqueuePos;
+        slot = &a_Queue->Slots[pos & a_Queue->Mask];
+        diff = (sint32)(slot->Sequence - pos);
+
+        if (diff < 0)
+        {
+            Atomic_FetchAdd(&a_Queue->Dropped, 1);   /* The slot still holds an event of the previous lap */
+            return FALSE;
+        }
+    } while ((diff > 0) || !Atomic_CompareExchange(&a_Queue->EnqueuePos, pos, pos + 1));
+
+    slot->Event = a_Event;
+    Data_Memory_Barrier();                           /* The event is stored before the slot is published */
+    slot->Sequence = pos + 1;
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: EventQueue_Get
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (single consumer)
+ * Parameters (in): None
+ * Parameters (inout): a_Queue - Event queue object
+ * Parameters (out): a_Event - Oldest published event
+ * Return value: boolean - TRUE if an event is returned, FALSE if the queue is empty
+ * Description: Function to take the oldest event. An event claimed by a preempted producer but not published yet is
+ *              reported as empty and returned on a later call, after that producer completes.
+****************************************************************************************************************************************/
+boolean EventQueue_Get(EventQueue_Type *a_Queue, uint32 *a_Event)
+{
+    uint32 pos = a_Queue->DequeuePos;
+    EventQueue_SlotType *slot = &a_Queue->Slots[pos & a_Queue->Mask];
+
+    if (slot->Sequence != (pos + 1))
+    {
+        return FALSE;
+    }
+
+    Data_Memory_Barrier();                           /* The event is loaded after the published sequence */
+    *a_Event = slot->Event;
+    Data_Memory_Barrier();                           /* The event is loaded before the slot is freed for the next lap */
+    slot->Sequence = pos + a_Queue->Mask + 1;
+    a_Queue->DequeuePos = pos + 1;
+
+    return TRUE;
+}
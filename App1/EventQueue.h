@@ -0,0 +1,50 @@
+/***********************************************************************************************************************************
+ Module      : EventQueue
+ Name        : EventQueue.h
+ Author      : Salma Hamdy
+ Description : Header file for the bounded lock-free multi-producer single-consumer event queue (ISRs to main loop)
+ ************************************************************************************************************************************/
+
+#ifndef EVENTQUEUE_H_
+#define EVENTQUEUE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Each slot carries a sequence number: Sequence == position means free for the producer claiming that position,
+ * Sequence == position + 1 means published for the consumer. */
+typedef struct
+{
+    volatile uint32 Sequence;
+    uint32 Event;
+}EventQueue_SlotType;
+
+typedef struct
+{
+    EventQueue_SlotType *Slots;
+    uint32 Mask;                     /* Number of slots - 1, the number of slots is a power of two */
+    volatile uint32 EnqueuePos;      /* Next position to claim, shared by all the producers */
+    uint32 DequeuePos;               /* Next position to consume, owned by the consumer */
+    volatile uint32 Dropped;         /* Events rejected because the queue was full */
+}EventQueue_Type;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean EventQueue_Init(EventQueue_Type *a_Queue, EventQueue_SlotType *a_Slots, uint32 a_SlotsNum);
+
+boolean EventQueue_Post(EventQueue_Type *a_Queue, uint32 a_Event);
+
+boolean EventQueue_Get(EventQueue_Type *a_Queue, uint32 *a_Event);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* EVENTQUEUE_H_ */
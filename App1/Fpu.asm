@@ -0,0 +1,24 @@
+;***********************************************************************************************************************************
+; Module      : Fpu
+; Name        : Fpu.asm
+; Author      : Salma Hamdy
+; Description : CONTROL register access for the FPU context checks of the ARM Cortex M4F (TI ARM assembler syntax)
+;***********************************************************************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global Fpu_GetControl
+
+;***********************************************************************************************************************************
+; uint32 Fpu_GetControl(void)
+; Returns the CONTROL register, FPCA (bit 2) is set once the current context executed an FP instruction. On exception entry it
+; is cleared for the handler, so a handler reading it set has used the FPU itself.
+;***********************************************************************************************************************************
+Fpu_GetControl: .asmfunc
+        MRS     R0, CONTROL
+        BX      LR
+        .endasmfunc
+
+        .end
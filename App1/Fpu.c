@@ -0,0 +1,117 @@
+/**************************************************************************************************************************************
+ Module      : Fpu
+ Name        : Fpu.c
+ Author      : Salma Hamdy
+ Description : Source file for the FPU access and exception FP context stacking configuration (lazy, automatic or disabled)
+
+ _c_int00 enables the FPU before main, which leaves the FP context stacking in its reset state (ASPEN and LSPEN set, lazy). The
+ drivers never touched FPCCR, so the mode was implicit. Fpu_Init makes it a per-build choice (FPU_STACKING_MODE). An exception
+ taken from a context with an active FP context reserves or stores the FP registers depending on this mode, the integer-only
+ handlers keep the minimal 8-word frame cost with LAZY and the minimal frame itself with DISABLED. The ISR_TIMING build counts
+ per vector the executions that used the FPU (IsrTiming_StatsType FpuUses), which tells whether DISABLED is safe.
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "Fpu.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#ifdef TM4C_SIM
+#define Fpu_SyncBarriers()
+#else
+#define Fpu_SyncBarriers()                   __asm(" DSB \n ISB ")
+#endif
+
+/***************************************************************************************************************************************
+ * Service Name: Fpu_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to grant full access to the FPU (already done by _c_int00, kept for other start-up code) and apply
+ *              the FP stacking mode of the build. It must be called before the interrupts are enabled.
+****************************************************************************************************************************************/
+void Fpu_Init(void)
+{
+    FPU_CPAC_REG |= FPU_CPAC_CP10_CP11_FULL_MASK;
+    Fpu_SyncBarriers();
+    (void)Fpu_SetStackingMode(FPU_STACKING_MODE);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fpu_SetStackingMode
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Mode - FPU_STACKING_AUTOMATIC, FPU_STACKING_LAZY or FPU_STACKING_DISABLED
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the mode is applied, FALSE if it is not a valid mode
+ * Description: Function to set ASPEN and LSPEN in FPCCR. The mode must only change from thread mode with no exception active,
+ *              frames already stacked keep the layout they were stacked with.
+****************************************************************************************************************************************/
+boolean Fpu_SetStackingMode(Fpu_StackingModeType a_Mode)
+{
+    uint32 fpcc = FPU_FPCC_REG & ~(FPU_FPCC_ASPEN_MASK | FPU_FPCC_LSPEN_MASK);
+
+    switch (a_Mode)
+    {
+    case FPU_STACKING_AUTOMATIC:
+        fpcc |= FPU_FPCC_ASPEN_MASK;
+        break;
+    case FPU_STACKING_LAZY:
+        fpcc |= FPU_FPCC_ASPEN_MASK | FPU_FPCC_LSPEN_MASK;
+        break;
+    case FPU_STACKING_DISABLED:
+        break;
+    default:
+        return FALSE;
+    }
+
+    FPU_FPCC_REG = fpcc;
+    Fpu_SyncBarriers();
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fpu_GetStackingMode
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Fpu_StackingModeType - Mode read back from FPCCR
+ * Description: Function to read the FP stacking mode in effect. LSPEN without ASPEN reads as DISABLED, nothing is stacked.
+****************************************************************************************************************************************/
+Fpu_StackingModeType Fpu_GetStackingMode(void)
+{
+    uint32 fpcc = FPU_FPCC_REG;
+
+    if (!(fpcc & FPU_FPCC_ASPEN_MASK))
+    {
+        return FPU_STACKING_DISABLED;
+    }
+    return (fpcc & FPU_FPCC_LSPEN_MASK) ? FPU_STACKING_LAZY : FPU_STACKING_AUTOMATIC;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fpu_IsContextActive
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the current context executed an FP instruction (CONTROL.FPCA), FALSE otherwise
+ * Description: Function to check the FP context of the running code. In a handler it tells whether the handler itself used
+ *              the FPU since its entry. FPCA is only set automatically with the AUTOMATIC and LAZY modes.
+****************************************************************************************************************************************/
+boolean Fpu_IsContextActive(void)
+{
+    return (Fpu_GetControl() & FPU_CONTROL_FPCA_MASK) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
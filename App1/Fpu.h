@@ -0,0 +1,77 @@
+/***********************************************************************************************************************************
+ Module      : Fpu
+ Name        : Fpu.h
+ Author      : Salma Hamdy
+ Description : Header file for the FPU access and exception FP context stacking configuration (lazy, automatic or disabled)
+ ************************************************************************************************************************************/
+
+#ifndef FPU_H_
+#define FPU_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/*
+ * FP context stacking on exception entry, for a context whose CONTROL.FPCA is set (it executed an FP instruction):
+ *   AUTOMATIC  S0-S15 and FPSCR are always pushed and popped, 17 more words and about 17 cycles more on entry and on exit.
+ *   LAZY       The space is reserved but the registers are only saved if the handler executes an FP instruction, integer-only
+ *              handlers pay no extra time (reset state of the core).
+ *   DISABLED   FPCA is never set by the hardware, every frame is the minimal 8-word one. Only valid when no handler uses the
+ *              FPU and a single context (main, not several kernel threads) does, as nothing saves the FP registers.
+ */
+#define FPU_STACKING_AUTOMATIC               0
+#define FPU_STACKING_LAZY                    1
+#define FPU_STACKING_DISABLED                2
+
+/* Mode applied by Fpu_Init, select it per build with -DFPU_STACKING_MODE=FPU_STACKING_xxx */
+#ifndef FPU_STACKING_MODE
+#define FPU_STACKING_MODE                    FPU_STACKING_LAZY
+#endif
+
+/* Coprocessor Access Control register: full access to CP10 and CP11 (the FPU) */
+#define FPU_CPAC_CP10_CP11_FULL_MASK         0x00F00000
+
+/* Floating-Point Context Control register */
+#define FPU_FPCC_ASPEN_MASK                  0x80000000   /* Set CONTROL.FPCA on FP instructions, stack the FP context */
+#define FPU_FPCC_LSPEN_MASK                  0x40000000   /* Lazy preservation of the FP context */
+#define FPU_FPCC_LSPACT_MASK                 0x00000001   /* Lazy state preservation is pending */
+
+/* CONTROL register: an FP context is active in the current mode */
+#define FPU_CONTROL_FPCA_MASK                0x00000004
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Fpu_StackingModeType;  /* FPU_STACKING_xxx */
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+#ifdef TM4C_SIM
+/* Host build: CONTROL is kept by the simulator */
+#include "Sim.h"
+#define Fpu_GetControl()                     Sim_GetControl()
+#else
+/* MRS of the CONTROL register, implemented in Fpu.asm */
+uint32 Fpu_GetControl(void);
+#endif
+
+void Fpu_Init(void);
+
+boolean Fpu_SetStackingMode(Fpu_StackingModeType a_Mode);
+
+Fpu_StackingModeType Fpu_GetStackingMode(void);
+
+boolean Fpu_IsContextActive(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* FPU_H_ */
@@ -0,0 +1,265 @@
+/**************************************************************************************************************************************
+ Module      : Governor
+ Name        : Governor.c
+ Author      : Salma Hamdy
+ Description : Source file for the frequency governor choosing a PLL operating point from the measured CPU busy time
+
+ Every SysTick tick the governor takes the busy time of the period from the Idle accounting (elapsed minus sleep cycles). A tick
+ busy above GOVERNOR_UP_LOAD requests the fastest point at once: the work that did not fit is unknown and a late job misses its
+ deadline. Otherwise the ticks of a window are averaged and the slowest point running the same work below GOVERNOR_TARGET_LOAD is
+ chosen, a slower point being applied only after GOVERNOR_DOWN_WINDOWS windows agree. The switch is done in the SysTick ISR: a
+ job running to completion in thread mode would otherwise keep the slow clock for its whole length. Every point is a division
+ of the 400 MHz PLL, which stays locked, so a switch costs a few microseconds with the interrupts disabled and no MOSC start-up
+ or PLL lock time. The clock listeners of SysTick, Idle and CpuLoad keep the tick period in wall-clock time and the counters
+ continuous.
+ ***************************************************************************************************************************************/
+
+#include "NVIC.h"
+#include "Idle.h"
+#include "Clock.h"
+#include "Governor.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Operating points: 400 MHz PLL divided by 25, 16, 10, 8 and 5 */
+static const uint32 g_Governor_PointsHz[GOVERNOR_POINTS] =
+{
+    16000000UL, 25000000UL, 40000000UL, 50000000UL, 80000000UL
+};
+
+/* Running operating point */
+static uint8 g_Governor_Point = GOVERNOR_FASTEST_POINT;
+
+/* Idle accounting at the previous tick */
+static uint64 g_Governor_LastTotal = 0;
+static uint64 g_Governor_LastSleep = 0;
+
+/* Window in progress, restarted when the point changes */
+static uint8 g_Governor_WindowTicks = 0;
+static uint32 g_Governor_WindowBusy = 0;
+static uint32 g_Governor_WindowTotal = 0;
+
+/* Consecutive windows asking for a slower point and the fastest of their choices */
+static uint8 g_Governor_DownWindows = 0;
+static uint8 g_Governor_DownPoint = 0;
+
+static Governor_StatsType g_Governor_Stats;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Busy per mille of a number of cycles */
+static uint16 Governor_Load(uint32 a_BusyCycles, uint32 a_TotalCycles)
+{
+    uint32 cycles_per_mille = a_TotalCycles / GOVERNOR_FULL_SCALE;
+
+    if ((cycles_per_mille == 0) || (a_BusyCycles >= a_TotalCycles))
+    {
+        return GOVERNOR_FULL_SCALE;
+    }
+    return (uint16)(a_BusyCycles / cycles_per_mille);
+}
+
+/* Slowest point running the load of the current point below the target load, in kHz so the product fits 32 bits */
+static uint8 Governor_SelectPoint(uint16 a_Load)
+{
+    uint32 needed_khz = ((g_Governor_PointsHz[g_Governor_Point] / 1000) * a_Load) / GOVERNOR_TARGET_LOAD;
+    uint8 point;
+
+    for (point = 0; point < GOVERNOR_FASTEST_POINT; point++)
+    {
+        if ((g_Governor_PointsHz[point] / 1000) >= needed_khz)
+        {
+            break;
+        }
+    }
+    return point;
+}
+
+/* Switch to an operating point, a refused switch leaves the clock on the 16 MHz PIOSC, counted as the slowest point */
+static void Governor_Apply(uint8 a_Point)
+{
+    if (Clock_SetFrequency(CLOCK_SOURCE_PLL, g_Governor_PointsHz[a_Point]))
+    {
+        g_Governor_Point = a_Point;
+        g_Governor_Stats.Switches++;
+    }
+    else
+    {
+        g_Governor_Point = 0;
+        g_Governor_Stats.Failures++;
+    }
+}
+
+/* Start a new window and a new down decision, after a switch or a saturated tick */
+static void Governor_RestartWindow(void)
+{
+    g_Governor_WindowTicks = 0;
+    g_Governor_WindowBusy  = 0;
+    g_Governor_WindowTotal = 0;
+    g_Governor_DownWindows = 0;
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: Governor_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the core runs at the fastest operating point, FALSE if the PLL could not be started
+ * Description: Function to start the governor at the fastest point, so no deadline is missed before the first decision.
+ *              SysTick and Idle must be initialized and Governor_Tick must be called from the SysTick call back function.
+ *              It must be called with the interrupts enabled, the application does not change the clock itself afterwards.
+****************************************************************************************************************************************/
+boolean Governor_Init(void)
+{
+    Idle_StatsType idle;
+    uint8 point;
+    boolean started;
+
+    started = Clock_SetFrequency(CLOCK_SOURCE_PLL, g_Governor_PointsHz[GOVERNOR_FASTEST_POINT]);
+
+    Disable_Exceptions();
+    g_Governor_Point = started ? GOVERNOR_FASTEST_POINT : 0;
+    Governor_RestartWindow();
+
+    Idle_GetStats(&idle);
+    g_Governor_LastTotal = idle.TotalCycles;
+    g_Governor_LastSleep = idle.SleepCycles;
+
+    g_Governor_Stats.Load     = 0;
+    g_Governor_Stats.Switches = 0;
+    g_Governor_Stats.Failures = started ? 0 : 1;
+    for (point = 0; point < GOVERNOR_POINTS; point++)
+    {
+        g_Governor_Stats.TicksAtPoint[point] = 0;
+    }
+    Enable_Exceptions();
+
+    return started;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Governor_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sample the busy time of the elapsed tick and switch the operating point, it must be called from
+ *              the SysTick call back function. A switch happens on a tick boundary, so every sample runs at a single clock.
+****************************************************************************************************************************************/
+void Governor_Tick(void)
+{
+    Idle_StatsType idle;
+    uint32 total_cycles;
+    uint32 sleep_cycles;
+    uint32 busy_cycles;
+    uint16 load;
+    uint8 point;
+
+    Idle_GetStats(&idle);
+    total_cycles = (uint32)(idle.TotalCycles - g_Governor_LastTotal);
+    sleep_cycles = (uint32)(idle.SleepCycles - g_Governor_LastSleep);
+    busy_cycles  = (sleep_cycles < total_cycles) ? (total_cycles - sleep_cycles) : 0;
+    g_Governor_LastTotal = idle.TotalCycles;
+    g_Governor_LastSleep = idle.SleepCycles;
+
+    g_Governor_Stats.TicksAtPoint[g_Governor_Point]++;
+
+    if (Governor_Load(busy_cycles, total_cycles) >= GOVERNOR_UP_LOAD)
+    {
+        if (g_Governor_Point != GOVERNOR_FASTEST_POINT)
+        {
+            Governor_Apply(GOVERNOR_FASTEST_POINT);
+        }
+        Governor_RestartWindow();
+        return;
+    }
+
+    g_Governor_WindowBusy  += busy_cycles;
+    g_Governor_WindowTotal += total_cycles;
+    if (++g_Governor_WindowTicks < GOVERNOR_WINDOW_TICKS)
+    {
+        return;
+    }
+
+    load  = Governor_Load(g_Governor_WindowBusy, g_Governor_WindowTotal);
+    point = Governor_SelectPoint(load);
+    g_Governor_Stats.Load  = load;
+    g_Governor_WindowTicks = 0;
+    g_Governor_WindowBusy  = 0;
+    g_Governor_WindowTotal = 0;
+
+    if (point > g_Governor_Point)
+    {
+        Governor_Apply(point);
+        Governor_RestartWindow();
+    }
+    else if (point < g_Governor_Point)
+    {
+        /* Lower the clock only to the fastest point the last windows asked for */
+        if ((g_Governor_DownWindows == 0) || (point > g_Governor_DownPoint))
+        {
+            g_Governor_DownPoint = point;
+        }
+        if (++g_Governor_DownWindows >= GOVERNOR_DOWN_WINDOWS)
+        {
+            Governor_Apply(g_Governor_DownPoint);
+            Governor_RestartWindow();
+        }
+    }
+    else
+    {
+        g_Governor_DownWindows = 0;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Governor_GetPointFrequency
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Point - Index of the operating point
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - System clock of the operating point in Hz, 0 if the index is not valid
+ * Description: Function to read the operating point table.
+****************************************************************************************************************************************/
+uint32 Governor_GetPointFrequency(uint8 a_Point)
+{
+    return (a_Point < GOVERNOR_POINTS) ? g_Governor_PointsHz[a_Point] : 0;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Governor_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the governor statistics
+ * Return value: None
+ * Description: Function to read the running point, the last window load and the switch and residency counters.
+****************************************************************************************************************************************/
+void Governor_GetStats(Governor_StatsType *a_Stats)
+{
+    if (a_Stats != NULL_PTR)
+    {
+        Disable_Exceptions();
+        *a_Stats = g_Governor_Stats;
+        a_Stats->Point = g_Governor_Point;
+        Enable_Exceptions();
+    }
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
@@ -0,0 +1,64 @@
+/***********************************************************************************************************************************
+ Module      : Governor
+ Name        : Governor.h
+ Author      : Salma Hamdy
+ Description : Header file for the frequency governor choosing a PLL operating point from the measured CPU busy time
+ ************************************************************************************************************************************/
+
+#ifndef GOVERNOR_H_
+#define GOVERNOR_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Operating points of the table in Governor.c, index 0 is the slowest one and the last index the fastest one */
+#define GOVERNOR_POINTS                      5
+#define GOVERNOR_FASTEST_POINT               (GOVERNOR_POINTS - 1)
+
+/* Busy time in per mille of the SysTick period */
+#define GOVERNOR_FULL_SCALE                  1000
+
+/* A tick busy above this level jumps to the fastest point at once, the load of a saturated tick is unknown */
+#define GOVERNOR_UP_LOAD                     900
+
+/* A window picks the slowest point that would run its load below this level */
+#define GOVERNOR_TARGET_LOAD                 700
+
+/* SysTick ticks averaged by one decision and windows a slower point must be enough before the clock is lowered */
+#define GOVERNOR_WINDOW_TICKS                5
+#define GOVERNOR_DOWN_WINDOWS                4
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint8 Point;                           /* Running operating point */
+    uint16 Load;                           /* Busy per mille of the last complete window */
+    uint32 Switches;                       /* Operating point changes */
+    uint32 Failures;                       /* Changes refused by the clock driver, the clock is then the 16 MHz PIOSC */
+    uint32 TicksAtPoint[GOVERNOR_POINTS];  /* SysTick ticks spent at each operating point */
+}Governor_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean Governor_Init(void);
+
+void Governor_Tick(void);
+
+uint32 Governor_GetPointFrequency(uint8 a_Point);
+
+void Governor_GetStats(Governor_StatsType *a_Stats);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* GOVERNOR_H_ */
@@ -0,0 +1,192 @@
+/**************************************************************************************************************************************
+ Module      : Idle
+ Name        : Idle.c
+ Author      : Salma Hamdy
+ Description : Source file for the WFI / sleep-on-exit low-power idle integrated with the SysTick driver
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Clock.h"
+#include "Idle.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Fraction bits of the system clock cycles per SysTick counter clock, exact for the PLL divisions of a PIOSC / 4 counter */
+#define IDLE_CYCLES_PER_COUNT_SHIFT          16
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Cumulative sleep time in system clock cycles (main context only) */
+static uint64 g_Idle_SleepCycles = 0;
+
+/* Cycles elapsed before the last clock change, tick count since then and cycles of one tick at the running clock */
+static uint64 g_Idle_TotalCyclesBase = 0;
+static uint32 g_Idle_StartTick = 0;
+static uint32 g_Idle_CyclesPerTick = 0;
+
+/* System clock cycles per SysTick counter clock, 1.0 unless the counter runs from PIOSC / 4 */
+static uint32 g_Idle_CyclesPerCount = 1UL << IDLE_CYCLES_PER_COUNT_SHIFT;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint32 Idle_ComputeCyclesPerCount(void)
+{
+    return (uint32)(((uint64)Clock_GetFrequency() << IDLE_CYCLES_PER_COUNT_SHIFT) / SysTick_GetCounterFrequency());
+}
+
+/* Clock change listener: the elapsed ticks are converted at the old clock, the next ones count at the new clock */
+static void Idle_ClockChanged(uint32 a_OldFrequencyHz, uint32 a_NewFrequencyHz)
+{
+    uint32 tick = SysTick_GetTickCount();
+
+    g_Idle_TotalCyclesBase += (uint64)(tick - g_Idle_StartTick) * g_Idle_CyclesPerTick;
+    g_Idle_StartTick        = tick;
+    g_Idle_CyclesPerTick    = (uint32)(((uint64)g_Idle_CyclesPerTick * a_NewFrequencyHz) / a_OldFrequencyHz);
+    g_Idle_CyclesPerCount   = Idle_ComputeCyclesPerCount();
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the accounting follows the system clock changes, FALSE if the Clock listener table is full
+ * Description: Function to restart the sleep / active accounting, the SysTick interrupt must be running. The total cycles
+ *              stay continuous across system clock changes, a PIOSC / 4 SysTick counter is converted to system clock cycles.
+****************************************************************************************************************************************/
+boolean Idle_Init(void)
+{
+    g_Idle_SleepCycles     = 0;
+    g_Idle_TotalCyclesBase = 0;
+    g_Idle_StartTick       = SysTick_GetTickCount();
+    g_Idle_CyclesPerTick   = SysTick_GetPeriodCycles();
+    g_Idle_CyclesPerCount  = Idle_ComputeCyclesPerCount();
+    return Clock_AddListener(Idle_ClockChanged);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_Sleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (main context only)
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep with WFI until the next interrupt. It must be called with the interrupts disabled
+ *              (Disable_Exceptions) right after checking there is no work, so an interrupt between the check and the WFI
+ *              still wakes the processor up. It returns with the interrupts enabled, after the pending ISR is served.
+ *              The sleep time is measured on the SysTick counter, which keeps counting while the core clock is gated;
+ *              at most one SysTick wrap can happen before the wake-up because the wrap itself pends an interrupt.
+****************************************************************************************************************************************/
+void Idle_Sleep(void)
+{
+    uint32 before_current;
+    uint32 after_current;
+    uint32 pending_before;
+    uint32 sleep_counts = 0;
+
+    before_current = SYSTICK_CURRENT_REG;
+    pending_before = NVIC_SYSTEM_INTCTRL & INTCTRL_PENDSTSET_MASK;
+
+    Wait_For_Interrupt();
+
+    after_current = SYSTICK_CURRENT_REG;
+
+    if (!pending_before && (NVIC_SYSTEM_INTCTRL & INTCTRL_PENDSTSET_MASK))
+    {
+        /* Woken up by the SysTick wrap, a PIOSC / 4 counter still reads 0 during the counter clock that follows it */
+        sleep_counts = before_current + ((after_current != 0) ? ((SYSTICK_RELOAD_REG + 1) - after_current) : 0);
+    }
+    else if (after_current <= before_current)
+    {
+        sleep_counts = before_current - after_current;
+    }
+    g_Idle_SleepCycles += ((uint64)sleep_counts * g_Idle_CyclesPerCount) >> IDLE_CYCLES_PER_COUNT_SHIFT;
+
+    Enable_Exceptions();                     /* The pending interrupt is served here */
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_DelayTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (main context only)
+ * Parameters (in): a_Ticks - Delay in SysTick ticks
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to wait for the specified number of SysTick interrupts while sleeping, instead of polling the
+ *              COUNTFLAG bit like SysTick_StartBusyWait. Other interrupts keep being served during the delay.
+****************************************************************************************************************************************/
+void Idle_DelayTicks(uint32 a_Ticks)
+{
+    uint32 start_tick = SysTick_GetTickCount();
+
+    while(1)
+    {
+        Disable_Exceptions();
+
+        if ((SysTick_GetTickCount() - start_tick) >= a_Ticks)
+        {
+            Enable_Exceptions();
+            return;
+        }
+
+        Idle_Sleep();
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_SetSleepOnExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Enable - TRUE to sleep again on every return from an ISR to Thread mode
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to control SLEEPONEXIT, an interrupt-only application sets it and executes WFI once, then it runs
+ *              only in the ISRs and never pays the thread mode exception return and re-entry costs.
+****************************************************************************************************************************************/
+void Idle_SetSleepOnExit(boolean a_Enable)
+{
+    if (a_Enable)
+    {
+        NVIC_SYSTEM_SYSCTRL |= SYSCTRL_SLEEPONEXIT_MASK;
+    }
+    else
+    {
+        NVIC_SYSTEM_SYSCTRL &= ~SYSCTRL_SLEEPONEXIT_MASK;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (main context only)
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Sleep and total cycles since Idle_Init, the active cycles are TotalCycles - SleepCycles
+ * Return value: None
+ * Description: Function to read the sleep accounting, used to measure the duty cycle of the application.
+****************************************************************************************************************************************/
+void Idle_GetStats(Idle_StatsType *a_Stats)
+{
+    if (a_Stats != NULL_PTR)
+    {
+        a_Stats->SleepCycles = g_Idle_SleepCycles;
+        a_Stats->TotalCycles = g_Idle_TotalCyclesBase + (uint64)(SysTick_GetTickCount() - g_Idle_StartTick) * g_Idle_CyclesPerTick;
+    }
+}
@@ -0,0 +1,181 @@
+/**************************************************************************************************************************************
+ Module      : IsrTiming
+ Name        : IsrTiming.c
+ Author      : Salma Hamdy
+ Description : Source file for the per-vector ISR timing statistics collected by the generated vector table trampolines
+
+ Building with ISR_TIMING replaces g_pfnVectors of tm4c123gh6pm_startup_ccs.c with the table of IsrTiming_Vectors.h, where every
+ handler is entered through an ISR_TIMING_TRAMPOLINE. The handlers themselves are not changed, the table is regenerated with
+ Tools/isr_timing_gen.py whenever the vector table of the startup file changes.
+ ***************************************************************************************************************************************/
+
+#include "NVIC.h"
+#include "IsrTiming.h"
+
+#ifdef TM4C_SIM
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+IsrTiming_StatsType g_IsrTiming_Stats[ISR_TIMING_VECTORS];
+volatile uint32 g_IsrTiming_NestedCycles = 0;
+
+static IsrTiming_OverheadType g_IsrTiming_Overhead;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void IsrTiming_EmptyHandler(void)
+{
+}
+
+/* Called through a volatile pointer so the calibration handler is a real call like the vector table handlers */
+static void (* volatile g_IsrTiming_CalibrationHandler)(void) = IsrTiming_EmptyHandler;
+
+ISR_TIMING_TRAMPOLINE(IsrTiming_CalibrationTrampoline, ISR_TIMING_CALIBRATION_VECTOR, g_IsrTiming_CalibrationHandler)
+
+#ifdef TM4C_SIM
+/* Host build: print the statistics next to the exception report of the simulator, read directly as the simulation has stopped */
+static void IsrTiming_Report(void)
+{
+    const IsrTiming_StatsType *stats;
+    uint8 vector;
+
+    printf("isr timing: bias %u cycles, trampoline %u cycles\n",
+           g_IsrTiming_Overhead.BiasCycles, g_IsrTiming_Overhead.TrampolineCycles);
+    printf("%8s %10s %12s %10s %10s %10s\n", "vector", "count", "total", "mean", "max", "fpu uses");
+    for (vector = 1; vector < ISR_TIMING_VECTORS; vector++)
+    {
+        stats = &g_IsrTiming_Stats[vector];
+        if (stats->Count != 0)
+        {
+            printf("%8u %10u %12llu %10llu %10u %10u\n", vector, stats->Count, stats->TotalCycles,
+                   stats->TotalCycles / stats->Count, stats->MaxCycles, stats->FpuUses);
+        }
+    }
+}
+#endif
+
+/***************************************************************************************************************************************
+ * Service Name: IsrTiming_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to start the DWT cycle counter, clear the statistics and measure the trampoline overhead around an
+ *              empty handler. It must be called before the interrupts are enabled, the counts start from the first interrupt.
+ *              The trampoline masks the interrupts itself and returns with them enabled.
+****************************************************************************************************************************************/
+void IsrTiming_Init(void)
+{
+    uint32 start_cycles;
+    uint32 cycles;
+    uint8 sample;
+
+    Dwt_EnableCycleCounter();
+
+    /* Minimum over a few runs, the first one may include cache and pipeline refill effects */
+    g_IsrTiming_Overhead.BiasCycles       = 0xFFFFFFFF;
+    g_IsrTiming_Overhead.TrampolineCycles = 0xFFFFFFFF;
+
+    for (sample = 0; sample < ISR_TIMING_CALIBRATION_SAMPLES; sample++)
+    {
+        g_IsrTiming_Stats[ISR_TIMING_CALIBRATION_VECTOR].MaxCycles = 0;
+
+        start_cycles = Dwt_GetCycles();
+        IsrTiming_CalibrationTrampoline();
+        cycles = Dwt_GetCycles() - start_cycles;
+
+        if (cycles < g_IsrTiming_Overhead.TrampolineCycles)
+        {
+            g_IsrTiming_Overhead.TrampolineCycles = cycles;
+        }
+        if (g_IsrTiming_Stats[ISR_TIMING_CALIBRATION_VECTOR].MaxCycles < g_IsrTiming_Overhead.BiasCycles)
+        {
+            g_IsrTiming_Overhead.BiasCycles = g_IsrTiming_Stats[ISR_TIMING_CALIBRATION_VECTOR].MaxCycles;
+        }
+    }
+
+    IsrTiming_Reset();
+
+#ifdef TM4C_SIM
+    atexit(IsrTiming_Report);
+#endif
+}
+
+/***************************************************************************************************************************************
+ * Service Name: IsrTiming_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Vector - Vector table index (exception number) of the handler
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the statistics of the vector
+ * Return value: boolean - TRUE if the vector index is valid, FALSE otherwise
+ * Description: Function to read the execution count, total and maximum cycles of one vector. The copy is taken with the
+ *              interrupts disabled because the 64-bit total cannot be read in one access.
+****************************************************************************************************************************************/
+boolean IsrTiming_GetStats(uint8 a_Vector, IsrTiming_StatsType *a_Stats)
+{
+    if ((a_Vector == ISR_TIMING_CALIBRATION_VECTOR) || (a_Vector >= ISR_TIMING_VECTORS))
+    {
+        return FALSE;
+    }
+
+    Disable_Exceptions();
+    *a_Stats = g_IsrTiming_Stats[a_Vector];
+    Enable_Exceptions();
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: IsrTiming_GetOverhead
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Overhead - Trampoline overhead measured by IsrTiming_Init
+ * Return value: None
+ * Description: Function to read the trampoline overhead. BiasCycles can be subtracted from every execution figure,
+ *              TrampolineCycles is the extra latency and CPU time the instrumented table adds to each interrupt.
+****************************************************************************************************************************************/
+void IsrTiming_GetOverhead(IsrTiming_OverheadType *a_Overhead)
+{
+    *a_Overhead = g_IsrTiming_Overhead;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: IsrTiming_Reset
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the statistics of all the vectors, e.g. at the start of a measurement window.
+****************************************************************************************************************************************/
+void IsrTiming_Reset(void)
+{
+    uint8 vector;
+
+    Disable_Exceptions();
+    for (vector = 0; vector < ISR_TIMING_VECTORS; vector++)
+    {
+        g_IsrTiming_Stats[vector].Count       = 0;
+        g_IsrTiming_Stats[vector].MaxCycles   = 0;
+        g_IsrTiming_Stats[vector].TotalCycles = 0;
+        g_IsrTiming_Stats[vector].FpuUses     = 0;
+    }
+    Enable_Exceptions();
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
@@ -0,0 +1,151 @@
+/***********************************************************************************************************************************
+ Module      : IsrTiming
+ Name        : IsrTiming.h
+ Author      : Salma Hamdy
+ Description : Header file for the per-vector ISR timing statistics collected by the generated vector table trampolines
+ ************************************************************************************************************************************/
+
+#ifndef ISRTIMING_H_
+#define ISRTIMING_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+#include "Dwt.h"
+#include "Fpu.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Entries of the TM4C123GH6PM vector table: 16 system exceptions and 139 IRQ entries */
+#define ISR_TIMING_VECTORS                   155
+
+/* Vector table entry 0 holds the initial stack pointer and never runs, its statistics slot is used by the calibration */
+#define ISR_TIMING_CALIBRATION_VECTOR        0
+#define ISR_TIMING_CALIBRATION_SAMPLES       8
+
+/*
+ * Timing trampoline of one vector, expanded for every entry of the instrumented vector table generated by
+ * Tools/isr_timing_gen.py. The handler is called unchanged, so only handlers that return normally (no EXC_RETURN
+ * handling in LR like PendSV_Handler, no fault handlers inspecting the stacked frame) can be wrapped.
+ */
+#define ISR_TIMING_TRAMPOLINE(NAME, VECTOR, HANDLER)    \
+    static void NAME(void)                              \
+    {                                                   \
+        IsrTiming_FrameType frame;                      \
+        IsrTiming_Enter(&frame);                        \
+        HANDLER();                                      \
+        IsrTiming_Exit((VECTOR), &frame);               \
+    }
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 Count;             /* Completed executions of the handler */
+    uint32 MaxCycles;         /* Longest execution, nested handlers excluded */
+    uint64 TotalCycles;       /* Sum of the executions, nested handlers excluded */
+    uint32 FpuUses;           /* Executions that used the FPU (CONTROL.FPCA set on exit), 0 for integer-only handlers */
+}IsrTiming_StatsType;
+
+typedef struct
+{
+    uint32 BiasCycles;        /* Trampoline cycles between the two counter reads, included in every execution figure */
+    uint32 TrampolineCycles;  /* Full cost of one trampoline call around an empty handler, added to every interrupt */
+}IsrTiming_OverheadType;
+
+/* State of one trampoline, kept on the stack of the interrupted context */
+typedef struct
+{
+    uint32 Start;
+    uint32 SavedNestedCycles;
+}IsrTiming_FrameType;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+
+/* Each slot is written by the trampoline of its own vector only, a vector cannot preempt itself */
+extern IsrTiming_StatsType g_IsrTiming_Stats[ISR_TIMING_VECTORS];
+
+/* Cycles spent in the handlers nested inside the running one */
+extern volatile uint32 g_IsrTiming_NestedCycles;
+
+/*******************************************************************************
+ *                         Inline Functions Definitions                        *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: IsrTiming_Enter
+ * Reentrancy: Reentrant
+ * Parameters (out): a_Frame - Trampoline state
+ * Return value: None
+ * Description: Function to start timing a handler, the nested time of the preempted handler is saved in the frame. The start
+ *              time, the save and the clear are taken with the interrupts masked, a handler nested between them would be
+ *              counted in neither the preempted handler nor this one, or would make the own time of this one wrap. It returns
+ *              with the interrupts enabled, which they are in any handler it wraps.
+****************************************************************************************************************************************/
+static inline void IsrTiming_Enter(IsrTiming_FrameType *a_Frame)
+{
+    Disable_Exceptions();
+    a_Frame->Start             = Dwt_GetCycles();
+    a_Frame->SavedNestedCycles = g_IsrTiming_NestedCycles;
+    g_IsrTiming_NestedCycles   = 0;
+    Enable_Exceptions();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: IsrTiming_Exit
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Vector - Vector table index of the handler, a_Frame - Trampoline state filled by IsrTiming_Enter
+ * Return value: None
+ * Description: Function to account a handler execution without the handlers nested in it, its whole duration is then added to
+ *              the nested time of the preempted handler. FPCA was cleared on the handler entry, set on exit it shows that the
+ *              handler used the FPU (nested handlers restore it on their return). The end time, the nested time and its
+ *              hand-over to the preempted handler are taken with the interrupts masked, so a handler nested between them
+ *              is not lost from the preempted handler. The statistics slot belongs to this vector only and is updated after.
+****************************************************************************************************************************************/
+static inline void IsrTiming_Exit(uint8 a_Vector, const IsrTiming_FrameType *a_Frame)
+{
+    IsrTiming_StatsType *stats = &g_IsrTiming_Stats[a_Vector];
+    uint32 elapsed;
+    uint32 own;
+
+    Disable_Exceptions();
+    elapsed                  = Dwt_GetCycles() - a_Frame->Start;
+    own                      = elapsed - g_IsrTiming_NestedCycles;
+    g_IsrTiming_NestedCycles = a_Frame->SavedNestedCycles + elapsed;
+    Enable_Exceptions();
+
+    stats->TotalCycles += own;
+    if (own > stats->MaxCycles)
+    {
+        stats->MaxCycles = own;
+    }
+    stats->Count++;
+    if (Fpu_IsContextActive())
+    {
+        stats->FpuUses++;
+    }
+}
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void IsrTiming_Init(void);
+
+boolean IsrTiming_GetStats(uint8 a_Vector, IsrTiming_StatsType *a_Stats);
+
+void IsrTiming_GetOverhead(IsrTiming_OverheadType *a_Overhead);
+
+void IsrTiming_Reset(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* ISRTIMING_H_ */
@@ -0,0 +1,291 @@
+/***********************************************************************************************************************************
+ Module      : IsrTiming
+ Name        : IsrTiming_Vectors.h
+ Author      : Generated by Tools/isr_timing_gen.py from tm4c123gh6pm_startup_ccs.c, do not edit
+ Description : Instrumented vector table of the ISR_TIMING build, included by the startup file in place of g_pfnVectors
+ ************************************************************************************************************************************/
+
+#ifndef ISRTIMING_VECTORS_H_
+#define ISRTIMING_VECTORS_H_
+
+#include "IsrTiming.h"
+
+/* Not instrumented: FaultISR, NmiSR, PendSV_Handler, ResetISR */
+
+/* Timing trampolines, one per instrumented vector */
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector4, 4, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector5, 5, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector6, 6, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector11, 11, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector12, 12, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector15, 15, SysTick_Handler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector16, 16, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector17, 17, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector18, 18, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector19, 19, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector20, 20, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector21, 21, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector22, 22, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector23, 23, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector24, 24, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector25, 25, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector26, 26, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector27, 27, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector28, 28, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector29, 29, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector30, 30, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector31, 31, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector32, 32, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector33, 33, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector34, 34, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector35, 35, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector36, 36, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector37, 37, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector38, 38, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector39, 39, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector40, 40, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector41, 41, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector42, 42, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector43, 43, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector44, 44, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector45, 45, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector46, 46, GPIOPortF_Handler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector47, 47, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector48, 48, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector49, 49, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector50, 50, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector51, 51, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector52, 52, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector53, 53, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector54, 54, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector55, 55, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector56, 56, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector59, 59, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector60, 60, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector61, 61, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector62, 62, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector63, 63, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector64, 64, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector65, 65, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector66, 66, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector67, 67, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector70, 70, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector71, 71, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector72, 72, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector73, 73, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector74, 74, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector75, 75, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector76, 76, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector77, 77, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector78, 78, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector79, 79, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector84, 84, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector85, 85, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector86, 86, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector87, 87, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector108, 108, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector109, 109, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector110, 110, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector111, 111, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector112, 112, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector113, 113, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector114, 114, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector115, 115, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector116, 116, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector117, 117, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector118, 118, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector119, 119, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector120, 120, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector121, 121, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector122, 122, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector125, 125, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector126, 126, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector127, 127, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector128, 128, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector129, 129, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector132, 132, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector133, 133, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector134, 134, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector135, 135, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector136, 136, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector137, 137, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector138, 138, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector139, 139, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector140, 140, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector141, 141, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector142, 142, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector143, 143, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector144, 144, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector145, 145, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector146, 146, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector147, 147, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector148, 148, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector149, 149, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector150, 150, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector151, 151, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector152, 152, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector153, 153, IntDefaultHandler)
+ISR_TIMING_TRAMPOLINE(IsrTiming_Vector154, 154, IntDefaultHandler)
+
+#pragma DATA_SECTION(g_pfnVectors, ".intvecs")
+void (* const g_pfnVectors[])(void) =
+{
+    (void (*)(void))((uintptr_t)&__STACK_TOP),
+                                            // The initial stack pointer
+    ResetISR,                               // The reset handler
+    NmiSR,                                  // The NMI handler
+    FaultISR,                               // The hard fault handler
+    IsrTiming_Vector4,                      // The MPU fault handler
+    IsrTiming_Vector5,                      // The bus fault handler
+    IsrTiming_Vector6,                      // The usage fault handler
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector11,                     // SVCall handler
+    IsrTiming_Vector12,                     // Debug monitor handler
+    0,                                      // Reserved
+    PendSV_Handler,                         // The PendSV handler
+    IsrTiming_Vector15,                     // The SysTick handler
+    IsrTiming_Vector16,                     // GPIO Port A
+    IsrTiming_Vector17,                     // GPIO Port B
+    IsrTiming_Vector18,                     // GPIO Port C
+    IsrTiming_Vector19,                     // GPIO Port D
+    IsrTiming_Vector20,                     // GPIO Port E
+    IsrTiming_Vector21,                     // UART0 Rx and Tx
+    IsrTiming_Vector22,                     // UART1 Rx and Tx
+    IsrTiming_Vector23,                     // SSI0 Rx and Tx
+    IsrTiming_Vector24,                     // I2C0 Master and Slave
+    IsrTiming_Vector25,                     // PWM Fault
+    IsrTiming_Vector26,                     // PWM Generator 0
+    IsrTiming_Vector27,                     // PWM Generator 1
+    IsrTiming_Vector28,                     // PWM Generator 2
+    IsrTiming_Vector29,                     // Quadrature Encoder 0
+    IsrTiming_Vector30,                     // ADC Sequence 0
+    IsrTiming_Vector31,                     // ADC Sequence 1
+    IsrTiming_Vector32,                     // ADC Sequence 2
+    IsrTiming_Vector33,                     // ADC Sequence 3
+    IsrTiming_Vector34,                     // Watchdog timer
+    IsrTiming_Vector35,                     // Timer 0 subtimer A
+    IsrTiming_Vector36,                     // Timer 0 subtimer B
+    IsrTiming_Vector37,                     // Timer 1 subtimer A
+    IsrTiming_Vector38,                     // Timer 1 subtimer B
+    IsrTiming_Vector39,                     // Timer 2 subtimer A
+    IsrTiming_Vector40,                     // Timer 2 subtimer B
+    IsrTiming_Vector41,                     // Analog Comparator 0
+    IsrTiming_Vector42,                     // Analog Comparator 1
+    IsrTiming_Vector43,                     // Analog Comparator 2
+    IsrTiming_Vector44,                     // System Control (PLL, OSC, BO)
+    IsrTiming_Vector45,                     // FLASH Control
+    IsrTiming_Vector46,                     // GPIO Port F
+    IsrTiming_Vector47,                     // GPIO Port G
+    IsrTiming_Vector48,                     // GPIO Port H
+    IsrTiming_Vector49,                     // UART2 Rx and Tx
+    IsrTiming_Vector50,                     // SSI1 Rx and Tx
+    IsrTiming_Vector51,                     // Timer 3 subtimer A
+    IsrTiming_Vector52,                     // Timer 3 subtimer B
+    IsrTiming_Vector53,                     // I2C1 Master and Slave
+    IsrTiming_Vector54,                     // Quadrature Encoder 1
+    IsrTiming_Vector55,                     // CAN0
+    IsrTiming_Vector56,                     // CAN1
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector59,                     // Hibernate
+    IsrTiming_Vector60,                     // USB0
+    IsrTiming_Vector61,                     // PWM Generator 3
+    IsrTiming_Vector62,                     // uDMA Software Transfer
+    IsrTiming_Vector63,                     // uDMA Error
+    IsrTiming_Vector64,                     // ADC1 Sequence 0
+    IsrTiming_Vector65,                     // ADC1 Sequence 1
+    IsrTiming_Vector66,                     // ADC1 Sequence 2
+    IsrTiming_Vector67,                     // ADC1 Sequence 3
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector70,                     // GPIO Port J
+    IsrTiming_Vector71,                     // GPIO Port K
+    IsrTiming_Vector72,                     // GPIO Port L
+    IsrTiming_Vector73,                     // SSI2 Rx and Tx
+    IsrTiming_Vector74,                     // SSI3 Rx and Tx
+    IsrTiming_Vector75,                     // UART3 Rx and Tx
+    IsrTiming_Vector76,                     // UART4 Rx and Tx
+    IsrTiming_Vector77,                     // UART5 Rx and Tx
+    IsrTiming_Vector78,                     // UART6 Rx and Tx
+    IsrTiming_Vector79,                     // UART7 Rx and Tx
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector84,                     // I2C2 Master and Slave
+    IsrTiming_Vector85,                     // I2C3 Master and Slave
+    IsrTiming_Vector86,                     // Timer 4 subtimer A
+    IsrTiming_Vector87,                     // Timer 4 subtimer B
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector108,                    // Timer 5 subtimer A
+    IsrTiming_Vector109,                    // Timer 5 subtimer B
+    IsrTiming_Vector110,                    // Wide Timer 0 subtimer A
+    IsrTiming_Vector111,                    // Wide Timer 0 subtimer B
+    IsrTiming_Vector112,                    // Wide Timer 1 subtimer A
+    IsrTiming_Vector113,                    // Wide Timer 1 subtimer B
+    IsrTiming_Vector114,                    // Wide Timer 2 subtimer A
+    IsrTiming_Vector115,                    // Wide Timer 2 subtimer B
+    IsrTiming_Vector116,                    // Wide Timer 3 subtimer A
+    IsrTiming_Vector117,                    // Wide Timer 3 subtimer B
+    IsrTiming_Vector118,                    // Wide Timer 4 subtimer A
+    IsrTiming_Vector119,                    // Wide Timer 4 subtimer B
+    IsrTiming_Vector120,                    // Wide Timer 5 subtimer A
+    IsrTiming_Vector121,                    // Wide Timer 5 subtimer B
+    IsrTiming_Vector122,                    // FPU
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector125,                    // I2C4 Master and Slave
+    IsrTiming_Vector126,                    // I2C5 Master and Slave
+    IsrTiming_Vector127,                    // GPIO Port M
+    IsrTiming_Vector128,                    // GPIO Port N
+    IsrTiming_Vector129,                    // Quadrature Encoder 2
+    0,                                      // Reserved
+    0,                                      // Reserved
+    IsrTiming_Vector132,                    // GPIO Port P (Summary or P0)
+    IsrTiming_Vector133,                    // GPIO Port P1
+    IsrTiming_Vector134,                    // GPIO Port P2
+    IsrTiming_Vector135,                    // GPIO Port P3
+    IsrTiming_Vector136,                    // GPIO Port P4
+    IsrTiming_Vector137,                    // GPIO Port P5
+    IsrTiming_Vector138,                    // GPIO Port P6
+    IsrTiming_Vector139,                    // GPIO Port P7
+    IsrTiming_Vector140,                    // GPIO Port Q (Summary or Q0)
+    IsrTiming_Vector141,                    // GPIO Port Q1
+    IsrTiming_Vector142,                    // GPIO Port Q2
+    IsrTiming_Vector143,                    // GPIO Port Q3
+    IsrTiming_Vector144,                    // GPIO Port Q4
+    IsrTiming_Vector145,                    // GPIO Port Q5
+    IsrTiming_Vector146,                    // GPIO Port Q6
+    IsrTiming_Vector147,                    // GPIO Port Q7
+    IsrTiming_Vector148,                    // GPIO Port R
+    IsrTiming_Vector149,                    // GPIO Port S
+    IsrTiming_Vector150,                    // PWM 1 Generator 0
+    IsrTiming_Vector151,                    // PWM 1 Generator 1
+    IsrTiming_Vector152,                    // PWM 1 Generator 2
+    IsrTiming_Vector153,                    // PWM 1 Generator 3
+    IsrTiming_Vector154                     // PWM 1 Fault
+};
+
+#endif /* ISRTIMING_VECTORS_H_ */
@@ -0,0 +1,395 @@
+/**************************************************************************************************************************************
+ Module      : Kernel
+ Name        : Kernel.c
+ Author      : Salma Hamdy
+ Description : Source file for the preemptive priority-based kernel using PendSV context switching and SysTick time slicing
+ ***************************************************************************************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Mpu.h"
+#include "Stack.h"
+#include "Kernel.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Running thread and the thread to switch to, shared with PendSV_Handler */
+Kernel_TcbType * volatile g_Kernel_CurrentTcb = NULL_PTR;
+Kernel_TcbType * volatile g_Kernel_NextTcb = NULL_PTR;
+
+/* FIFO ready list of each priority level, the head of the list is the thread that runs at this level */
+static Kernel_TcbType *g_Kernel_ReadyHead[KERNEL_PRIORITY_LEVELS];
+static Kernel_TcbType *g_Kernel_ReadyTail[KERNEL_PRIORITY_LEVELS];
+
+/* Bitmap of the priority levels that have at least one ready thread */
+static volatile uint32 g_Kernel_ReadyMask = 0;
+
+/* Delta list of the sleeping threads ordered by wake-up time */
+static Kernel_TcbType *g_Kernel_SleepHead = NULL_PTR;
+
+/* Number of SysTick ticks since Kernel_Start */
+static volatile uint32 g_Kernel_TickCount = 0;
+
+/* Idle thread, runs at the lowest priority level when no other thread is ready */
+static Kernel_TcbType g_Kernel_IdleTcb;
+static uint32 g_Kernel_IdleStack[KERNEL_IDLE_STACK_WORDS + KERNEL_STACK_GUARD_WORDS];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Append a thread to the tail of the ready list of its priority */
+static void Kernel_ReadyInsert(Kernel_TcbType *a_Tcb)
+{
+    Kernel_PriorityType prio = a_Tcb->Priority;
+
+    a_Tcb->Next  = NULL_PTR;
+    a_Tcb->State = KERNEL_THREAD_READY;
+
+    if (g_Kernel_ReadyHead[prio] == NULL_PTR)
+    {
+        g_Kernel_ReadyHead[prio] = a_Tcb;
+        g_Kernel_ReadyMask |= KERNEL_PRIORITY_BIT(prio);
+    }
+    else
+    {
+        g_Kernel_ReadyTail[prio]->Next = a_Tcb;
+    }
+    g_Kernel_ReadyTail[prio] = a_Tcb;
+}
+
+/* Remove the head thread (the running one of its priority level) from its ready list */
+static void Kernel_ReadyRemoveHead(Kernel_PriorityType a_Priority)
+{
+    Kernel_TcbType *head = g_Kernel_ReadyHead[a_Priority];
+
+    g_Kernel_ReadyHead[a_Priority] = head->Next;
+    head->Next = NULL_PTR;
+
+    if (g_Kernel_ReadyHead[a_Priority] == NULL_PTR)
+    {
+        g_Kernel_ReadyTail[a_Priority] = NULL_PTR;
+        g_Kernel_ReadyMask &= ~KERNEL_PRIORITY_BIT(a_Priority);
+    }
+}
+
+/* Move the head thread of a priority level to the tail of its list (round robin) */
+static void Kernel_ReadyRotate(Kernel_PriorityType a_Priority)
+{
+    Kernel_TcbType *head = g_Kernel_ReadyHead[a_Priority];
+
+    if ((head != NULL_PTR) && (head->Next != NULL_PTR))
+    {
+        g_Kernel_ReadyHead[a_Priority] = head->Next;
+        g_Kernel_ReadyTail[a_Priority]->Next = head;
+        g_Kernel_ReadyTail[a_Priority] = head;
+        head->Next = NULL_PTR;
+    }
+}
+
+/* Insert a thread in the sleep delta list, each entry keeps the ticks remaining after its predecessor wakes up */
+static void Kernel_SleepInsert(Kernel_TcbType *a_Tcb, uint32 a_Ticks)
+{
+    Kernel_TcbType **link = &g_Kernel_SleepHead;
+
+    while ((*link != NULL_PTR) && ((*link)->SleepDelta <= a_Ticks))
+    {
+        a_Ticks -= (*link)->SleepDelta;
+        link = &((*link)->Next);
+    }
+
+    if (*link != NULL_PTR)
+    {
+        (*link)->SleepDelta -= a_Ticks;
+    }
+
+    a_Tcb->SleepDelta = a_Ticks;
+    a_Tcb->State = KERNEL_THREAD_SLEEPING;
+    a_Tcb->Next = *link;
+    *link = a_Tcb;
+}
+
+/* Pick the head thread of the most urgent ready priority and pend PendSV if it is not the running one. The target is always
+ * written: a thread that sleeps and is woken by a tick taken before PendSV must not be switched out to the previous target */
+static void Kernel_Schedule(void)
+{
+    Kernel_TcbType *next = g_Kernel_ReadyHead[_norm(g_Kernel_ReadyMask)];   /* CLZ: most urgent ready priority */
+
+    g_Kernel_NextTcb = next;
+    if (next != g_Kernel_CurrentTcb)
+    {
+        NVIC_SYSTEM_INTCTRL = PENDSV_SET_MASK;   /* Write-one register, no read-modify-write to avoid re-pending other exceptions */
+    }
+    else
+    {
+        NVIC_SYSTEM_INTCTRL = PENDSV_CLR_MASK;   /* Drop a switch pended for a target that is no longer the most urgent */
+    }
+}
+
+/* Returned to when a thread function exits, the thread becomes dormant */
+static void Kernel_ThreadExit(void)
+{
+    Disable_Exceptions();
+    Kernel_ReadyRemoveHead(g_Kernel_CurrentTcb->Priority);
+    g_Kernel_CurrentTcb->State = KERNEL_THREAD_DORMANT;
+    Kernel_Schedule();
+    Enable_Exceptions();
+
+    while(1)
+    {
+    }
+}
+
+static void Kernel_IdleThread(void)
+{
+    while(1)
+    {
+        Wait_For_Interrupt();
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the kernel ready and sleep lists and create the idle thread.
+****************************************************************************************************************************************/
+void Kernel_Init(void)
+{
+    uint8 prio;
+
+    for (prio = 0; prio < KERNEL_PRIORITY_LEVELS; prio++)
+    {
+        g_Kernel_ReadyHead[prio] = NULL_PTR;
+        g_Kernel_ReadyTail[prio] = NULL_PTR;
+    }
+
+    g_Kernel_ReadyMask  = 0;
+    g_Kernel_SleepHead  = NULL_PTR;
+    g_Kernel_TickCount  = 0;
+    g_Kernel_CurrentTcb = NULL_PTR;
+    g_Kernel_NextTcb    = NULL_PTR;
+
+    Kernel_CreateThread(&g_Kernel_IdleTcb, Kernel_IdleThread, g_Kernel_IdleStack, KERNEL_IDLE_STACK_WORDS + KERNEL_STACK_GUARD_WORDS,
+                        KERNEL_IDLE_PRIORITY);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_CreateThread
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_ThreadFunc - Thread entry function, the thread becomes dormant if it returns
+ *                  a_Stack - Thread stack (8-byte aligned), a_StackWords - Stack size in 32-bit words
+ *                  a_Priority - Priority level of the thread (0 is the most urgent)
+ * Parameters (inout): a_Tcb - Thread Control Block owned by the caller
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the thread is created and ready, FALSE if the parameters are invalid
+ * Description: Function to build the initial exception frame of a thread on its stack and add it to the ready list. When the MPU
+ *              stack guards are enabled (Mpu_Init) the bottom of the stack becomes the guard of the thread, the stack then needs
+ *              KERNEL_STACK_GUARD_WORDS extra words.
+****************************************************************************************************************************************/
+boolean Kernel_CreateThread(Kernel_TcbType *a_Tcb, Kernel_ThreadFuncType a_ThreadFunc, uint32 *a_Stack,
+                            uint32 a_StackWords, Kernel_PriorityType a_Priority)
+{
+    uint32 guard = Mpu_GetStackGuard(a_Stack);
+    uint32 *sp;
+    uint8 reg;
+
+    if ((a_Tcb == NULL_PTR) || (a_ThreadFunc == NULL_PTR) || (a_Stack == NULL_PTR) ||
+        (a_StackWords < (KERNEL_MIN_STACK_WORDS + ((guard != 0) ? KERNEL_STACK_GUARD_WORDS : 0))) ||
+        (a_Priority >= KERNEL_PRIORITY_LEVELS) ||
+        ((a_Priority == KERNEL_IDLE_PRIORITY) && (a_Tcb != &g_Kernel_IdleTcb)))
+    {
+        return FALSE;
+    }
+
+    Stack_Paint(a_Stack, a_StackWords);       /* Before the frame, the frame words count as used */
+
+    sp = a_Stack + a_StackWords;
+    sp = (uint32 *)((uintptr_t)sp & ~(uintptr_t)0x7);   /* AAPCS: 8-byte aligned stack */
+
+    /* Hardware frame popped on exception return, code addresses are 32 bits wide on target */
+    *(--sp) = KERNEL_INITIAL_XPSR;                       /* xPSR */
+    *(--sp) = (uint32)(uintptr_t)a_ThreadFunc;           /* PC */
+    *(--sp) = (uint32)(uintptr_t)Kernel_ThreadExit;      /* LR */
+    for (reg = 0; reg < 5; reg++)
+    {
+        *(--sp) = 0;                                     /* R12, R3, R2, R1, R0 */
+    }
+
+    /* Software frame restored by PendSV_Handler */
+    *(--sp) = KERNEL_INITIAL_EXC_RETURN;                 /* EXC_RETURN */
+    for (reg = 0; reg < 8; reg++)
+    {
+        *(--sp) = 0;                                     /* R11 .. R4 */
+    }
+
+    a_Tcb->StackPtr   = sp;
+    a_Tcb->StackGuard = guard;
+    a_Tcb->Priority   = a_Priority;
+    a_Tcb->SleepDelta = 0;
+    a_Tcb->SliceLeft  = KERNEL_TIME_SLICE_TICKS;
+    a_Tcb->StackBase  = a_Stack;
+    a_Tcb->StackWords = a_StackWords;
+
+    Disable_Exceptions();
+    Kernel_ReadyInsert(a_Tcb);
+    if (g_Kernel_CurrentTcb != NULL_PTR)
+    {
+        Kernel_Schedule();                     /* Preempt the caller if the new thread is more urgent */
+    }
+    Enable_Exceptions();
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to start multitasking, it never returns. Kernel_Tick must be registered as the SysTick call back function,
+ *              and SysTick must have a higher priority than PendSV.
+****************************************************************************************************************************************/
+void Kernel_Start(void)
+{
+    /* PendSV at the lowest priority so the context switch runs only after all the ISRs complete */
+    NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, PENDSV_LOWEST_PRIORITY);
+
+    Disable_Exceptions();
+    g_Kernel_NextTcb = g_Kernel_ReadyHead[_norm(g_Kernel_ReadyMask)];
+    Kernel_StartFirstThread();                 /* Enables the interrupts and jumps to the first thread */
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to wake up the sleeping threads and rotate the time slice, it must be registered as the SysTick call back function.
+****************************************************************************************************************************************/
+void Kernel_Tick(void)
+{
+    Kernel_TcbType *tcb;
+
+    if (g_Kernel_CurrentTcb == NULL_PTR)
+    {
+        return;                                /* Kernel not started yet */
+    }
+
+    /* No critical section needed, threads cannot run while the SysTick ISR is active and no other ISR touches the lists */
+    g_Kernel_TickCount++;
+
+    /* Only the head of the delta list counts down, all the threads with a zero delta wake up together */
+    if (g_Kernel_SleepHead != NULL_PTR)
+    {
+        g_Kernel_SleepHead->SleepDelta--;
+        while ((g_Kernel_SleepHead != NULL_PTR) && (g_Kernel_SleepHead->SleepDelta == 0))
+        {
+            tcb = g_Kernel_SleepHead;
+            g_Kernel_SleepHead = tcb->Next;
+            Kernel_ReadyInsert(tcb);
+        }
+    }
+
+    /* Round robin between the ready threads of the running priority */
+    tcb = g_Kernel_CurrentTcb;
+    if ((tcb->State == KERNEL_THREAD_READY) && (--tcb->SliceLeft == 0))
+    {
+        tcb->SliceLeft = KERNEL_TIME_SLICE_TICKS;
+        Kernel_ReadyRotate(tcb->Priority);
+    }
+
+    Kernel_Schedule();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_Sleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Ticks - Number of SysTick ticks to sleep, zero behaves as Kernel_Yield
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to block the calling thread for the specified number of ticks.
+****************************************************************************************************************************************/
+void Kernel_Sleep(uint32 a_Ticks)
+{
+    Kernel_TcbType *tcb = g_Kernel_CurrentTcb;
+
+    if (a_Ticks == 0)
+    {
+        Kernel_Yield();
+        return;
+    }
+
+    Disable_Exceptions();
+    Kernel_ReadyRemoveHead(tcb->Priority);
+    Kernel_SleepInsert(tcb, a_Ticks);
+    Kernel_Schedule();
+    Enable_Exceptions();                       /* PendSV switches the thread out here */
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_Yield
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to give the processor to the next ready thread of the same priority, if any.
+****************************************************************************************************************************************/
+void Kernel_Yield(void)
+{
+    Kernel_TcbType *tcb = g_Kernel_CurrentTcb;
+
+    Disable_Exceptions();
+    tcb->SliceLeft = KERNEL_TIME_SLICE_TICKS;
+    Kernel_ReadyRotate(tcb->Priority);
+    Kernel_Schedule();
+    Enable_Exceptions();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_GetTickCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of SysTick ticks since the kernel started
+ * Description: Function to read the kernel tick counter.
+****************************************************************************************************************************************/
+uint32 Kernel_GetTickCount(void)
+{
+    return g_Kernel_TickCount;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Kernel_GetStackHighWater
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Tcb - Thread Control Block of a created thread
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Deepest use of the thread stack in bytes, including the frames saved by the context switches
+ * Description: Function to read the high-water mark of a thread stack, to compare with the size given to Kernel_CreateThread.
+****************************************************************************************************************************************/
+uint32 Kernel_GetStackHighWater(const Kernel_TcbType *a_Tcb)
+{
+    return Stack_GetHighWater(a_Tcb->StackBase, a_Tcb->StackWords);
+}
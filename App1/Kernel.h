@@ -0,0 +1,104 @@
+/***********************************************************************************************************************************
+ Module      : Kernel
+ Name        : Kernel.h
+ Author      : Salma Hamdy
+ Description : Header file for the preemptive priority-based kernel using PendSV context switching and SysTick time slicing
+ ************************************************************************************************************************************/
+
+#ifndef KERNEL_H_
+#define KERNEL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Priority levels, 0 is the most urgent one (same ordering as the NVIC), the last level is reserved for the idle thread */
+#define KERNEL_PRIORITY_LEVELS               32
+#define KERNEL_IDLE_PRIORITY                 (KERNEL_PRIORITY_LEVELS - 1)
+
+/* Ready bitmap bit of a priority level, priority 0 is the MSB so CLZ of the bitmap returns the most urgent ready priority */
+#define KERNEL_PRIORITY_BIT(PRIORITY)        (0x80000000UL >> (PRIORITY))
+
+/* Number of SysTick ticks a thread runs before yielding to the next ready thread of the same priority */
+#define KERNEL_TIME_SLICE_TICKS              5
+
+#define KERNEL_IDLE_STACK_WORDS              64
+
+/* Words stored by PendSV_Handler on top of the hardware exception frame: R4-R11 and EXC_RETURN */
+#define KERNEL_SW_FRAME_WORDS                9
+/* Words of the basic hardware exception frame: R0-R3, R12, LR, PC and xPSR */
+#define KERNEL_HW_FRAME_WORDS                8
+#define KERNEL_MIN_STACK_WORDS               (KERNEL_SW_FRAME_WORDS + KERNEL_HW_FRAME_WORDS + 16)
+/* Words of a thread stack lost to the MPU stack guard (32-byte guard plus alignment) when Mpu_Init was called */
+#define KERNEL_STACK_GUARD_WORDS             15
+
+#define KERNEL_INITIAL_XPSR                  0x01000000   /* Thumb state bit */
+#define KERNEL_INITIAL_EXC_RETURN            0xFFFFFFFD   /* Return to Thread mode, use PSP, basic frame (no FPU context) */
+
+#define PENDSV_SET_MASK                      0x10000000   /* PENDSV bit in the Interrupt Control and State register */
+#define PENDSV_CLR_MASK                      0x08000000   /* PENDSVCLR bit, removes the pending state of PendSV */
+#define PENDSV_LOWEST_PRIORITY               7
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Kernel_PriorityType;
+
+typedef void (*Kernel_ThreadFuncType)(void);
+
+typedef enum
+{
+    KERNEL_THREAD_DORMANT,
+    KERNEL_THREAD_READY,
+    KERNEL_THREAD_SLEEPING
+}Kernel_ThreadStateType;
+
+/* Thread Control Block, PendSV_Handler accesses StackPtr at offset 0 and StackGuard at offset 4 */
+typedef struct Kernel_Tcb
+{
+    uint32 *StackPtr;                 /* Saved process stack pointer while the thread is switched out */
+    uint32 StackGuard;                /* MPU base register value of the stack guard of the thread, 0 without MPU guards */
+    struct Kernel_Tcb *Next;          /* Link in the ready list of its priority or in the sleep list */
+    uint32 SleepDelta;                /* Ticks to wait after the previous thread of the sleep list wakes up */
+    Kernel_PriorityType Priority;
+    Kernel_ThreadStateType State;
+    uint8 SliceLeft;                  /* Remaining ticks of the current time slice */
+    uint32 *StackBase;                /* Stack given to Kernel_CreateThread, painted for the high-water mark */
+    uint32 StackWords;
+}Kernel_TcbType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Kernel_Init(void);
+
+boolean Kernel_CreateThread(Kernel_TcbType *a_Tcb, Kernel_ThreadFuncType a_ThreadFunc, uint32 *a_Stack,
+                            uint32 a_StackWords, Kernel_PriorityType a_Priority);
+
+void Kernel_Start(void);
+
+void Kernel_Tick(void);
+
+void Kernel_Sleep(uint32 a_Ticks);
+
+void Kernel_Yield(void);
+
+uint32 Kernel_GetTickCount(void);
+
+uint32 Kernel_GetStackHighWater(const Kernel_TcbType *a_Tcb);
+
+/* Context switch routines implemented in Kernel_PendSV.asm */
+void PendSV_Handler(void);
+
+void Kernel_StartFirstThread(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* KERNEL_H_ */
@@ -0,0 +1,93 @@
+;***********************************************************************************************************************************
+; Module      : Kernel
+; Name        : Kernel_PendSV.asm
+; Author      : Salma Hamdy
+; Description : Context switch routines of the preemptive kernel for the ARM Cortex M4F (TI ARM assembler syntax)
+;***********************************************************************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global PendSV_Handler
+        .global Kernel_StartFirstThread
+        .ref    g_Kernel_CurrentTcb
+        .ref    g_Kernel_NextTcb
+
+CurrentTcbAddr  .field  g_Kernel_CurrentTcb, 32
+NextTcbAddr     .field  g_Kernel_NextTcb, 32
+MpuBaseAddr     .field  0xE000ED9C, 32      ; MPU_BASE_REG
+
+;***********************************************************************************************************************************
+; PendSV_Handler
+; Saves the callee-saved context of the running thread on its process stack and restores the context of g_Kernel_NextTcb.
+; The hardware already stacked R0-R3, R12, LR, PC and xPSR (plus S0-S15 and FPSCR lazily if the thread used the FPU).
+; EXC_RETURN bit 4 is clear only for threads with an active FP context, so S16-S31 are saved and restored only for them,
+; integer-only threads keep the minimal frame.
+; A non-zero StackGuard (TCB offset 4) is written to the MPU base register, which moves the thread stack guard region to the
+; bottom of the stack of the next thread.
+;***********************************************************************************************************************************
+PendSV_Handler: .asmfunc
+        CPSID   I
+        MRS     R0, PSP
+        TST     LR, #0x10               ; EXC_RETURN bit 4 = 0 : extended frame, thread uses the FPU
+        IT      EQ
+        VSTMDBEQ R0!, {S16-S31}         ; Also triggers the pending lazy stacking of S0-S15
+        STMDB   R0!, {R4-R11, LR}       ; Callee-saved registers and EXC_RETURN of the thread
+
+        LDR     R1, CurrentTcbAddr
+        LDR     R2, [R1]
+        STR     R0, [R2]                ; g_Kernel_CurrentTcb->StackPtr = PSP
+
+        LDR     R3, NextTcbAddr
+        LDR     R2, [R3]
+        STR     R2, [R1]                ; g_Kernel_CurrentTcb = g_Kernel_NextTcb
+        LDR     R3, [R2, #4]            ; g_Kernel_NextTcb->StackGuard
+        CBZ     R3, SwitchNoGuard
+        LDR     R1, MpuBaseAddr
+        STR     R3, [R1]                ; Guard region to the bottom of the next stack
+        DSB
+SwitchNoGuard:
+        LDR     R0, [R2]                ; PSP = g_Kernel_NextTcb->StackPtr
+
+        LDMIA   R0!, {R4-R11, LR}
+        TST     LR, #0x10
+        IT      EQ
+        VLDMIAEQ R0!, {S16-S31}
+        MSR     PSP, R0
+        CPSIE   I
+        BX      LR                      ; Exception return pops the hardware frame of the next thread
+        .endasmfunc
+
+;***********************************************************************************************************************************
+; Kernel_StartFirstThread
+; Switches Thread mode to the process stack of g_Kernel_NextTcb and jumps to its entry point, the initial frame built by
+; Kernel_CreateThread is consumed without an exception return. Called with the interrupts disabled, it never returns.
+;***********************************************************************************************************************************
+Kernel_StartFirstThread: .asmfunc
+        LDR     R1, NextTcbAddr
+        LDR     R2, [R1]
+        LDR     R1, CurrentTcbAddr
+        STR     R2, [R1]                ; g_Kernel_CurrentTcb = g_Kernel_NextTcb
+
+        LDR     R3, [R2, #4]            ; g_Kernel_NextTcb->StackGuard
+        CBZ     R3, StartNoGuard
+        LDR     R1, MpuBaseAddr
+        STR     R3, [R1]                ; Guard region to the bottom of the first stack
+        DSB
+        ISB
+StartNoGuard:
+        LDR     R0, [R2]                ; Initial stack pointer of the thread
+        ADDS    R0, R0, #36             ; Skip the software frame (R4-R11, EXC_RETURN)
+        LDR     LR, [R0, #20]           ; LR slot of the hardware frame (thread exit routine)
+        LDR     R1, [R0, #24]           ; PC slot of the hardware frame (thread entry point)
+        ADDS    R0, R0, #32             ; Skip the hardware frame
+        MSR     PSP, R0
+        MOVS    R0, #2
+        MSR     CONTROL, R0             ; Thread mode uses PSP (privileged)
+        ISB
+        CPSIE   I
+        BX      R1
+        .endasmfunc
+
+        .end
@@ -0,0 +1,147 @@
+/**************************************************************************************************************************************
+ Module      : Log
+ Name        : Log.c
+ Author      : Salma Hamdy
+ Description : Source file for the binary trace log with deferred formatting, safe to call from any ISR or thread
+ ***************************************************************************************************************************************/
+
+#include "Atomic.h"
+#include "Dwt.h"
+#include "Log.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define LOG_INDEX(POSITION)                  ((POSITION) & (LOG_BUFFER_WORDS - 1))
+
+#if (LOG_BUFFER_WORDS & (LOG_BUFFER_WORDS - 1)) != 0
+#error "LOG_BUFFER_WORDS must be a power of two"
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+Log_Type g_Log;
+
+/***************************************************************************************************************************************
+ * Service Name: Log_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty the log and start the DWT cycle counter used for the timestamps, it must be called before
+ *              the first LOG_EVENT.
+****************************************************************************************************************************************/
+void Log_Init(void)
+{
+    uint32 word;
+
+    Dwt_EnableCycleCounter();
+
+    for (word = 0; word < LOG_BUFFER_WORDS; word++)
+    {
+        g_Log.Buffer[word] = 0;
+    }
+    g_Log.Head    = 0;
+    g_Log.Tail    = 0;
+    g_Log.Dropped = 0;
+    g_Log.Words   = LOG_BUFFER_WORDS;
+    g_Log.Magic   = LOG_MAGIC;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Log_Event
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Id - Format id from Log_Formats.h
+ *                  a_Count - Number of valid arguments (0 to LOG_MAX_ARGS)
+ *                  a_Arg0 .. a_Arg3 - Raw arguments of the format
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function behind the LOG_EVENTx macros. The record space is reserved with a compare and exchange on Head, so ISRs
+ *              preempting each other and the thread never share a record. The record is dropped if the buffer is full.
+****************************************************************************************************************************************/
+void Log_Event(Log_IdType a_Id, uint8 a_Count, uint32 a_Arg0, uint32 a_Arg1, uint32 a_Arg2, uint32 a_Arg3)
+{
+    uint32 words;
+    uint32 head;
+
+    if (a_Count > LOG_MAX_ARGS)
+    {
+        a_Count = LOG_MAX_ARGS;
+    }
+    words = LOG_RECORD_WORDS(a_Count);
+
+    do
+    {
+        head = g_Log.Head;
+        if ((head + words - g_Log.Tail) > LOG_BUFFER_WORDS)
+        {
+            Atomic_FetchAdd(&g_Log.Dropped, 1);
+            return;
+        }
+    } while (!Atomic_CompareExchange(&g_Log.Head, head, head + words));
+
+    g_Log.Buffer[LOG_INDEX(head + 1)] = Dwt_GetCycles();
+    switch (a_Count)
+    {
+    case 4: g_Log.Buffer[LOG_INDEX(head + 5)] = a_Arg3;   /* Fall through */
+    case 3: g_Log.Buffer[LOG_INDEX(head + 4)] = a_Arg2;   /* Fall through */
+    case 2: g_Log.Buffer[LOG_INDEX(head + 3)] = a_Arg1;   /* Fall through */
+    case 1: g_Log.Buffer[LOG_INDEX(head + 2)] = a_Arg0;   /* Fall through */
+    default: break;
+    }
+
+    Data_Memory_Barrier();                 /* The payload is visible before the header completes the record */
+    g_Log.Buffer[LOG_INDEX(head)] = LOG_HEADER(a_Id, a_Count);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Log_Drain
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (single consumer)
+ * Parameters (in): a_MaxWords - Size of the output buffer in words
+ * Parameters (inout): None
+ * Parameters (out): a_Words - Complete records copied out of the log, in the record layout of Log.h
+ * Return value: uint32 - Number of words copied
+ * Description: Function to move the completed records to a transport (UART, RAM dump...) from the main loop. It stops at the
+ *              first record still being written by a preempted producer, the next call picks it up.
+****************************************************************************************************************************************/
+uint32 Log_Drain(uint32 *a_Words, uint32 a_MaxWords)
+{
+    uint32 copied = 0;
+    uint32 tail = g_Log.Tail;
+    uint32 header;
+    uint32 words;
+    uint32 word;
+
+    while (tail != g_Log.Head)
+    {
+        header = g_Log.Buffer[LOG_INDEX(tail)];
+        if ((header & 0xFF) != LOG_RECORD_MARK)
+        {
+            break;                         /* Reserved but not committed yet */
+        }
+        words = LOG_RECORD_WORDS((header >> 8) & 0xF);
+        if ((copied + words) > a_MaxWords)
+        {
+            break;
+        }
+
+        Data_Memory_Barrier();             /* The payload loads cannot be performed before the header load */
+        for (word = 0; word < words; word++)
+        {
+            a_Words[copied++] = g_Log.Buffer[LOG_INDEX(tail + word)];
+            g_Log.Buffer[LOG_INDEX(tail + word)] = 0;
+        }
+        tail += words;
+    }
+
+    Data_Memory_Barrier();                 /* The cleared words are visible before the producers can reuse them */
+    g_Log.Tail = tail;
+
+    return copied;
+}
@@ -0,0 +1,85 @@
+/***********************************************************************************************************************************
+ Module      : Log
+ Name        : Log.h
+ Author      : Salma Hamdy
+ Description : Header file for the binary trace log with deferred formatting, safe to call from any ISR or thread
+ ************************************************************************************************************************************/
+
+#ifndef LOG_H_
+#define LOG_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Ring buffer size in 32-bit words, must be a power of two */
+#define LOG_BUFFER_WORDS                     256
+
+#define LOG_MAX_ARGS                         4
+
+/* Identification of g_Log in a memory dump, "TLOG" in memory order */
+#define LOG_MAGIC                            0x474F4C54UL
+
+/* Record layout: header, DWT timestamp, then the arguments
+ * header = format id (bits 31:16) | argument count (bits 11:8) | LOG_RECORD_MARK (bits 7:0)
+ * The header is written last, a zero header marks a record still being written. */
+#define LOG_RECORD_MARK                      0xA5
+#define LOG_HEADER(ID, COUNT)                (((uint32)(ID) << 16) | ((uint32)(COUNT) << 8) | LOG_RECORD_MARK)
+#define LOG_RECORD_WORDS(COUNT)              (2 + (COUNT))
+
+/* Call site macros, only the format id and the raw arguments are stored, the text never leaves the host */
+#define LOG_EVENT0(ID)                       Log_Event((ID), 0, 0, 0, 0, 0)
+#define LOG_EVENT1(ID, A)                    Log_Event((ID), 1, (uint32)(A), 0, 0, 0)
+#define LOG_EVENT2(ID, A, B)                 Log_Event((ID), 2, (uint32)(A), (uint32)(B), 0, 0)
+#define LOG_EVENT3(ID, A, B, C)              Log_Event((ID), 3, (uint32)(A), (uint32)(B), (uint32)(C), 0)
+#define LOG_EVENT4(ID, A, B, C, D)           Log_Event((ID), 4, (uint32)(A), (uint32)(B), (uint32)(C), (uint32)(D))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Format ids, generated from the table of Log_Formats.h */
+#define LOG_FORMAT(ID, TEXT)                 ID,
+typedef enum
+{
+#include "Log_Formats.h"
+    LOG_FORMATS
+}Log_IdType;
+#undef LOG_FORMAT
+
+/* Head and Tail are free running word counters: Head is reserved by the producers with a compare and exchange,
+ * Tail is advanced by Log_Drain. The whole structure can be dumped by the debugger and decoded on the host. */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Words;                     /* LOG_BUFFER_WORDS */
+    volatile uint32 Head;
+    volatile uint32 Tail;
+    volatile uint32 Dropped;          /* Records lost because the buffer was full */
+    volatile uint32 Buffer[LOG_BUFFER_WORDS];
+}Log_Type;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+extern Log_Type g_Log;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Log_Init(void);
+
+void Log_Event(Log_IdType a_Id, uint8 a_Count, uint32 a_Arg0, uint32 a_Arg1, uint32 a_Arg2, uint32 a_Arg3);
+
+uint32 Log_Drain(uint32 *a_Words, uint32 a_MaxWords);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* LOG_H_ */
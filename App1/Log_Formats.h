@@ -0,0 +1,14 @@
+/***********************************************************************************************************************************
+ Module      : Log
+ Name        : Log_Formats.h
+ Author      : Salma Hamdy
+ Description : Format string table of the binary trace log, decoded on the host by Tools/log_decode.py
+
+ One LOG_FORMAT(identifier, "format") entry per message, the position in the table is the format id stored in the records,
+ so new entries are added at the end. The arguments are raw 32-bit words printed with %u, %d, %x, %X or %c.
+ This file is included several times on purpose and has no include guard.
+ ************************************************************************************************************************************/
+
+LOG_FORMAT(LOG_BOOT,               "boot, log buffer of %u words")
+LOG_FORMAT(LOG_SW2_PRESSED,        "SW2 pressed at tick %u")
+LOG_FORMAT(LOG_CPU_LOAD,           "cpu load isr %u thread %u idle %u per mille")
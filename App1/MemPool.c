@@ -0,0 +1,153 @@
+/**************************************************************************************************************************************
+ Module      : MemPool
+ Name        : MemPool.c
+ Author      : Salma Hamdy
+ Description : Source file for the ISR-safe O(1) fixed-block memory pool allocator
+ ***************************************************************************************************************************************/
+
+#include <stdint.h>
+#include "Atomic.h"
+#include "MemPool.h"
+
+/***************************************************************************************************************************************
+ * Service Name: MemPool_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Storage - Pool storage declared with MEMPOOL_DEFINE_STORAGE
+ *                  a_BlockSize - Block size in bytes, a_BlocksNum - Number of blocks (less than MEMPOOL_MAX_BLOCKS)
+ * Parameters (inout): a_Pool - Pool object
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the pool is initialized, FALSE if the parameters are invalid
+ * Description: Function to link all the blocks of the storage in the free list, must be called before any allocation.
+****************************************************************************************************************************************/
+boolean MemPool_Init(MemPool_Type *a_Pool, uint32 *a_Storage, uint32 a_BlockSize, uint16 a_BlocksNum)
+{
+    uint32 block_words = MEMPOOL_BLOCK_WORDS(a_BlockSize);
+    uint16 block;
+
+    if ((a_Pool == NULL_PTR) || (a_Storage == NULL_PTR) || (a_BlockSize == 0) ||
+        (a_BlocksNum == 0) || (a_BlocksNum >= MEMPOOL_MAX_BLOCKS))
+    {
+        return FALSE;
+    }
+
+    /* The first word of a free block holds the index of the next free block */
+    for (block = 0; block < (a_BlocksNum - 1); block++)
+    {
+        a_Storage[block * block_words] = block + 1;
+    }
+    a_Storage[(a_BlocksNum - 1) * block_words] = MEMPOOL_NIL_INDEX;
+
+    a_Pool->Storage    = a_Storage;
+    a_Pool->BlockWords = block_words;
+    a_Pool->BlocksNum  = a_BlocksNum;
+    a_Pool->FreeHead   = 0;
+    a_Pool->Used       = 0;
+    a_Pool->HighWater  = 0;
+    a_Pool->Failures   = 0;
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: MemPool_Alloc
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (ISRs at any priority and the main loop)
+ * Parameters (in): None
+ * Parameters (inout): a_Pool - Pool object
+ * Parameters (out): None
+ * Return value: void* - Word aligned block, NULL_PTR if the pool is empty
+ * Description: Function to pop a block from the lock-free free list. The head carries a tag incremented on every update,
+ *              so an ISR that pops and pushes the same block while this call is preempted makes its compare-exchange fail.
+****************************************************************************************************************************************/
+void *MemPool_Alloc(MemPool_Type *a_Pool)
+{
+    uint32 head;
+    uint32 index;
+    uint32 next;
+    uint32 used;
+    uint32 high_water;
+
+    do
+    {
+        head  = a_Pool->FreeHead;
+        index = head & MEMPOOL_INDEX_MASK;
+
+        if (index == MEMPOOL_NIL_INDEX)
+        {
+            Atomic_FetchAdd(&a_Pool->Failures, 1);
+            return NULL_PTR;
+        }
+
+        next = a_Pool->Storage[index * a_Pool->BlockWords];   /* May be stale if preempted, then the exchange fails */
+    } while (!Atomic_CompareExchange(&a_Pool->FreeHead, head,
+                                     ((head + MEMPOOL_TAG_INCREMENT) & MEMPOOL_TAG_MASK) | next));
+
+    used = Atomic_FetchAdd(&a_Pool->Used, 1) + 1;
+
+    do
+    {
+        high_water = a_Pool->HighWater;
+    } while ((used > high_water) && !Atomic_CompareExchange(&a_Pool->HighWater, high_water, used));
+
+    return &a_Pool->Storage[index * a_Pool->BlockWords];
+}
+
+/***************************************************************************************************************************************
+ * Service Name: MemPool_Free
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (ISRs at any priority and the main loop)
+ * Parameters (in): a_Block - Block returned by MemPool_Alloc of the same pool
+ * Parameters (inout): a_Pool - Pool object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to push a block back on the lock-free free list. A pointer outside the storage or not at the start
+ *              of a block is ignored, linking it would corrupt the free list.
+****************************************************************************************************************************************/
+void MemPool_Free(MemPool_Type *a_Pool, void *a_Block)
+{
+    uint32 *block = (uint32 *)a_Block;
+    uintptr_t offset = (uintptr_t)a_Block - (uintptr_t)a_Pool->Storage;    /* Wraps above the storage size when below it */
+    uint32 block_size = a_Pool->BlockWords * 4;
+    uint32 index;
+    uint32 head;
+
+    if ((offset >= ((uintptr_t)a_Pool->BlocksNum * block_size)) || ((offset % block_size) != 0))
+    {
+        return;                                               /* Not a block of this pool */
+    }
+
+    index = (uint32)(offset / block_size);
+
+    /* Counted out before it is linked, so a preempting allocation of the same block cannot push Used above the blocks number */
+    Atomic_FetchAdd(&a_Pool->Used, (uint32)-1);
+
+    do
+    {
+        head = a_Pool->FreeHead;
+        *block = head & MEMPOOL_INDEX_MASK;
+    } while (!Atomic_CompareExchange(&a_Pool->FreeHead, head,
+                                     ((head + MEMPOOL_TAG_INCREMENT) & MEMPOOL_TAG_MASK) | index));
+}
+
+/***************************************************************************************************************************************
+ * Service Name: MemPool_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Pool - Pool object
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Pool geometry, current usage, high-water mark and allocation failures
+ * Return value: None
+ * Description: Function to read the pool statistics.
+****************************************************************************************************************************************/
+void MemPool_GetStats(MemPool_Type *a_Pool, MemPool_StatsType *a_Stats)
+{
+    if ((a_Pool != NULL_PTR) && (a_Stats != NULL_PTR))
+    {
+        a_Stats->BlockSize = a_Pool->BlockWords * 4;
+        a_Stats->BlocksNum = a_Pool->BlocksNum;
+        a_Stats->Used      = a_Pool->Used;
+        a_Stats->HighWater = a_Pool->HighWater;
+        a_Stats->Failures  = a_Pool->Failures;
+    }
+}
@@ -0,0 +1,73 @@
+/***********************************************************************************************************************************
+ Module      : MemPool
+ Name        : MemPool.h
+ Author      : Salma Hamdy
+ Description : Header file for the ISR-safe O(1) fixed-block memory pool allocator
+ ************************************************************************************************************************************/
+
+#ifndef MEMPOOL_H_
+#define MEMPOOL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Free list head word: ABA tag in the upper half-word and the index of the first free block in the lower half-word */
+#define MEMPOOL_NIL_INDEX                    0xFFFF
+#define MEMPOOL_INDEX_MASK                   0x0000FFFF
+#define MEMPOOL_TAG_MASK                     0xFFFF0000
+#define MEMPOOL_TAG_INCREMENT                0x00010000
+
+#define MEMPOOL_MAX_BLOCKS                   MEMPOOL_NIL_INDEX
+
+/* Blocks are rounded up to whole words so every block is word aligned and can hold the free list link */
+#define MEMPOOL_BLOCK_WORDS(BLOCK_SIZE)      (((BLOCK_SIZE) + 3) / 4)
+
+/* Compile-time storage of a pool, e.g. MEMPOOL_DEFINE_STORAGE(g_TimerPoolStorage, sizeof(Timer_Type), 16); */
+#define MEMPOOL_DEFINE_STORAGE(NAME, BLOCK_SIZE, BLOCKS_NUM)    \
+    static uint32 NAME[MEMPOOL_BLOCK_WORDS(BLOCK_SIZE) * (BLOCKS_NUM)]
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 *Storage;
+    uint32 BlockWords;
+    uint16 BlocksNum;
+    volatile uint32 FreeHead;        /* Tagged index of the first free block */
+    volatile uint32 Used;            /* Blocks currently allocated */
+    volatile uint32 HighWater;       /* Maximum of Used since initialization */
+    volatile uint32 Failures;        /* Allocations rejected because the pool was empty */
+}MemPool_Type;
+
+typedef struct
+{
+    uint32 BlockSize;
+    uint32 BlocksNum;
+    uint32 Used;
+    uint32 HighWater;
+    uint32 Failures;
+}MemPool_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean MemPool_Init(MemPool_Type *a_Pool, uint32 *a_Storage, uint32 a_BlockSize, uint16 a_BlocksNum);
+
+void *MemPool_Alloc(MemPool_Type *a_Pool);
+
+void MemPool_Free(MemPool_Type *a_Pool, void *a_Block);
+
+void MemPool_GetStats(MemPool_Type *a_Pool, MemPool_StatsType *a_Stats);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* MEMPOOL_H_ */
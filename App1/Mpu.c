@@ -0,0 +1,264 @@
+/**************************************************************************************************************************************
+ Module      : Mpu
+ Name        : Mpu.c
+ Author      : Salma Hamdy
+ Description : Source file for the ARM Cortex M4 MPU driver with region configuration and hardware stack overflow guards
+
+ The MPU runs with the default memory map as background region (PRIVDEFENA), so only the configured regions restrict accesses.
+ Mpu_Init places a no-access guard at the bottom of the main stack, and the kernel moves a second guard to the bottom of the
+ stack of each thread it switches to (one store in PendSV_Handler). A stack overflow then raises a MemManage fault on the first
+ access to the guard instead of silently corrupting the memory below the stack, with no run time check.
+ ***************************************************************************************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Mpu.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#ifdef TM4C_SIM
+#define Mpu_SyncBarriers()
+#else
+#define Mpu_SyncBarriers()                   __asm(" DSB \n ISB ")
+#endif
+
+/* Guard region attributes: no access, execute never, smallest size */
+#define MPU_STACK_GUARD_ATTR                 (MPU_ATTR_XN_MASK | ((uint32)MPU_ACCESS_NONE << MPU_ATTR_AP_BITS_POS) | \
+                                              ((uint32)MPU_MEMORY_SRAM << MPU_ATTR_TEX_S_C_B_BITS_POS) | \
+                                              (Mpu_SizeField(MPU_STACK_GUARD_SIZE) << MPU_ATTR_SIZE_BITS_POS) | \
+                                              MPU_ATTR_ENABLE_MASK)
+
+/* SIZE field of the attribute register: region size is 2^(SIZE + 1) bytes */
+#define Mpu_SizeField(SIZE_BYTES)            ((uint32)(31 - _norm(SIZE_BYTES)) - 1)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Lowest address of the main stack (.stack section), set by the linker */
+#ifdef TM4C_SIM
+static uint32 __stack;                          /* Host build: stand-in for the linker symbol */
+#else
+extern uint32 __stack;
+#endif
+
+/* Set once the thread stack guard region is configured, Mpu_GetStackGuard returns 0 before */
+static boolean g_Mpu_ThreadGuards = FALSE;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Lowest guard-aligned address inside a stack, the guard takes at most MPU_STACK_GUARD_SIZE + 28 bytes of it. Addresses are
+ * uintptr_t so the host build computes on its full pointers, they fit 32 bits on target. */
+static uintptr_t Mpu_GuardBase(uintptr_t a_StackBottom)
+{
+    return (a_StackBottom + (MPU_STACK_GUARD_SIZE - 1)) & ~(uintptr_t)(MPU_STACK_GUARD_SIZE - 1);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_CheckRegion
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_BaseAddress - Region start address, a_SizeBytes - Region size in bytes
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the MPU can map the region, FALSE otherwise
+ * Description: Function to check the MPU rules: the size is a power of two of at least 32 bytes and the base address is
+ *              aligned on the size.
+****************************************************************************************************************************************/
+boolean Mpu_CheckRegion(uint32 a_BaseAddress, uint32 a_SizeBytes)
+{
+    if ((a_SizeBytes < MPU_MIN_REGION_SIZE) || ((a_SizeBytes & (a_SizeBytes - 1)) != 0))
+    {
+        return FALSE;
+    }
+    if ((a_BaseAddress & (a_SizeBytes - 1)) != 0)
+    {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_ConfigureRegion
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Region - Region number (0..MPU_REGIONS-1), a_Config - Region settings
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the region is programmed and enabled, FALSE if the settings are invalid
+ * Description: Function to program and enable one region. The region is selected through the VALID bit of the base register
+ *              and the two writes are done with the interrupts disabled, so a context switch moving the thread stack guard
+ *              cannot select another region in between.
+****************************************************************************************************************************************/
+boolean Mpu_ConfigureRegion(uint8 a_Region, const Mpu_RegionConfigType *a_Config)
+{
+    uint32 attr;
+
+    if ((a_Region >= MPU_REGIONS) || (a_Config == NULL_PTR) ||
+        !Mpu_CheckRegion(a_Config->BaseAddress, a_Config->SizeBytes))
+    {
+        return FALSE;
+    }
+    if ((a_Config->SubregionDisable != 0) && (a_Config->SizeBytes < 256))
+    {
+        return FALSE;                              /* Regions below 256 bytes have no subregions */
+    }
+
+    attr = ((uint32)a_Config->Access << MPU_ATTR_AP_BITS_POS) |
+           ((uint32)a_Config->Memory << MPU_ATTR_TEX_S_C_B_BITS_POS) |
+           ((uint32)a_Config->SubregionDisable << MPU_ATTR_SRD_BITS_POS) |
+           (Mpu_SizeField(a_Config->SizeBytes) << MPU_ATTR_SIZE_BITS_POS) |
+           MPU_ATTR_ENABLE_MASK;
+    if (a_Config->ExecuteNever)
+    {
+        attr |= MPU_ATTR_XN_MASK;
+    }
+
+    Disable_Exceptions();
+    HW_WRITE32(MPU_BASE_REG, (a_Config->BaseAddress & MPU_BASE_ADDR_MASK) | MPU_BASE_VALID_MASK | a_Region);
+    HW_WRITE32(MPU_ATTR_REG, attr);
+    Mpu_SyncBarriers();
+    Enable_Exceptions();
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_DisableRegion
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Region - Region number (0..MPU_REGIONS-1)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable one region, the addresses it covered fall back to the other regions or the default map.
+****************************************************************************************************************************************/
+void Mpu_DisableRegion(uint8 a_Region)
+{
+    if (a_Region >= MPU_REGIONS)
+    {
+        return;
+    }
+
+    Disable_Exceptions();
+    HW_WRITE32(MPU_NUMBER_REG, a_Region);
+    HW_WRITE32(MPU_ATTR_REG, 0);
+    Mpu_SyncBarriers();
+    Enable_Exceptions();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_Enable
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable the MPU with the default memory map as background region and the MemManage fault handler.
+ *              The MPU stays off in the HardFault and NMI handlers so they can still run after a stack overflow.
+****************************************************************************************************************************************/
+void Mpu_Enable(void)
+{
+    NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE);
+    HW_WRITE32(MPU_CTRL_REG, MPU_CTRL_PRIVDEFENA_MASK | MPU_CTRL_ENABLE_MASK);
+    Mpu_SyncBarriers();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_Disable
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable the MPU, the regions keep their settings.
+****************************************************************************************************************************************/
+void Mpu_Disable(void)
+{
+    Mpu_SyncBarriers();
+    HW_WRITE32(MPU_CTRL_REG, 0);
+    Mpu_SyncBarriers();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear all the regions, install the main stack guard and the thread stack guard region and enable
+ *              the MPU. It must be called before any thread is created so the threads get their guard.
+****************************************************************************************************************************************/
+void Mpu_Init(void)
+{
+    uint32 main_guard = (uint32)Mpu_GuardBase((uintptr_t)&__stack);
+    uint8 region;
+
+    Mpu_Disable();
+    for (region = 0; region < MPU_REGIONS; region++)
+    {
+        HW_WRITE32(MPU_NUMBER_REG, region);
+        HW_WRITE32(MPU_ATTR_REG, 0);
+    }
+
+    HW_WRITE32(MPU_BASE_REG, main_guard | MPU_BASE_VALID_MASK | MPU_MAIN_STACK_GUARD_REGION);
+    HW_WRITE32(MPU_ATTR_REG, MPU_STACK_GUARD_ATTR);
+
+    /* Same guard until the first context switch moves it to the running thread */
+    HW_WRITE32(MPU_BASE_REG, main_guard | MPU_BASE_VALID_MASK | MPU_THREAD_STACK_GUARD_REGION);
+    HW_WRITE32(MPU_ATTR_REG, MPU_STACK_GUARD_ATTR);
+    g_Mpu_ThreadGuards = TRUE;
+
+    Mpu_Enable();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_GetStackGuard
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Stack - Lowest address of a thread stack
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Base register value that moves the thread stack guard to this stack, 0 if Mpu_Init was not called
+ * Description: Function used by the kernel to precompute the guard of a thread, the guard covers the first 32-byte aligned
+ *              block of the stack so up to 60 bytes of it are not usable.
+****************************************************************************************************************************************/
+uint32 Mpu_GetStackGuard(const uint32 *a_Stack)
+{
+    if (!g_Mpu_ThreadGuards)
+    {
+        return 0;
+    }
+    return (uint32)Mpu_GuardBase((uintptr_t)a_Stack) | MPU_BASE_VALID_MASK | MPU_THREAD_STACK_GUARD_REGION;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Mpu_GetUsableStack
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Stack - Lowest address of a stack
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32* - Lowest address of the stack that can be accessed, above its guard once Mpu_Init was called
+ * Description: Function used by the stack monitoring to paint and scan a stack without touching its guard.
+****************************************************************************************************************************************/
+uint32 *Mpu_GetUsableStack(uint32 *a_Stack)
+{
+    if (!g_Mpu_ThreadGuards)
+    {
+        return a_Stack;
+    }
+    return a_Stack + ((Mpu_GuardBase((uintptr_t)a_Stack) + MPU_STACK_GUARD_SIZE - (uintptr_t)a_Stack) / sizeof(uint32));
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
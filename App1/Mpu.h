@@ -0,0 +1,100 @@
+/***********************************************************************************************************************************
+ Module      : Mpu
+ Name        : Mpu.h
+ Author      : Salma Hamdy
+ Description : Header file for the ARM Cortex M4 MPU driver with region configuration and hardware stack overflow guards
+ ************************************************************************************************************************************/
+
+#ifndef MPU_H_
+#define MPU_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define MPU_REGIONS                          8
+#define MPU_MIN_REGION_SIZE                  32
+
+/* Regions 0..5 are free for the application, the higher region number wins where regions overlap */
+#define MPU_THREAD_STACK_GUARD_REGION        6
+#define MPU_MAIN_STACK_GUARD_REGION          7
+
+/* A guard is the smallest region, any access to it raises a MemManage fault */
+#define MPU_STACK_GUARD_SIZE                 MPU_MIN_REGION_SIZE
+
+/* MPU Control register */
+#define MPU_CTRL_ENABLE_MASK                 0x00000001
+#define MPU_CTRL_HFNMIENA_MASK               0x00000002
+#define MPU_CTRL_PRIVDEFENA_MASK             0x00000004
+
+/* MPU Region Base Address register */
+#define MPU_BASE_ADDR_MASK                   0xFFFFFFE0
+#define MPU_BASE_VALID_MASK                  0x00000010
+#define MPU_BASE_REGION_MASK                 0x0000000F
+
+/* MPU Region Attribute and Size register */
+#define MPU_ATTR_XN_MASK                     0x10000000
+#define MPU_ATTR_AP_BITS_POS                 24
+#define MPU_ATTR_TEX_S_C_B_BITS_POS          16
+#define MPU_ATTR_SRD_BITS_POS                8
+#define MPU_ATTR_SIZE_BITS_POS               1
+#define MPU_ATTR_ENABLE_MASK                 0x00000001
+
+/* Memory attributes (TEX, S, C, B) of the TM4C123GH6PM memories */
+#define MPU_MEMORY_FLASH                     0x02         /* Normal, not shareable, write-through */
+#define MPU_MEMORY_SRAM                      0x06         /* Normal, shareable, write-through */
+#define MPU_MEMORY_PERIPHERAL                0x05         /* Device, shareable */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Access permissions (AP field) for privileged / unprivileged code */
+typedef enum
+{
+    MPU_ACCESS_NONE      = 0,     /* No access */
+    MPU_ACCESS_PRIV_RW   = 1,     /* Privileged read / write, unprivileged no access */
+    MPU_ACCESS_PRIV_RW_USER_RO = 2,
+    MPU_ACCESS_FULL      = 3,     /* Read / write for both */
+    MPU_ACCESS_PRIV_RO   = 5,
+    MPU_ACCESS_READ_ONLY = 6      /* Read only for both */
+}Mpu_AccessType;
+
+typedef struct
+{
+    uint32 BaseAddress;           /* Aligned on SizeBytes */
+    uint32 SizeBytes;             /* Power of two, at least MPU_MIN_REGION_SIZE */
+    Mpu_AccessType Access;
+    uint8 Memory;                 /* MPU_MEMORY_xxx */
+    uint8 SubregionDisable;       /* One bit per eighth of the region, regions of 256 bytes and more only */
+    boolean ExecuteNever;
+}Mpu_RegionConfigType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean Mpu_CheckRegion(uint32 a_BaseAddress, uint32 a_SizeBytes);
+
+boolean Mpu_ConfigureRegion(uint8 a_Region, const Mpu_RegionConfigType *a_Config);
+
+void Mpu_DisableRegion(uint8 a_Region);
+
+void Mpu_Enable(void);
+
+void Mpu_Disable(void);
+
+void Mpu_Init(void);
+
+uint32 Mpu_GetStackGuard(const uint32 *a_Stack);
+
+uint32 *Mpu_GetUsableStack(uint32 *a_Stack);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* MPU_H_ */
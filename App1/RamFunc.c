@@ -0,0 +1,130 @@
+/**************************************************************************************************************************************
+ Module      : RamFunc
+ Name        : RamFunc.c
+ Author      : Salma Hamdy
+ Description : Source file for the copy of the hot functions from flash to SRAM at reset and the report of the relocation
+
+ Tools/ramfunc_gen.py turns RamFunc_List.txt into the linker fragment RamFunc.cmd: each listed function is loaded in flash, linked
+ to run from SRAM and described by a record of g_RamFunc_CopyTable. Every reference to it, the vector table entries and the call
+ sites included, is resolved by the linker to the SRAM address, so the handlers run without flash wait states or prefetch misses
+ once the core is clocked above 40 MHz. ResetISR calls RamFunc_CopyIn before _c_int00, nothing can run the functions before.
+ Without the fragment in the link the weak table reference is 0, nothing is copied and the report shows the functions in flash.
+ ***************************************************************************************************************************************/
+
+#include <stdint.h>
+#include "RamFunc.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Created by the linker from RamFunc.cmd */
+#ifdef TM4C_SIM
+static const RamFunc_CopyTableType g_RamFunc_SimCopyTable = { sizeof(RamFunc_CopyRecordType), 0, { { 0, 0, 0 } } };
+#define RAMFUNC_COPY_TABLE                   (&g_RamFunc_SimCopyTable)   /* Host build: nothing is relocated */
+#else
+#pragma WEAK(g_RamFunc_CopyTable)
+extern const RamFunc_CopyTableType g_RamFunc_CopyTable;
+#define RAMFUNC_COPY_TABLE                   (&g_RamFunc_CopyTable)
+#endif
+
+/***************************************************************************************************************************************
+ * Service Name: RamFunc_CopyIn
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to copy every record of the copy table from its load address to its run address. It runs before the
+ *              C initialization, so it only uses local variables and the constant copy table.
+****************************************************************************************************************************************/
+void RamFunc_CopyIn(void)
+{
+    const RamFunc_CopyTableType *table = RAMFUNC_COPY_TABLE;
+    const RamFunc_CopyRecordType *record;
+    const uint8 *source;
+    uint8 *destination;
+    uint32 index;
+    uint32 size;
+
+    if (table == NULL_PTR)
+    {
+        return;
+    }
+
+    for (index = 0; index < table->RecordCount; index++)
+    {
+        record      = &table->Records[index];
+        source      = (const uint8 *)(uintptr_t)record->LoadAddress;
+        destination = (uint8 *)(uintptr_t)record->RunAddress;
+        for (size = record->SizeBytes; size != 0; size--)
+        {
+            *destination++ = *source++;
+        }
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RamFunc_GetCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint8 - Number of functions listed for SRAM placement
+ * Description: Function to read the size of the relocation report.
+****************************************************************************************************************************************/
+uint8 RamFunc_GetCount(void)
+{
+    return RAMFUNC_COUNT;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RamFunc_GetInfo
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Index - Index in RamFunc_List.txt order
+ * Parameters (inout): None
+ * Parameters (out): a_Info - Name, run and load addresses and size of the function
+ * Return value: boolean - TRUE if the index is valid, FALSE otherwise
+ * Description: Function to report the relocation of one function. The run address is the one the linker gave the function,
+ *              the load address and the size come from the copy record covering it. A function is relocated when such a
+ *              record exists and the run address is in SRAM.
+****************************************************************************************************************************************/
+boolean RamFunc_GetInfo(uint8 a_Index, RamFunc_InfoType *a_Info)
+{
+    const RamFunc_CopyTableType *table = RAMFUNC_COPY_TABLE;
+    const RamFunc_CopyRecordType *record;
+    uint32 address;
+    uint32 index;
+
+    if (a_Index >= RAMFUNC_COUNT)
+    {
+        return FALSE;
+    }
+
+    address = (uint32)(uintptr_t)g_RamFunc_Entries[a_Index].Address & ~(uint32)RAMFUNC_THUMB_BIT_MASK;
+    a_Info->Name        = g_RamFunc_Entries[a_Index].Name;
+    a_Info->RunAddress  = address;
+    a_Info->LoadAddress = 0;
+    a_Info->SizeBytes   = 0;
+    a_Info->Relocated   = FALSE;
+
+    for (index = 0; (table != NULL_PTR) && (index < table->RecordCount); index++)
+    {
+        record = &table->Records[index];
+        if ((address >= record->RunAddress) && (address < (record->RunAddress + record->SizeBytes)))
+        {
+            a_Info->LoadAddress = record->LoadAddress + (address - record->RunAddress);
+            a_Info->SizeBytes   = record->SizeBytes;
+            a_Info->Relocated   = ((address >= RAMFUNC_SRAM_START) && (address < RAMFUNC_SRAM_END)) ? TRUE : FALSE;
+            break;
+        }
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
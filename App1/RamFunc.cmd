@@ -0,0 +1,19 @@
+/* Generated by Tools/ramfunc_gen.py from RamFunc_List.txt, do not edit
+ *
+ * Add this file to the linker command files of the project and compile with --gen_func_subsections=on.
+ * Every function is loaded in FLASH and runs from SRAM, RamFunc_CopyIn (called by ResetISR before _c_int00)
+ * copies it using the records of g_RamFunc_CopyTable. */
+
+SECTIONS
+{
+    .ramfunc:SysTick_Handler   : { *(.text:SysTick_Handler) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+    .ramfunc:SysTick_TickTask  : { *(.text:SysTick_TickTask) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+    .ramfunc:Sched_Tick        : { *(.text:Sched_Tick) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+    .ramfunc:CpuLoad_Tick      : { *(.text:CpuLoad_Tick) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+    .ramfunc:CpuLoad_IsrEnter  : { *(.text:CpuLoad_IsrEnter) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+    .ramfunc:CpuLoad_IsrExit   : { *(.text:CpuLoad_IsrExit) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+    .ramfunc:GPIOPortF_Handler : { *(.text:GPIOPortF_Handler) } load = FLASH, run = SRAM, table(g_RamFunc_CopyTable, compression = off)
+
+    /* Copy tables */
+    .ovly : > FLASH
+}
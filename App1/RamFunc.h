@@ -0,0 +1,83 @@
+/***********************************************************************************************************************************
+ Module      : RamFunc
+ Name        : RamFunc.h
+ Author      : Salma Hamdy
+ Description : Header file for the copy of the hot functions from flash to SRAM at reset and the report of the relocation
+ ************************************************************************************************************************************/
+
+#ifndef RAMFUNC_H_
+#define RAMFUNC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "RamFunc_Cfg.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* On-chip SRAM of the TM4C123GH6PM, a relocated function runs inside it */
+#define RAMFUNC_SRAM_START                   0x20000000
+#define RAMFUNC_SRAM_END                     0x20008000
+
+/* Bit 0 of a function address selects the Thumb state, it is not part of the code address */
+#define RAMFUNC_THUMB_BIT_MASK               0x00000001
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*RamFunc_AddressType)(void);
+
+/* Entry of the generated table in RamFunc_Cfg.c */
+typedef struct
+{
+    const char *Name;
+    RamFunc_AddressType Address;      /* Run address resolved by the linker */
+}RamFunc_EntryType;
+
+/* Copy table built by the TI linker for table(g_RamFunc_CopyTable, compression = off), same layout as COPY_TABLE */
+typedef struct
+{
+    uint32 LoadAddress;
+    uint32 RunAddress;
+    uint32 SizeBytes;
+}RamFunc_CopyRecordType;
+
+typedef struct
+{
+    uint16 RecordSize;
+    uint16 RecordCount;
+    RamFunc_CopyRecordType Records[1];
+}RamFunc_CopyTableType;
+
+/* Relocation report of one function */
+typedef struct
+{
+    const char *Name;
+    uint32 RunAddress;
+    uint32 LoadAddress;               /* 0 if no copy record covers the function */
+    uint32 SizeBytes;                 /* Size of the copied section of the function */
+    boolean Relocated;                /* Runs from SRAM */
+}RamFunc_InfoType;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+extern const RamFunc_EntryType g_RamFunc_Entries[RAMFUNC_COUNT];
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void RamFunc_CopyIn(void);
+
+uint8 RamFunc_GetCount(void);
+
+boolean RamFunc_GetInfo(uint8 a_Index, RamFunc_InfoType *a_Info);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* RAMFUNC_H_ */
@@ -0,0 +1,28 @@
+/**************************************************************************************************************************************
+ Module      : RamFunc
+ Name        : RamFunc_Cfg.c
+ Author      : Generated by Tools/ramfunc_gen.py from RamFunc_List.txt, do not edit
+ Description : Names and addresses of the functions placed in SRAM by RamFunc.cmd
+ ***************************************************************************************************************************************/
+
+#include "RamFunc.h"
+
+/* Only the addresses are used, the real prototypes do not matter here */
+extern void SysTick_Handler(void);
+extern void SysTick_TickTask(void);
+extern void Sched_Tick(void);
+extern void CpuLoad_Tick(void);
+extern void CpuLoad_IsrEnter(void);
+extern void CpuLoad_IsrExit(void);
+extern void GPIOPortF_Handler(void);
+
+const RamFunc_EntryType g_RamFunc_Entries[RAMFUNC_COUNT] =
+{
+    { "SysTick_Handler", (RamFunc_AddressType)SysTick_Handler },
+    { "SysTick_TickTask", (RamFunc_AddressType)SysTick_TickTask },
+    { "Sched_Tick", (RamFunc_AddressType)Sched_Tick },
+    { "CpuLoad_Tick", (RamFunc_AddressType)CpuLoad_Tick },
+    { "CpuLoad_IsrEnter", (RamFunc_AddressType)CpuLoad_IsrEnter },
+    { "CpuLoad_IsrExit", (RamFunc_AddressType)CpuLoad_IsrExit },
+    { "GPIOPortF_Handler", (RamFunc_AddressType)GPIOPortF_Handler },
+};
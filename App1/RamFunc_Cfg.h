@@ -0,0 +1,13 @@
+/***********************************************************************************************************************************
+ Module      : RamFunc
+ Name        : RamFunc_Cfg.h
+ Author      : Generated by Tools/ramfunc_gen.py from RamFunc_List.txt, do not edit
+ Description : Functions placed in SRAM by RamFunc.cmd
+ ************************************************************************************************************************************/
+
+#ifndef RAMFUNC_CFG_H_
+#define RAMFUNC_CFG_H_
+
+#define RAMFUNC_COUNT                        7
+
+#endif /* RAMFUNC_CFG_H_ */
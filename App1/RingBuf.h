@@ -0,0 +1,197 @@
+/***********************************************************************************************************************************
+ Module      : RingBuf
+ Name        : RingBuf.h
+ Author      : Salma Hamdy
+ Description : Header-only lock-free single-producer single-consumer ring buffer for ISR to main loop data handoff
+ ************************************************************************************************************************************/
+
+#ifndef RINGBUF_H_
+#define RINGBUF_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "Atomic.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Head and Tail are free running byte counters, each one is written by one side only:
+ * Head by the producer (e.g. an ISR) and Tail by the consumer (e.g. the main loop), so no interrupt masking is needed. */
+typedef struct
+{
+    uint8 *Buffer;
+    uint32 Mask;              /* Size - 1, the size is a power of two */
+    volatile uint32 Head;     /* Total bytes committed by the producer */
+    volatile uint32 Tail;     /* Total bytes released by the consumer */
+}RingBuf_Type;
+
+/*******************************************************************************
+ *                         Inline Functions Definitions                        *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Init
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Buffer - Storage of the ring, a_Size - Storage size in bytes, must be a power of two
+ * Parameters (inout): a_Ring - Ring buffer object
+ * Return value: boolean - TRUE if the ring is initialized, FALSE if the size is not a power of two
+ * Description: Function to attach the storage to an empty ring buffer, must be called before the producer and consumer start.
+****************************************************************************************************************************************/
+static inline boolean RingBuf_Init(RingBuf_Type *a_Ring, uint8 *a_Buffer, uint32 a_Size)
+{
+    if ((a_Size == 0) || ((a_Size & (a_Size - 1)) != 0))
+    {
+        return FALSE;
+    }
+
+    a_Ring->Buffer = a_Buffer;
+    a_Ring->Mask   = a_Size - 1;
+    a_Ring->Head   = 0;
+    a_Ring->Tail   = 0;
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Reserve
+ * Reentrancy: Non-reentrant (producer side only)
+ * Parameters (inout): a_Ring - Ring buffer object
+ *                     a_Length - in: requested bytes, out: contiguous free bytes granted (may be less, zero if the ring is full)
+ * Return value: uint8* - Write pointer into the ring storage
+ * Description: Function to reserve free space for zero-copy writing, the data becomes visible to the consumer on RingBuf_Commit.
+****************************************************************************************************************************************/
+static inline uint8 *RingBuf_Reserve(RingBuf_Type *a_Ring, uint32 *a_Length)
+{
+    uint32 head   = a_Ring->Head;
+    uint32 offset = head & a_Ring->Mask;
+    uint32 free   = (a_Ring->Mask + 1) - (head - a_Ring->Tail);
+    uint32 contiguous = (a_Ring->Mask + 1) - offset;
+
+    if (free > contiguous)
+    {
+        free = contiguous;             /* Stop at the end of the storage, the rest is granted by the next reserve */
+    }
+    if (*a_Length > free)
+    {
+        *a_Length = free;
+    }
+
+    return &a_Ring->Buffer[offset];
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Commit
+ * Reentrancy: Non-reentrant (producer side only)
+ * Parameters (in): a_Length - Bytes written in the reserved region, at most the length granted by RingBuf_Reserve
+ * Parameters (inout): a_Ring - Ring buffer object
+ * Return value: None
+ * Description: Function to publish the written bytes to the consumer.
+****************************************************************************************************************************************/
+static inline void RingBuf_Commit(RingBuf_Type *a_Ring, uint32 a_Length)
+{
+    Data_Memory_Barrier();             /* The data stores complete before the consumer can see the new Head */
+    a_Ring->Head += a_Length;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Peek
+ * Reentrancy: Non-reentrant (consumer side only)
+ * Parameters (inout): a_Ring - Ring buffer object
+ * Parameters (out): a_Length - Contiguous readable bytes (zero if the ring is empty)
+ * Return value: uint8* - Read pointer into the ring storage
+ * Description: Function to access the committed data in place, the space is given back to the producer on RingBuf_Release.
+****************************************************************************************************************************************/
+static inline uint8 *RingBuf_Peek(RingBuf_Type *a_Ring, uint32 *a_Length)
+{
+    uint32 tail   = a_Ring->Tail;
+    uint32 offset = tail & a_Ring->Mask;
+    uint32 used   = a_Ring->Head - tail;
+    uint32 contiguous = (a_Ring->Mask + 1) - offset;
+
+    Data_Memory_Barrier();             /* The data loads cannot be performed before the Head load */
+
+    *a_Length = (used > contiguous) ? contiguous : used;
+
+    return &a_Ring->Buffer[offset];
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Release
+ * Reentrancy: Non-reentrant (consumer side only)
+ * Parameters (in): a_Length - Bytes consumed, at most the length returned by RingBuf_Peek
+ * Parameters (inout): a_Ring - Ring buffer object
+ * Return value: None
+ * Description: Function to give the consumed bytes back to the producer.
+****************************************************************************************************************************************/
+static inline void RingBuf_Release(RingBuf_Type *a_Ring, uint32 a_Length)
+{
+    Data_Memory_Barrier();             /* The data loads complete before the producer can overwrite the space */
+    a_Ring->Tail += a_Length;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Write
+ * Reentrancy: Non-reentrant (producer side only)
+ * Parameters (in): a_Data - Bytes to copy, a_Length - Number of bytes
+ * Parameters (inout): a_Ring - Ring buffer object
+ * Return value: boolean - TRUE if all the bytes are queued, FALSE (nothing queued) if there is not enough free space
+ * Description: Function to copy a whole record into the ring, it is split over the end of the storage if needed.
+****************************************************************************************************************************************/
+static inline boolean RingBuf_Write(RingBuf_Type *a_Ring, const uint8 *a_Data, uint32 a_Length)
+{
+    uint32 head = a_Ring->Head;
+    uint32 i;
+
+    if (a_Length > ((a_Ring->Mask + 1) - (head - a_Ring->Tail)))
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < a_Length; i++)
+    {
+        a_Ring->Buffer[(head + i) & a_Ring->Mask] = a_Data[i];
+    }
+
+    RingBuf_Commit(a_Ring, a_Length);
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RingBuf_Read
+ * Reentrancy: Non-reentrant (consumer side only)
+ * Parameters (in): a_Length - Maximum number of bytes to copy
+ * Parameters (inout): a_Ring - Ring buffer object
+ * Parameters (out): a_Data - Destination of the copied bytes
+ * Return value: uint32 - Number of bytes copied
+ * Description: Function to copy the queued bytes out of the ring and release them.
+****************************************************************************************************************************************/
+static inline uint32 RingBuf_Read(RingBuf_Type *a_Ring, uint8 *a_Data, uint32 a_Length)
+{
+    uint32 tail = a_Ring->Tail;
+    uint32 used = a_Ring->Head - tail;
+    uint32 i;
+
+    Data_Memory_Barrier();             /* The data loads cannot be performed before the Head load */
+
+    if (a_Length > used)
+    {
+        a_Length = used;
+    }
+
+    for (i = 0; i < a_Length; i++)
+    {
+        a_Data[i] = a_Ring->Buffer[(tail + i) & a_Ring->Mask];
+    }
+
+    RingBuf_Release(a_Ring, a_Length);
+    return a_Length;
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* RINGBUF_H_ */
@@ -0,0 +1,210 @@
+/**************************************************************************************************************************************
+ Module      : Sched
+ Name        : Sched.c
+ Author      : Salma Hamdy
+ Description : Source file for the cooperative run-to-completion task scheduler driven by the SysTick tick
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Idle.h"
+#include "Dwt.h"
+#include "Sched.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Task function of each priority level */
+static Sched_TaskFuncType g_Sched_TaskFunc[SCHED_MAX_TASKS];
+
+/* Release period of each task in SysTick ticks */
+static uint16 g_Sched_Period[SCHED_MAX_TASKS];
+
+/* Remaining ticks until the next release of each task (updated by the SysTick ISR only) */
+static uint16 g_Sched_Countdown[SCHED_MAX_TASKS];
+
+/* Execution statistics of each task */
+static Sched_TaskStatsType g_Sched_Stats[SCHED_MAX_TASKS];
+
+/* Bitmap of the registered tasks */
+static volatile uint32 g_Sched_TaskMask = 0;
+
+/* Bitmap of the released tasks waiting for or in execution (set by the SysTick ISR, cleared by the main loop when the task
+ * returns) */
+static volatile uint32 g_Sched_ReadyMask = 0;
+
+/***************************************************************************************************************************************
+ * Service Name: Sched_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the task table and enable the DWT cycle counter used for the execution time statistics.
+ *              Must be called before the SysTick interrupt is routed to Sched_Tick.
+****************************************************************************************************************************************/
+void Sched_Init(void)
+{
+    uint8 task;
+
+    g_Sched_TaskMask  = 0;
+    g_Sched_ReadyMask = 0;
+
+    for (task = 0; task < SCHED_MAX_TASKS; task++)
+    {
+        g_Sched_TaskFunc[task]            = NULL_PTR;
+        g_Sched_Period[task]              = 0;
+        g_Sched_Countdown[task]           = 0;
+        g_Sched_Stats[task].Runs          = 0;
+        g_Sched_Stats[task].Overruns      = 0;
+        g_Sched_Stats[task].MaxExecCycles = 0;
+    }
+
+    Dwt_EnableCycleCounter();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sched_AddTask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Priority - Priority level of the task (0 is the most urgent), each level holds one task
+ *                  a_TaskFunc - Run-to-completion task function
+ *                  a_PeriodTicks - Release period in SysTick ticks (must be greater than zero)
+ *                  a_OffsetTicks - Tick of the first release, counted from the first SysTick tick after registration
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the task is registered, FALSE if the parameters are invalid or the priority level is taken
+ * Description: Function to register a periodic task in the scheduler.
+****************************************************************************************************************************************/
+boolean Sched_AddTask(Sched_PriorityType a_Priority, Sched_TaskFuncType a_TaskFunc, uint16 a_PeriodTicks, uint16 a_OffsetTicks)
+{
+    if ((a_Priority >= SCHED_MAX_TASKS) || (a_TaskFunc == NULL_PTR) || (a_PeriodTicks == 0) ||
+        (g_Sched_TaskMask & SCHED_PRIORITY_BIT(a_Priority)))
+    {
+        return FALSE;
+    }
+
+    g_Sched_TaskFunc[a_Priority]  = a_TaskFunc;
+    g_Sched_Period[a_Priority]    = a_PeriodTicks;
+    g_Sched_Countdown[a_Priority] = a_OffsetTicks;
+
+    /* Publish the task to the SysTick ISR only after its entry is complete */
+    Disable_Exceptions();
+    g_Sched_TaskMask |= SCHED_PRIORITY_BIT(a_Priority);
+    Enable_Exceptions();
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sched_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to release the tasks whose period elapsed, it must be registered as the SysTick call back function.
+ *              A release that finds the task still ready, waiting or running, is counted as an overrun and is not queued
+ *              twice.
+****************************************************************************************************************************************/
+void Sched_Tick(void)
+{
+    uint32 pending = g_Sched_TaskMask;
+    uint32 ready   = g_Sched_ReadyMask;
+    uint8  task;
+
+    while (pending != 0)
+    {
+        task = _norm(pending);                            /* CLZ: next registered task */
+        pending &= ~SCHED_PRIORITY_BIT(task);
+
+        if (g_Sched_Countdown[task] == 0)
+        {
+            g_Sched_Countdown[task] = g_Sched_Period[task] - 1;
+
+            if (ready & SCHED_PRIORITY_BIT(task))
+            {
+                g_Sched_Stats[task].Overruns++;           /* Previous release is not executed yet */
+            }
+            else
+            {
+                ready |= SCHED_PRIORITY_BIT(task);
+            }
+        }
+        else
+        {
+            g_Sched_Countdown[task]--;
+        }
+    }
+
+    g_Sched_ReadyMask = ready;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sched_Dispatch
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to run the most urgent ready task to completion, it must be called repeatedly from the main loop.
+ *              When no task is ready the processor sleeps with WFI until the next interrupt instead of polling. The ready
+ *              bit of the task stays set while it runs, so a release that comes before it returns is an overrun.
+****************************************************************************************************************************************/
+void Sched_Dispatch(void)
+{
+    uint8  task;
+    uint32 start_cycles;
+    uint32 exec_cycles;
+
+    /* Check and sleep with the I-bit set, so a release between the check and the WFI still wakes the processor up */
+    Disable_Exceptions();
+
+    if (g_Sched_ReadyMask == 0)
+    {
+        Idle_Sleep();                                      /* Returns with the interrupts enabled */
+        return;
+    }
+
+    task = _norm(g_Sched_ReadyMask);                       /* CLZ: most urgent ready task */
+    Enable_Exceptions();
+
+    start_cycles = Dwt_GetCycles();
+    (*g_Sched_TaskFunc[task])();
+    exec_cycles = Dwt_GetCycles() - start_cycles;
+
+    /* The release is complete, the next one may be queued */
+    Disable_Exceptions();
+    g_Sched_ReadyMask &= ~SCHED_PRIORITY_BIT(task);
+    Enable_Exceptions();
+
+    g_Sched_Stats[task].Runs++;
+    if (exec_cycles > g_Sched_Stats[task].MaxExecCycles)
+    {
+        g_Sched_Stats[task].MaxExecCycles = exec_cycles;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sched_GetTaskStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Priority - Priority level of the task
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the task statistics
+ * Return value: None
+ * Description: Function to read the run, overrun and maximum execution time statistics of a task.
+****************************************************************************************************************************************/
+void Sched_GetTaskStats(Sched_PriorityType a_Priority, Sched_TaskStatsType *a_Stats)
+{
+    if ((a_Priority < SCHED_MAX_TASKS) && (a_Stats != NULL_PTR))
+    {
+        Disable_Exceptions();
+        *a_Stats = g_Sched_Stats[a_Priority];
+        Enable_Exceptions();
+    }
+}
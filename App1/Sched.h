@@ -0,0 +1,57 @@
+/***********************************************************************************************************************************
+ Module      : Sched
+ Name        : Sched.h
+ Author      : Salma Hamdy
+ Description : Header file for the cooperative run-to-completion task scheduler driven by the SysTick tick
+ ************************************************************************************************************************************/
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* One task per priority level, priority 0 is the most urgent one (same ordering as the NVIC) */
+#define SCHED_MAX_TASKS                      32
+
+/* Ready bitmap bit of a priority level, priority 0 is the MSB so CLZ of the bitmap returns the most urgent ready priority */
+#define SCHED_PRIORITY_BIT(PRIORITY)         (0x80000000UL >> (PRIORITY))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Sched_PriorityType;
+
+typedef void (*Sched_TaskFuncType)(void);
+
+typedef struct
+{
+    uint32 Runs;             /* Number of completed executions */
+    uint32 Overruns;         /* Number of releases that found the task still waiting for or running its previous release */
+    uint32 MaxExecCycles;    /* Longest measured execution time in core clock cycles */
+}Sched_TaskStatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Sched_Init(void);
+
+boolean Sched_AddTask(Sched_PriorityType a_Priority, Sched_TaskFuncType a_TaskFunc, uint16 a_PeriodTicks, uint16 a_OffsetTicks);
+
+void Sched_Tick(void);
+
+void Sched_Dispatch(void);
+
+void Sched_GetTaskStats(Sched_PriorityType a_Priority, Sched_TaskStatsType *a_Stats);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* SCHED_H_ */
@@ -0,0 +1,106 @@
+/**************************************************************************************************************************************
+ Module      : Semaphore
+ Name        : Semaphore.c
+ Author      : Salma Hamdy
+ Description : Source file for the counting semaphore given from ISRs and taken from the main context with a timeout
+ ***************************************************************************************************************************************/
+
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Idle.h"
+#include "Atomic.h"
+#include "Semaphore.h"
+
+/***************************************************************************************************************************************
+ * Service Name: Semaphore_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_InitialCount - Initial number of available units
+ * Parameters (inout): a_Sem - Semaphore object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to initialize a counting semaphore.
+****************************************************************************************************************************************/
+void Semaphore_Init(Semaphore_Type *a_Sem, uint32 a_InitialCount)
+{
+    a_Sem->Count = a_InitialCount;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Semaphore_Give
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (ISRs at any priority and the main loop)
+ * Parameters (in): None
+ * Parameters (inout): a_Sem - Semaphore object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to release one unit with a single atomic increment.
+****************************************************************************************************************************************/
+void Semaphore_Give(Semaphore_Type *a_Sem)
+{
+    Atomic_FetchAdd(&a_Sem->Count, 1);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Semaphore_TryTake
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant (ISRs at any priority and the main loop)
+ * Parameters (in): None
+ * Parameters (inout): a_Sem - Semaphore object
+ * Parameters (out): None
+ * Return value: boolean - TRUE if a unit is taken, FALSE if the count is zero
+ * Description: Function to take one unit without waiting.
+****************************************************************************************************************************************/
+boolean Semaphore_TryTake(Semaphore_Type *a_Sem)
+{
+    uint32 count;
+
+    do
+    {
+        count = a_Sem->Count;
+        if (count == 0)
+        {
+            return FALSE;
+        }
+    } while (!Atomic_CompareExchange(&a_Sem->Count, count, count - 1));
+
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Semaphore_Take
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (thread mode only, with the interrupts enabled)
+ * Parameters (in): a_TimeoutTicks - Timeout in SysTick ticks, SEMAPHORE_WAIT_FOREVER to wait without timeout
+ * Parameters (inout): a_Sem - Semaphore object
+ * Parameters (out): None
+ * Return value: boolean - TRUE if a unit is taken, FALSE on timeout
+ * Description: Function to take one unit, sleeping with WFI between attempts until an ISR gives the semaphore or the
+ *              timeout elapses. The SysTick interrupt must be running when a timeout is used. It returns with the interrupts
+ *              enabled whatever the PRIMASK was on entry, so it must not be called from an ISR or inside a Disable_Exceptions
+ *              section; use Semaphore_TryTake there.
+****************************************************************************************************************************************/
+boolean Semaphore_Take(Semaphore_Type *a_Sem, uint32 a_TimeoutTicks)
+{
+    uint32 start_tick = SysTick_GetTickCount();
+
+    while(1)
+    {
+        /* Check and sleep with the I-bit set, so a give between the check and the WFI still wakes the processor up */
+        Disable_Exceptions();
+
+        if (Semaphore_TryTake(a_Sem))
+        {
+            Enable_Exceptions();
+            return TRUE;
+        }
+
+        if ((a_TimeoutTicks != SEMAPHORE_WAIT_FOREVER) && ((SysTick_GetTickCount() - start_tick) >= a_TimeoutTicks))
+        {
+            Enable_Exceptions();
+            return FALSE;
+        }
+
+        Idle_Sleep();                        /* Returns with the interrupts enabled */
+    }
+}
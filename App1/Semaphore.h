@@ -0,0 +1,44 @@
+/***********************************************************************************************************************************
+ Module      : Semaphore
+ Name        : Semaphore.h
+ Author      : Salma Hamdy
+ Description : Header file for the counting semaphore given from ISRs and taken from the main context with a timeout
+ ************************************************************************************************************************************/
+
+#ifndef SEMAPHORE_H_
+#define SEMAPHORE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define SEMAPHORE_WAIT_FOREVER               0xFFFFFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    volatile uint32 Count;
+}Semaphore_Type;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Semaphore_Init(Semaphore_Type *a_Sem, uint32 a_InitialCount);
+
+void Semaphore_Give(Semaphore_Type *a_Sem);
+
+boolean Semaphore_TryTake(Semaphore_Type *a_Sem);
+
+boolean Semaphore_Take(Semaphore_Type *a_Sem, uint32 a_TimeoutTicks);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* SEMAPHORE_H_ */
@@ -0,0 +1,164 @@
+/**************************************************************************************************************************************
+ Module      : Spurious
+ Name        : Spurious.c
+ Author      : Salma Hamdy
+ Description : Source file for the accounting of the unexpected interrupts taken by the default handler of the vector table
+
+ IntDefaultHandler and NmiSR of the startup file call Spurious_Handler, so an NMI, an enabled IRQ or a system exception without
+ an application handler becomes a counted, non-fatal event instead of hanging the device. The exception number is read from VECTACTIVE, the
+ memory mapped copy of IPSR, which avoids an assembly helper and is also modelled by the host simulator.
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Atomic.h"
+#include "Spurious.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Write-one-to-disable register of an IRQ, the other IRQs of the register are not touched */
+#define SPURIOUS_NVIC_DIS_REG(IRQ_NUM)       HW_REG32(0xE000E180 + (((IRQ_NUM) >> 5) * 4))
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Each slot is written by its own vector only, a vector cannot preempt itself */
+static volatile uint16 g_Spurious_Counts[SPURIOUS_VECTORS];
+
+/* The total is updated atomically because an unexpected vector can preempt another one */
+static volatile uint32 g_Spurious_Total = 0;
+static volatile uint8 g_Spurious_LastVector = 0;
+
+static volatile boolean g_Spurious_DisableIrq = TRUE;
+
+/***************************************************************************************************************************************
+ * Service Name: Spurious_Handler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to account an unexpected exception, to be called from the default handler and the NMI handler of
+ *              the vector table. An IRQ is disabled in the NVIC (unless turned off by Spurious_SetDisableIrq) so a level
+ *              source cannot keep re-entering, then the handler returns. The configurable faults cannot be returned from and
+ *              still halt here after being counted, preserving the state for the debugger.
+****************************************************************************************************************************************/
+void Spurious_Handler(void)
+{
+    uint32 vector = HW_READ32(NVIC_SYSTEM_INTCTRL) & INTCTRL_VECTACTIVE_MASK;
+    uint32 irq;
+
+    if (vector >= SPURIOUS_VECTORS)
+    {
+        vector = 0;                              /* Not a TM4C123GH6PM vector, accounted in the unused slot 0 */
+    }
+
+    if (g_Spurious_Counts[vector] != SPURIOUS_COUNT_MAX)
+    {
+        g_Spurious_Counts[vector]++;
+    }
+
+    (void)Atomic_FetchAdd(&g_Spurious_Total, 1);
+    g_Spurious_LastVector = (uint8)vector;
+
+    if (vector >= SPURIOUS_FIRST_IRQ_VECTOR)
+    {
+        if (g_Spurious_DisableIrq)
+        {
+            irq = vector - SPURIOUS_FIRST_IRQ_VECTOR;
+            HW_WRITE32(SPURIOUS_NVIC_DIS_REG(irq), (uint32)1 << (irq & 31));
+        }
+    }
+    else if ((vector >= SPURIOUS_MEM_FAULT_VECTOR) && (vector <= SPURIOUS_USAGE_FAULT_VECTOR))
+    {
+        while(1)
+        {
+        }
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Spurious_SetDisableIrq
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Enable - TRUE to disable an unexpected IRQ after its first occurrence (default), FALSE to keep it enabled
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to choose if an unexpected IRQ is disabled in the NVIC, keeping it enabled counts every occurrence
+ *              but a level-triggered source then keeps the CPU in the default handler until it is cleared.
+****************************************************************************************************************************************/
+void Spurious_SetDisableIrq(boolean a_Enable)
+{
+    g_Spurious_DisableIrq = a_Enable;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Spurious_GetCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Vector - Vector table index (exception number)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint16 - Occurrences of the vector in the default handler (saturated), 0 for an invalid vector
+ * Description: Function to read the unexpected occurrences of one vector.
+****************************************************************************************************************************************/
+uint16 Spurious_GetCount(uint8 a_Vector)
+{
+    if (a_Vector >= SPURIOUS_VECTORS)
+    {
+        return 0;
+    }
+    return g_Spurious_Counts[a_Vector];
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Spurious_GetTotal
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_LastVector - Exception number of the last unexpected vector (optional, may be NULL_PTR)
+ * Return value: uint32 - Unexpected exceptions taken since the start or the last Spurious_Clear
+ * Description: Function to check cheaply if any unexpected exception happened, the per-vector counts tell which ones.
+****************************************************************************************************************************************/
+uint32 Spurious_GetTotal(uint8 *a_LastVector)
+{
+    if (a_LastVector != NULL_PTR)
+    {
+        *a_LastVector = g_Spurious_LastVector;
+    }
+    return g_Spurious_Total;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Spurious_Clear
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear all the counts, the IRQs disabled by the default handler stay disabled.
+****************************************************************************************************************************************/
+void Spurious_Clear(void)
+{
+    uint8 vector;
+
+    Disable_Exceptions();
+    for (vector = 0; vector < SPURIOUS_VECTORS; vector++)
+    {
+        g_Spurious_Counts[vector] = 0;
+    }
+    g_Spurious_Total = 0;
+    g_Spurious_LastVector = 0;
+    Enable_Exceptions();
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
@@ -0,0 +1,51 @@
+/***********************************************************************************************************************************
+ Module      : Spurious
+ Name        : Spurious.h
+ Author      : Salma Hamdy
+ Description : Header file for the accounting of the unexpected interrupts taken by the default handler of the vector table
+ ************************************************************************************************************************************/
+
+#ifndef SPURIOUS_H_
+#define SPURIOUS_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Entries of the TM4C123GH6PM vector table: 16 system exceptions and 139 IRQ entries */
+#define SPURIOUS_VECTORS                     155
+
+/* Exception numbers (IPSR values) of the configurable faults and of the first IRQ */
+#define SPURIOUS_MEM_FAULT_VECTOR            4
+#define SPURIOUS_USAGE_FAULT_VECTOR          6
+#define SPURIOUS_FIRST_IRQ_VECTOR            16
+
+/* Active exception number field of the Interrupt Control and State register, same value as IPSR */
+#define INTCTRL_VECTACTIVE_MASK              0x000001FF
+
+/* The per-vector counts saturate instead of wrapping */
+#define SPURIOUS_COUNT_MAX                   0xFFFF
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Spurious_Handler(void);
+
+void Spurious_SetDisableIrq(boolean a_Enable);
+
+uint16 Spurious_GetCount(uint8 a_Vector);
+
+uint32 Spurious_GetTotal(uint8 *a_LastVector);
+
+void Spurious_Clear(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* SPURIOUS_H_ */
@@ -0,0 +1,125 @@
+/**************************************************************************************************************************************
+ Module      : Stack
+ Name        : Stack.c
+ Author      : Salma Hamdy
+ Description : Source file for the stack painting and high-water monitoring of the main stack and the thread stacks
+
+ The unused part of a stack is filled with STACK_PAINT_PATTERN once: the main stack by Stack_PaintMain at the start of main and
+ every thread stack by Kernel_CreateThread. The high-water mark is found by scanning up from the bottom of the stack to the first
+ overwritten word, so it costs nothing at run time and the scan only reads the words that were never used. The main stack mark
+ includes the nested exception frames and handlers, which all run on the main stack. The bound computed off-line by
+ Tools/stack_usage.py is the figure to size the stacks with, the mark checks it on the running device.
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "Mpu.h"
+#include "Stack.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Bounds of the main stack (.stack section), set by the linker */
+#ifdef TM4C_SIM
+static uint32 g_Stack_SimMain[256];             /* Host build: stand-in for the main stack, the host stack is not painted */
+#define STACK_MAIN_BOTTOM                    (&g_Stack_SimMain[0])
+#define STACK_MAIN_TOP                       (&g_Stack_SimMain[256])
+#else
+extern uint32 __stack;
+extern uint32 __STACK_END;
+#define STACK_MAIN_BOTTOM                    (&__stack)
+#define STACK_MAIN_TOP                       (&__STACK_END)
+#endif
+
+/***************************************************************************************************************************************
+ * Service Name: Stack_PaintMain
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to paint the free part of the main stack, from its bottom up to STACK_PAINT_MARGIN_WORDS below the frame
+ *              of this function. It must be the first call of main, before the interrupts are enabled.
+****************************************************************************************************************************************/
+void Stack_PaintMain(void)
+{
+    volatile uint32 marker = 0;
+    uint32 *end = (uint32 *)&marker - STACK_PAINT_MARGIN_WORDS;
+    uint32 *word = Mpu_GetUsableStack(STACK_MAIN_BOTTOM);
+
+#ifdef TM4C_SIM
+    end = STACK_MAIN_TOP;                       /* Host build: the whole stand-in is free */
+#endif
+    while (word < end)
+    {
+        *word++ = STACK_PAINT_PATTERN;
+    }
+    (void)marker;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Stack_Paint
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Stack - Lowest address of the stack, a_Words - Stack size in words
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to paint a stack that is not in use, e.g. a thread stack before its initial frame is built.
+****************************************************************************************************************************************/
+void Stack_Paint(uint32 *a_Stack, uint32 a_Words)
+{
+    uint32 *word = Mpu_GetUsableStack(a_Stack);
+    uint32 *end = a_Stack + a_Words;
+
+    while (word < end)
+    {
+        *word++ = STACK_PAINT_PATTERN;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Stack_GetHighWater
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Stack - Lowest address of the stack, a_Words - Stack size in words
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Deepest use of the stack in bytes since it was painted
+ * Description: Function to find the high-water mark of a painted stack, scanning up from the bottom (above the MPU guard) to
+ *              the first word that differs from the pattern.
+****************************************************************************************************************************************/
+uint32 Stack_GetHighWater(uint32 *a_Stack, uint32 a_Words)
+{
+    const uint32 *word = Mpu_GetUsableStack(a_Stack);
+    const uint32 *end = a_Stack + a_Words;
+
+    while ((word < end) && (*word == STACK_PAINT_PATTERN))
+    {
+        word++;
+    }
+    return (uint32)(end - word) * sizeof(uint32);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Stack_GetMainUsage
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Usage - Usable size and high-water mark of the main stack in bytes
+ * Return value: None
+ * Description: Function to read the deepest use of the main stack by main and the nested exception handlers.
+****************************************************************************************************************************************/
+void Stack_GetMainUsage(Stack_UsageType *a_Usage)
+{
+    uint32 words = (uint32)(STACK_MAIN_TOP - STACK_MAIN_BOTTOM);
+
+    a_Usage->SizeBytes = (uint32)(STACK_MAIN_TOP - Mpu_GetUsableStack(STACK_MAIN_BOTTOM)) * sizeof(uint32);
+    a_Usage->UsedBytes = Stack_GetHighWater(STACK_MAIN_BOTTOM, words);
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
@@ -0,0 +1,50 @@
+/***********************************************************************************************************************************
+ Module      : Stack
+ Name        : Stack.h
+ Author      : Salma Hamdy
+ Description : Header file for the stack painting and high-water monitoring of the main stack and the thread stacks
+ ************************************************************************************************************************************/
+
+#ifndef STACK_H_
+#define STACK_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Fill value of the unused stack words, unlikely as an address, a count or a saved register */
+#define STACK_PAINT_PATTERN                  0xC5C5C5C5
+
+/* Words left unpainted below the frame of Stack_PaintMain, the function itself and the pending exceptions may use them */
+#define STACK_PAINT_MARGIN_WORDS             16
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 SizeBytes;                 /* Usable size, without the MPU guard */
+    uint32 UsedBytes;                 /* Deepest use since the painting (high-water mark) */
+}Stack_UsageType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Stack_PaintMain(void);
+
+void Stack_Paint(uint32 *a_Stack, uint32 a_Words);
+
+uint32 Stack_GetHighWater(uint32 *a_Stack, uint32 a_Words);
+
+void Stack_GetMainUsage(Stack_UsageType *a_Usage);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* STACK_H_ */
@@ -6,8 +6,24 @@
  ***************************************************************************************************************************************/
 
 #include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Clock.h"
 #include "SysTick.h"
 
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* The counter is 24 bits wide */
+#define SYSTICK_RELOAD_MAX                   0x00FFFFFF
+
+/* Control register: counter clocked by the system clock instead of PIOSC / 4 */
+#define SYSTICK_CTRL_CLK_SRC_MASK            0x04
+
+/* Unit of the period fraction: a counter clock per millisecond is 10^12 when the frequency in Hz is scaled by 10^9 for the trim */
+#define SYSTICK_PPB_ONE                      1000000000LL
+#define SYSTICK_PHASE_ONE                    1000000000000ULL
+
 /*******************************************************************************
  *                           Global Variables                                  *
  *******************************************************************************/
@@ -15,6 +31,223 @@
 /* Global variable to hold the address of the call back function in the application */
 static volatile void (*g_SysTickCallBackPtr)(void) = NULL_PTR;
 
+/* Global variable to count the SysTick interrupts, used as the time base of the timeouts */
+static volatile uint32 g_SysTickCount = 0;
+
+/* Tick period given to SysTick_Init, the reload is recomputed from it when the system clock changes */
+static uint16 g_SysTickPeriodMs = 0;
+
+/* Counter clock chosen by SysTick_SetClockSource, latched into the active one by SysTick_Init and SysTick_StartBusyWait */
+static SysTick_ClockSourceType g_SysTickClockSource = SYSTICK_CLOCK_SYSTEM;
+
+/* Counter clock programmed in CTRL.CLK_SRC, the unit of RELOAD and CURRENT until the next SysTick_Init or SysTick_StartBusyWait */
+static SysTick_ClockSourceType g_SysTickActiveSource = SYSTICK_CLOCK_SYSTEM;
+
+/* Measured error of the counter clock in parts per billion, positive when it runs fast */
+static sint32 g_SysTickTrimPpb = 0;
+
+/* Period in counter clocks: whole part, fraction added to the phase every period and phase, both in 1 / SYSTICK_PHASE_ONE */
+static uint32 g_SysTickPeriodWhole = 0;
+static uint64 g_SysTickPhaseStep = 0;
+static uint64 g_SysTickPhase = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Counter clocks of a period in milliseconds with the trim applied: the whole part is returned, limited to the 24-bit counter,
+ * and the fraction is written to a_Step in 1 / SYSTICK_PHASE_ONE */
+static uint32 SysTick_ComputePeriod(uint32 a_FrequencyHz, uint16 a_TimeInMilliSeconds, uint64 *a_Step)
+{
+    uint64 per_ms   = (uint64)a_FrequencyHz * (uint64)(SYSTICK_PPB_ONE + g_SysTickTrimPpb);
+    uint64 fraction = (per_ms % SYSTICK_PHASE_ONE) * a_TimeInMilliSeconds;
+    uint64 whole    = ((per_ms / SYSTICK_PHASE_ONE) * a_TimeInMilliSeconds) + (fraction / SYSTICK_PHASE_ONE);
+
+    *a_Step = fraction % SYSTICK_PHASE_ONE;
+    if (whole > (SYSTICK_RELOAD_MAX + 1))
+    {
+        whole   = SYSTICK_RELOAD_MAX + 1;
+        *a_Step = 0;
+    }
+    return (uint32)whole;
+}
+
+/* Period of the running tick from the counter clock, the phase restarts with the period in progress counted */
+static void SysTick_UpdatePeriod(uint32 a_FrequencyHz)
+{
+    g_SysTickPeriodWhole = SysTick_ComputePeriod(a_FrequencyHz, g_SysTickPeriodMs, &g_SysTickPhaseStep);
+    g_SysTickPhase       = g_SysTickPhaseStep;
+}
+
+/* Bresenham step: the counter already runs the period loaded at the last wrap, RELOAD sets the length of the one after it,
+ * one counter clock longer each time the phase overflows, so n periods last exactly floor(n * period) counter clocks */
+static void SysTick_ProgramNextPeriod(void)
+{
+    g_SysTickPhase += g_SysTickPhaseStep;
+    if (g_SysTickPhase >= SYSTICK_PHASE_ONE)
+    {
+        g_SysTickPhase -= SYSTICK_PHASE_ONE;
+        HW_WRITE32(SYSTICK_RELOAD_REG, g_SysTickPeriodWhole);
+    }
+    else
+    {
+        HW_WRITE32(SYSTICK_RELOAD_REG, g_SysTickPeriodWhole - 1);
+    }
+}
+
+/* Clock change listener: the period in progress is finished with its remaining time converted to the new clock, the
+ * following ones use the new reload, so the ticks keep their length in time and none is lost or added. A counter clocked by
+ * PIOSC / 4 does not see the change. The fraction of a counter clock carried by the phase is lost. */
+static void SysTick_ClockChanged(uint32 a_OldFrequencyHz, uint32 a_NewFrequencyHz)
+{
+    uint32 reload;
+    uint32 remaining;
+
+    if (g_SysTickActiveSource == SYSTICK_CLOCK_PIOSC_DIV4)
+    {
+        return;
+    }
+
+    SysTick_UpdatePeriod(a_NewFrequencyHz);
+    reload = g_SysTickPeriodWhole - 1;
+    if (!(HW_READ32(SYSTICK_CTRL_REG) & 0x01))
+    {
+        HW_WRITE32(SYSTICK_RELOAD_REG, reload);                  /* Stopped: the next period uses the new reload */
+        return;
+    }
+
+    remaining = (uint32)(((uint64)HW_READ32(SYSTICK_CURRENT_REG) * a_NewFrequencyHz) / a_OldFrequencyHz);
+    if (remaining < 2)
+    {
+        remaining = 2;                                           /* A zero reload would stop the counter */
+    }
+    else if (remaining > (reload + 1))
+    {
+        remaining = reload + 1;
+    }
+
+    /* The cleared counter loads the remaining time on the next clock, the new reload only takes effect at its end */
+    HW_WRITE32(SYSTICK_RELOAD_REG, remaining - 1);
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);
+    while (HW_READ32(SYSTICK_CURRENT_REG) == 0);
+    SysTick_ProgramNextPeriod();
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: SysTick_SetClockSource
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Source - SYSTICK_CLOCK_SYSTEM or SYSTICK_CLOCK_PIOSC_DIV4
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the source is valid, FALSE otherwise
+ * Description: Function to select the clock of the SysTick counter, applied by the next SysTick_Init or SysTick_StartBusyWait.
+ *              The running counter, its period and SysTick_GetCounterFrequency keep the active clock until then.
+ *              With PIOSC / 4 the tick keeps its rate when the system clock changes or the PLL is powered down, without any
+ *              reload rescaling, at a resolution of 250 ns and for periods up to 4194 ms.
+****************************************************************************************************************************************/
+boolean SysTick_SetClockSource(SysTick_ClockSourceType a_Source)
+{
+    if ((a_Source != SYSTICK_CLOCK_SYSTEM) && (a_Source != SYSTICK_CLOCK_PIOSC_DIV4))
+    {
+        return FALSE;
+    }
+    g_SysTickClockSource = a_Source;
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: SysTick_GetClockSource
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: SysTick_ClockSourceType - Selected counter clock
+ * Description: Function to read the clock of the SysTick counter selected for the next SysTick_Init or SysTick_StartBusyWait.
+****************************************************************************************************************************************/
+SysTick_ClockSourceType SysTick_GetClockSource(void)
+{
+    return g_SysTickClockSource;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: SysTick_SetTrim
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_PartsPerBillion - Error of the counter clock measured against a reference, positive when it runs fast,
+ *                                      at most SYSTICK_TRIM_MAX_PPB either way
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the trim is in range, FALSE otherwise
+ * Description: Function to correct the tick period for the measured error of its clock (crystal tolerance and ageing, PIOSC
+ *              calibration). A period that is not a whole number of counter clocks, from the trim or from a clock that is not
+ *              a multiple of 1 kHz, is generated by alternating two reload values with a phase accumulator, so the long-run
+ *              tick rate is exact to 10^-12 counter clock per millisecond and the tick jitter is one counter clock. A running
+ *              tick takes the new period after the one in progress, whole or fractional. It must be called with the interrupts
+ *              enabled, they are disabled while the period is updated.
+****************************************************************************************************************************************/
+boolean SysTick_SetTrim(sint32 a_PartsPerBillion)
+{
+    if ((a_PartsPerBillion > SYSTICK_TRIM_MAX_PPB) || (a_PartsPerBillion < -SYSTICK_TRIM_MAX_PPB))
+    {
+        return FALSE;
+    }
+
+    Disable_Exceptions();
+    g_SysTickTrimPpb = a_PartsPerBillion;
+    if (g_SysTickPeriodMs != 0)
+    {
+        SysTick_UpdatePeriod(SysTick_GetCounterFrequency());
+        SysTick_ProgramNextPeriod();                              /* A whole period must not keep the last alternating reload */
+    }
+    Enable_Exceptions();
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: SysTick_GetCounterFrequency
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Frequency in Hz at which the counter decrements
+ * Description: Function to read the unit of the CURRENT and RELOAD values: the system clock or 4 MHz, from the clock active
+ *              since the last SysTick_Init or SysTick_StartBusyWait.
+****************************************************************************************************************************************/
+uint32 SysTick_GetCounterFrequency(void)
+{
+    return (g_SysTickActiveSource == SYSTICK_CLOCK_PIOSC_DIV4) ? SYSTICK_PIOSC_DIV4_HZ : Clock_GetFrequency();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: SysTick_GetPeriodCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Length of the tick period in system clock cycles
+ * Description: Function to convert the programmed period (RELOAD + 1 counter clocks) to system clock cycles, for the modules
+ *              that compare it with cycle counts. It divides for a PIOSC / 4 counter, it is meant for the initializations.
+ *              A fractional period is one counter clock longer in some periods, the error is below one clock per tick.
+****************************************************************************************************************************************/
+uint32 SysTick_GetPeriodCycles(void)
+{
+    uint32 counts = HW_READ32(SYSTICK_RELOAD_REG) + 1;
+
+    if (g_SysTickActiveSource == SYSTICK_CLOCK_SYSTEM)
+    {
+        return counts;
+    }
+    return (uint32)(((uint64)counts * Clock_GetFrequency()) / SYSTICK_PIOSC_DIV4_HZ);
+}
+
 /***************************************************************************************************************************************
  * Service Name: SysTick_Init
  * Sync/Async: Synchronous
@@ -22,19 +255,38 @@ static volatile void (*g_SysTickCallBackPtr)(void) = NULL_PTR;
  * Parameters (in): a_TimeInMilliSeconds - required time in milliseconds
  * Parameters (inout): None
  * Parameters (out): None
- * Return value: None
- * Description: Function to initialize the SysTick timer with the specified time in milliseconds using interrupts.
+ * Return value: boolean - TRUE if the period follows the system clock changes, FALSE if the Clock listener table is full
+ * Description: Function to initialize the SysTick timer with the specified time in milliseconds using interrupts. The counter
+ *              runs from the clock chosen by SysTick_SetClockSource. From the system clock the reload follows
+ *              Clock_GetFrequency and is rescaled by Clock_SetFrequency, the period must fit in the 24-bit counter at the
+ *              highest frequency used. A period with a fraction of a counter clock (see SysTick_SetTrim) alternates two
+ *              reload values from the interrupt.
 ****************************************************************************************************************************************/
-void SysTick_Init(uint16 a_TimeInMilliSeconds)
+boolean SysTick_Init(uint16 a_TimeInMilliSeconds)
 {
-    SYSTICK_CTRL_REG    = 0;                                      /* Disable the SysTick Timer by Clear the ENABLE Bit */
-    SYSTICK_RELOAD_REG  = (16000 * a_TimeInMilliSeconds) - 1;     /* Set the reload value for 16MHz clock */
-    SYSTICK_CURRENT_REG = 0;                                      /* Clear the Current Register value */
+    boolean listening;
+
+    g_SysTickPeriodMs     = a_TimeInMilliSeconds;
+    g_SysTickActiveSource = g_SysTickClockSource;
+    listening = Clock_AddListener(SysTick_ClockChanged);
+    SysTick_UpdatePeriod(SysTick_GetCounterFrequency());
+
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);                              /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    HW_WRITE32(SYSTICK_RELOAD_REG, g_SysTickPeriodWhole - 1);     /* Set the reload value for the counter clock */
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);                           /* Clear the Current Register value */
     /* Configure the SysTick Control Register
      * Enable the SysTick Timer (ENABLE = 1)
      * Enable SysTick Interrupt (INTEN = 1)
-     * Choose the clock source to be System Clock (CLK_SRC = 1) */
-    SYSTICK_CTRL_REG   |= 0x07;
+     * Choose the clock source: System Clock (CLK_SRC = 1) or PIOSC / 4 (CLK_SRC = 0) */
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) | 0x03 |
+               ((g_SysTickActiveSource == SYSTICK_CLOCK_SYSTEM) ? SYSTICK_CTRL_CLK_SRC_MASK : 0));
+
+    if (g_SysTickPhaseStep != 0)
+    {
+        while (HW_READ32(SYSTICK_CURRENT_REG) == 0);              /* Wait for the first period to load, then set the second one */
+        SysTick_ProgramNextPeriod();
+    }
+    return listening;
 }
 
 /****************************************************************************************************************************************
@@ -50,18 +302,22 @@ void SysTick_Init(uint16 a_TimeInMilliSeconds)
 ****************************************************************************************************************************************/
 void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
 {
-    SYSTICK_CTRL_REG    = 0;                                     /* Disable the SysTick Timer by Clear the ENABLE Bit */
-    SYSTICK_RELOAD_REG  = (16000 * a_TimeInMilliSeconds) - 1;    /* Set the Reload value with 7999999 to count half Second */
-    SYSTICK_CURRENT_REG = 0;                                     /* Clear the Current Register value */
+    uint64 fraction;
+
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);                             /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    g_SysTickActiveSource = g_SysTickClockSource;
+    HW_WRITE32(SYSTICK_RELOAD_REG, SysTick_ComputePeriod(SysTick_GetCounterFrequency(), a_TimeInMilliSeconds, &fraction) - 1); /* Set the reload value for the counter clock */
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);                          /* Clear the Current Register value */
     /* Configure the SysTick Control Register
      * Enable the SysTick Timer (ENABLE = 1)
      * Disable SysTick Interrupt (INTEN = 0)
-     * Choose the clock source to be System Clock (CLK_SRC = 1) */
-    SYSTICK_CTRL_REG   |= 0x05;
+     * Choose the clock source: System Clock (CLK_SRC = 1) or PIOSC / 4 (CLK_SRC = 0) */
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) | 0x01 |
+               ((g_SysTickActiveSource == SYSTICK_CLOCK_SYSTEM) ? SYSTICK_CTRL_CLK_SRC_MASK : 0));
 
-    while(!(SYSTICK_CTRL_REG & (1<<16)));                       /* Wait until the COUNT flag = 1 which mean SysTick Timer reaches ZERO value */
+    while(!(HW_READ32(SYSTICK_CTRL_REG) & (1<<16)));            /* Wait until the COUNT flag = 1 which mean SysTick Timer reaches ZERO value */
 
-    SYSTICK_CTRL_REG = 0;                                       /* Disable SysTick after completion */
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);                            /* Disable SysTick after completion */
 }
 
 /***************************************************************************************************************************************
@@ -72,10 +328,18 @@ void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function Handler for SysTick interrupt used to call the call-back function..
+ * Description: Function Handler for SysTick interrupt used to count the ticks and call the call-back function..
+ *              A fractional period gets the reload of the period after the one just started.
 ****************************************************************************************************************************************/
 void SysTick_Handler(void)
 {
+    g_SysTickCount++;                    /* Only writer, no read-modify-write race with the readers */
+
+    if (g_SysTickPhaseStep != 0)
+    {
+        SysTick_ProgramNextPeriod();
+    }
+
     if (g_SysTickCallBackPtr != NULL_PTR)
     {
         (*g_SysTickCallBackPtr)();       /* Call the callback function if it's set */
@@ -109,7 +373,7 @@ void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
 ****************************************************************************************************************************************/
 void SysTick_Stop(void)
 {
-    SYSTICK_CTRL_REG &= ~0x01;              /* Clear the ENABLE bit */
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) & ~0x01); /* Clear the ENABLE bit */
 }
 
 /***************************************************************************************************************************************
@@ -124,7 +388,7 @@ void SysTick_Stop(void)
 ****************************************************************************************************************************************/
 void SysTick_Start(void)
 {
-    SYSTICK_CTRL_REG |= 0x01;               /* Set the ENABLE bit */
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) | 0x01); /* Set the ENABLE bit */
 }
 
 /***************************************************************************************************************************************
@@ -139,8 +403,22 @@ void SysTick_Start(void)
  ****************************************************************************************************************************************/
 void SysTick_DeInit(void)
 {
-    SYSTICK_CTRL_REG = 0;                   /* Disable the SysTick Timer by Clear the ENABLE Bit */
-    SYSTICK_RELOAD_REG = 0;                 /* Clear the reload value */
-    SYSTICK_CURRENT_REG = 0;                /* Clear the Current Register value */
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);        /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    HW_WRITE32(SYSTICK_RELOAD_REG, 0);      /* Clear the reload value */
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);     /* Clear the Current Register value */
 }
 
+/***************************************************************************************************************************************
+ * Service Name: SysTick_GetTickCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of SysTick interrupts since reset (wraps around)
+ * Description: Function to read the SysTick tick counter, elapsed time is (now - start) which stays correct across the wrap around.
+****************************************************************************************************************************************/
+uint32 SysTick_GetTickCount(void)
+{
+    return g_SysTickCount;
+}
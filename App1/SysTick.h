@@ -14,10 +14,38 @@
  *******************************************************************************/
 #include "std_types.h"
 
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Clock of the SysTick counter (CLK_SRC bit of the control register) */
+#define SYSTICK_CLOCK_SYSTEM                 0            /* System clock, the reload follows its changes (default) */
+#define SYSTICK_CLOCK_PIOSC_DIV4             1            /* PIOSC / 4, independent of the system clock and the PLL */
+
+#define SYSTICK_PIOSC_DIV4_HZ                4000000UL
+
+/* Largest trim of the counter clock, 5 % covers the untrimmed PIOSC */
+#define SYSTICK_TRIM_MAX_PPB                 50000000L
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 SysTick_ClockSourceType;  /* SYSTICK_CLOCK_xxx */
+
 /*******************************************************************************
  *                            Functions Prototypes                             *
  *******************************************************************************/
-void SysTick_Init(uint16 a_TimeInMilliSeconds);
+boolean SysTick_SetClockSource(SysTick_ClockSourceType a_Source);
+
+SysTick_ClockSourceType SysTick_GetClockSource(void);
+
+boolean SysTick_SetTrim(sint32 a_PartsPerBillion);
+
+uint32 SysTick_GetCounterFrequency(void);
+
+uint32 SysTick_GetPeriodCycles(void);
+
+boolean SysTick_Init(uint16 a_TimeInMilliSeconds);
 
 void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds);
 
@@ -31,6 +59,8 @@ void SysTick_Start(void);
 
 void SysTick_DeInit(void);
 
+uint32 SysTick_GetTickCount(void);
+
 /*******************************************************************************
  *                                 End of File                                 *
  *******************************************************************************/
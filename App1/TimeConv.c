@@ -0,0 +1,99 @@
+/**************************************************************************************************************************************
+ Module      : TimeConv
+ Name        : TimeConv.c
+ Author      : Salma Hamdy
+ Description : Source file for the division-free conversions between core cycles, SysTick counts, microseconds and nanoseconds
+
+ A time conversion is a multiplication by a ratio of frequencies, and done directly it needs a 64-bit division, a library call of
+ tens to hundreds of cycles on the Cortex M4. Each ratio is instead stored as an integer part and a 32-bit fraction rounded up,
+ computed once here with divisions, so the conversions in TimeConv.h are two UMULL and an addition. The scales follow the system
+ clock through a listener and the SysTick counter clock (system clock or PIOSC / 4) is read again at each change.
+ ***************************************************************************************************************************************/
+
+#include "SysTick.h"
+#include "Clock.h"
+#include "TimeConv.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Scales of the 16 MHz PIOSC clocking the core and the SysTick counter at reset */
+TimeConv_ScaleType g_TimeConv_CyclesToNs = { 62, 0x80000000UL };
+TimeConv_ScaleType g_TimeConv_CyclesToUs = { 0, 0x10000000UL };
+TimeConv_ScaleType g_TimeConv_NsToCycles = { 0, 0x04189375UL };
+TimeConv_ScaleType g_TimeConv_UsToCycles = { 16, 0 };
+TimeConv_ScaleType g_TimeConv_CountsToNs = { 62, 0x80000000UL };
+TimeConv_ScaleType g_TimeConv_UsToCounts = { 16, 0 };
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Compute every scale from the running system clock and SysTick counter clock */
+static void TimeConv_Update(void)
+{
+    uint32 core_hz    = Clock_GetFrequency();
+    uint32 counter_hz = SysTick_GetCounterFrequency();
+
+    TimeConv_ComputeScale(TIMECONV_NS_PER_S, core_hz, &g_TimeConv_CyclesToNs);
+    TimeConv_ComputeScale(TIMECONV_US_PER_S, core_hz, &g_TimeConv_CyclesToUs);
+    TimeConv_ComputeScale(core_hz, TIMECONV_NS_PER_S, &g_TimeConv_NsToCycles);
+    TimeConv_ComputeScale(core_hz, TIMECONV_US_PER_S, &g_TimeConv_UsToCycles);
+    TimeConv_ComputeScale(TIMECONV_NS_PER_S, counter_hz, &g_TimeConv_CountsToNs);
+    TimeConv_ComputeScale(counter_hz, TIMECONV_US_PER_S, &g_TimeConv_UsToCounts);
+}
+
+/* Clock change listener, the counter clock follows the system clock unless it is PIOSC / 4 */
+static void TimeConv_ClockChanged(uint32 a_OldFrequencyHz, uint32 a_NewFrequencyHz)
+{
+    (void)a_OldFrequencyHz;
+    (void)a_NewFrequencyHz;
+    TimeConv_Update();
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: TimeConv_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the scales follow the system clock changes, FALSE if the Clock listener table is full
+ * Description: Function to compute the scales of the running clocks and keep them up to date across system clock changes.
+ *              It must be called again after a SysTick_Init with another clock source. A value measured across a clock
+ *              change is converted at the new clock.
+****************************************************************************************************************************************/
+boolean TimeConv_Init(void)
+{
+    TimeConv_Update();
+    return Clock_AddListener(TimeConv_ClockChanged);
+}
+
+/***************************************************************************************************************************************
+ * Service Name: TimeConv_ComputeScale
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Numerator - Numerator of the ratio
+ *                  a_Denominator - Denominator of the ratio, not 0
+ * Parameters (inout): None
+ * Parameters (out): a_Scale - Integer part of the ratio and its fraction in units of 2^-32, rounded up
+ * Return value: None
+ * Description: Function to turn a ratio into a scale for TimeConv_Apply. It divides, so it belongs to the initialization
+ *              and the clock change path, not to the conversions.
+****************************************************************************************************************************************/
+void TimeConv_ComputeScale(uint32 a_Numerator, uint32 a_Denominator, TimeConv_ScaleType *a_Scale)
+{
+    uint64 remainder = a_Numerator % a_Denominator;
+
+    a_Scale->Integer  = a_Numerator / a_Denominator;
+    a_Scale->Fraction = (uint32)(((remainder << TIMECONV_FRACTION_BITS) + a_Denominator - 1) / a_Denominator);
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
@@ -0,0 +1,113 @@
+/***********************************************************************************************************************************
+ Module      : TimeConv
+ Name        : TimeConv.h
+ Author      : Salma Hamdy
+ Description : Header file for the division-free conversions between core cycles, SysTick counts, microseconds and nanoseconds
+ ************************************************************************************************************************************/
+
+#ifndef TIMECONV_H_
+#define TIMECONV_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define TIMECONV_NS_PER_S                    1000000000UL
+#define TIMECONV_US_PER_S                    1000000UL
+
+/* Bits of the fractional part of a scale */
+#define TIMECONV_FRACTION_BITS               32
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Ratio Integer + Fraction / 2^32, the fraction rounded up so a conversion never returns less than the exact result */
+typedef struct
+{
+    uint32 Integer;
+    uint32 Fraction;
+}TimeConv_ScaleType;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+
+/* Scales of the running clocks, rewritten by TimeConv_Init and on every clock change */
+extern TimeConv_ScaleType g_TimeConv_CyclesToNs;
+extern TimeConv_ScaleType g_TimeConv_CyclesToUs;
+extern TimeConv_ScaleType g_TimeConv_NsToCycles;
+extern TimeConv_ScaleType g_TimeConv_UsToCycles;
+extern TimeConv_ScaleType g_TimeConv_CountsToNs;
+extern TimeConv_ScaleType g_TimeConv_UsToCounts;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+boolean TimeConv_Init(void);
+
+void TimeConv_ComputeScale(uint32 a_Numerator, uint32 a_Denominator, TimeConv_ScaleType *a_Scale);
+
+/*******************************************************************************
+ *                         Inline Functions Definitions                        *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: TimeConv_Apply
+ * Reentrancy: Reentrant
+ * Description: Function to multiply a value by a scale with two 32 x 32 -> 64-bit multiplications (UMULL) and no division.
+ *              With r the exact ratio, the result is floor(value * r) or floor(value * r) + 1 for every 32-bit value: the
+ *              rounded-up fraction is less than 2^-32 above the exact one, so it adds less than one to the product. The
+ *              result is exact when r is a multiple of 2^-32, as the cycles to nanoseconds ratio of every 16, 25, 40, 50 and
+ *              80 MHz clock and the counts to nanoseconds ratio of PIOSC / 4.
+****************************************************************************************************************************************/
+static inline uint64 TimeConv_Apply(const TimeConv_ScaleType *a_Scale, uint32 a_Value)
+{
+    return ((uint64)a_Value * a_Scale->Integer) + (((uint64)a_Value * a_Scale->Fraction) >> TIMECONV_FRACTION_BITS);
+}
+
+/* Core clock cycles (DWT counter) to nanoseconds, 2^32 cycles are at most 4295 s at 1 MHz so the result needs 64 bits */
+static inline uint64 TimeConv_CyclesToNs(uint32 a_Cycles)
+{
+    return TimeConv_Apply(&g_TimeConv_CyclesToNs, a_Cycles);
+}
+
+/* Core clock cycles to microseconds */
+static inline uint32 TimeConv_CyclesToUs(uint32 a_Cycles)
+{
+    return (uint32)TimeConv_Apply(&g_TimeConv_CyclesToUs, a_Cycles);
+}
+
+/* Nanoseconds to core clock cycles */
+static inline uint32 TimeConv_NsToCycles(uint32 a_Ns)
+{
+    return (uint32)TimeConv_Apply(&g_TimeConv_NsToCycles, a_Ns);
+}
+
+/* Microseconds to core clock cycles, above 53 s at 80 MHz the result needs 64 bits */
+static inline uint64 TimeConv_UsToCycles(uint32 a_Us)
+{
+    return TimeConv_Apply(&g_TimeConv_UsToCycles, a_Us);
+}
+
+/* SysTick counter clocks (RELOAD - CURRENT differences) to nanoseconds */
+static inline uint64 TimeConv_CountsToNs(uint32 a_Counts)
+{
+    return TimeConv_Apply(&g_TimeConv_CountsToNs, a_Counts);
+}
+
+/* Microseconds to SysTick counter clocks */
+static inline uint64 TimeConv_UsToCounts(uint32 a_Us)
+{
+    return TimeConv_Apply(&g_TimeConv_UsToCounts, a_Us);
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* TIMECONV_H_ */
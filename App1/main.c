@@ -1,11 +1,28 @@
 #include "SysTick.h"
 #include "NVIC.h"
+#include "Sched.h"
+#include "Idle.h"
+#include "CpuLoad.h"
+#include "Log.h"
+#include "Mpu.h"
+#include "Stack.h"
+#include "Fpu.h"
+#ifdef ISR_TIMING
+#include "IsrTiming.h"
+#endif
+#ifdef GOVERNOR
+#include "Governor.h"
+#endif
 #include "tm4c123gh6pm_registers.h"
 
 #define GPIO_PORTF_IRQ_NUM                30
 #define GPIO_PORTF_INTERRUPT_PRIORITY     2
 #define SYSTICK_INTERRUPT_PRIORITY        1
 
+#define SCHED_TICK_MS                     10
+#define LEDS_TASK_PRIORITY                0
+#define LEDS_TASK_PERIOD_TICKS            (1000 / SCHED_TICK_MS)
+
 #define NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND 364
 
 /* Global variable to count time in seconds */
@@ -20,11 +37,26 @@ void Delay_MS(unsigned long long n)
 /* GPIO PORTF External Interrupt - ISR */
 void GPIOPortF_Handler(void)
 {
+    CpuLoad_IsrEnter();
+    LOG_EVENT1(LOG_SW2_PRESSED, SysTick_GetTickCount());
     SysTick_Stop();
     GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x0E; /* Turn on the Red, Blue and Green LEDs */
     Delay_MS(5000);
     SysTick_Start();
     GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
+    CpuLoad_IsrExit();
+}
+
+/* SysTick call back: scheduler tick and CPU load accounting, its own time is accounted as ISR load */
+void SysTick_TickTask(void)
+{
+    CpuLoad_IsrEnter();
+    Sched_Tick();
+    CpuLoad_Tick();
+#ifdef GOVERNOR
+    Governor_Tick();
+#endif
+    CpuLoad_IsrExit();
 }
 
 /* Enable PF0 (SW2) and activate external interrupt with falling edge */
@@ -60,8 +92,14 @@ void Leds_Init(void)
     GPIO_PORTF_DATA_REG  &= 0xF1;         /* Clear bit 0, 1 and 2 in Data register to turn off the leds */
 }
 
-void SysTick_CallBackFunc(void)
+/* Periodic scheduler task to rotate the LEDs every 1 second */
+void Leds_RotateTask(void)
 {
+    CpuLoad_ReportType load;
+
+    CpuLoad_GetReport(&load);
+    LOG_EVENT3(LOG_CPU_LOAD, load.Load1s.Isr, load.Load1s.Thread, load.Load1s.Idle);
+
     g_Counter++;
 
     switch(g_Counter)
@@ -81,20 +119,56 @@ void SysTick_CallBackFunc(void)
 
 int main(void)
 {
+    /* Fill the free main stack with a pattern, Stack_GetMainUsage finds the deepest use by main and the nested handlers */
+    Stack_PaintMain();
+
+    /* Guard the bottom of the main stack, an overflow raises a MemManage fault instead of corrupting the memory below */
+    Mpu_Init();
+
+    /* FP context stacking of the build (lazy by default), the integer-only handlers keep the minimal entry and exit time */
+    Fpu_Init();
+
     /* Enable clock for PORTF and wait for clock to start */
     SYSCTL_RCGCGPIO_REG |= 0x20;
     while(!(SYSCTL_PRGPIO_REG & 0x20));
 
+    /* Start the binary trace log, the records are read back with the debugger and decoded by Tools/log_decode.py */
+    Log_Init();
+    LOG_EVENT1(LOG_BOOT, LOG_BUFFER_WORDS);
+
     /* Initialize the SW2(PF0) as GPIO Pin and activate external interrupt with falling edge */
     SW2_Init();
 
     /* Initialize the LEDs as GPIO Pins */
     Leds_Init();
 
-    /* Start SysTick Timer to generate interrupt every 1 second */
-    SysTick_Init(1000);
+    /* Register the LEDs task in the scheduler, it is released by the SysTick tick and executed from the main loop */
+    Sched_Init();
+    Sched_AddTask(LEDS_TASK_PRIORITY, Leds_RotateTask, LEDS_TASK_PERIOD_TICKS, 0);
+
+#ifdef GOVERNOR
+    /* Clock the tick from PIOSC / 4, its period does not depend on the operating point chosen by the governor */
+    SysTick_SetClockSource(SYSTICK_CLOCK_PIOSC_DIV4);
+#endif
+
+    /* Start SysTick Timer to generate the scheduler tick every 10 milliseconds */
+    SysTick_Init(SCHED_TICK_MS);
     NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE,SYSTICK_INTERRUPT_PRIORITY);
-    SysTick_SetCallBack(SysTick_CallBackFunc);
+    SysTick_SetCallBack(SysTick_TickTask);
+    Idle_Init();
+
+    /* Publish the ISR / thread / idle split of the CPU time every second */
+    CpuLoad_Init(1000 / SCHED_TICK_MS);
+
+#ifdef GOVERNOR
+    /* Start at 80 MHz and follow the measured busy time down the PLL operating points */
+    Governor_Init();
+#endif
+
+#ifdef ISR_TIMING
+    /* Per-vector counts, total and maximum cycles of every handler entered through the instrumented vector table */
+    IsrTiming_Init();
+#endif
 
     /* Enable Interrupts, Exceptions and Faults */
     Enable_Exceptions();
@@ -102,6 +176,6 @@ int main(void)
 
     while(1)
     {
-
+        Sched_Dispatch();   /* Run the ready tasks, sleep until the next interrupt otherwise */
     }
 }
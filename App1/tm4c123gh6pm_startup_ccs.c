@@ -35,6 +35,12 @@ static void FaultISR(void);
 static void IntDefaultHandler(void);
 extern void GPIOPortF_Handler(void);
 extern void SysTick_Handler(void);
+extern void PendSV_Handler(void);
+extern void Spurious_Handler(void);
+extern void RamFunc_CopyIn(void);
+#ifdef TM4C_SIM
+#pragma weak PendSV_Handler                 // Assembly, not in the host build
+#endif
 
 //*****************************************************************************
 //
@@ -46,10 +52,16 @@ extern void _c_int00(void);
 
 //*****************************************************************************
 //
-// Linker variable that marks the top of the stack.
+// Linker variable that marks the top of the stack.  The host simulation build
+// (TM4C_SIM) has no linker command file, the vector table only gets linked in
+// so that the simulator dispatches the exceptions through it.
 //
 //*****************************************************************************
+#ifdef TM4C_SIM
+uint32_t __STACK_TOP;
+#else
 extern uint32_t __STACK_TOP;
+#endif
 
 //*****************************************************************************
 //
@@ -64,11 +76,18 @@ extern uint32_t __STACK_TOP;
 // ensure that it ends up at physical address 0x0000.0000 or at the start of
 // the program if located at a start address other than 0.
 //
+// The ISR_TIMING build uses the instrumented copy of this table generated by
+// Tools/isr_timing_gen.py, where every handler is entered through a timing
+// trampoline.  Regenerate it whenever a handler is added below.
+//
 //*****************************************************************************
+#ifdef ISR_TIMING
+#include "IsrTiming_Vectors.h"
+#else
 #pragma DATA_SECTION(g_pfnVectors, ".intvecs")
 void (* const g_pfnVectors[])(void) =
 {
-    (void (*)(void))((uint32_t)&__STACK_TOP),
+    (void (*)(void))((uintptr_t)&__STACK_TOP),
                                             // The initial stack pointer
     ResetISR,                               // The reset handler
     NmiSR,                                  // The NMI handler
@@ -83,7 +102,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // SVCall handler
     IntDefaultHandler,                      // Debug monitor handler
     0,                                      // Reserved
-    IntDefaultHandler,                      // The PendSV handler
+    PendSV_Handler,                         // The PendSV handler
     SysTick_Handler,                      // The SysTick handler
     IntDefaultHandler,                      // GPIO Port A
     IntDefaultHandler,                      // GPIO Port B
@@ -225,6 +244,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // PWM 1 Generator 3
     IntDefaultHandler                       // PWM 1 Fault
 };
+#endif
 
 //*****************************************************************************
 //
@@ -239,30 +259,35 @@ void (* const g_pfnVectors[])(void) =
 void
 ResetISR(void)
 {
+#ifndef TM4C_SIM
+    //
+    // Copy the functions linked to run from SRAM (RamFunc.cmd) before any
+    // code or interrupt can call them.
+    //
+    RamFunc_CopyIn();
+
     //
     // Jump to the CCS C initialization routine.  This will enable the
     // floating-point unit as well, so that does not need to be done here.
     //
     __asm("    .global _c_int00\n"
           "    b.w     _c_int00");
+#endif
 }
 
 //*****************************************************************************
 //
-// This is the code that gets called when the processor receives a NMI.  This
-// simply enters an infinite loop, preserving the system state for examination
-// by a debugger.
+// This is the code that gets called when the processor receives a NMI.  The
+// NMI is counted by the Spurious module and the handler returns.
 //
 //*****************************************************************************
 static void
 NmiSR(void)
 {
     //
-    // Enter an infinite loop.
+    // Account the NMI and return.
     //
-    while(1)
-    {
-    }
+    Spurious_Handler();
 }
 
 //*****************************************************************************
@@ -286,17 +311,15 @@ FaultISR(void)
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  The vector is counted by the Spurious module and the handler
+// returns, an unexpected IRQ is disabled in the NVIC so it cannot fire again.
 //
 //*****************************************************************************
 static void
 IntDefaultHandler(void)
 {
     //
-    // Go into an infinite loop.
+    // Account the vector and return.
     //
-    while(1)
-    {
-    }
+    Spurious_Handler();
 }
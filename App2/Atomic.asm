@@ -0,0 +1,83 @@
+;***********************************************************************************************************************************
+; Module      : Atomic
+; Name        : Atomic.asm
+; Author      : Salma Hamdy
+; Description : Lock-free atomic operations for the ARM Cortex M4 using LDREX/STREX (TI ARM assembler syntax)
+;***********************************************************************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global Atomic_FetchAdd
+        .global Atomic_FetchOr
+        .global Atomic_FetchAnd
+        .global Atomic_CompareExchange
+
+;***********************************************************************************************************************************
+; uint32 Atomic_FetchAdd(volatile uint32 *a_Address, uint32 a_Value)
+; Adds a_Value to *a_Address and returns the previous value, STREX fails and the add is retried if an exception or another
+; exclusive access happened since the LDREX.
+;***********************************************************************************************************************************
+Atomic_FetchAdd: .asmfunc
+AtomicFetchAddRetry:
+        LDREX   R2, [R0]
+        ADDS    R3, R2, R1
+        STREX   R12, R3, [R0]
+        CMP     R12, #0
+        BNE     AtomicFetchAddRetry
+        MOV     R0, R2
+        BX      LR
+        .endasmfunc
+
+;***********************************************************************************************************************************
+; uint32 Atomic_FetchOr(volatile uint32 *a_Address, uint32 a_Mask)
+; Sets the a_Mask bits in *a_Address and returns the previous value.
+;***********************************************************************************************************************************
+Atomic_FetchOr: .asmfunc
+AtomicFetchOrRetry:
+        LDREX   R2, [R0]
+        ORR     R3, R2, R1
+        STREX   R12, R3, [R0]
+        CMP     R12, #0
+        BNE     AtomicFetchOrRetry
+        MOV     R0, R2
+        BX      LR
+        .endasmfunc
+
+;***********************************************************************************************************************************
+; uint32 Atomic_FetchAnd(volatile uint32 *a_Address, uint32 a_Mask)
+; Keeps only the a_Mask bits in *a_Address and returns the previous value.
+;***********************************************************************************************************************************
+Atomic_FetchAnd: .asmfunc
+AtomicFetchAndRetry:
+        LDREX   R2, [R0]
+        AND     R3, R2, R1
+        STREX   R12, R3, [R0]
+        CMP     R12, #0
+        BNE     AtomicFetchAndRetry
+        MOV     R0, R2
+        BX      LR
+        .endasmfunc
+
+;***********************************************************************************************************************************
+; boolean Atomic_CompareExchange(volatile uint32 *a_Address, uint32 a_Expected, uint32 a_Desired)
+; Stores a_Desired in *a_Address only if it still holds a_Expected, returns TRUE if the store happened.
+;***********************************************************************************************************************************
+Atomic_CompareExchange: .asmfunc
+AtomicCompareExchangeRetry:
+        LDREX   R3, [R0]
+        CMP     R3, R1
+        BNE     AtomicCompareExchangeFail
+        STREX   R12, R2, [R0]
+        CMP     R12, #0
+        BNE     AtomicCompareExchangeRetry
+        MOVS    R0, #1
+        BX      LR
+AtomicCompareExchangeFail:
+        CLREX
+        MOVS    R0, #0
+        BX      LR
+        .endasmfunc
+
+        .end
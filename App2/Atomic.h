@@ -0,0 +1,74 @@
+/***********************************************************************************************************************************
+ Module      : Atomic
+ Name        : Atomic.h
+ Author      : Salma Hamdy
+ Description : Header file for the lock-free atomic operations built on the ARM Cortex M4 exclusive load/store (LDREX/STREX)
+ ************************************************************************************************************************************/
+
+#ifndef ATOMIC_H_
+#define ATOMIC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+#if defined(__TI_ARM__)
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Data Memory Barrier ... This Macro makes all the memory accesses before it complete before any memory access after it. */
+#define Data_Memory_Barrier()    __asm(" DMB ")
+
+/*******************************************************************************
+ *                 Functions Prototypes (implemented in Atomic.asm)            *
+ *******************************************************************************/
+
+/* The exclusive monitor is cleared on every exception entry and return, so an operation preempted by an ISR at any
+ * priority retries instead of overwriting the ISR update. No interrupt masking is needed. */
+uint32 Atomic_FetchAdd(volatile uint32 *a_Address, uint32 a_Value);
+
+uint32 Atomic_FetchOr(volatile uint32 *a_Address, uint32 a_Mask);
+
+uint32 Atomic_FetchAnd(volatile uint32 *a_Address, uint32 a_Mask);
+
+boolean Atomic_CompareExchange(volatile uint32 *a_Address, uint32 a_Expected, uint32 a_Desired);
+
+#else
+
+/*******************************************************************************
+ *                   C11 Atomics Fallback for the Host Builds                  *
+ *******************************************************************************/
+#include <stdatomic.h>
+
+#define Data_Memory_Barrier()    atomic_thread_fence(memory_order_seq_cst)
+
+static inline uint32 Atomic_FetchAdd(volatile uint32 *a_Address, uint32 a_Value)
+{
+    return atomic_fetch_add((volatile _Atomic uint32 *)a_Address, a_Value);
+}
+
+static inline uint32 Atomic_FetchOr(volatile uint32 *a_Address, uint32 a_Mask)
+{
+    return atomic_fetch_or((volatile _Atomic uint32 *)a_Address, a_Mask);
+}
+
+static inline uint32 Atomic_FetchAnd(volatile uint32 *a_Address, uint32 a_Mask)
+{
+    return atomic_fetch_and((volatile _Atomic uint32 *)a_Address, a_Mask);
+}
+
+static inline boolean Atomic_CompareExchange(volatile uint32 *a_Address, uint32 a_Expected, uint32 a_Desired)
+{
+    return atomic_compare_exchange_strong((volatile _Atomic uint32 *)a_Address, &a_Expected, a_Desired) ? TRUE : FALSE;
+}
+
+#endif /* __TI_ARM__ */
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* ATOMIC_H_ */
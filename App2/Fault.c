@@ -0,0 +1,209 @@
+/**************************************************************************************************************************************
+ Module      : Fault
+ Name        : Fault.c
+ Author      : Salma Hamdy
+ Description : Source file for the fault capture saving a crash record that survives the reset for post-mortem analysis
+
+ The HardFault, MemManage, BusFault and UsageFault vectors of the startup file point to Fault_Handler (Fault_Handler.asm), which
+ passes the stacked frame to Fault_Capture. The frame, the fault status and address registers go into g_Fault_Record, a NOINIT
+ variable the C start-up code does not clear, then the device is reset. Nothing runs on the normal path: Fault_Init only checks
+ the record of the previous run once at boot. The record is read with the debugger or Fault_GetRecord and decoded by
+ Tools/fault_decode.py.
+ ***************************************************************************************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "Fault.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#ifdef TM4C_SIM
+#define Fault_DataSyncBarrier()
+#else
+#define Fault_DataSyncBarrier()              __asm(" DSB ")
+#endif
+
+#define FAULT_RECORD_WORDS                   (sizeof(Fault_RecordType) / sizeof(uint32))
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Not initialized by the C start-up code (.TI.noinit), the content of the previous run is still there after a reset */
+#ifndef TM4C_SIM
+#pragma NOINIT(g_Fault_Record)
+#endif
+Fault_RecordType g_Fault_Record;
+
+/* Stack of Fault_Capture, switched to by Fault_Handler */
+#ifndef TM4C_SIM
+#pragma DATA_ALIGN(g_Fault_Stack, 8)
+#endif
+uint32 g_Fault_Stack[FAULT_STACK_WORDS];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Sum of all the words of the record, zero for a record with a correct checksum */
+static uint32 Fault_Sum(const Fault_RecordType *a_Record)
+{
+    const uint32 *word = (const uint32 *)a_Record;
+    uint32 sum = 0;
+    uint8 index;
+
+    for (index = 0; index < FAULT_RECORD_WORDS; index++)
+    {
+        sum += word[index];
+    }
+    return sum;
+}
+
+static boolean Fault_IsValid(const Fault_RecordType *a_Record)
+{
+    return ((a_Record->Magic == FAULT_RECORD_MAGIC) && (a_Record->Version == FAULT_RECORD_VERSION) &&
+            (Fault_Sum(a_Record) == 0)) ? TRUE : FALSE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fault_Capture
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Frame - Exception frame stacked by the hardware for the faulting context
+ *                  a_ExcReturn - EXC_RETURN value of the fault handler
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to save the crash record and reset the device, called from Fault_Handler only. The frame is not read
+ *              when the stacking itself faulted (stack overflow), the record then keeps the status registers only.
+****************************************************************************************************************************************/
+void Fault_Capture(const uint32 *a_Frame, uint32 a_ExcReturn)
+{
+    Fault_RecordType *record = &g_Fault_Record;
+    uint32 count = Fault_IsValid(record) ? (record->Count + 1) : 1;
+    uint32 cfsr = HW_READ32(NVIC_SYSTEM_FAULTSTAT);
+    uint32 frame_size;
+
+    record->Magic     = FAULT_RECORD_MAGIC;
+    record->Version   = FAULT_RECORD_VERSION;
+    record->Count     = count;
+    record->Vector    = HW_READ32(NVIC_SYSTEM_INTCTRL) & INTCTRL_VECTACTIVE_MASK;
+    record->ExcReturn = a_ExcReturn;
+    record->Flags     = (a_ExcReturn & FAULT_EXC_RETURN_PSP_MASK) ? FAULT_FLAG_PSP : 0;
+    frame_size        = FAULT_BASIC_FRAME_SIZE;
+    if (!(a_ExcReturn & FAULT_EXC_RETURN_BASIC_FRAME_MASK))
+    {
+        record->Flags |= FAULT_FLAG_FP_FRAME;
+        frame_size     = FAULT_EXTENDED_FRAME_SIZE;
+    }
+
+    if (cfsr & (FAULT_CFSR_MSTKERR_MASK | FAULT_CFSR_STKERR_MASK))
+    {
+        record->Flags |= FAULT_FLAG_NO_FRAME;
+        record->StackPointer = (uint32)(uintptr_t)a_Frame;
+        record->R0 = record->R1 = record->R2 = record->R3 = 0;
+        record->R12 = record->LR = record->PC = record->xPSR = 0;
+    }
+    else
+    {
+        record->R0   = a_Frame[0];
+        record->R1   = a_Frame[1];
+        record->R2   = a_Frame[2];
+        record->R3   = a_Frame[3];
+        record->R12  = a_Frame[4];
+        record->LR   = a_Frame[5];
+        record->PC   = a_Frame[6];
+        record->xPSR = a_Frame[7];
+        record->StackPointer = (uint32)(uintptr_t)a_Frame + frame_size + ((record->xPSR & FAULT_XPSR_STACK_ALIGN_MASK) ? 4 : 0);
+    }
+
+    record->CFSR  = cfsr;
+    record->HFSR  = HW_READ32(NVIC_SYSTEM_HFAULTSTAT);
+    record->MMFAR = HW_READ32(NVIC_SYSTEM_MMADDR);
+    record->BFAR  = HW_READ32(NVIC_SYSTEM_FAULTADDR);
+    record->Checksum = 0;
+    record->Checksum = 0 - Fault_Sum(record);
+
+    /* The record stores complete before the reset request */
+    Fault_DataSyncBarrier();
+    HW_WRITE32(NVIC_SYSTEM_APINT, APINT_VECTKEY | APINT_SYSRESETREQ_MASK);
+    Fault_DataSyncBarrier();
+
+    while(1)
+    {
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fault_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if a crash record of a previous run is available, FALSE otherwise
+ * Description: Function to enable the MemManage, BusFault and UsageFault handlers and the division by zero trap so every fault
+ *              reaches Fault_Handler with its own status, and to check the record left by the previous run. An invalid record
+ *              (power-on garbage) is cleared.
+****************************************************************************************************************************************/
+boolean Fault_Init(void)
+{
+    NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE);
+    NVIC_EnableException(EXCEPTION_BUS_FAULT_TYPE);
+    NVIC_EnableException(EXCEPTION_USAGE_FAULT_TYPE);
+    HW_WRITE32(NVIC_SYSTEM_CFGCTRL, HW_READ32(NVIC_SYSTEM_CFGCTRL) | CFGCTRL_DIV0_MASK);
+
+    if (!Fault_IsValid(&g_Fault_Record))
+    {
+        Fault_ClearRecord();
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fault_GetRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Record - Copy of the crash record
+ * Return value: boolean - TRUE if the record is valid, FALSE if no fault was captured
+ * Description: Function to read the crash record of the last fault, e.g. to send it to a host after the reboot.
+****************************************************************************************************************************************/
+boolean Fault_GetRecord(Fault_RecordType *a_Record)
+{
+    if (!Fault_IsValid(&g_Fault_Record))
+    {
+        return FALSE;
+    }
+    *a_Record = g_Fault_Record;
+    return TRUE;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Fault_ClearRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to discard the crash record once it has been reported, the fault count restarts from zero.
+****************************************************************************************************************************************/
+void Fault_ClearRecord(void)
+{
+    uint32 *word = (uint32 *)&g_Fault_Record;
+    uint8 index;
+
+    for (index = 0; index < FAULT_RECORD_WORDS; index++)
+    {
+        word[index] = 0;
+    }
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
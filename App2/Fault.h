@@ -0,0 +1,108 @@
+/***********************************************************************************************************************************
+ Module      : Fault
+ Name        : Fault.h
+ Author      : Salma Hamdy
+ Description : Header file for the fault capture saving a crash record that survives the reset for post-mortem analysis
+ ************************************************************************************************************************************/
+
+#ifndef FAULT_H_
+#define FAULT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define FAULT_RECORD_MAGIC                   0x544C4146   /* "FALT" */
+#define FAULT_RECORD_VERSION                 1
+
+/* EXC_RETURN bits of the interrupted context */
+#define FAULT_EXC_RETURN_PSP_MASK            0x00000004   /* The frame was stacked on the process stack */
+#define FAULT_EXC_RETURN_BASIC_FRAME_MASK    0x00000010   /* Clear when the frame includes the FPU registers */
+
+/* Configurable Fault Status register bits telling that the stacking itself failed, the frame cannot be read */
+#define FAULT_CFSR_MSTKERR_MASK              0x00000010
+#define FAULT_CFSR_STKERR_MASK               0x00001000
+
+/* xPSR bit 9: one padding word was added to align the frame on 8 bytes */
+#define FAULT_XPSR_STACK_ALIGN_MASK          0x00000200
+
+/* Flags of the crash record */
+#define FAULT_FLAG_PSP                       0x00000001
+#define FAULT_FLAG_FP_FRAME                  0x00000002
+#define FAULT_FLAG_NO_FRAME                  0x00000004
+
+/* Frame sizes in bytes, basic (R0-R3, R12, LR, PC, xPSR) and extended (plus S0-S15, FPSCR and a reserved word) */
+#define FAULT_BASIC_FRAME_SIZE               32
+#define FAULT_EXTENDED_FRAME_SIZE            104
+
+/* Active exception number field of the Interrupt Control and State register, same value as IPSR */
+#define INTCTRL_VECTACTIVE_MASK              0x000001FF
+
+/* Capture stack used by Fault_Capture, its size in bytes is also written in Fault_Handler.asm */
+#define FAULT_STACK_WORDS                    64
+
+/* Application Interrupt and Reset Control register: write key and system reset request */
+#define APINT_VECTKEY                        0x05FA0000
+#define APINT_SYSRESETREQ_MASK               0x00000004
+
+/* Configuration and Control register: trap on division by zero */
+#define CFGCTRL_DIV0_MASK                    0x00000010
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Crash record, the layout is decoded by Tools/fault_decode.py. All the words including Checksum sum to zero. */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 Count;             /* Faults captured since power-on, the record is kept across the resets */
+    uint32 Vector;            /* Exception number of the fault handler (3 HardFault, 4 MemManage, 5 BusFault, 6 UsageFault) */
+    uint32 ExcReturn;
+    uint32 Flags;             /* FAULT_FLAG_xxx */
+    uint32 StackPointer;      /* SP of the interrupted context before the stacking */
+    uint32 R0;
+    uint32 R1;
+    uint32 R2;
+    uint32 R3;
+    uint32 R12;
+    uint32 LR;
+    uint32 PC;                /* Faulting instruction (precise faults) or next instruction */
+    uint32 xPSR;
+    uint32 CFSR;
+    uint32 HFSR;
+    uint32 MMFAR;
+    uint32 BFAR;
+    uint32 Checksum;
+}Fault_RecordType;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+extern Fault_RecordType g_Fault_Record;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Fault vectors of the startup file (Fault_Handler.asm), they never return */
+void Fault_Handler(void);
+
+void Fault_Capture(const uint32 *a_Frame, uint32 a_ExcReturn);
+
+boolean Fault_Init(void);
+
+boolean Fault_GetRecord(Fault_RecordType *a_Record);
+
+void Fault_ClearRecord(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* FAULT_H_ */
@@ -0,0 +1,37 @@
+;***********************************************************************************************************************************
+; Module      : Fault
+; Name        : Fault_Handler.asm
+; Author      : Salma Hamdy
+; Description : Fault vector entry of the fault capture for the ARM Cortex M4F (TI ARM assembler syntax)
+;***********************************************************************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global Fault_Handler
+        .ref    Fault_Capture
+        .ref    g_Fault_Stack
+
+; Top of the capture stack, FAULT_STACK_WORDS (Fault.h) words
+FaultStackTop   .field  g_Fault_Stack + 256, 32
+
+;***********************************************************************************************************************************
+; Fault_Handler
+; Entry of the HardFault, MemManage, BusFault and UsageFault vectors. EXC_RETURN in LR tells on which stack the hardware saved
+; the frame of the faulting context, the frame address and EXC_RETURN are passed to Fault_Capture which saves the crash record
+; and resets the device. Nothing is pushed before the frame address is taken, then MSP moves to a dedicated capture stack so
+; the capture neither overwrites the frame nor depends on a main stack that may have overflowed (the handler never returns).
+;***********************************************************************************************************************************
+Fault_Handler: .asmfunc
+        TST     LR, #0x4                ; EXC_RETURN bit 2 = 1 : the frame is on the process stack
+        ITE     EQ
+        MRSEQ   R0, MSP
+        MRSNE   R0, PSP
+        MOV     R1, LR
+        LDR     R2, FaultStackTop
+        MSR     MSP, R2                 ; Capture stack for Fault_Capture
+        B       Fault_Capture           ; Fault_Capture(frame, EXC_RETURN), never returns
+        .endasmfunc
+
+        .end
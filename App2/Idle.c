@@ -0,0 +1,147 @@
+/**************************************************************************************************************************************
+ Module      : Idle
+ Name        : Idle.c
+ Author      : Salma Hamdy
+ Description : Source file for the WFI / sleep-on-exit low-power idle integrated with the SysTick driver
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Idle.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Cumulative sleep time in system clock cycles (main context only) */
+static uint64 g_Idle_SleepCycles = 0;
+
+/* SysTick tick count when the accounting started */
+static uint32 g_Idle_StartTick = 0;
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to restart the sleep / active accounting, the SysTick interrupt must be running.
+****************************************************************************************************************************************/
+void Idle_Init(void)
+{
+    g_Idle_SleepCycles = 0;
+    g_Idle_StartTick   = SysTick_GetTickCount();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_Sleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (main context only)
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep with WFI until the next interrupt. It must be called with the interrupts disabled
+ *              (Disable_Exceptions) right after checking there is no work, so an interrupt between the check and the WFI
+ *              still wakes the processor up. It returns with the interrupts enabled, after the pending ISR is served.
+ *              The sleep time is measured on the SysTick counter, which keeps counting while the core clock is gated;
+ *              at most one SysTick wrap can happen before the wake-up because the wrap itself pends an interrupt.
+****************************************************************************************************************************************/
+void Idle_Sleep(void)
+{
+    uint32 before_current;
+    uint32 after_current;
+    uint32 pending_before;
+
+    before_current = SYSTICK_CURRENT_REG;
+    pending_before = NVIC_SYSTEM_INTCTRL & INTCTRL_PENDSTSET_MASK;
+
+    Wait_For_Interrupt();
+
+    after_current = SYSTICK_CURRENT_REG;
+
+    if (!pending_before && (NVIC_SYSTEM_INTCTRL & INTCTRL_PENDSTSET_MASK))
+    {
+        g_Idle_SleepCycles += before_current + (SYSTICK_RELOAD_REG + 1) - after_current;   /* Woken up by the SysTick wrap */
+    }
+    else if (after_current <= before_current)
+    {
+        g_Idle_SleepCycles += before_current - after_current;
+    }
+
+    Enable_Exceptions();                     /* The pending interrupt is served here */
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_DelayTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (main context only)
+ * Parameters (in): a_Ticks - Delay in SysTick ticks
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to wait for the specified number of SysTick interrupts while sleeping, instead of polling the
+ *              COUNTFLAG bit like SysTick_StartBusyWait. Other interrupts keep being served during the delay.
+****************************************************************************************************************************************/
+void Idle_DelayTicks(uint32 a_Ticks)
+{
+    uint32 start_tick = SysTick_GetTickCount();
+
+    while(1)
+    {
+        Disable_Exceptions();
+
+        if ((SysTick_GetTickCount() - start_tick) >= a_Ticks)
+        {
+            Enable_Exceptions();
+            return;
+        }
+
+        Idle_Sleep();
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_SetSleepOnExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Enable - TRUE to sleep again on every return from an ISR to Thread mode
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to control SLEEPONEXIT, an interrupt-only application sets it and executes WFI once, then it runs
+ *              only in the ISRs and never pays the thread mode exception return and re-entry costs.
+****************************************************************************************************************************************/
+void Idle_SetSleepOnExit(boolean a_Enable)
+{
+    if (a_Enable)
+    {
+        NVIC_SYSTEM_SYSCTRL |= SYSCTRL_SLEEPONEXIT_MASK;
+    }
+    else
+    {
+        NVIC_SYSTEM_SYSCTRL &= ~SYSCTRL_SLEEPONEXIT_MASK;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Idle_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant (main context only)
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Sleep and total cycles since Idle_Init, the active cycles are TotalCycles - SleepCycles
+ * Return value: None
+ * Description: Function to read the sleep accounting, used to measure the duty cycle of the application.
+****************************************************************************************************************************************/
+void Idle_GetStats(Idle_StatsType *a_Stats)
+{
+    if (a_Stats != NULL_PTR)
+    {
+        a_Stats->SleepCycles = g_Idle_SleepCycles;
+        a_Stats->TotalCycles = (uint64)(SysTick_GetTickCount() - g_Idle_StartTick) * (SYSTICK_RELOAD_REG + 1);
+    }
+}
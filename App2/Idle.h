@@ -0,0 +1,48 @@
+/***********************************************************************************************************************************
+ Module      : Idle
+ Name        : Idle.h
+ Author      : Salma Hamdy
+ Description : Header file for the WFI / sleep-on-exit low-power idle integrated with the SysTick driver
+ ************************************************************************************************************************************/
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define SYSCTRL_SLEEPONEXIT_MASK             0x00000002
+#define INTCTRL_PENDSTSET_MASK               0x04000000   /* SysTick exception pending */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint64 SleepCycles;      /* System clock cycles spent sleeping in Idle_Sleep */
+    uint64 TotalCycles;      /* System clock cycles elapsed since Idle_Init (SysTick period resolution) */
+}Idle_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Idle_Init(void);
+
+void Idle_Sleep(void);
+
+void Idle_DelayTicks(uint32 a_Ticks);
+
+void Idle_SetSleepOnExit(boolean a_Enable);
+
+void Idle_GetStats(Idle_StatsType *a_Stats);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* IDLE_H_ */
@@ -42,6 +42,15 @@
 #define BUS_FAULT_ENABLE_MASK                0x00020000
 #define USAGE_FAULT_ENABLE_MASK              0x00040000
 
+#ifdef TM4C_SIM
+/* Host build: the PRIMASK, FAULTMASK and WFI instructions are executed by the peripheral simulator */
+#include "Sim.h"
+#define Enable_Exceptions()    Sim_SetPrimask(0)
+#define Disable_Exceptions()   Sim_SetPrimask(1)
+#define Enable_Faults()        Sim_SetFaultmask(0)
+#define Disable_Faults()       Sim_SetFaultmask(1)
+#define Wait_For_Interrupt()   Sim_WaitForInterrupt()
+#else
 /* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
 #define Enable_Exceptions()    __asm(" CPSIE I ")
 
@@ -54,6 +63,10 @@
 /* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
 #define Disable_Faults()       __asm(" CPSID F ")
 
+/* Wait For Interrupt ... This Macro puts the processor in sleep mode until an interrupt is pending, it wakes up even if the I-bit in the PRIMASK is set. */
+#define Wait_For_Interrupt()   __asm(" WFI ")
+#endif
+
 /*******************************************************************************
  *                           Data Types Declarations                           *
  *******************************************************************************/
@@ -15,6 +15,9 @@
 /* Global variable to hold the address of the call back function in the application */
 static volatile void (*g_SysTickCallBackPtr)(void) = NULL_PTR;
 
+/* Global variable to count the SysTick interrupts, used as the time base of the timeouts */
+static volatile uint32 g_SysTickCount = 0;
+
 /***************************************************************************************************************************************
  * Service Name: SysTick_Init
  * Sync/Async: Synchronous
@@ -27,14 +30,14 @@ static volatile void (*g_SysTickCallBackPtr)(void) = NULL_PTR;
 ****************************************************************************************************************************************/
 void SysTick_Init(uint16 a_TimeInMilliSeconds)
 {
-    SYSTICK_CTRL_REG    = 0;                                      /* Disable the SysTick Timer by Clear the ENABLE Bit */
-    SYSTICK_RELOAD_REG  = (16000 * a_TimeInMilliSeconds) - 1;     /* Set the reload value for 16MHz clock */
-    SYSTICK_CURRENT_REG = 0;                                      /* Clear the Current Register value */
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);                              /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    HW_WRITE32(SYSTICK_RELOAD_REG, (16000 * a_TimeInMilliSeconds) - 1); /* Set the reload value for 16MHz clock */
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);                           /* Clear the Current Register value */
     /* Configure the SysTick Control Register
      * Enable the SysTick Timer (ENABLE = 1)
      * Disable SysTick Interrupt (INTEN = 1)
      * Choose the clock source to be System Clock (CLK_SRC = 1) */
-    SYSTICK_CTRL_REG   |= 0x07;
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) | 0x07);
 }
 
 /****************************************************************************************************************************************
@@ -50,18 +53,18 @@ void SysTick_Init(uint16 a_TimeInMilliSeconds)
 ****************************************************************************************************************************************/
 void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
 {
-    SYSTICK_CTRL_REG    = 0;                                     /* Disable the SysTick Timer by Clear the ENABLE Bit */
-    SYSTICK_RELOAD_REG  = (16000 * a_TimeInMilliSeconds) - 1;    /* Set the Reload value with 7999999 to count half Second */
-    SYSTICK_CURRENT_REG = 0;                                     /* Clear the Current Register value */
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);                             /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    HW_WRITE32(SYSTICK_RELOAD_REG, (16000 * a_TimeInMilliSeconds) - 1); /* Set the Reload value with 7999999 to count half Second */
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);                          /* Clear the Current Register value */
     /* Configure the SysTick Control Register
      * Enable the SysTick Timer (ENABLE = 1)
      * Disable SysTick Interrupt (INTEN = 0)
      * Choose the clock source to be System Clock (CLK_SRC = 1) */
-    SYSTICK_CTRL_REG   |= 0x05;
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) | 0x05);
 
-    while(!(SYSTICK_CTRL_REG & (1<<16)));                       /* Wait until the COUNT flag = 1 which mean SysTick Timer reaches ZERO value */
+    while(!(HW_READ32(SYSTICK_CTRL_REG) & (1<<16)));            /* Wait until the COUNT flag = 1 which mean SysTick Timer reaches ZERO value */
 
-    SYSTICK_CTRL_REG = 0;                                       /* Disable SysTick after completion */
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);                            /* Disable SysTick after completion */
 }
 
 /***************************************************************************************************************************************
@@ -72,10 +75,12 @@ void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function Handler for SysTick interrupt used to call the call-back function..
+ * Description: Function Handler for SysTick interrupt used to count the ticks and call the call-back function..
 ****************************************************************************************************************************************/
 void SysTick_Handler(void)
 {
+    g_SysTickCount++;                    /* Only writer, no read-modify-write race with the readers */
+
     if (g_SysTickCallBackPtr != NULL_PTR)
     {
         (*g_SysTickCallBackPtr)();       /* Call the callback function if it's set */
@@ -109,7 +114,7 @@ void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
 ****************************************************************************************************************************************/
 void SysTick_Stop(void)
 {
-    SYSTICK_CTRL_REG &= ~0x01;              /* Clear the ENABLE bit */
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) & ~0x01); /* Clear the ENABLE bit */
 }
 
 /***************************************************************************************************************************************
@@ -124,7 +129,7 @@ void SysTick_Stop(void)
 ****************************************************************************************************************************************/
 void SysTick_Start(void)
 {
-    SYSTICK_CTRL_REG |= 0x01;               /* Set the ENABLE bit */
+    HW_WRITE32(SYSTICK_CTRL_REG, HW_READ32(SYSTICK_CTRL_REG) | 0x01); /* Set the ENABLE bit */
 }
 
 /***************************************************************************************************************************************
@@ -139,8 +144,22 @@ void SysTick_Start(void)
  ****************************************************************************************************************************************/
 void SysTick_DeInit(void)
 {
-    SYSTICK_CTRL_REG = 0;                   /* Disable the SysTick Timer by Clear the ENABLE Bit */
-    SYSTICK_RELOAD_REG = 0;                 /* Clear the reload value */
-    SYSTICK_CURRENT_REG = 0;                /* Clear the Current Register value */
+    HW_WRITE32(SYSTICK_CTRL_REG, 0);        /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    HW_WRITE32(SYSTICK_RELOAD_REG, 0);      /* Clear the reload value */
+    HW_WRITE32(SYSTICK_CURRENT_REG, 0);     /* Clear the Current Register value */
 }
 
+/***************************************************************************************************************************************
+ * Service Name: SysTick_GetTickCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of SysTick interrupts since reset (wraps around)
+ * Description: Function to read the SysTick tick counter, elapsed time is (now - start) which stays correct across the wrap around.
+****************************************************************************************************************************************/
+uint32 SysTick_GetTickCount(void)
+{
+    return g_SysTickCount;
+}
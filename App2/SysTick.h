@@ -31,6 +31,8 @@ void SysTick_Start(void);
 
 void SysTick_DeInit(void);
 
+uint32 SysTick_GetTickCount(void);
+
 /*******************************************************************************
  *                                 End of File                                 *
  *******************************************************************************/
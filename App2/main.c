@@ -1,5 +1,7 @@
 #include "SysTick.h"
 #include "NVIC.h"
+#include "Idle.h"
+#include "Fault.h"
 #include "tm4c123gh6pm_registers.h"
 #include <assert.h>
 
@@ -11,6 +13,9 @@
 #define PENDSV_EXCEPTION_PRIORITY           6
 #define SYSTICK_EXCEPTION_PRIORITY          7
 
+#define SYSTICK_TICK_MS                     10
+#define LED_ON_TIME_TICKS                   (1000 / SYSTICK_TICK_MS)
+
 /* Enable PF1, PF2 and PF3 (RED, Blue and Green LEDs) */
 void Leds_Init(void)
 {
@@ -90,13 +95,20 @@ int main(void)
     /* Test all System and Fault Exceptions settings */
     Test_Exceptions_Settings();
 
+    /* Route every fault to the fault capture, a crash record of the previous run stays in g_Fault_Record for the debugger */
+    (void)Fault_Init();
+
+    /* Start SysTick Timer to generate interrupt every 10 milliseconds, the delays sleep until the tick instead of polling */
+    SysTick_Init(SYSTICK_TICK_MS);
+    Idle_Init();
+
     while(1)
     {
         GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x02; /* Turn on the Red LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
+        Idle_DelayTicks(LED_ON_TIME_TICKS); /* Sleep 1 second */
         GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x04; /* Turn on the Blue LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
+        Idle_DelayTicks(LED_ON_TIME_TICKS); /* Sleep 1 second */
         GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x08; /* Turn on the Green LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
+        Idle_DelayTicks(LED_ON_TIME_TICKS); /* Sleep 1 second */
     }
 }
@@ -31,8 +31,13 @@
 //*****************************************************************************
 void ResetISR(void);
 static void NmiSR(void);
-static void FaultISR(void);
 static void IntDefaultHandler(void);
+extern void SysTick_Handler(void);
+extern void Fault_Handler(void);
+extern void Spurious_Handler(void);
+#ifdef TM4C_SIM
+#pragma weak Fault_Handler                  // Assembly, not in the host build
+#endif
 
 //*****************************************************************************
 //
@@ -44,10 +49,16 @@ extern void _c_int00(void);
 
 //*****************************************************************************
 //
-// Linker variable that marks the top of the stack.
+// Linker variable that marks the top of the stack.  The host simulation build
+// (TM4C_SIM) has no linker command file, the vector table only gets linked in
+// so that the simulator dispatches the exceptions through it.
 //
 //*****************************************************************************
+#ifdef TM4C_SIM
+uint32_t __STACK_TOP;
+#else
 extern uint32_t __STACK_TOP;
+#endif
 
 //*****************************************************************************
 //
@@ -66,14 +77,14 @@ extern uint32_t __STACK_TOP;
 #pragma DATA_SECTION(g_pfnVectors, ".intvecs")
 void (* const g_pfnVectors[])(void) =
 {
-    (void (*)(void))((uint32_t)&__STACK_TOP),
+    (void (*)(void))((uintptr_t)&__STACK_TOP),
                                             // The initial stack pointer
     ResetISR,                               // The reset handler
     NmiSR,                                  // The NMI handler
-    FaultISR,                               // The hard fault handler
-    IntDefaultHandler,                      // The MPU fault handler
-    IntDefaultHandler,                      // The bus fault handler
-    IntDefaultHandler,                      // The usage fault handler
+    Fault_Handler,                          // The hard fault handler
+    Fault_Handler,                          // The MPU fault handler
+    Fault_Handler,                          // The bus fault handler
+    Fault_Handler,                          // The usage fault handler
     0,                                      // Reserved
     0,                                      // Reserved
     0,                                      // Reserved
@@ -82,7 +93,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // Debug monitor handler
     0,                                      // Reserved
     IntDefaultHandler,                      // The PendSV handler
-    IntDefaultHandler,                      // The SysTick handler
+    SysTick_Handler,                        // The SysTick handler
     IntDefaultHandler,                      // GPIO Port A
     IntDefaultHandler,                      // GPIO Port B
     IntDefaultHandler,                      // GPIO Port C
@@ -237,64 +248,43 @@ void (* const g_pfnVectors[])(void) =
 void
 ResetISR(void)
 {
+#ifndef TM4C_SIM
     //
     // Jump to the CCS C initialization routine.  This will enable the
     // floating-point unit as well, so that does not need to be done here.
     //
     __asm("    .global _c_int00\n"
           "    b.w     _c_int00");
+#endif
 }
 
 //*****************************************************************************
 //
-// This is the code that gets called when the processor receives a NMI.  This
-// simply enters an infinite loop, preserving the system state for examination
-// by a debugger.
+// This is the code that gets called when the processor receives a NMI.  The
+// NMI is counted by the Spurious module and the handler returns.
 //
 //*****************************************************************************
 static void
 NmiSR(void)
 {
     //
-    // Enter an infinite loop.
+    // Account the NMI and return.
     //
-    while(1)
-    {
-    }
-}
-
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
-//
-//*****************************************************************************
-static void
-FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
+    Spurious_Handler();
 }
 
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  The vector is counted by the Spurious module and the handler
+// returns, an unexpected IRQ is disabled in the NVIC so it cannot fire again.
 //
 //*****************************************************************************
 static void
 IntDefaultHandler(void)
 {
     //
-    // Go into an infinite loop.
+    // Account the vector and return.
     //
-    while(1)
-    {
-    }
+    Spurious_Handler();
 }
@@ -0,0 +1,182 @@
+/**************************************************************************************************************************************
+ Module      : Bench
+ Name        : Bench.c
+ Author      : Salma Hamdy
+ Description : Source file for the DWT cycle count microbenchmarks of the SysTick and NVIC drivers
+ ***************************************************************************************************************************************/
+
+#include "tm4c123gh6pm_registers.h"
+#include "Dwt.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Bench.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define BENCH_IRQ_NUM                        30          /* GPIO Port F, not triggered during the benchmarks */
+#define BENCH_IRQ_PRIORITY                   2
+#define BENCH_EXCEPTION_PRIORITY             3
+#define BENCH_TICK_MS                        1
+
+#define INTCTRL_PENDSTCLR_MASK               0x02000000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Bench_CaseFuncType)(void);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+Bench_BlockType g_Bench_Block;
+
+static uint32 g_Bench_Samples[BENCH_ITERATIONS];
+static volatile uint32 g_Bench_LatencyCount = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Measured calls, all of them go through the same indirect call as the empty one used for the overhead */
+static void Bench_Empty(void)                   { }
+static void Bench_SysTickInit(void)             { SysTick_Init(BENCH_TICK_MS); }
+static void Bench_SysTickStart(void)            { SysTick_Start(); }
+static void Bench_SysTickStop(void)             { SysTick_Stop(); }
+static void Bench_SysTickSetCallBack(void)      { SysTick_SetCallBack(Bench_Empty); }
+static void Bench_SysTickHandler(void)          { SysTick_Handler(); }
+static void Bench_NvicEnableIrq(void)           { NVIC_EnableIRQ(BENCH_IRQ_NUM); }
+static void Bench_NvicDisableIrq(void)          { NVIC_DisableIRQ(BENCH_IRQ_NUM); }
+static void Bench_NvicSetPriorityIrq(void)      { NVIC_SetPriorityIRQ(BENCH_IRQ_NUM, BENCH_IRQ_PRIORITY); }
+static void Bench_NvicEnableException(void)     { NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE); }
+static void Bench_NvicSetPriorityException(void){ NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, BENCH_EXCEPTION_PRIORITY); }
+
+/* Indexed by Bench_IdType, the latency benchmark is event driven and has no entry */
+static const Bench_CaseFuncType g_Bench_Cases[BENCH_SYSTICK_ISR_LATENCY] =
+{
+    Bench_SysTickInit,
+    Bench_SysTickStart,
+    Bench_SysTickStop,
+    Bench_SysTickSetCallBack,
+    Bench_SysTickHandler,
+    Bench_NvicEnableIrq,
+    Bench_NvicDisableIrq,
+    Bench_NvicSetPriorityIrq,
+    Bench_NvicEnableException,
+    Bench_NvicSetPriorityException
+};
+
+/* Called by SysTick_Handler: the counter was reloaded one cycle after reaching zero, so the elapsed cycles are RELOAD - CURRENT + 1 */
+static void Bench_LatencyCallBack(void)
+{
+    uint32 current = SYSTICK_CURRENT_REG;
+
+    if (g_Bench_LatencyCount < BENCH_ITERATIONS)
+    {
+        g_Bench_Samples[g_Bench_LatencyCount++] = SYSTICK_RELOAD_REG - current + 1;
+    }
+}
+
+/* Sort the samples and store their min / median / max */
+static void Bench_Record(Bench_IdType a_Id)
+{
+    Bench_ResultType *result = &g_Bench_Block.Results[a_Id];
+    uint32 sample;
+    uint32 i;
+    uint32 j;
+
+    for (i = 1; i < BENCH_ITERATIONS; i++)
+    {
+        sample = g_Bench_Samples[i];
+        for (j = i; (j > 0) && (g_Bench_Samples[j - 1] > sample); j--)
+        {
+            g_Bench_Samples[j] = g_Bench_Samples[j - 1];
+        }
+        g_Bench_Samples[j] = sample;
+    }
+
+    result->Id      = a_Id;
+    result->Samples = BENCH_ITERATIONS;
+    result->Min     = g_Bench_Samples[0];
+    result->Median  = g_Bench_Samples[BENCH_ITERATIONS / 2];
+    result->Max     = g_Bench_Samples[BENCH_ITERATIONS - 1];
+}
+
+/* Cycles of each call of a_Case, the overhead is clamped so a sample never wraps below zero */
+static void Bench_Measure(Bench_CaseFuncType a_Case, uint32 a_Overhead)
+{
+    uint32 start;
+    uint32 cycles;
+    uint32 i;
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start  = Dwt_GetCycles();
+        a_Case();
+        cycles = Dwt_GetCycles() - start;
+        g_Bench_Samples[i] = (cycles > a_Overhead) ? (cycles - a_Overhead) : 0;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Bench_Run
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to run all the benchmarks and fill g_Bench_Block. The driver calls are timed with the interrupts
+ *              disabled, then the SysTick interrupt latency is sampled on BENCH_ITERATIONS ticks of BENCH_TICK_MS.
+****************************************************************************************************************************************/
+void Bench_Run(void)
+{
+    const uint32 *word;
+    uint32 sum = 0;
+    uint32 id;
+
+    Dwt_EnableCycleCounter();
+    Disable_Exceptions();
+
+    g_Bench_Block.Magic       = BENCH_BLOCK_MAGIC;
+    g_Bench_Block.Version     = BENCH_BLOCK_VERSION;
+    g_Bench_Block.Count       = BENCH_CASES;
+    g_Bench_Block.CoreClockHz = BENCH_CORE_CLOCK_HZ;
+
+    /* Overhead: the fastest empty measurement */
+    Bench_Measure(Bench_Empty, 0);
+    Bench_Record(BENCH_SYSTICK_INIT);
+    g_Bench_Block.OverheadCycles = g_Bench_Block.Results[BENCH_SYSTICK_INIT].Min;
+
+    for (id = 0; id < BENCH_SYSTICK_ISR_LATENCY; id++)
+    {
+        Bench_Measure(g_Bench_Cases[id], g_Bench_Block.OverheadCycles);
+        Bench_Record((Bench_IdType)id);
+    }
+
+    /* Leave the NVIC as found and drop the SysTick interrupts pended by the measured calls */
+    NVIC_DisableException(EXCEPTION_MEM_FAULT_TYPE);
+    SysTick_DeInit();
+    NVIC_SYSTEM_INTCTRL = INTCTRL_PENDSTCLR_MASK;
+
+    /* Interrupt latency with the core running thread code (not sleeping) */
+    g_Bench_LatencyCount = 0;
+    SysTick_SetCallBack(Bench_LatencyCallBack);
+    SysTick_Init(BENCH_TICK_MS);
+    Enable_Exceptions();
+    while (g_Bench_LatencyCount < BENCH_ITERATIONS)
+    {
+        (void)Dwt_GetCycles();
+    }
+    Disable_Exceptions();
+    SysTick_DeInit();
+    Bench_Record(BENCH_SYSTICK_ISR_LATENCY);
+
+    for (word = (const uint32 *)&g_Bench_Block; word < &g_Bench_Block.Checksum; word++)
+    {
+        sum += *word;
+    }
+    g_Bench_Block.Checksum = 0 - sum;
+
+    Enable_Exceptions();
+}
@@ -0,0 +1,86 @@
+/***********************************************************************************************************************************
+ Module      : Bench
+ Name        : Bench.h
+ Author      : Salma Hamdy
+ Description : Header file for the DWT cycle count microbenchmarks of the SysTick and NVIC drivers
+ ************************************************************************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Samples per benchmark, odd so the median is a sample */
+#define BENCH_ITERATIONS                     101
+
+/* Result block identification, "BNCH" in memory order */
+#define BENCH_BLOCK_MAGIC                    0x48434E42UL
+#define BENCH_BLOCK_VERSION                  1
+
+#define BENCH_CORE_CLOCK_HZ                  16000000UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Benchmark identifiers, the order is part of the result block format (Tools/bench_parse.py) */
+typedef enum
+{
+    BENCH_SYSTICK_INIT,
+    BENCH_SYSTICK_START,
+    BENCH_SYSTICK_STOP,
+    BENCH_SYSTICK_SET_CALLBACK,
+    BENCH_SYSTICK_HANDLER,
+    BENCH_NVIC_ENABLE_IRQ,
+    BENCH_NVIC_DISABLE_IRQ,
+    BENCH_NVIC_SET_PRIORITY_IRQ,
+    BENCH_NVIC_ENABLE_EXCEPTION,
+    BENCH_NVIC_SET_PRIORITY_EXCEPTION,
+    BENCH_SYSTICK_ISR_LATENCY,         /* SysTick counter reaching zero to the first instruction of the call back */
+    BENCH_CASES
+}Bench_IdType;
+
+/* Cycles of one benchmark, the measurement overhead is already subtracted */
+typedef struct
+{
+    uint32 Id;
+    uint32 Samples;
+    uint32 Min;
+    uint32 Median;
+    uint32 Max;
+}Bench_ResultType;
+
+/* Result block read back by the debugger (or written to a file by the host build), only 32-bit little endian words */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 Count;                      /* Number of results */
+    uint32 CoreClockHz;
+    uint32 OverheadCycles;             /* Cost of an empty measurement, subtracted from every sample */
+    Bench_ResultType Results[BENCH_CASES];
+    uint32 Checksum;                   /* The sum of all the words of the block is zero */
+}Bench_BlockType;
+
+/*******************************************************************************
+ *                              External Variables                             *
+ *******************************************************************************/
+extern Bench_BlockType g_Bench_Block;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Bench_Run(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,45 @@
+/***********************************************************************************************************************************
+ Module      : Dwt
+ Name        : Dwt.h
+ Author      : Salma Hamdy
+ Description : Header-only access to the ARM Cortex M4 DWT cycle counter used by the timing and statistics modules
+ ************************************************************************************************************************************/
+
+#ifndef DWT_H_
+#define DWT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define DWT_CTRL_CYCCNTENA_MASK              0x00000001
+#define CORE_DEBUG_DEMCR_TRCENA_MASK         0x01000000
+
+/* Core clock cycles since the counter was enabled, wraps around every 2^32 cycles (268 seconds at 16MHz) */
+#define Dwt_GetCycles()                      (DWT_CYCCNT_REG)
+
+/*******************************************************************************
+ *                         Inline Functions Definitions                        *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: Dwt_EnableCycleCounter
+ * Reentrancy: Reentrant
+ * Description: Function to enable the DWT unit and start the cycle counter, it does not reset a running counter so several
+ *              modules can call it.
+****************************************************************************************************************************************/
+static inline void Dwt_EnableCycleCounter(void)
+{
+    CORE_DEBUG_DEMCR_REG |= CORE_DEBUG_DEMCR_TRCENA_MASK;   /* Enable the DWT unit */
+    DWT_CTRL_REG         |= DWT_CTRL_CYCCNTENA_MASK;        /* Start the cycle counter */
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* DWT_H_ */
@@ -0,0 +1,32 @@
+#include "NVIC.h"
+#include "Bench.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef TM4C_SIM
+#include <stdio.h>
+
+#define BENCH_OUTPUT_FILE                   "bench.bin"
+#endif
+
+int main(void)
+{
+    /* Time every SysTick and NVIC driver call, the results are left in g_Bench_Block */
+    Bench_Run();
+
+#ifdef TM4C_SIM
+    /* Host build: write the result block for Tools/bench_parse.py */
+    FILE *output = fopen(BENCH_OUTPUT_FILE, "wb");
+    if (output != NULL_PTR)
+    {
+        fwrite(&g_Bench_Block, sizeof(g_Bench_Block), 1, output);
+        fclose(output);
+    }
+    return 0;
+#else
+    /* Target build: halt here and save sizeof(Bench_BlockType) bytes at g_Bench_Block with the debugger */
+    while(1)
+    {
+        Wait_For_Interrupt();
+    }
+#endif
+}
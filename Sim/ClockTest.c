@@ -0,0 +1,236 @@
+/**************************************************************************************************************************************
+ Module      : ClockTest
+ Name        : ClockTest.c
+ Author      : Salma Hamdy
+ Description : Host check of the system clock transitions, their listener notifications and the SysTick tick across them
+
+ Built with TM4C_SIM, each case moves the clock to its start point, then switches it once in the middle of a 1 ms tick and
+ checks the return value, the clock the simulator runs at, and the (old, new) pairs a listener registered after SysTick was
+ told, in order. A switch away from a clock other than 16 MHz goes through the undivided oscillator first, so it is notified
+ twice. Sim_SetClockFailure makes the MOSC or the PLL never get ready: the driver must time out and fall back to the undivided
+ PIOSC. The callback time stamps every tick with the simulated time, and SysTick_ClockChanged must keep the tick length across
+ the notifications: the ticks after the switch stay on the 1 ms grid of the ticks before it, one period apart. The tick that
+ expires while the interrupts are disabled during the switch is taken late, when they are enabled again, it is not checked.
+ Sim_RunCases runs each case in its own child process, a ready flag polled without a timeout hangs it until it is killed:
+   - PIOSC to PLL:            16 MHz PIOSC to 80 MHz, the bypass runs at the old frequency and is not notified;
+   - PLL to MOSC:             80 MHz PLL to the 8 MHz MOSC, notified at 16 MHz and at 8 MHz;
+   - PLL to PLL:              80 MHz to 50 MHz, the PLL keeps its lock but the core still runs from the 16 MHz bypass;
+   - MOSC not ready:          4 MHz PIOSC to the 16 MHz MOSC, the MOSC never starts;
+   - PLL not locked:          8 MHz MOSC to the 80 MHz PLL, the PLL never locks;
+   - MOSC not ready for PLL:  8 MHz PIOSC to the 40 MHz PLL, the PLL reference never starts.
+ The exit status is 1 when a check fails.
+
+ Usage: clocktest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Clock.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define CLOCKTEST_TICK_NS                    1000000ULL
+#define CLOCKTEST_TICKS                      20            /* Ticks before and after the switch */
+#define CLOCKTEST_MAX_TICKS                  (4 * CLOCKTEST_TICKS)
+#define CLOCKTEST_MAX_NOTIFICATIONS          4
+
+/* Distance to the tick grid allowed after the switch. The callback runs some 30 core cycles after the counter reaches 0 (exception
+ * entry and the register accesses of SysTick_Handler), 7.5 us at 4 MHz against 0.4 us at 80 MHz, so the time stamps move by
+ * that much with the clock, plus a counter clock lost to the rounding of the remaining time at each notification */
+#define CLOCKTEST_TOLERANCE_NS               10000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 OldFrequencyHz;
+    uint32 NewFrequencyHz;
+}ClockTest_NotificationType;
+
+typedef struct
+{
+    Clock_SourceType FromSource;
+    uint32 FromHz;
+    Clock_SourceType ToSource;
+    uint32 ToHz;
+    boolean MoscFails;
+    boolean PllFails;
+    boolean Ready;                                       /* Expected return of the switch */
+    Clock_SourceType FinalSource;
+    uint32 FinalHz;
+    ClockTest_NotificationType Notifications[CLOCKTEST_MAX_NOTIFICATIONS];
+    uint8 NotificationsNum;
+}ClockTest_TransitionType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+/* One transition per case, in the order of g_ClockTest_Cases */
+static const ClockTest_TransitionType g_ClockTest_Transitions[] =
+{
+    {CLOCK_SOURCE_PIOSC, 16000000UL, CLOCK_SOURCE_PLL,  80000000UL, FALSE, FALSE,
+     TRUE,  CLOCK_SOURCE_PLL,   80000000UL, {{16000000UL, 80000000UL}}, 1},
+    {CLOCK_SOURCE_PLL,   80000000UL, CLOCK_SOURCE_MOSC,  8000000UL, FALSE, FALSE,
+     TRUE,  CLOCK_SOURCE_MOSC,   8000000UL, {{80000000UL, 16000000UL}, {16000000UL, 8000000UL}}, 2},
+    {CLOCK_SOURCE_PLL,   80000000UL, CLOCK_SOURCE_PLL,  50000000UL, FALSE, FALSE,
+     TRUE,  CLOCK_SOURCE_PLL,   50000000UL, {{80000000UL, 16000000UL}, {16000000UL, 50000000UL}}, 2},
+    {CLOCK_SOURCE_PIOSC,  4000000UL, CLOCK_SOURCE_MOSC, 16000000UL, TRUE,  FALSE,
+     FALSE, CLOCK_SOURCE_PIOSC, 16000000UL, {{4000000UL, 16000000UL}}, 1},
+    {CLOCK_SOURCE_MOSC,   8000000UL, CLOCK_SOURCE_PLL,  80000000UL, FALSE, TRUE,
+     FALSE, CLOCK_SOURCE_PIOSC, 16000000UL, {{8000000UL, 16000000UL}}, 1},
+    {CLOCK_SOURCE_PIOSC,  8000000UL, CLOCK_SOURCE_PLL,  40000000UL, TRUE,  FALSE,
+     FALSE, CLOCK_SOURCE_PIOSC, 16000000UL, {{8000000UL, 16000000UL}}, 1},
+};
+
+static ClockTest_NotificationType g_ClockTest_Notifications[CLOCKTEST_MAX_NOTIFICATIONS];
+static uint8 g_ClockTest_NotificationsNum = 0;
+
+static uint64 g_ClockTest_TickNs[CLOCKTEST_MAX_TICKS];
+static volatile uint32 g_ClockTest_Ticks = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static void ClockTest_Listener(uint32 a_OldFrequencyHz, uint32 a_NewFrequencyHz)
+{
+    if (g_ClockTest_NotificationsNum < CLOCKTEST_MAX_NOTIFICATIONS)
+    {
+        g_ClockTest_Notifications[g_ClockTest_NotificationsNum].OldFrequencyHz = a_OldFrequencyHz;
+        g_ClockTest_Notifications[g_ClockTest_NotificationsNum].NewFrequencyHz = a_NewFrequencyHz;
+    }
+    g_ClockTest_NotificationsNum++;
+}
+
+static void ClockTest_TickTask(void)
+{
+    if (g_ClockTest_Ticks < CLOCKTEST_MAX_TICKS)
+    {
+        g_ClockTest_TickNs[g_ClockTest_Ticks] = Sim_GetTimeNs();
+    }
+    g_ClockTest_Ticks++;
+}
+
+static void ClockTest_WaitTicks(uint32 a_Ticks)
+{
+    uint32 target = g_ClockTest_Ticks + a_Ticks;
+
+    while (g_ClockTest_Ticks < target)
+    {
+        Wait_For_Interrupt();
+    }
+}
+
+/* Distance of a time to the nearest point of the tick grid through a_ReferenceNs */
+static uint64 ClockTest_GridError(uint64 a_TimeNs, uint64 a_ReferenceNs)
+{
+    uint64 phase = (a_TimeNs - a_ReferenceNs) % CLOCKTEST_TICK_NS;
+
+    return (phase > (CLOCKTEST_TICK_NS / 2)) ? (CLOCKTEST_TICK_NS - phase) : phase;
+}
+
+static boolean ClockTest_Run(const Sim_CaseType *a_Case)
+{
+    const ClockTest_TransitionType *transition = (const ClockTest_TransitionType *)a_Case->Data;
+    boolean passed = TRUE;
+    boolean ready;
+    uint64 reference_ns;
+    uint64 interval_ns;
+    uint32 first_after;
+    uint32 tick;
+    uint8 index;
+
+    SysTick_SetCallBack(ClockTest_TickTask);
+    SysTick_Init(1);
+    Enable_Exceptions();
+    if (!Clock_SetFrequency(transition->FromSource, transition->FromHz))
+    {
+        printf("FAIL %s: start clock of %u Hz refused\n", a_Case->Name, transition->FromHz);
+        return FALSE;
+    }
+    if (!Clock_AddListener(ClockTest_Listener))
+    {
+        printf("FAIL %s: listener table full\n", a_Case->Name);
+        return FALSE;
+    }
+
+    /* Settle on the start clock, then switch 0.4 ms into a tick */
+    ClockTest_WaitTicks(2);
+    g_ClockTest_Ticks = 0;
+    ClockTest_WaitTicks(CLOCKTEST_TICKS);
+    reference_ns = g_ClockTest_TickNs[CLOCKTEST_TICKS - 1];
+    Sim_Compute((uint64)transition->FromHz * 4 / 10000);
+
+    Sim_SetClockFailure(transition->MoscFails, transition->PllFails);
+    ready = Clock_SetFrequency(transition->ToSource, transition->ToHz);
+    first_after = g_ClockTest_Ticks + 1;
+    ClockTest_WaitTicks(CLOCKTEST_TICKS + 1);
+
+    if ((ready != transition->Ready) || (Clock_GetSource() != transition->FinalSource) ||
+        (Clock_GetFrequency() != transition->FinalHz) || (Sim_GetCoreClock() != transition->FinalHz))
+    {
+        printf("FAIL %s: switch returned %u, source %u at %u Hz, core at %u Hz\n", a_Case->Name, ready, Clock_GetSource(),
+               Clock_GetFrequency(), Sim_GetCoreClock());
+        passed = FALSE;
+    }
+
+    if (g_ClockTest_NotificationsNum != transition->NotificationsNum)
+    {
+        printf("FAIL %s: %u notifications, expected %u\n", a_Case->Name, g_ClockTest_NotificationsNum,
+               transition->NotificationsNum);
+        passed = FALSE;
+    }
+    for (index = 0; (index < transition->NotificationsNum) && (index < g_ClockTest_NotificationsNum); index++)
+    {
+        if ((g_ClockTest_Notifications[index].OldFrequencyHz != transition->Notifications[index].OldFrequencyHz) ||
+            (g_ClockTest_Notifications[index].NewFrequencyHz != transition->Notifications[index].NewFrequencyHz))
+        {
+            printf("FAIL %s: notification %u from %u to %u Hz, expected %u to %u Hz\n", a_Case->Name, index,
+                   g_ClockTest_Notifications[index].OldFrequencyHz, g_ClockTest_Notifications[index].NewFrequencyHz,
+                   transition->Notifications[index].OldFrequencyHz, transition->Notifications[index].NewFrequencyHz);
+            passed = FALSE;
+        }
+    }
+
+    if (SysTick_GetPeriodCycles() != (transition->FinalHz / 1000))
+    {
+        printf("FAIL %s: %u cycles per tick at %u Hz\n", a_Case->Name, SysTick_GetPeriodCycles(), transition->FinalHz);
+        passed = FALSE;
+    }
+
+    /* The ticks after the late one stay on the grid of the start clock, one period apart */
+    for (tick = first_after; tick < g_ClockTest_Ticks; tick++)
+    {
+        interval_ns = g_ClockTest_TickNs[tick] - g_ClockTest_TickNs[tick - 1];
+        if ((ClockTest_GridError(g_ClockTest_TickNs[tick], reference_ns) > CLOCKTEST_TOLERANCE_NS) ||
+            ((tick > first_after) && ((interval_ns + CLOCKTEST_TOLERANCE_NS < CLOCKTEST_TICK_NS) ||
+                                      (interval_ns > CLOCKTEST_TICK_NS + CLOCKTEST_TOLERANCE_NS))))
+        {
+            printf("FAIL %s: tick %u at %llu ns, %llu ns after the previous one, %llu ns off the grid\n", a_Case->Name,
+                   tick - first_after, (unsigned long long)g_ClockTest_TickNs[tick], (unsigned long long)interval_ns,
+                   (unsigned long long)ClockTest_GridError(g_ClockTest_TickNs[tick], reference_ns));
+            passed = FALSE;
+        }
+    }
+    return passed;
+}
+
+static const Sim_CaseType g_ClockTest_Cases[] =
+{
+    {"PIOSC to PLL",           ClockTest_Run, &g_ClockTest_Transitions[0]},
+    {"PLL to MOSC",            ClockTest_Run, &g_ClockTest_Transitions[1]},
+    {"PLL to PLL",             ClockTest_Run, &g_ClockTest_Transitions[2]},
+    {"MOSC not ready",         ClockTest_Run, &g_ClockTest_Transitions[3]},
+    {"PLL not locked",         ClockTest_Run, &g_ClockTest_Transitions[4]},
+    {"MOSC not ready for PLL", ClockTest_Run, &g_ClockTest_Transitions[5]},
+};
+
+#define CLOCKTEST_CASES                      (sizeof(g_ClockTest_Cases) / sizeof(g_ClockTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_ClockTest_Cases, CLOCKTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+/**************************************************************************************************************************************
+ Module      : CpuLoadSim
+ Name        : CpuLoadSim.c
+ Author      : Salma Hamdy
+ Description : Host check of the CPU load meter against the simulator on synthetic load profiles
+
+ Built with TM4C_SIM, every 10 ms tick the SysTick call back computes the ISR share of a load profile between CpuLoad_IsrEnter
+ and CpuLoad_IsrExit, then the main loop computes the thread share and sleeps with Idle_DelayTicks. The shares are per mille of
+ the tick at the current clock, so the load does not depend on the clock (light, steady, heavy, a step every 7 seconds, and a
+ steady load while the clock moves between the PIOSC, the PLL and the MOSC in the middle of windows). The tick runs from
+ PIOSC / 4 as in the App1 governor build. At every 1 second window the simulator time spent in the call back and asleep gives
+ the exact split, and each published Load1s must be within CPULOAD_SIM_TOLERANCE per mille of it. A window where the clock
+ changed mixes cycles of both clocks and is only checked to add up to the full scale. Load10s and Load60s must be the mean of
+ the last 10 and 60 published samples. Each profile runs in its own child process; the exit status is 1 when a check fails.
+
+ Usage: cpuloadsim [seconds]      (simulated time of each profile, 70 by default so the 60 s average rolls over)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Idle.h"
+#include "Clock.h"
+#include "CpuLoad.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define CPULOAD_SIM_TICK_MS                  10
+#define CPULOAD_SIM_WINDOW_TICKS             (1000 / CPULOAD_SIM_TICK_MS)
+#define CPULOAD_SIM_DEFAULT_SECONDS          70
+#define CPULOAD_SIM_MAX_SECONDS              600
+
+/* Largest difference allowed between a published 1 s split and the simulator, in per mille */
+#define CPULOAD_SIM_TOLERANCE                2
+
+#define CPULOAD_SIM_STEP_TICKS               700
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint16 Isr;       /* Per mille of the tick computed in the SysTick call back */
+    uint16 Thread;    /* Per mille of the tick computed by the main loop */
+}CpuLoadSim_ShareType;
+
+typedef struct
+{
+    const char *Name;
+    CpuLoadSim_ShareType (*Share)(uint32 a_Tick);
+    boolean ClockChanges;
+}CpuLoadSim_ProfileType;
+
+typedef struct
+{
+    uint32 Tick;
+    Clock_SourceType Source;
+    uint32 FrequencyHz;
+}CpuLoadSim_ChangeType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Changes in the middle of windows 3, 7 and 11, then back to the reset clock at a window boundary */
+static const CpuLoadSim_ChangeType g_CpuLoadSim_Changes[] =
+{
+    { 250, CLOCK_SOURCE_PLL,   80000000UL},
+    { 620, CLOCK_SOURCE_PLL,   25000000UL},
+    {1010, CLOCK_SOURCE_MOSC,  16000000UL},
+    {1500, CLOCK_SOURCE_PIOSC, 16000000UL},
+};
+
+#define CPULOAD_SIM_CHANGES                  (sizeof(g_CpuLoadSim_Changes) / sizeof(g_CpuLoadSim_Changes[0]))
+
+static const CpuLoadSim_ProfileType *g_CpuLoadSim_Profile;
+static volatile boolean g_CpuLoadSim_Running = FALSE;
+static uint32 g_CpuLoadSim_Ticks = 0;
+
+/* Simulator time spent in the call back and asleep in the current window, and the split of every closed window */
+static uint64 g_CpuLoadSim_IsrNs = 0;
+static uint64 g_CpuLoadSim_SleepNs = 0;
+static uint64 g_CpuLoadSim_LastSleepCycles = 0;
+static CpuLoad_SplitType g_CpuLoadSim_Expected[CPULOAD_SIM_MAX_SECONDS];
+static boolean g_CpuLoadSim_Changed[CPULOAD_SIM_MAX_SECONDS];
+
+/* Published 1 s samples, for the 10 s and 60 s averages */
+static CpuLoad_SplitType g_CpuLoadSim_Published[CPULOAD_SIM_MAX_SECONDS];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static CpuLoadSim_ShareType CpuLoadSim_ShareLight(uint32 a_Tick)
+{
+    CpuLoadSim_ShareType share = {20, 50};
+    (void)a_Tick;
+    return share;
+}
+
+static CpuLoadSim_ShareType CpuLoadSim_ShareSteady(uint32 a_Tick)
+{
+    CpuLoadSim_ShareType share = {150, 400};
+    (void)a_Tick;
+    return share;
+}
+
+static CpuLoadSim_ShareType CpuLoadSim_ShareHeavy(uint32 a_Tick)
+{
+    CpuLoadSim_ShareType share = {250, 700};
+    (void)a_Tick;
+    return share;
+}
+
+/* ISR bound then thread bound every 7 seconds, so the 10 s and 60 s averages differ from the last sample */
+static CpuLoadSim_ShareType CpuLoadSim_ShareStep(uint32 a_Tick)
+{
+    CpuLoadSim_ShareType isr_bound    = {500, 100};
+    CpuLoadSim_ShareType thread_bound = {30, 600};
+
+    return (((a_Tick / CPULOAD_SIM_STEP_TICKS) % 2) == 0) ? isr_bound : thread_bound;
+}
+
+static const CpuLoadSim_ProfileType g_CpuLoadSim_Profiles[] =
+{
+    {"light",  CpuLoadSim_ShareLight,  FALSE},
+    {"steady", CpuLoadSim_ShareSteady, FALSE},
+    {"heavy",  CpuLoadSim_ShareHeavy,  FALSE},
+    {"step",   CpuLoadSim_ShareStep,   FALSE},
+    {"clock",  CpuLoadSim_ShareSteady, TRUE},
+};
+
+#define CPULOAD_SIM_PROFILES                 (sizeof(g_CpuLoadSim_Profiles) / sizeof(g_CpuLoadSim_Profiles[0]))
+
+/* Core cycles of a per mille of the tick at the current clock */
+static uint32 CpuLoadSim_Cycles(uint16 a_PerMille)
+{
+    return (uint32)(((uint64)Clock_GetFrequency() * CPULOAD_SIM_TICK_MS * a_PerMille) / (1000ULL * CPULOAD_FULL_SCALE));
+}
+
+static uint16 CpuLoadSim_Difference(uint16 a_Value, uint16 a_Reference)
+{
+    return (a_Value > a_Reference) ? (a_Value - a_Reference) : (a_Reference - a_Value);
+}
+
+/* SysTick call back: the measured ISR work, then the window bookkeeping at the same tick as CpuLoad_Tick */
+static void CpuLoadSim_TickTask(void)
+{
+    uint64 sleep_cycles = Sim_GetSleepCycles();
+    uint64 start_ns;
+    uint32 window;
+
+    if (!g_CpuLoadSim_Running)
+    {
+        return;
+    }
+
+    /* The main loop changes the clock before it computes and sleeps, so the sleep of the last tick ran at the current clock */
+    g_CpuLoadSim_SleepNs += ((sleep_cycles - g_CpuLoadSim_LastSleepCycles) * 1000000000ULL) / Sim_GetCoreClock();
+    g_CpuLoadSim_LastSleepCycles = sleep_cycles;
+
+    CpuLoad_IsrEnter();
+    start_ns = Sim_GetTimeNs();
+    Sim_Compute(CpuLoadSim_Cycles(g_CpuLoadSim_Profile->Share(g_CpuLoadSim_Ticks).Isr));
+    g_CpuLoadSim_IsrNs += Sim_GetTimeNs() - start_ns;
+    CpuLoad_IsrExit();
+
+    CpuLoad_Tick();
+
+    g_CpuLoadSim_Ticks++;
+    if ((g_CpuLoadSim_Ticks % CPULOAD_SIM_WINDOW_TICKS) == 0)
+    {
+        window = (g_CpuLoadSim_Ticks / CPULOAD_SIM_WINDOW_TICKS) - 1;
+        g_CpuLoadSim_Expected[window].Isr    = (uint16)(g_CpuLoadSim_IsrNs / 1000000ULL);
+        g_CpuLoadSim_Expected[window].Idle   = (uint16)(g_CpuLoadSim_SleepNs / 1000000ULL);
+        g_CpuLoadSim_Expected[window].Thread = CPULOAD_FULL_SCALE - g_CpuLoadSim_Expected[window].Isr -
+                                               g_CpuLoadSim_Expected[window].Idle;
+        g_CpuLoadSim_IsrNs   = 0;
+        g_CpuLoadSim_SleepNs = 0;
+    }
+}
+
+/* Load10s or Load60s from the published 1 s samples, as the mean of the last a_Horizon ones */
+static boolean CpuLoadSim_CheckAverage(const char *a_Horizon, const CpuLoad_SplitType *a_Split, uint32 a_Samples,
+                                       uint32 a_HorizonSamples)
+{
+    uint32 first = (a_Samples > a_HorizonSamples) ? (a_Samples - a_HorizonSamples) : 0;
+    uint32 isr_sum = 0;
+    uint32 idle_sum = 0;
+    uint32 sample;
+
+    for (sample = first; sample < a_Samples; sample++)
+    {
+        isr_sum  += g_CpuLoadSim_Published[sample].Isr;
+        idle_sum += g_CpuLoadSim_Published[sample].Idle;
+    }
+    if ((a_Split->Isr != (isr_sum / (a_Samples - first))) || (a_Split->Idle != (idle_sum / (a_Samples - first))) ||
+        ((a_Split->Isr + a_Split->Thread + a_Split->Idle) != CPULOAD_FULL_SCALE))
+    {
+        printf("FAIL %s sample %u: %s split %u/%u/%u, mean of the samples %u/%u\n", g_CpuLoadSim_Profile->Name, a_Samples,
+               a_Horizon, a_Split->Isr, a_Split->Thread, a_Split->Idle, isr_sum / (a_Samples - first),
+               idle_sum / (a_Samples - first));
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* One profile in the child process */
+static boolean CpuLoadSim_Run(const CpuLoadSim_ProfileType *a_Profile, uint32 a_Seconds)
+{
+    CpuLoad_ReportType report;
+    const CpuLoad_SplitType *expected;
+    uint32 samples = 0;
+    uint32 change = 0;
+    uint32 checked = 0;
+    uint16 error;
+    uint16 max_error = 0;
+    boolean passed = TRUE;
+
+    g_CpuLoadSim_Profile = a_Profile;
+
+    (void)SysTick_SetClockSource(SYSTICK_CLOCK_PIOSC_DIV4);
+    SysTick_Init(CPULOAD_SIM_TICK_MS);
+    SysTick_SetCallBack(CpuLoadSim_TickTask);
+    Idle_Init();
+    Enable_Exceptions();
+
+    /* Start on a tick so the windows of the meter and of the check close together */
+    Idle_DelayTicks(1);
+    g_CpuLoadSim_LastSleepCycles = Sim_GetSleepCycles();
+    CpuLoad_Init(CPULOAD_SIM_WINDOW_TICKS);
+    g_CpuLoadSim_Running = TRUE;
+
+    while (samples < a_Seconds)
+    {
+        if (a_Profile->ClockChanges && (change < CPULOAD_SIM_CHANGES) && (g_CpuLoadSim_Ticks == g_CpuLoadSim_Changes[change].Tick))
+        {
+            if (!Clock_SetFrequency(g_CpuLoadSim_Changes[change].Source, g_CpuLoadSim_Changes[change].FrequencyHz))
+            {
+                printf("FAIL %s: switch to %u Hz refused\n", a_Profile->Name, g_CpuLoadSim_Changes[change].FrequencyHz);
+                return FALSE;
+            }
+            /* A change at a window boundary is made after the window closed, and does not mix the clocks */
+            if ((g_CpuLoadSim_Ticks % CPULOAD_SIM_WINDOW_TICKS) != 0)
+            {
+                g_CpuLoadSim_Changed[g_CpuLoadSim_Ticks / CPULOAD_SIM_WINDOW_TICKS] = TRUE;
+            }
+            change++;
+        }
+
+        Sim_Compute(CpuLoadSim_Cycles(a_Profile->Share(g_CpuLoadSim_Ticks).Thread));
+        Idle_DelayTicks(1);
+
+        CpuLoad_GetReport(&report);
+        if (report.Samples == samples)
+        {
+            continue;
+        }
+        if (report.Samples != (samples + 1))
+        {
+            printf("FAIL %s: %u samples published after %u\n", a_Profile->Name, report.Samples, samples);
+            return FALSE;
+        }
+
+        expected = &g_CpuLoadSim_Expected[samples];
+        g_CpuLoadSim_Published[samples] = report.Load1s;
+        samples++;
+
+        if (g_CpuLoadSim_Changed[samples - 1])
+        {
+            passed &= CpuLoadSim_CheckAverage("1 s", &report.Load1s, samples, 1);
+        }
+        else
+        {
+            error = CpuLoadSim_Difference(report.Load1s.Isr, expected->Isr);
+            if (CpuLoadSim_Difference(report.Load1s.Thread, expected->Thread) > error)
+            {
+                error = CpuLoadSim_Difference(report.Load1s.Thread, expected->Thread);
+            }
+            if (CpuLoadSim_Difference(report.Load1s.Idle, expected->Idle) > error)
+            {
+                error = CpuLoadSim_Difference(report.Load1s.Idle, expected->Idle);
+            }
+            if (error > max_error)
+            {
+                max_error = error;
+            }
+            if (error > CPULOAD_SIM_TOLERANCE)
+            {
+                printf("FAIL %s sample %u: split %u/%u/%u, simulator %u/%u/%u\n", a_Profile->Name, samples,
+                       report.Load1s.Isr, report.Load1s.Thread, report.Load1s.Idle, expected->Isr, expected->Thread,
+                       expected->Idle);
+                passed = FALSE;
+            }
+            checked++;
+        }
+
+        passed &= CpuLoadSim_CheckAverage("10 s", &report.Load10s, samples, CPULOAD_SHORT_SAMPLES);
+        passed &= CpuLoadSim_CheckAverage("60 s", &report.Load60s, samples, CPULOAD_HISTORY_SAMPLES);
+    }
+
+    printf("%-8s %7u %7u %9u %8u/%u/%u %8u/%u/%u %8u/%u/%u %7u\n", a_Profile->Name, samples, checked, max_error,
+           report.Load1s.Isr, report.Load1s.Thread, report.Load1s.Idle, report.Load10s.Isr, report.Load10s.Thread,
+           report.Load10s.Idle, report.Load60s.Isr, report.Load60s.Thread, report.Load60s.Idle, report.MaxTickCycles);
+    return passed;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 seconds = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : CPULOAD_SIM_DEFAULT_SECONDS;
+    boolean passed = TRUE;
+    uint32 profile;
+    pid_t child;
+    int status;
+
+    if ((seconds == 0) || (seconds > CPULOAD_SIM_MAX_SECONDS))
+    {
+        printf("Usage: %s [seconds]      (1 to %u)\n", argv[0], CPULOAD_SIM_MAX_SECONDS);
+        return 2;
+    }
+
+    printf("%-8s %7s %7s %9s %14s %14s %14s %7s\n", "profile", "samples", "checked", "max error", "1 s i/t/s", "10 s i/t/s",
+           "60 s i/t/s", "tick");
+
+    /* The simulator state is global, each profile starts from the reset state in a child process */
+    for (profile = 0; profile < CPULOAD_SIM_PROFILES; profile++)
+    {
+        fflush(stdout);
+        child = fork();
+        if (child == 0)
+        {
+            Sim_SetCycleLimit(0xFFFFFFFFFFFFFFFFULL);
+            passed = CpuLoadSim_Run(&g_CpuLoadSim_Profiles[profile], seconds);
+            fflush(stdout);
+            _exit(passed ? 0 : 1);
+        }
+        if ((waitpid(child, &status, 0) != child) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            printf("FAIL %s\n", g_CpuLoadSim_Profiles[profile].Name);
+            passed = FALSE;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
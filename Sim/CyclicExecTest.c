@@ -0,0 +1,143 @@
+/**************************************************************************************************************************************
+ Module      : CyclicExecTest
+ Name        : CyclicExecTest.c
+ Author      : Salma Hamdy
+ Description : Host test of the cyclic executive frame measurement with fractional SysTick periods
+
+ Built with TM4C_SIM, it runs the App1 frame table (CyclicExec_Cfg.c) with a trimmed counter clock, so the tick alternates two
+ reload values and RELOAD already holds the next period while a frame runs. The job of each frame computes a scripted number of
+ cycles: none, inside the WCET budget, one counter clock above it, and longer than the whole frame across both reload values.
+ Every measured frame must be the work of its job plus the constant cost of the register samples, which is a few clocks higher
+ when the counter wrapped, the budget and frame overruns must be counted exactly, and CyclicExec_Start must refuse a system
+ clock at which the frame no longer fits in the 24-bit counter. The exit status is 1 when a check fails.
+
+ Usage: cyclicexectest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Clock.h"
+#include "TimeConv.h"
+#include "CyclicExec.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Trim that makes the 1000 ms frame 16000197.52 counter clocks at 16 MHz */
+#define CYCLICEXECTEST_TRIM_PPB              12345
+
+/* Highest extra cost of the samples of a frame that wrapped (the CTRL, RELOAD and second CURRENT reads) */
+#define CYCLICEXECTEST_MAX_WRAP_SAMPLE       8
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Work of the job of each frame in core cycles (one core cycle per counter clock at 16 MHz), in increasing order as only the
+ * longest frame is kept */
+static const uint32 g_CyclicExecTest_Work[] = {0, 100, 799, 800, 801, 5000, 17000000, 17000001, 17000002, 17000003};
+
+#define CYCLICEXECTEST_FRAMES                (sizeof(g_CyclicExecTest_Work) / sizeof(g_CyclicExecTest_Work[0]))
+
+/* Statistics seen by the job of each frame, so after the previous frame, plus the ones after the last frame */
+static CyclicExec_StatsType g_CyclicExecTest_Stats[CYCLICEXECTEST_FRAMES + 1];
+static volatile uint32 g_CyclicExecTest_Frame = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Only job of the App1 frame table */
+void Leds_RotateTask(void)
+{
+    if (g_CyclicExecTest_Frame <= CYCLICEXECTEST_FRAMES)
+    {
+        CyclicExec_GetStats(&g_CyclicExecTest_Stats[g_CyclicExecTest_Frame]);
+    }
+    if (g_CyclicExecTest_Frame < CYCLICEXECTEST_FRAMES)
+    {
+        Sim_Compute(g_CyclicExecTest_Work[g_CyclicExecTest_Frame]);
+    }
+    g_CyclicExecTest_Frame++;
+}
+
+int main(void)
+{
+    const CyclicExec_StatsType *stats;
+    uint32 budget;
+    uint32 overhead;
+    uint32 wrap_overhead = 0;
+    uint32 expected;
+    uint32 budget_overruns = 0;
+    uint32 frame_overruns = 0;
+    uint32 frame;
+    boolean passed = TRUE;
+
+    Sim_SetCycleLimit(0xFFFFFFFFFFFFFFFFULL);
+
+    /* 1000 ms is 80 * 10^9 clocks at 80 MHz, far above the 2^24 counter */
+    (void)Clock_SetFrequency(CLOCK_SOURCE_PLL, CLOCK_MAX_HZ);
+    if (CyclicExec_Start())
+    {
+        printf("FAIL start: the %u ms frame was accepted at %u Hz\n", CYCLIC_EXEC_FRAME_MS, SysTick_GetCounterFrequency());
+        passed = FALSE;
+    }
+    (void)Clock_SetFrequency(CLOCK_SOURCE_PIOSC, CLOCK_PIOSC_HZ);
+
+    (void)SysTick_SetTrim(CYCLICEXECTEST_TRIM_PPB);
+    if (!CyclicExec_Start())
+    {
+        printf("FAIL start: the %u ms frame was refused at %u Hz\n", CYCLIC_EXEC_FRAME_MS, SysTick_GetCounterFrequency());
+        return 1;
+    }
+    Enable_Exceptions();
+
+    while (g_CyclicExecTest_Frame <= CYCLICEXECTEST_FRAMES)
+    {
+        Wait_For_Interrupt();
+    }
+
+    budget   = (uint32)TimeConv_UsToCounts(g_CyclicExec_FrameBudgetUs[0]);
+    overhead = g_CyclicExecTest_Stats[1].MaxFrameCycles;
+
+    printf("frame     work    measured  budget  overruns  frame overruns\n");
+    for (frame = 0; frame < CYCLICEXECTEST_FRAMES; frame++)
+    {
+        stats = &g_CyclicExecTest_Stats[frame + 1];
+        expected = g_CyclicExecTest_Work[frame] + overhead;
+        if (expected > budget)
+        {
+            budget_overruns++;
+        }
+        if (expected >= SysTick_GetPeriodCycles())
+        {
+            /* The first frame that wraps gives the cost of the extra samples, the others must match it exactly */
+            frame_overruns++;
+            if (wrap_overhead == 0)
+            {
+                wrap_overhead = stats->MaxFrameCycles - expected;
+                if (wrap_overhead > CYCLICEXECTEST_MAX_WRAP_SAMPLE)
+                {
+                    printf("FAIL frame %u: the samples after a wrap cost %u counter clocks\n", frame, wrap_overhead);
+                    passed = FALSE;
+                }
+            }
+            expected += wrap_overhead;
+        }
+
+        printf("%5u %10u %10u %6u %9u %14u\n", frame, g_CyclicExecTest_Work[frame], stats->MaxFrameCycles, budget,
+               stats->BudgetOverruns, stats->FrameOverruns);
+
+        if ((stats->MaxFrameCycles != expected) ||
+            (stats->BudgetOverruns != budget_overruns) || (stats->FrameOverruns != frame_overruns))
+        {
+            printf("FAIL frame %u: expected %u counter clocks, %u budget and %u frame overruns\n", frame, expected,
+                   budget_overruns, frame_overruns);
+            passed = FALSE;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+/**************************************************************************************************************************************
+ Module      : EventQueueStress
+ Name        : EventQueueStress.c
+ Author      : Salma Hamdy
+ Description : Host stress test of the multi-producer single-consumer event queue with producer threads, and enqueue benchmark
+
+ The producer threads stand for ISRs at different NVIC priorities and the main thread for the main loop, so the position claim
+ of EventQueue_Post is raced by real concurrent compare-exchanges where the host has several cores, and by preemption where it
+ has one. Every producer posts its own numbered events, [producer (8 bits)] [sequence (24 bits)], and retries an event the full
+ queue rejected. The consumer must get every event exactly once, each producer's events in order, and the Dropped counter must
+ match the rejections the producers saw. Queue sizes go down to 2 slots so the slots are reused every few events. The exit
+ status is 1 on a failure. The benchmark then times EventQueue_Post with one producer against the same post under a mutex,
+ the host stand-in for masking interrupts, and the post throughput with several producers. Host timings only show the relative
+ cost, on the Cortex M4 the claim is an LDREX/STREX pair.
+
+ Build it with -pthread, and with TM4C_SIM for the 32-bit host types.
+
+ Usage: eventqueuestress [events]      (events per producer, 10^6 by default)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "Atomic.h"
+#include "EventQueue.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define EVENTQUEUESTRESS_DEFAULT_EVENTS      1000000UL
+#define EVENTQUEUESTRESS_MAX_EVENTS          (1UL << 24)
+#define EVENTQUEUESTRESS_PRODUCERS           8
+#define EVENTQUEUESTRESS_MAX_SLOTS           1024
+#define EVENTQUEUESTRESS_BENCH_EVENTS        (1UL << 22)
+#define EVENTQUEUESTRESS_BENCH_BATCH         512                /* Posts between two drains of the benchmark queue */
+#define EVENTQUEUESTRESS_STALL_NS            2000000000ULL      /* No event for this long while producers run is a livelock */
+
+#define EVENTQUEUESTRESS_EVENT(producer, sequence)   (((uint32)(producer) << 24) | (sequence))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 Id;
+    uint32 Events;
+    uint32 Rejected;         /* Posts the full queue refused */
+}EventQueueStress_ProducerType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Slot counts, down to 2 so the producers keep reusing slots of the previous lap */
+static const uint32 g_EventQueueStress_Slots[] = {2, 16, EVENTQUEUESTRESS_MAX_SLOTS};
+
+#define EVENTQUEUESTRESS_SIZES               (sizeof(g_EventQueueStress_Slots) / sizeof(g_EventQueueStress_Slots[0]))
+
+static EventQueue_SlotType g_EventQueueStress_Storage[EVENTQUEUESTRESS_MAX_SLOTS];
+static EventQueue_Type g_EventQueueStress_Queue;
+static volatile uint32 g_EventQueueStress_Running;    /* Producer threads not finished yet */
+
+static pthread_mutex_t g_EventQueueStress_Lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint64 EventQueueStress_NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
+}
+
+static void *EventQueueStress_Producer(void *a_Arg)
+{
+    EventQueueStress_ProducerType *producer = (EventQueueStress_ProducerType *)a_Arg;
+    uint32 sequence;
+
+    for (sequence = 0; sequence < producer->Events; sequence++)
+    {
+        while (!EventQueue_Post(&g_EventQueueStress_Queue, EVENTQUEUESTRESS_EVENT(producer->Id, sequence)))
+        {
+            producer->Rejected++;
+            sched_yield();                          /* Full: let the consumer run on a single core host */
+        }
+    }
+    (void)Atomic_FetchAdd(&g_EventQueueStress_Running, (uint32)-1);
+    return NULL_PTR;
+}
+
+/* Producer threads posting into a queue of the given size, the calling thread consumes */
+static boolean EventQueueStress_Run(uint32 a_Slots, uint32 a_Events)
+{
+    EventQueueStress_ProducerType producers[EVENTQUEUESTRESS_PRODUCERS];
+    pthread_t threads[EVENTQUEUESTRESS_PRODUCERS];
+    uint32 next[EVENTQUEUESTRESS_PRODUCERS] = {0};
+    uint64 total = (uint64)a_Events * EVENTQUEUESTRESS_PRODUCERS;
+    uint64 received = 0;
+    uint32 rejected = 0;
+    uint32 errors = 0;
+    uint32 event;
+    uint32 id;
+    uint32 sequence;
+    uint64 start;
+    uint64 progress;
+    double seconds;
+
+    (void)EventQueue_Init(&g_EventQueueStress_Queue, g_EventQueueStress_Storage, a_Slots);
+    g_EventQueueStress_Running = EVENTQUEUESTRESS_PRODUCERS;
+
+    start = EventQueueStress_NowNs();
+    for (id = 0; id < EVENTQUEUESTRESS_PRODUCERS; id++)
+    {
+        producers[id].Id       = id;
+        producers[id].Events   = a_Events;
+        producers[id].Rejected = 0;
+        pthread_create(&threads[id], NULL_PTR, EventQueueStress_Producer, &producers[id]);
+    }
+    progress = start;
+
+    /* A lost event would leave the count short, so also stop once the producers are done and the queue is empty. A producer
+     * publishes its last event before it counts itself out. */
+    while (received < total)
+    {
+        if (!EventQueue_Get(&g_EventQueueStress_Queue, &event))
+        {
+            if (g_EventQueueStress_Running != 0)
+            {
+                if ((EventQueueStress_NowNs() - progress) > EVENTQUEUESTRESS_STALL_NS)
+                {
+                    /* The producers spin in EventQueue_Post and cannot be joined */
+                    printf("FAIL %u slots: no event for 2 s after %llu events, the producers are stuck\n", a_Slots,
+                           (unsigned long long)received);
+                    exit(1);
+                }
+                sched_yield();                      /* Empty: let the producers run on a single core host */
+                continue;
+            }
+            if (!EventQueue_Get(&g_EventQueueStress_Queue, &event))
+            {
+                break;
+            }
+        }
+
+        received++;
+        progress = EventQueueStress_NowNs();
+        id       = event >> 24;
+        sequence = event & (EVENTQUEUESTRESS_MAX_EVENTS - 1);
+        if ((id >= EVENTQUEUESTRESS_PRODUCERS) || (sequence != next[id]))
+        {
+            printf("FAIL event %u of producer %u, expected %u\n", sequence, id, (id < EVENTQUEUESTRESS_PRODUCERS) ? next[id] : 0);
+            if (++errors == 10)
+            {
+                /* Stale events may be read again and again while the producers are stuck and cannot be joined */
+                printf("FAIL %u slots: stopped after %u errors\n", a_Slots, errors);
+                exit(1);
+            }
+            if (id >= EVENTQUEUESTRESS_PRODUCERS)
+            {
+                continue;
+            }
+        }
+        next[id] = sequence + 1;
+    }
+
+    for (id = 0; id < EVENTQUEUESTRESS_PRODUCERS; id++)
+    {
+        pthread_join(threads[id], NULL_PTR);
+        rejected += producers[id].Rejected;
+    }
+    seconds = (double)(EventQueueStress_NowNs() - start) / 1e9;
+
+    if (EventQueue_Get(&g_EventQueueStress_Queue, &event))
+    {
+        printf("FAIL event %u of producer %u left in the queue\n", (uint32)(event & (EVENTQUEUESTRESS_MAX_EVENTS - 1)),
+               event >> 24);
+        errors++;
+    }
+    if (received != total)
+    {
+        printf("FAIL %llu events received out of %llu\n", (unsigned long long)received, (unsigned long long)total);
+        errors++;
+    }
+    if (g_EventQueueStress_Queue.Dropped != rejected)
+    {
+        printf("FAIL %u events counted as dropped, the producers saw %u rejected\n", g_EventQueueStress_Queue.Dropped, rejected);
+        errors++;
+    }
+
+    printf("%6u %10llu %10u %8.2f %8u\n", a_Slots, (unsigned long long)received, rejected,
+           ((double)received / 1e6) / seconds, errors);
+    return (errors == 0) ? TRUE : FALSE;
+}
+
+/* Same position claim as EventQueue_Post but under a lock, as a main loop would post with interrupts masked */
+static boolean EventQueueStress_LockedPost(EventQueue_Type *a_Queue, uint32 a_Event)
+{
+    EventQueue_SlotType *slot;
+    boolean queued = FALSE;
+
+    pthread_mutex_lock(&g_EventQueueStress_Lock);
+    slot = &a_Queue->Slots[a_Queue->EnqueuePos & a_Queue->Mask];
+    if (slot->Sequence == a_Queue->EnqueuePos)
+    {
+        slot->Event = a_Event;
+        slot->Sequence = a_Queue->EnqueuePos + 1;
+        a_Queue->EnqueuePos++;
+        queued = TRUE;
+    }
+    pthread_mutex_unlock(&g_EventQueueStress_Lock);
+    return queued;
+}
+
+/* Nanoseconds per post with one producer, draining the queue every batch outside the timed loop */
+static double EventQueueStress_BenchPost(boolean (*a_Post)(EventQueue_Type *, uint32))
+{
+    uint64 elapsed = 0;
+    uint64 start;
+    uint32 event;
+    uint32 batch;
+    uint32 i;
+
+    (void)EventQueue_Init(&g_EventQueueStress_Queue, g_EventQueueStress_Storage, EVENTQUEUESTRESS_MAX_SLOTS);
+    for (batch = 0; batch < (EVENTQUEUESTRESS_BENCH_EVENTS / EVENTQUEUESTRESS_BENCH_BATCH); batch++)
+    {
+        start = EventQueueStress_NowNs();
+        for (i = 0; i < EVENTQUEUESTRESS_BENCH_BATCH; i++)
+        {
+            (void)a_Post(&g_EventQueueStress_Queue, i);
+        }
+        elapsed += EventQueueStress_NowNs() - start;
+        while (EventQueue_Get(&g_EventQueueStress_Queue, &event))
+        {
+        }
+    }
+    return (double)elapsed / (double)EVENTQUEUESTRESS_BENCH_EVENTS;
+}
+
+static void EventQueueStress_Bench(void)
+{
+    EventQueueStress_ProducerType producers[EVENTQUEUESTRESS_PRODUCERS];
+    pthread_t threads[EVENTQUEUESTRESS_PRODUCERS];
+    uint32 count;
+    uint32 id;
+    uint32 event;
+    uint64 start;
+    double seconds;
+
+    printf("\npost, one producer:  lock-free %6.1f ns   under a mutex %6.1f ns\n",
+           EventQueueStress_BenchPost(EventQueue_Post), EventQueueStress_BenchPost(EventQueueStress_LockedPost));
+
+    printf("producers  Mposts/s  rejected\n");
+    for (count = 1; count <= EVENTQUEUESTRESS_PRODUCERS; count *= 2)
+    {
+        (void)EventQueue_Init(&g_EventQueueStress_Queue, g_EventQueueStress_Storage, EVENTQUEUESTRESS_MAX_SLOTS);
+        g_EventQueueStress_Running = count;
+
+        start = EventQueueStress_NowNs();
+        for (id = 0; id < count; id++)
+        {
+            producers[id].Id       = id;
+            producers[id].Events   = EVENTQUEUESTRESS_BENCH_EVENTS / count;
+            producers[id].Rejected = 0;
+            pthread_create(&threads[id], NULL_PTR, EventQueueStress_Producer, &producers[id]);
+        }
+        while (TRUE)
+        {
+            if (EventQueue_Get(&g_EventQueueStress_Queue, &event))
+            {
+                continue;
+            }
+            if ((g_EventQueueStress_Running == 0) && !EventQueue_Get(&g_EventQueueStress_Queue, &event))
+            {
+                break;
+            }
+            sched_yield();
+        }
+        for (id = 0; id < count; id++)
+        {
+            pthread_join(threads[id], NULL_PTR);
+        }
+        seconds = (double)(EventQueueStress_NowNs() - start) / 1e9;
+
+        printf("%9u %9.2f %9u\n", count, ((double)EVENTQUEUESTRESS_BENCH_EVENTS / 1e6) / seconds,
+               g_EventQueueStress_Queue.Dropped);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    boolean passed = TRUE;
+    uint32 events;
+    uint32 size;
+
+    events = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : EVENTQUEUESTRESS_DEFAULT_EVENTS;
+    if ((events == 0) || (events > EVENTQUEUESTRESS_MAX_EVENTS))
+    {
+        printf("Usage: %s [events]      (1 to %lu events per producer)\n", argv[0], EVENTQUEUESTRESS_MAX_EVENTS);
+        return 2;
+    }
+
+    printf("%u producers, %u events each\n", EVENTQUEUESTRESS_PRODUCERS, events);
+    printf("%6s %10s %10s %8s %8s\n", "slots", "received", "rejected", "Mev/s", "errors");
+    for (size = 0; size < EVENTQUEUESTRESS_SIZES; size++)
+    {
+        if (!EventQueueStress_Run(g_EventQueueStress_Slots[size], events))
+        {
+            passed = FALSE;
+        }
+    }
+
+    if (passed)
+    {
+        EventQueueStress_Bench();
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/**************************************************************************************************************************************
+ Module      : GovernorSim
+ Name        : GovernorSim.c
+ Author      : Salma Hamdy
+ Description : Host simulation of the frequency governor against fixed clocks on synthetic load profiles
+
+ Built with TM4C_SIM, it runs a periodic job released by the scheduler every 10 ms tick. The work of a job, in core cycles at any
+ clock, follows a load profile (steady, peak, bursty, ramp). Each profile runs in its own child process from the reset state of
+ the simulator with three clock policies: fixed 80 MHz PLL, fixed 16 MHz PIOSC (reset clock) and the governor. A job is late when
+ it completes after the release of the next one, a release finding the previous job not completed is an overrun and is late too.
+ The energy comes from the power model of the simulator. The tick runs from PIOSC / 4 as in the App1 governor build, the tick
+ count at the end shows its period stays 10 ms of wall-clock time whatever the clock changes.
+
+ Usage: governorsim [seconds]      (simulated time of each run, 10 by default)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Sched.h"
+#include "Idle.h"
+#include "Clock.h"
+#include "Governor.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define GOVSIM_TICK_MS                       10
+#define GOVSIM_TICKS_PER_SECOND              (1000 / GOVSIM_TICK_MS)
+#define GOVSIM_DEFAULT_SECONDS               10
+#define GOVSIM_JOB_PRIORITY                  0
+
+/* Clock policies */
+#define GOVSIM_POLICY_FIXED_80MHZ            0
+#define GOVSIM_POLICY_FIXED_16MHZ            1
+#define GOVSIM_POLICY_GOVERNOR               2
+#define GOVSIM_POLICIES                      3
+
+/* Work of one job in core cycles, a 10 ms tick is 800000 cycles at 80 MHz and 160000 cycles at 16 MHz */
+#define GOVSIM_WORK_IDLE                     8000
+#define GOVSIM_WORK_STEADY                   240000
+#define GOVSIM_WORK_PEAK                     600000
+#define GOVSIM_BURST_PERIOD_TICKS            200
+#define GOVSIM_BURST_LENGTH_TICKS            50
+#define GOVSIM_RAMP_PERIOD_TICKS             1000
+#define GOVSIM_RAMP_MAX_WORK                 640000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    const char *Name;
+    uint32 (*Work)(uint32 a_Release);     /* Work of the job of a release */
+}GovSim_ProfileType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+static const char *const g_GovSim_PolicyNames[GOVSIM_POLICIES] = {"80 MHz", "16 MHz", "governor"};
+
+static const GovSim_ProfileType *g_GovSim_Profile;
+static uint32 g_GovSim_Jobs = 0;
+static uint32 g_GovSim_Late = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static uint32 GovSim_WorkIdle(uint32 a_Release)   { (void)a_Release; return GOVSIM_WORK_IDLE; }
+static uint32 GovSim_WorkSteady(uint32 a_Release) { (void)a_Release; return GOVSIM_WORK_STEADY; }
+static uint32 GovSim_WorkPeak(uint32 a_Release)   { (void)a_Release; return GOVSIM_WORK_PEAK; }
+
+/* Peak load for half a second every 2 seconds, light load in between */
+static uint32 GovSim_WorkBursty(uint32 a_Release)
+{
+    return ((a_Release % GOVSIM_BURST_PERIOD_TICKS) < GOVSIM_BURST_LENGTH_TICKS) ? GOVSIM_WORK_PEAK : GOVSIM_WORK_IDLE;
+}
+
+/* Triangle from no load to 80 % of 80 MHz and back every 10 seconds */
+static uint32 GovSim_WorkRamp(uint32 a_Release)
+{
+    uint32 phase = a_Release % GOVSIM_RAMP_PERIOD_TICKS;
+
+    if (phase >= (GOVSIM_RAMP_PERIOD_TICKS / 2))
+    {
+        phase = GOVSIM_RAMP_PERIOD_TICKS - phase;
+    }
+    return (uint32)(((uint64)GOVSIM_RAMP_MAX_WORK * phase) / (GOVSIM_RAMP_PERIOD_TICKS / 2));
+}
+
+static const GovSim_ProfileType g_GovSim_Profiles[] =
+{
+    {"idle",   GovSim_WorkIdle},
+    {"steady", GovSim_WorkSteady},
+    {"peak",   GovSim_WorkPeak},
+    {"bursty", GovSim_WorkBursty},
+    {"ramp",   GovSim_WorkRamp},
+};
+
+#define GOVSIM_PROFILES                      (sizeof(g_GovSim_Profiles) / sizeof(g_GovSim_Profiles[0]))
+
+/* Periodic job: computes for the work of its release, the SysTick ISR preempts it */
+static void GovSim_JobTask(void)
+{
+    uint32 release = SysTick_GetTickCount();
+
+    Sim_Compute(g_GovSim_Profile->Work(release));
+
+    g_GovSim_Jobs++;
+    if (SysTick_GetTickCount() != release)
+    {
+        g_GovSim_Late++;
+    }
+}
+
+static void GovSim_TickTask(void)
+{
+    Sched_Tick();
+    Governor_Tick();
+}
+
+static void GovSim_TickTaskFixed(void)
+{
+    Sched_Tick();
+}
+
+/* One run of a profile with a policy, in the child process */
+static void GovSim_Run(const GovSim_ProfileType *a_Profile, uint8 a_Policy, uint32 a_Seconds)
+{
+    Sched_TaskStatsType task;
+    Governor_StatsType governor;
+    uint64 end_ns = (uint64)a_Seconds * 1000000000ULL;
+    uint64 energy_uj;
+    uint64 power_uw;
+
+    g_GovSim_Profile = a_Profile;
+    Sim_SetCycleLimit(0xFFFFFFFFFFFFFFFFULL);
+
+    if (a_Policy == GOVSIM_POLICY_FIXED_80MHZ)
+    {
+        (void)Clock_SetFrequency(CLOCK_SOURCE_PLL, CLOCK_MAX_HZ);
+    }
+
+    Sched_Init();
+    Sched_AddTask(GOVSIM_JOB_PRIORITY, GovSim_JobTask, 1, 0);
+    (void)SysTick_SetClockSource(SYSTICK_CLOCK_PIOSC_DIV4);
+    SysTick_Init(GOVSIM_TICK_MS);
+    SysTick_SetCallBack((a_Policy == GOVSIM_POLICY_GOVERNOR) ? GovSim_TickTask : GovSim_TickTaskFixed);
+    Idle_Init();
+    if (a_Policy == GOVSIM_POLICY_GOVERNOR)
+    {
+        (void)Governor_Init();
+    }
+    Enable_Exceptions();
+
+    while (Sim_GetTimeNs() < end_ns)
+    {
+        Sched_Dispatch();
+    }
+
+    Sched_GetTaskStats(GOVSIM_JOB_PRIORITY, &task);
+    Governor_GetStats(&governor);
+    energy_uj = Sim_GetEnergyUj();
+    power_uw  = (energy_uj * 1000000) / (Sim_GetTimeNs() / 1000);
+
+    printf("%-8s %-9s %6u %6u %7u %8llu.%03llu %6llu.%03llu %8u\n", a_Profile->Name, g_GovSim_PolicyNames[a_Policy],
+           SysTick_GetTickCount(), g_GovSim_Jobs, g_GovSim_Late + task.Overruns, energy_uj / 1000, energy_uj % 1000,
+           power_uw / 1000, power_uw % 1000, (a_Policy == GOVSIM_POLICY_GOVERNOR) ? governor.Switches : 0);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 seconds = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : GOVSIM_DEFAULT_SECONDS;
+    uint32 profile;
+    uint8 policy;
+    pid_t child;
+
+    if (seconds == 0)
+    {
+        printf("Usage: %s [seconds]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%-8s %-9s %6s %6s %7s %12s %10s %8s\n", "profile", "clock", "ticks", "jobs", "late", "energy mJ", "power mW",
+           "switches");
+    fflush(stdout);
+
+    /* The simulator state is global, each run starts from the reset state in a child process */
+    for (profile = 0; profile < GOVSIM_PROFILES; profile++)
+    {
+        for (policy = 0; policy < GOVSIM_POLICIES; policy++)
+        {
+            child = fork();
+            if (child == 0)
+            {
+                GovSim_Run(&g_GovSim_Profiles[profile], policy, seconds);
+                _exit(0);
+            }
+            if (child > 0)
+            {
+                (void)waitpid(child, NULL_PTR, 0);
+            }
+        }
+    }
+    return 0;
+}
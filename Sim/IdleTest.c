@@ -0,0 +1,211 @@
+/**************************************************************************************************************************************
+ Module      : IdleTest
+ Name        : IdleTest.c
+ Author      : Salma Hamdy
+ Description : Host check of the Idle sleep and total cycle accounting across system clock changes
+
+ Built with TM4C_SIM, the main loop computes a pseudo-random amount of work, from none to more than a tick, and sleeps with
+ Idle_DelayTicks, while the system clock is moved through PIOSC, PLL and MOSC frequencies and the Idle clock listener rescales
+ the cycles per tick and per counter clock. After every phase the Idle statistics are compared with the simulator: the sleep
+ cycles with the exact WFI time, within the register accesses around the WFI and one counter clock per sleep, and the total
+ cycles with the elapsed core cycles, within one tick per clock change. Sim_RunCases runs each case in its own child process:
+   - system clock counter: the SysTick counter on the system clock, one counter clock per core cycle;
+   - PIOSC / 4 counter:    the counter on PIOSC / 4, 20 then 12.5 core cycles per counter clock at 80 and 50 MHz.
+ The exit status is 1 when a check fails.
+
+ Usage: idletest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Clock.h"
+#include "Idle.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define IDLETEST_TICK_MS                     1
+#define IDLETEST_PHASE_TICKS                 300
+
+/* Core cycles taken around the WFI by the register reads of Idle_Sleep that the simulator does not count as sleep */
+#define IDLETEST_SLEEP_OVERHEAD              8
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Clock_SourceType Source;
+    uint32 FrequencyHz;
+}IdleTest_PhaseType;
+
+typedef struct
+{
+    SysTick_ClockSourceType CounterSource;
+    const IdleTest_PhaseType *Phases;
+    uint32 PhasesNum;
+}IdleTest_CounterType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Reset clock first, then the governor points and the low oscillator divisions */
+static const IdleTest_PhaseType g_IdleTest_SystemPhases[] =
+{
+    {CLOCK_SOURCE_PIOSC, 16000000UL},
+    {CLOCK_SOURCE_PLL,   80000000UL},
+    {CLOCK_SOURCE_PLL,   25000000UL},
+    {CLOCK_SOURCE_MOSC,   8000000UL},
+    {CLOCK_SOURCE_PLL,   50000000UL},
+    {CLOCK_SOURCE_PIOSC,  4000000UL},
+};
+
+/* 80 and 50 MHz give a whole and a fractional number of core cycles per PIOSC / 4 counter clock */
+static const IdleTest_PhaseType g_IdleTest_Piosc4Phases[] =
+{
+    {CLOCK_SOURCE_PIOSC, 16000000UL},
+    {CLOCK_SOURCE_PLL,   80000000UL},
+    {CLOCK_SOURCE_PLL,   50000000UL},
+    {CLOCK_SOURCE_MOSC,  16000000UL},
+    {CLOCK_SOURCE_PLL,   12500000UL},
+};
+
+static const IdleTest_CounterType g_IdleTest_SystemCounter =
+{
+    SYSTICK_CLOCK_SYSTEM, g_IdleTest_SystemPhases, sizeof(g_IdleTest_SystemPhases) / sizeof(g_IdleTest_SystemPhases[0])
+};
+
+static const IdleTest_CounterType g_IdleTest_Piosc4Counter =
+{
+    SYSTICK_CLOCK_PIOSC_DIV4, g_IdleTest_Piosc4Phases, sizeof(g_IdleTest_Piosc4Phases) / sizeof(g_IdleTest_Piosc4Phases[0])
+};
+
+static uint32 g_IdleTest_Random = 0x2468ACE1UL;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* xorshift32 */
+static uint32 IdleTest_Random(void)
+{
+    g_IdleTest_Random ^= g_IdleTest_Random << 13;
+    g_IdleTest_Random ^= g_IdleTest_Random >> 17;
+    g_IdleTest_Random ^= g_IdleTest_Random << 5;
+    return g_IdleTest_Random;
+}
+
+static uint64 IdleTest_Difference(uint64 a_Value, uint64 a_Reference)
+{
+    return (a_Value > a_Reference) ? (a_Value - a_Reference) : (a_Reference - a_Value);
+}
+
+static boolean IdleTest_Run(const Sim_CaseType *a_Case)
+{
+    const IdleTest_CounterType *counter = (const IdleTest_CounterType *)a_Case->Data;
+    Idle_StatsType stats;
+    uint64 start_cycles;
+    uint64 start_sleep;
+    uint64 sim_sleep;
+    uint64 idle_sleep = 0;
+    uint64 sleep_error;
+    uint64 total_error;
+    uint64 sleep_bound;
+    uint64 total_bound = 0;
+    uint32 cycles_per_count;
+    uint32 period_cycles;
+    uint32 sleeps;
+    uint32 phase;
+    uint32 tick;
+    boolean passed = TRUE;
+
+    (void)SysTick_SetClockSource(counter->CounterSource);
+    SysTick_Init(IDLETEST_TICK_MS);
+    Idle_Init();
+    Enable_Exceptions();
+
+    /* Align on a tick so the accounting starts with whole ticks */
+    Idle_DelayTicks(1);
+    Idle_Init();
+    start_cycles = Sim_GetCycles();
+    start_sleep  = Sim_GetSleepCycles();
+
+    printf("%s\n     clock  sleeps  sleep error (bound)  total error (bound)\n", a_Case->Name);
+    for (phase = 0; phase < counter->PhasesNum; phase++)
+    {
+        if (phase > 0)
+        {
+            if (!Clock_SetFrequency(counter->Phases[phase].Source, counter->Phases[phase].FrequencyHz))
+            {
+                printf("FAIL %s: switch to %u Hz refused\n", a_Case->Name, counter->Phases[phase].FrequencyHz);
+                return FALSE;
+            }
+        }
+        period_cycles    = SysTick_GetPeriodCycles();
+        cycles_per_count = (Clock_GetFrequency() + SysTick_GetCounterFrequency() - 1) / SysTick_GetCounterFrequency();
+
+        /* The tick running at the change is counted at the new clock, so each change may shift the total by one tick */
+        total_bound += (period_cycles > (Clock_GetFrequency() / 1000)) ? period_cycles : (Clock_GetFrequency() / 1000);
+
+        sim_sleep = Sim_GetSleepCycles();
+        Idle_GetStats(&stats);
+        idle_sleep = stats.SleepCycles;
+        sleeps = 0;
+        for (tick = 0; tick < IDLETEST_PHASE_TICKS; tick++)
+        {
+            /* From no work to one and a half tick, so the sleeps start anywhere in the period or are skipped */
+            Sim_Compute(IdleTest_Random() % ((period_cycles * 3) / 2));
+            Idle_DelayTicks(1);
+            sleeps++;
+        }
+
+        Idle_GetStats(&stats);
+        sim_sleep   = Sim_GetSleepCycles() - sim_sleep;
+        idle_sleep  = stats.SleepCycles - idle_sleep;
+        sleep_error = IdleTest_Difference(idle_sleep, sim_sleep);
+        sleep_bound = (uint64)sleeps * (IDLETEST_SLEEP_OVERHEAD + cycles_per_count);
+        total_error = IdleTest_Difference(stats.TotalCycles, Sim_GetCycles() - start_cycles);
+
+        printf("%10u %7u %12llu (%6llu) %12llu (%6llu)\n", Clock_GetFrequency(), sleeps, (unsigned long long)sleep_error,
+               (unsigned long long)sleep_bound, (unsigned long long)total_error, (unsigned long long)total_bound);
+
+        if ((sleep_error > sleep_bound) || (sim_sleep == 0))
+        {
+            printf("FAIL %s at %u Hz: %llu sleep cycles counted, %llu slept\n", a_Case->Name, Clock_GetFrequency(),
+                   (unsigned long long)idle_sleep, (unsigned long long)sim_sleep);
+            passed = FALSE;
+        }
+        if (total_error > total_bound)
+        {
+            printf("FAIL %s at %u Hz: %llu total cycles counted, %llu elapsed\n", a_Case->Name, Clock_GetFrequency(),
+                   (unsigned long long)stats.TotalCycles, (unsigned long long)(Sim_GetCycles() - start_cycles));
+            passed = FALSE;
+        }
+    }
+
+    Idle_GetStats(&stats);
+    if (IdleTest_Difference(stats.SleepCycles, Sim_GetSleepCycles() - start_sleep) >
+        ((uint64)counter->PhasesNum * IDLETEST_PHASE_TICKS * (IDLETEST_SLEEP_OVERHEAD + 20)))
+    {
+        printf("FAIL %s: %llu sleep cycles counted in all, %llu slept\n", a_Case->Name, (unsigned long long)stats.SleepCycles,
+               (unsigned long long)(Sim_GetSleepCycles() - start_sleep));
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static const Sim_CaseType g_IdleTest_Cases[] =
+{
+    {"system clock counter", IdleTest_Run, &g_IdleTest_SystemCounter},
+    {"PIOSC / 4 counter",    IdleTest_Run, &g_IdleTest_Piosc4Counter},
+};
+
+#define IDLETEST_CASES                       (sizeof(g_IdleTest_Cases) / sizeof(g_IdleTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_IdleTest_Cases, IDLETEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+/**************************************************************************************************************************************
+ Module      : IsrTimingTest
+ Name        : IsrTimingTest.c
+ Author      : Salma Hamdy
+ Description : Host check of the per-vector statistics of the ISR_TIMING trampolines
+
+ Built with TM4C_SIM and ISR_TIMING and linked with the startup file of App1, the simulator takes every exception through the
+ instrumented table of IsrTiming_Vectors.h. Three handlers run a known load with Sim_Compute: GPIO Port F at priority 5,
+ SysTick at priority 3 and GPIO Port A at priority 1 through IntDefaultHandler, whose Spurious_Handler is replaced here. Each
+ execution is expected to take its load plus the BiasCycles measured by IsrTiming_Init, and a handler that was preempted its
+ load plus at most ISRTIMINGTEST_NESTING_CYCLES for the entry, exit and trampoline of the nested ones, never their load.
+ Sim_RunCases runs each case in its own child process from the reset state of the simulator:
+   - loads:        several executions of two vectors give their count, total and maximum, the third one is never counted;
+   - nested:       GPIO Port F is preempted by SysTick, itself preempted by GPIO Port A;
+   - every cycle:  GPIO Port A is raised at each cycle from before GPIO Port F is taken to after it returns, including the
+                   trampoline entry and exit, GPIO Port F takes either its time alone or its time with a nested handler.
+ The exit status is 1 when a check fails.
+
+ Usage: isrtimingtest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "IsrTiming.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Cycles between a stimulus and the check of its effect, longer than every load */
+#define ISRTIMINGTEST_SETTLE_CYCLES          20000
+
+/* Upper bound of the time a nested handler adds to the one it preempts besides its load, at least its exception entry and exit */
+#define ISRTIMINGTEST_NESTING_CYCLES         64
+
+/* NVIC_SetPriorityIRQ writes the priority byte as given, the priority goes in its 3 implemented bits */
+#define ISRTIMINGTEST_IRQ_PRIORITY(LEVEL)    ((LEVEL) << 5)
+
+#define ISRTIMINGTEST_LOW_IRQ                30           /* GPIO Port F */
+#define ISRTIMINGTEST_HIGH_IRQ               0            /* GPIO Port A */
+#define ISRTIMINGTEST_LOW_VECTOR             46
+#define ISRTIMINGTEST_MID_VECTOR             15
+#define ISRTIMINGTEST_HIGH_VECTOR            16
+
+#define ISRTIMINGTEST_SWEEP_LOW_LOAD         200
+#define ISRTIMINGTEST_SWEEP_HIGH_LOAD        300
+#define ISRTIMINGTEST_SWEEP_START            10           /* Cycles from the sweep start to the GPIO Port F stimulus */
+#define ISRTIMINGTEST_SWEEP_CYCLES           (ISRTIMINGTEST_SWEEP_LOW_LOAD + 100)
+
+/* SysTick pend bit of the Interrupt Control and State register */
+#define ISRTIMINGTEST_PENDSTSET_MASK         0x04000000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    ISRTIMINGTEST_LOW, ISRTIMINGTEST_MID, ISRTIMINGTEST_HIGH, ISRTIMINGTEST_LEVELS
+}IsrTimingTest_LevelType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Load of the next execution of each handler, and whether it pends the next level halfway through it */
+static uint32 g_IsrTimingTest_Load[ISRTIMINGTEST_LEVELS];
+static boolean g_IsrTimingTest_Nest[ISRTIMINGTEST_LEVELS];
+
+static uint32 g_IsrTimingTest_Bias;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void IsrTimingTest_Pend(IsrTimingTest_LevelType a_Level)
+{
+    switch (a_Level)
+    {
+    case ISRTIMINGTEST_LOW:  Sim_PendIrq(ISRTIMINGTEST_LOW_IRQ, Sim_GetCycles());                   break;
+    case ISRTIMINGTEST_MID:  HW_WRITE32(NVIC_SYSTEM_INTCTRL, ISRTIMINGTEST_PENDSTSET_MASK);         break;
+    default:                 Sim_PendIrq(ISRTIMINGTEST_HIGH_IRQ, Sim_GetCycles());                  break;
+    }
+}
+
+static void IsrTimingTest_Run(IsrTimingTest_LevelType a_Level)
+{
+    uint32 load = g_IsrTimingTest_Load[a_Level];
+
+    Sim_Compute(load / 2);
+    if (g_IsrTimingTest_Nest[a_Level])
+    {
+        IsrTimingTest_Pend(a_Level + 1);
+    }
+    Sim_Compute(load - (load / 2));
+}
+
+void GPIOPortF_Handler(void)
+{
+    IsrTimingTest_Run(ISRTIMINGTEST_LOW);
+}
+
+void SysTick_Handler(void)
+{
+    IsrTimingTest_Run(ISRTIMINGTEST_MID);
+}
+
+/* Called by IntDefaultHandler, GPIO Port A is the only IRQ without a handler raised here */
+void Spurious_Handler(void)
+{
+    IsrTimingTest_Run(ISRTIMINGTEST_HIGH);
+}
+
+static void IsrTimingTest_Setup(void)
+{
+    IsrTiming_OverheadType overhead;
+
+    IsrTiming_Init();
+    IsrTiming_GetOverhead(&overhead);
+    g_IsrTimingTest_Bias = overhead.BiasCycles;
+
+    NVIC_SetPriorityIRQ(ISRTIMINGTEST_LOW_IRQ, ISRTIMINGTEST_IRQ_PRIORITY(5));
+    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, 3);
+    NVIC_SetPriorityIRQ(ISRTIMINGTEST_HIGH_IRQ, ISRTIMINGTEST_IRQ_PRIORITY(1));
+    NVIC_EnableIRQ(ISRTIMINGTEST_LOW_IRQ);
+    NVIC_EnableIRQ(ISRTIMINGTEST_HIGH_IRQ);
+    Enable_Exceptions();
+}
+
+/* Raise one level with the given load and run until every handler has returned */
+static void IsrTimingTest_Raise(IsrTimingTest_LevelType a_Level, uint32 a_Load)
+{
+    g_IsrTimingTest_Load[a_Level] = a_Load;
+    IsrTimingTest_Pend(a_Level);
+    Sim_Compute(ISRTIMINGTEST_SETTLE_CYCLES);
+}
+
+static boolean IsrTimingTest_Expect(const char *a_What, uint8 a_Vector, uint32 a_Count, uint64 a_Total, uint32 a_Max)
+{
+    IsrTiming_StatsType stats;
+
+    if (!IsrTiming_GetStats(a_Vector, &stats) || (stats.Count != a_Count) || (stats.TotalCycles != a_Total) ||
+        (stats.MaxCycles != a_Max) || (stats.FpuUses != 0))
+    {
+        printf("FAIL %s: vector %u count %u total %llu max %u fpu %u, expected %u, %llu and %u\n", a_What, a_Vector,
+               stats.Count, stats.TotalCycles, stats.MaxCycles, stats.FpuUses, a_Count, a_Total, a_Max);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* One execution of a preempted handler: its load and the overhead of the nested handlers, without their load */
+static boolean IsrTimingTest_ExpectPreempted(const char *a_What, uint8 a_Vector, uint32 a_Load)
+{
+    IsrTiming_StatsType stats;
+    uint32 own = a_Load + g_IsrTimingTest_Bias;
+    uint32 min = own + SIM_STACKING_CYCLES + SIM_UNSTACKING_CYCLES;
+
+    if (!IsrTiming_GetStats(a_Vector, &stats) || (stats.Count != 1) || (stats.TotalCycles != stats.MaxCycles) ||
+        (stats.MaxCycles < min) || (stats.MaxCycles > (own + ISRTIMINGTEST_NESTING_CYCLES)))
+    {
+        printf("FAIL %s: vector %u count %u max %u, expected once with %u to %u cycles\n", a_What, a_Vector, stats.Count,
+               stats.MaxCycles, min, own + ISRTIMINGTEST_NESTING_CYCLES);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static boolean IsrTimingTest_Loads(const Sim_CaseType *a_Case)
+{
+    static const uint32 low_loads[]  = {1000, 3000, 2000};
+    static const uint32 high_loads[] = {500, 700};
+    uint32 bias;
+    boolean passed = TRUE;
+    uint32 i;
+
+    (void)a_Case;
+    IsrTimingTest_Setup();
+    bias = g_IsrTimingTest_Bias;
+    for (i = 0; i < (sizeof(low_loads) / sizeof(low_loads[0])); i++)
+    {
+        IsrTimingTest_Raise(ISRTIMINGTEST_LOW, low_loads[i]);
+    }
+    for (i = 0; i < (sizeof(high_loads) / sizeof(high_loads[0])); i++)
+    {
+        IsrTimingTest_Raise(ISRTIMINGTEST_HIGH, high_loads[i]);
+    }
+
+    passed &= IsrTimingTest_Expect("GPIO Port F", ISRTIMINGTEST_LOW_VECTOR, 3, 6000 + (3 * bias), 3000 + bias);
+    passed &= IsrTimingTest_Expect("GPIO Port A", ISRTIMINGTEST_HIGH_VECTOR, 2, 1200 + (2 * bias), 700 + bias);
+    passed &= IsrTimingTest_Expect("SysTick", ISRTIMINGTEST_MID_VECTOR, 0, 0, 0);
+
+    IsrTiming_Reset();
+    passed &= IsrTimingTest_Expect("GPIO Port F after the reset", ISRTIMINGTEST_LOW_VECTOR, 0, 0, 0);
+    return passed;
+}
+
+static boolean IsrTimingTest_Nested(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+
+    (void)a_Case;
+    IsrTimingTest_Setup();
+    g_IsrTimingTest_Load[ISRTIMINGTEST_MID]  = 2000;
+    g_IsrTimingTest_Load[ISRTIMINGTEST_HIGH] = 1000;
+    g_IsrTimingTest_Nest[ISRTIMINGTEST_LOW]  = TRUE;
+    g_IsrTimingTest_Nest[ISRTIMINGTEST_MID]  = TRUE;
+    IsrTimingTest_Raise(ISRTIMINGTEST_LOW, 4000);
+
+    passed &= IsrTimingTest_Expect("GPIO Port A", ISRTIMINGTEST_HIGH_VECTOR, 1, 1000 + g_IsrTimingTest_Bias,
+                                   1000 + g_IsrTimingTest_Bias);
+    passed &= IsrTimingTest_ExpectPreempted("SysTick", ISRTIMINGTEST_MID_VECTOR, 2000);
+    passed &= IsrTimingTest_ExpectPreempted("GPIO Port F", ISRTIMINGTEST_LOW_VECTOR, 4000);
+    return passed;
+}
+
+static boolean IsrTimingTest_EveryCycle(const Sim_CaseType *a_Case)
+{
+    IsrTiming_StatsType low;
+    IsrTiming_StatsType high;
+    uint32 alone;
+    uint32 preempted = 0;
+    uint32 alone_runs = 0;
+    uint32 preempted_runs = 0;
+    uint64 start;
+    uint32 offset;
+    boolean passed = TRUE;
+
+    (void)a_Case;
+    IsrTimingTest_Setup();
+    alone = ISRTIMINGTEST_SWEEP_LOW_LOAD + g_IsrTimingTest_Bias;
+    g_IsrTimingTest_Load[ISRTIMINGTEST_LOW]  = ISRTIMINGTEST_SWEEP_LOW_LOAD;
+    g_IsrTimingTest_Load[ISRTIMINGTEST_HIGH] = ISRTIMINGTEST_SWEEP_HIGH_LOAD;
+
+    for (offset = 0; passed && (offset < ISRTIMINGTEST_SWEEP_CYCLES); offset++)
+    {
+        IsrTiming_Reset();
+        start = Sim_GetCycles() + ISRTIMINGTEST_SWEEP_START;
+        Sim_PendIrq(ISRTIMINGTEST_LOW_IRQ, start);
+        Sim_PendIrq(ISRTIMINGTEST_HIGH_IRQ, start + offset);
+        Sim_Compute(ISRTIMINGTEST_SETTLE_CYCLES);
+
+        /* The first preemption gives the time of every other one, it is checked against the bounds of a preempted run */
+        (void)IsrTiming_GetStats(ISRTIMINGTEST_LOW_VECTOR, &low);
+        if ((preempted == 0) && (low.MaxCycles != alone))
+        {
+            preempted = low.MaxCycles;
+            passed &= IsrTimingTest_ExpectPreempted("first preemption", ISRTIMINGTEST_LOW_VECTOR,
+                                                    ISRTIMINGTEST_SWEEP_LOW_LOAD);
+        }
+
+        (void)IsrTiming_GetStats(ISRTIMINGTEST_HIGH_VECTOR, &high);
+        if ((high.Count != 1) || (high.MaxCycles != (ISRTIMINGTEST_SWEEP_HIGH_LOAD + g_IsrTimingTest_Bias)) ||
+            (low.Count != 1) || ((low.MaxCycles != alone) && (low.MaxCycles != preempted)))
+        {
+            printf("FAIL GPIO Port A %u cycles after GPIO Port F: counts %u and %u, %u and %u cycles, expected %u, and "
+                   "%u or %u\n", offset, high.Count, low.Count, high.MaxCycles, low.MaxCycles,
+                   ISRTIMINGTEST_SWEEP_HIGH_LOAD + g_IsrTimingTest_Bias, alone, preempted);
+            passed = FALSE;
+        }
+        alone_runs     += (low.MaxCycles == alone) ? 1 : 0;
+        preempted_runs += (low.MaxCycles == preempted) ? 1 : 0;
+    }
+
+    if (passed && ((alone_runs == 0) || (preempted_runs < ISRTIMINGTEST_SWEEP_LOW_LOAD)))
+    {
+        printf("FAIL GPIO Port F ran %u times alone and %u times preempted\n", alone_runs, preempted_runs);
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static const Sim_CaseType g_IsrTimingTest_Cases[] =
+{
+    {"loads",       IsrTimingTest_Loads,      NULL_PTR},
+    {"nested",      IsrTimingTest_Nested,     NULL_PTR},
+    {"every cycle", IsrTimingTest_EveryCycle, NULL_PTR},
+};
+
+#define ISRTIMINGTEST_CASES                  (sizeof(g_IsrTimingTest_Cases) / sizeof(g_IsrTimingTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_IsrTimingTest_Cases, ISRTIMINGTEST_CASES) ? 0 : 1;
+}
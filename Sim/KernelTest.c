@@ -0,0 +1,373 @@
+/**************************************************************************************************************************************
+ Module      : KernelTest
+ Name        : KernelTest.c
+ Author      : Salma Hamdy
+ Description : Host test of the kernel ready bitmap, sleep delta list and round robin against the simulated tick
+
+ Built with TM4C_SIM, it links Kernel.c unchanged with a PendSV_Handler and a Kernel_StartFirstThread that only switch
+ g_Kernel_CurrentTcb to g_Kernel_NextTcb, in place of the context switch of Kernel_PendSV.asm. The thread functions are never
+ entered: the main loop plays the running thread and calls the kernel services on its behalf, Wait_For_Interrupt lets the
+ simulated 1 ms tick run Kernel_Tick. Sim_RunCases runs each case in its own child process from the reset state of the simulator:
+   - pick:         the most urgent ready thread (CLZ of the ready bitmap) runs first, a thread created or woken at a more
+                   urgent priority preempts the running one at once;
+   - sleep:        threads sleeping through scripted delays must run again exactly on the tick their delays add up to, the
+                   threads woken together in priority order, and the idle thread must run while all of them sleep;
+   - pending tick: a thread that sleeps while the tick is pending, and is woken by that tick before PendSV runs, must keep
+                   running without a switch;
+   - rotate:       threads of the same priority must share it in KERNEL_TIME_SLICE_TICKS slices, a Kernel_Yield hands over at
+                   once, and a less urgent thread must never run.
+ The exit status is 1 when a case fails.
+
+ Usage: kerneltest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Kernel.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define KERNELTEST_TICK_MS                   1
+#define KERNELTEST_TICK_CYCLES               16000UL      /* 1 ms at the 16 MHz PIOSC reset clock */
+#define KERNELTEST_MAX_THREADS               8
+#define KERNELTEST_STACK_WORDS               64
+#define KERNELTEST_MAX_LOG                   256
+#define KERNELTEST_MAX_STEPS                 6
+
+/* Sleep long enough to stay asleep until the end of a case */
+#define KERNELTEST_SLEEP_FOREVER             0xFFFFFFFFUL
+
+#define KERNELTEST_SLEEP_TICKS               40
+#define KERNELTEST_ROTATE_TICKS              60
+#define KERNELTEST_ROTATE_THREADS            3
+#define KERNELTEST_ROTATE_YIELD_TICK         23
+
+/* Index of the idle thread in the switch log */
+#define KERNELTEST_IDLE                      0xFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Thread of the sleep case: priority and the ticks of its successive sleeps, 0 ends the script */
+typedef struct
+{
+    Kernel_PriorityType Priority;
+    uint32 Sleeps[KERNELTEST_MAX_STEPS];
+}KernelTest_ScriptType;
+
+typedef struct
+{
+    uint8 Thread;            /* Index of the thread switched in, KERNELTEST_IDLE for the idle thread */
+    uint32 Tick;
+}KernelTest_SwitchType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+/* Defined in Kernel.c for Kernel_PendSV.asm, not part of the API */
+extern Kernel_TcbType * volatile g_Kernel_CurrentTcb;
+extern Kernel_TcbType * volatile g_Kernel_NextTcb;
+
+static Kernel_TcbType g_KernelTest_Tcb[KERNELTEST_MAX_THREADS];
+static uint32 g_KernelTest_Stack[KERNELTEST_MAX_THREADS][KERNELTEST_STACK_WORDS];
+
+/* Threads switched in by PendSV, in order */
+static KernelTest_SwitchType g_KernelTest_Log[KERNELTEST_MAX_LOG];
+static uint32 g_KernelTest_LogCount = 0;
+
+/* Staggered sleeps: several threads wake on ticks 3, 10 and 13, thread 3 sleeps one tick at a time */
+static const KernelTest_ScriptType g_KernelTest_Scripts[] =
+{
+    {2, { 7, 3, 10}},
+    {6, { 3, 3,  4, 20}},
+    {4, { 3, 7}},
+    {9, {10, 1,  1,  1}},
+    {1, {13, 5}},
+};
+
+#define KERNELTEST_SCRIPTS                   (sizeof(g_KernelTest_Scripts) / sizeof(g_KernelTest_Scripts[0]))
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Thread functions are never entered on the host */
+static void KernelTest_Thread(void)
+{
+}
+
+static uint8 KernelTest_Index(const Kernel_TcbType *a_Tcb)
+{
+    if ((a_Tcb >= &g_KernelTest_Tcb[0]) && (a_Tcb < &g_KernelTest_Tcb[KERNELTEST_MAX_THREADS]))
+    {
+        return (uint8)(a_Tcb - &g_KernelTest_Tcb[0]);
+    }
+    return KERNELTEST_IDLE;
+}
+
+static void KernelTest_Switch(void)
+{
+    g_Kernel_CurrentTcb = g_Kernel_NextTcb;
+
+    if (g_KernelTest_LogCount < KERNELTEST_MAX_LOG)
+    {
+        g_KernelTest_Log[g_KernelTest_LogCount].Thread = KernelTest_Index(g_Kernel_CurrentTcb);
+        g_KernelTest_Log[g_KernelTest_LogCount].Tick   = Kernel_GetTickCount();
+        g_KernelTest_LogCount++;
+    }
+}
+
+/* Stand-ins of the Kernel_PendSV.asm routines: switch the running TCB, no register context */
+void PendSV_Handler(void)
+{
+    KernelTest_Switch();
+}
+
+void Kernel_StartFirstThread(void)
+{
+    KernelTest_Switch();
+    Enable_Exceptions();
+}
+
+static boolean KernelTest_Create(uint8 a_Thread, Kernel_PriorityType a_Priority)
+{
+    return Kernel_CreateThread(&g_KernelTest_Tcb[a_Thread], KernelTest_Thread, g_KernelTest_Stack[a_Thread],
+                               KERNELTEST_STACK_WORDS, a_Priority);
+}
+
+static void KernelTest_Start(void)
+{
+    SysTick_SetCallBack(Kernel_Tick);
+    SysTick_Init(KERNELTEST_TICK_MS);
+    Kernel_Start();
+}
+
+static uint8 KernelTest_Current(void)
+{
+    return KernelTest_Index(g_Kernel_CurrentTcb);
+}
+
+/* Compare the switch log with the expected threads, ticks are checked when the expected tick list is given */
+static boolean KernelTest_CheckLog(const char *a_Case, const uint8 *a_Threads, const uint32 *a_Ticks, uint32 a_Count)
+{
+    uint32 entry;
+    boolean passed = (g_KernelTest_LogCount == a_Count);
+
+    for (entry = 0; passed && (entry < a_Count); entry++)
+    {
+        passed = (g_KernelTest_Log[entry].Thread == a_Threads[entry]) &&
+                 ((a_Ticks == NULL_PTR) || (g_KernelTest_Log[entry].Tick == a_Ticks[entry]));
+    }
+
+    if (!passed)
+    {
+        printf("FAIL %s: switches", a_Case);
+        for (entry = 0; entry < g_KernelTest_LogCount; entry++)
+        {
+            printf(" %u@%u", g_KernelTest_Log[entry].Thread, g_KernelTest_Log[entry].Tick);
+        }
+        printf("\n");
+    }
+    return passed;
+}
+
+/* CLZ pick at start, preemption by a created thread and by a woken thread */
+static boolean KernelTest_Pick(const Sim_CaseType *a_Case)
+{
+    static const uint8  threads[] = {1, 0, 2, 0, 1, 0, 2, 0};
+    static const uint32 ticks[]   = {0, 0, 1, 1, 2, 2, 6, 6};
+    boolean passed = TRUE;
+
+    Kernel_Init();
+    passed &= KernelTest_Create(0, 5);
+    passed &= KernelTest_Create(1, 3);
+    KernelTest_Start();
+
+    Kernel_Sleep(2);                            /* Thread 1 (priority 3) sleeps, thread 0 (priority 5) runs */
+    Wait_For_Interrupt();
+    passed &= KernelTest_Create(2, 1);          /* Created by thread 0 in tick 1, preempts it */
+    Kernel_Sleep(5);                            /* Thread 2 sleeps until tick 6 */
+    Wait_For_Interrupt();                       /* Tick 2: thread 1 wakes up and preempts thread 0 */
+    Kernel_Sleep(KERNELTEST_SLEEP_FOREVER);
+    while (Kernel_GetTickCount() < 6)
+    {
+        Wait_For_Interrupt();                   /* Tick 6: thread 2 wakes up */
+    }
+    Kernel_Sleep(KERNELTEST_SLEEP_FOREVER);
+
+    passed &= KernelTest_CheckLog(a_Case->Name, threads, ticks, sizeof(threads));
+    printf("pick:   %u switches\n", g_KernelTest_LogCount);
+    return passed;
+}
+
+/* Scripted sleeps, each thread sleeps again as soon as it runs */
+static boolean KernelTest_Sleep(const Sim_CaseType *a_Case)
+{
+    uint8  threads[KERNELTEST_MAX_LOG];
+    uint32 ticks[KERNELTEST_MAX_LOG];
+    uint32 wake[KERNELTEST_SCRIPTS];
+    uint8  step[KERNELTEST_SCRIPTS] = {0};
+    uint32 expected = 0;
+    uint32 tick;
+    uint8  thread;
+    uint8  best;
+    boolean passed = TRUE;
+
+    Kernel_Init();
+    for (thread = 0; thread < KERNELTEST_SCRIPTS; thread++)
+    {
+        passed &= KernelTest_Create(thread, g_KernelTest_Scripts[thread].Priority);
+        wake[thread] = 0;
+    }
+
+    /* Expected switches: in each tick the woken threads by priority, then the idle thread */
+    for (tick = 0; tick < KERNELTEST_SLEEP_TICKS; tick++)
+    {
+        do
+        {
+            best = KERNELTEST_IDLE;
+            for (thread = 0; thread < KERNELTEST_SCRIPTS; thread++)
+            {
+                if ((wake[thread] == tick) && ((best == KERNELTEST_IDLE) ||
+                    (g_KernelTest_Scripts[thread].Priority < g_KernelTest_Scripts[best].Priority)))
+                {
+                    best = thread;
+                }
+            }
+            if (best != KERNELTEST_IDLE)
+            {
+                threads[expected] = best;
+                ticks[expected++] = tick;
+                wake[best] = (g_KernelTest_Scripts[best].Sleeps[step[best]] != 0) ?
+                             (tick + g_KernelTest_Scripts[best].Sleeps[step[best]++]) : KERNELTEST_SLEEP_FOREVER;
+            }
+        } while (best != KERNELTEST_IDLE);
+
+        threads[expected] = KERNELTEST_IDLE;
+        ticks[expected++] = tick;
+    }
+    memset(step, 0, sizeof(step));
+
+    KernelTest_Start();
+    while (Kernel_GetTickCount() < KERNELTEST_SLEEP_TICKS)
+    {
+        /* Every running thread sleeps for its next delay, then the idle thread waits for the next tick */
+        while ((thread = KernelTest_Current()) != KERNELTEST_IDLE)
+        {
+            Kernel_Sleep((g_KernelTest_Scripts[thread].Sleeps[step[thread]] != 0) ?
+                         g_KernelTest_Scripts[thread].Sleeps[step[thread]++] : KERNELTEST_SLEEP_FOREVER);
+        }
+        if (Kernel_GetTickCount() == (KERNELTEST_SLEEP_TICKS - 1))
+        {
+            break;
+        }
+        Wait_For_Interrupt();
+    }
+
+    /* A tick that wakes no thread switches nothing, only the ticks with a switch are logged */
+    for (tick = 0, thread = 0; tick < expected; tick++)
+    {
+        if ((threads[tick] != KERNELTEST_IDLE) || (tick == 0) || (threads[tick - 1] != KERNELTEST_IDLE))
+        {
+            threads[thread] = threads[tick];
+            ticks[thread++] = ticks[tick];
+        }
+    }
+
+    passed &= KernelTest_CheckLog(a_Case->Name, threads, ticks, thread);
+    printf("sleep:  %u switches\n", g_KernelTest_LogCount);
+    return passed;
+}
+
+/* A sleep that pends PendSV with the tick already pending: the tick wakes the thread before the switch, so it keeps running */
+static boolean KernelTest_PendingTick(const Sim_CaseType *a_Case)
+{
+    static const uint8  threads[] = {1, 0};
+    static const uint32 ticks[]   = {0, 2};
+    boolean passed = TRUE;
+
+    Kernel_Init();
+    passed &= KernelTest_Create(0, 5);
+    passed &= KernelTest_Create(1, 3);
+    KernelTest_Start();
+
+    Wait_For_Interrupt();                       /* Tick 1 */
+    Disable_Exceptions();
+    Sim_Compute(KERNELTEST_TICK_CYCLES);        /* Tick 2 is pending */
+    Kernel_Sleep(1);                            /* Targets thread 0, then tick 2 wakes thread 1 before PendSV runs */
+    if ((KernelTest_Current() != 1) || (Kernel_GetTickCount() != 2))
+    {
+        printf("FAIL %s: thread %u runs in tick %u after the sleep, thread 1 is ready\n", a_Case->Name, KernelTest_Current(),
+               Kernel_GetTickCount());
+        passed = FALSE;
+    }
+    Kernel_Sleep(KERNELTEST_SLEEP_FOREVER);
+
+    passed &= KernelTest_CheckLog(a_Case->Name, threads, ticks, sizeof(threads));
+    printf("pending tick: %u switches\n", g_KernelTest_LogCount);
+    return passed;
+}
+
+/* Time slices between equal priorities, with a yield in the middle of a slice */
+static boolean KernelTest_Rotate(const Sim_CaseType *a_Case)
+{
+    uint8 current = 0;
+    uint8 slice = KERNEL_TIME_SLICE_TICKS;
+    uint32 tick;
+    boolean passed = TRUE;
+
+    Kernel_Init();
+    for (current = 0; current < KERNELTEST_ROTATE_THREADS; current++)
+    {
+        passed &= KernelTest_Create(current, 4);
+    }
+    passed &= KernelTest_Create(KERNELTEST_ROTATE_THREADS, 9);    /* Less urgent, must starve */
+    KernelTest_Start();
+
+    current = 0;
+    for (tick = 0; tick < KERNELTEST_ROTATE_TICKS; tick++)
+    {
+        if (tick == KERNELTEST_ROTATE_YIELD_TICK)
+        {
+            Kernel_Yield();
+            current = (current + 1) % KERNELTEST_ROTATE_THREADS;
+            slice   = KERNEL_TIME_SLICE_TICKS;
+        }
+
+        if (KernelTest_Current() != current)
+        {
+            printf("FAIL %s: thread %u runs in tick %u, expected %u\n", a_Case->Name, KernelTest_Current(), tick, current);
+            passed = FALSE;
+        }
+
+        Wait_For_Interrupt();
+        if (--slice == 0)
+        {
+            current = (current + 1) % KERNELTEST_ROTATE_THREADS;
+            slice   = KERNEL_TIME_SLICE_TICKS;
+        }
+    }
+
+    printf("rotate: %u switches\n", g_KernelTest_LogCount);
+    return passed;
+}
+
+static const Sim_CaseType g_KernelTest_Cases[] =
+{
+    {"pick",         KernelTest_Pick,        NULL_PTR},
+    {"sleep",        KernelTest_Sleep,       NULL_PTR},
+    {"pending tick", KernelTest_PendingTick, NULL_PTR},
+    {"rotate",       KernelTest_Rotate,      NULL_PTR},
+};
+
+#define KERNELTEST_CASES                     (sizeof(g_KernelTest_Cases) / sizeof(g_KernelTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_KernelTest_Cases, KERNELTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/**************************************************************************************************************************************
+ Module      : LogTest
+ Name        : LogTest.c
+ Author      : Salma Hamdy
+ Description : Host producer of the trace log round trip checked by Tools/test_log_decode.py
+
+ Built with TM4C_SIM, it logs a known sequence of records and writes them in the two forms Tools/log_decode.py reads: the words
+ copied out by Log_Drain and a memory dump holding g_Log. Record k has k % 5 arguments, 0x80000000 | (k << 8) | argument index,
+ under LOG_SW2_PRESSED (1 argument), LOG_CPU_LOAD (3 arguments) or the first id past the table (0, 2 and 4 arguments). It is
+ logged LOGTEST_STEP_CYCLES after record k - 1, the DWT counter starts LOGTEST_WRAP_RECORDS records before its 32-bit wrap.
+   - records 0 to 39:   logged, then drained in one call, the tail moves to word 160;
+   - records 40 to 109: logged until the ring is full, the records that do not fit are dropped and a smaller one after them
+                        can still fit. The ring then holds words 160 to 415, across the end of the buffer;
+   - dump:              g_Log is written at offset LOGTEST_DUMP_OFFSET of the dump file, after other RAM words;
+   - drain:             the second batch is drained LOGTEST_DRAIN_WORDS words at a time, which ends some calls before a record
+                        that does not fit in the words left.
+ The exit status is 1 when a file cannot be written.
+
+ Usage: logtest <drained file> <dump file>
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include "tm4c123gh6pm_registers.h"
+#include "Log.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define LOGTEST_STEP_CYCLES                  16000UL      /* 1 ms at the 16 MHz PIOSC reset clock */
+#define LOGTEST_WRAP_RECORDS                 50
+#define LOGTEST_FIRST_BATCH                  40
+#define LOGTEST_RECORDS                      110
+#define LOGTEST_DRAIN_WORDS                  7
+#define LOGTEST_DUMP_OFFSET                  12           /* Bytes of other variables before g_Log in the dump */
+
+/* Id past the LOG_FORMAT table, decoded with the raw arguments */
+#define LOGTEST_UNKNOWN_ID                   ((Log_IdType)LOG_FORMATS)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+static uint32 g_LogTest_Drained[LOGTEST_RECORDS * LOG_RECORD_WORDS(LOG_MAX_ARGS)];
+static uint32 g_LogTest_DrainedWords = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Log record k at its cycle, the DWT read of Log_Event comes the same number of cycles after the start of each record */
+static void LogTest_Record(uint32 a_Record, uint64 a_StartCycle)
+{
+    uint32 arg = 0x80000000UL | (a_Record << 8);
+
+    Sim_Compute(a_StartCycle + ((uint64)a_Record * LOGTEST_STEP_CYCLES) - Sim_GetCycles());
+    switch (a_Record % 5)
+    {
+    case 0:  LOG_EVENT0(LOGTEST_UNKNOWN_ID);                                         break;
+    case 1:  LOG_EVENT1(LOG_SW2_PRESSED, arg);                                       break;
+    case 2:  LOG_EVENT2(LOGTEST_UNKNOWN_ID, arg, arg | 1);                           break;
+    case 3:  LOG_EVENT3(LOG_CPU_LOAD, arg, arg | 1, arg | 2);                        break;
+    default: LOG_EVENT4(LOGTEST_UNKNOWN_ID, arg, arg | 1, arg | 2, arg | 3);         break;
+    }
+}
+
+static void LogTest_Drain(uint32 a_MaxWords)
+{
+    uint32 copied;
+
+    do
+    {
+        copied = Log_Drain(&g_LogTest_Drained[g_LogTest_DrainedWords], a_MaxWords);
+        g_LogTest_DrainedWords += copied;
+    } while (copied != 0);
+}
+
+static boolean LogTest_Write(const char *a_Path, const void *a_Data, uint32 a_Bytes, uint32 a_Offset)
+{
+    static const uint8 other[LOGTEST_DUMP_OFFSET] = {0x11, 0x22, 0x33, 0x44, 0x54, 0x4C, 0x4F, 0x00};
+    FILE *file = fopen(a_Path, "wb");
+    boolean written;
+
+    if (file == NULL_PTR)
+    {
+        printf("FAIL cannot open %s\n", a_Path);
+        return FALSE;
+    }
+    written = (fwrite(other, 1, a_Offset, file) == a_Offset) && (fwrite(a_Data, 1, a_Bytes, file) == a_Bytes);
+    written = (fclose(file) == 0) && written;
+    if (!written)
+    {
+        printf("FAIL cannot write %s\n", a_Path);
+    }
+    return written;
+}
+
+int main(int argc, char *argv[])
+{
+    uint64 start_cycle;
+    uint32 record;
+    boolean passed;
+
+    if (argc != 3)
+    {
+        printf("Usage: %s <drained file> <dump file>\n", argv[0]);
+        return 2;
+    }
+
+    Sim_SetCycleLimit(0xFFFFFFFFFFFFFFFFULL);
+    Log_Init();
+    DWT_CYCCNT_REG = 0xFFFFFFFFUL - (LOGTEST_WRAP_RECORDS * LOGTEST_STEP_CYCLES) + 1;
+    start_cycle = Sim_GetCycles() + LOGTEST_STEP_CYCLES;
+
+    for (record = 0; record < LOGTEST_FIRST_BATCH; record++)
+    {
+        LogTest_Record(record, start_cycle);
+    }
+    LogTest_Drain(sizeof(g_LogTest_Drained) / sizeof(g_LogTest_Drained[0]));
+
+    for (; record < LOGTEST_RECORDS; record++)
+    {
+        LogTest_Record(record, start_cycle);
+    }
+
+    passed = LogTest_Write(argv[2], &g_Log, sizeof(g_Log), LOGTEST_DUMP_OFFSET);
+    LogTest_Drain(LOGTEST_DRAIN_WORDS);
+    passed = LogTest_Write(argv[1], g_LogTest_Drained, g_LogTest_DrainedWords * sizeof(uint32), 0) && passed;
+
+    printf("%u records, %u words drained, %u dropped\n", LOGTEST_RECORDS, g_LogTest_DrainedWords, g_Log.Dropped);
+    return passed ? 0 : 1;
+}
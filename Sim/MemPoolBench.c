@@ -0,0 +1,225 @@
+/**************************************************************************************************************************************
+ Module      : MemPoolBench
+ Name        : MemPoolBench.c
+ Author      : Salma Hamdy
+ Description : Host benchmark of the fixed-block memory pool against malloc and free
+
+ Both allocators serve blocks of the same size in three patterns: an allocation freed at once, as an ISR that posts a message
+ handled in the same tick, a burst of allocations freed in reverse order, and a burst freed in a shuffled order, as timers that
+ expire out of order. The mean cost of an allocation and free pair is printed for both, and the slowest single pair, which is
+ the one an ISR has to budget for. Host timings only show the relative cost: on the Cortex M4 MemPool_Alloc and MemPool_Free are
+ a bounded LDREX/STREX loop each and the TI run-time malloc is not usable from an ISR at all.
+
+ Usage: mempoolbench [pairs]      (allocation and free pairs per pattern, 2^22 by default)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "MemPool.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define MEMPOOLBENCH_DEFAULT_PAIRS           (1UL << 22)
+#define MEMPOOLBENCH_BLOCK_SIZE              32
+#define MEMPOOLBENCH_BURST                   64
+#define MEMPOOLBENCH_TIMED_PAIRS             (1UL << 16)        /* Pairs timed one by one for the slowest pair */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    MEMPOOLBENCH_PATTERN_PAIR, MEMPOOLBENCH_PATTERN_REVERSE, MEMPOOLBENCH_PATTERN_SHUFFLED
+}MemPoolBench_PatternType;
+
+typedef struct
+{
+    const char *Name;
+    void *(*Alloc)(void);
+    void (*Free)(void *a_Block);
+}MemPoolBench_AllocatorType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+MEMPOOL_DEFINE_STORAGE(g_MemPoolBench_Storage, MEMPOOLBENCH_BLOCK_SIZE, MEMPOOLBENCH_BURST + 1);
+
+static MemPool_Type g_MemPoolBench_Pool;
+
+/* Free order of the shuffled bursts */
+static uint32 g_MemPoolBench_Order[MEMPOOLBENCH_BURST];
+
+static const char *const g_MemPoolBench_Patterns[] = {"alloc then free", "burst, reverse free", "burst, shuffled free"};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint64 MemPoolBench_NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
+}
+
+static void *MemPoolBench_PoolAlloc(void)
+{
+    return MemPool_Alloc(&g_MemPoolBench_Pool);
+}
+
+static void MemPoolBench_PoolFree(void *a_Block)
+{
+    MemPool_Free(&g_MemPoolBench_Pool, a_Block);
+}
+
+static void *MemPoolBench_Malloc(void)
+{
+    return malloc(MEMPOOLBENCH_BLOCK_SIZE);
+}
+
+static const MemPoolBench_AllocatorType g_MemPoolBench_Allocators[] =
+{
+    {"MemPool", MemPoolBench_PoolAlloc, MemPoolBench_PoolFree},
+    {"malloc",  MemPoolBench_Malloc,    free},
+};
+
+#define MEMPOOLBENCH_ALLOCATORS              (sizeof(g_MemPoolBench_Allocators) / sizeof(g_MemPoolBench_Allocators[0]))
+
+/* Allocate and free a_Pairs blocks in the given pattern, the blocks are touched so neither allocator is measured idle */
+static void MemPoolBench_Run(const MemPoolBench_AllocatorType *a_Allocator, MemPoolBench_PatternType a_Pattern, uint32 a_Pairs)
+{
+    volatile uint32 *blocks[MEMPOOLBENCH_BURST];
+    uint32 pair;
+    uint32 i;
+
+    if (a_Pattern == MEMPOOLBENCH_PATTERN_PAIR)
+    {
+        for (pair = 0; pair < a_Pairs; pair++)
+        {
+            blocks[0] = (volatile uint32 *)a_Allocator->Alloc();
+            blocks[0][0] = pair;
+            a_Allocator->Free((void *)blocks[0]);
+        }
+        return;
+    }
+
+    for (pair = 0; pair < a_Pairs; pair += MEMPOOLBENCH_BURST)
+    {
+        for (i = 0; i < MEMPOOLBENCH_BURST; i++)
+        {
+            blocks[i] = (volatile uint32 *)a_Allocator->Alloc();
+            blocks[i][0] = i;
+        }
+        for (i = MEMPOOLBENCH_BURST; i > 0; i--)
+        {
+            a_Allocator->Free((void *)blocks[(a_Pattern == MEMPOOLBENCH_PATTERN_REVERSE) ? (i - 1) : g_MemPoolBench_Order[i - 1]]);
+        }
+    }
+}
+
+/* Slowest single allocation and free pair in nanoseconds, including the cost of reading the clock, timed while 0 to a whole
+ * burst of other blocks are held */
+static uint64 MemPoolBench_WorstPair(const MemPoolBench_AllocatorType *a_Allocator)
+{
+    volatile uint32 *blocks[MEMPOOLBENCH_BURST];
+    volatile uint32 *block;
+    uint64 worst = 0;
+    uint64 start;
+    uint64 elapsed;
+    uint32 pair;
+    uint32 i;
+
+    for (pair = 0; pair < MEMPOOLBENCH_TIMED_PAIRS; pair += MEMPOOLBENCH_BURST)
+    {
+        for (i = 0; i < MEMPOOLBENCH_BURST; i++)
+        {
+            start = MemPoolBench_NowNs();
+            block = (volatile uint32 *)a_Allocator->Alloc();
+            block[0] = i;
+            a_Allocator->Free((void *)block);
+            elapsed = MemPoolBench_NowNs() - start;
+            if (elapsed > worst)
+            {
+                worst = elapsed;
+            }
+            blocks[i] = (volatile uint32 *)a_Allocator->Alloc();
+        }
+        for (i = 0; i < MEMPOOLBENCH_BURST; i++)
+        {
+            a_Allocator->Free((void *)blocks[g_MemPoolBench_Order[i]]);
+        }
+    }
+    return worst;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 pairs;
+    uint32 random = 0x12345678UL;
+    uint32 swap;
+    uint32 allocator;
+    uint32 pattern;
+    uint32 i;
+    uint32 j;
+    uint64 start;
+    double mean;
+
+    pairs = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : MEMPOOLBENCH_DEFAULT_PAIRS;
+    if (pairs < MEMPOOLBENCH_BURST)
+    {
+        printf("Usage: %s [pairs]      (at least %u)\n", argv[0], MEMPOOLBENCH_BURST);
+        return 2;
+    }
+
+    /* Fisher-Yates with xorshift32 */
+    for (i = 0; i < MEMPOOLBENCH_BURST; i++)
+    {
+        g_MemPoolBench_Order[i] = i;
+    }
+    for (i = MEMPOOLBENCH_BURST - 1; i > 0; i--)
+    {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        j = random % (i + 1);
+        swap = g_MemPoolBench_Order[i];
+        g_MemPoolBench_Order[i] = g_MemPoolBench_Order[j];
+        g_MemPoolBench_Order[j] = swap;
+    }
+
+    (void)MemPool_Init(&g_MemPoolBench_Pool, g_MemPoolBench_Storage, MEMPOOLBENCH_BLOCK_SIZE, MEMPOOLBENCH_BURST + 1);
+
+    printf("%u byte blocks, bursts of %u\n", MEMPOOLBENCH_BLOCK_SIZE, MEMPOOLBENCH_BURST);
+    printf("%-22s", "ns per pair");
+    for (allocator = 0; allocator < MEMPOOLBENCH_ALLOCATORS; allocator++)
+    {
+        printf("%10s", g_MemPoolBench_Allocators[allocator].Name);
+    }
+    printf("\n");
+
+    for (pattern = MEMPOOLBENCH_PATTERN_PAIR; pattern <= MEMPOOLBENCH_PATTERN_SHUFFLED; pattern++)
+    {
+        printf("%-22s", g_MemPoolBench_Patterns[pattern]);
+        for (allocator = 0; allocator < MEMPOOLBENCH_ALLOCATORS; allocator++)
+        {
+            MemPoolBench_Run(&g_MemPoolBench_Allocators[allocator], (MemPoolBench_PatternType)pattern, MEMPOOLBENCH_BURST);
+            start = MemPoolBench_NowNs();
+            MemPoolBench_Run(&g_MemPoolBench_Allocators[allocator], (MemPoolBench_PatternType)pattern, pairs);
+            mean = (double)(MemPoolBench_NowNs() - start) / (double)pairs;
+            printf("%10.1f", mean);
+        }
+        printf("\n");
+    }
+
+    printf("%-22s", "slowest pair");
+    for (allocator = 0; allocator < MEMPOOLBENCH_ALLOCATORS; allocator++)
+    {
+        printf("%10llu", (unsigned long long)MemPoolBench_WorstPair(&g_MemPoolBench_Allocators[allocator]));
+    }
+    printf("\n");
+
+    return (g_MemPoolBench_Pool.Used == 0) ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+/**************************************************************************************************************************************
+ Module      : MemPoolStress
+ Name        : MemPoolStress.c
+ Author      : Salma Hamdy
+ Description : Host stress test of the lock-free fixed-block memory pool with allocating threads
+
+ First MemPool_Free is given pointers that are not blocks of the pool: below and past the storage, inside a block, misaligned
+ and from another pool. Each one must leave the free list and the usage untouched. Then threads that stand for ISRs at different
+ priorities and the main loop allocate and free blocks of a shared pool in a pseudo-random order, holding up to a few blocks each,
+ so the pool runs empty and the tagged head is raced by concurrent compare-exchanges. A thread fills every block it gets with its
+ own pattern and checks the pattern is intact before it frees the block, so a block handed out twice fails the test. At the end
+ every block must be back on the free list exactly once, the usage must be zero, and the failure counter must match the empty
+ allocations the threads saw. The exit status is 1 on a failure.
+
+ Build it with -pthread, and with TM4C_SIM for the 32-bit host types.
+
+ Usage: mempoolstress [operations]      (allocations per thread, 10^6 by default)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "MemPool.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define MEMPOOLSTRESS_DEFAULT_OPERATIONS     1000000UL
+#define MEMPOOLSTRESS_THREADS                8
+#define MEMPOOLSTRESS_HELD                   4                  /* Blocks a thread holds at most */
+#define MEMPOOLSTRESS_BLOCK_SIZE             20
+#define MEMPOOLSTRESS_MAX_BLOCKS             64
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 Id;
+    uint32 Operations;
+    uint32 Empty;            /* Allocations that found the pool empty */
+    uint32 Errors;
+}MemPoolStress_ThreadType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Pool sizes, from fewer blocks than the threads can hold to more */
+static const uint16 g_MemPoolStress_Blocks[] = {8, 24, MEMPOOLSTRESS_MAX_BLOCKS};
+
+#define MEMPOOLSTRESS_SIZES                  (sizeof(g_MemPoolStress_Blocks) / sizeof(g_MemPoolStress_Blocks[0]))
+
+MEMPOOL_DEFINE_STORAGE(g_MemPoolStress_Storage, MEMPOOLSTRESS_BLOCK_SIZE, MEMPOOLSTRESS_MAX_BLOCKS);
+MEMPOOL_DEFINE_STORAGE(g_MemPoolStress_OtherStorage, MEMPOOLSTRESS_BLOCK_SIZE, 2);
+
+static MemPool_Type g_MemPoolStress_Pool;
+static MemPool_Type g_MemPoolStress_Other;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* xorshift32 */
+static uint32 MemPoolStress_Random(uint32 *a_State)
+{
+    *a_State ^= *a_State << 13;
+    *a_State ^= *a_State >> 17;
+    *a_State ^= *a_State << 5;
+    return *a_State;
+}
+
+/* Free a pointer that is not a block of the pool, TRUE if the pool is untouched */
+static boolean MemPoolStress_CheckReject(const char *a_Name, void *a_Pointer)
+{
+    uint32 head = g_MemPoolStress_Pool.FreeHead;
+    uint32 used = g_MemPoolStress_Pool.Used;
+
+    MemPool_Free(&g_MemPoolStress_Pool, a_Pointer);
+    if ((g_MemPoolStress_Pool.FreeHead != head) || (g_MemPoolStress_Pool.Used != used))
+    {
+        printf("FAIL free of a pointer %s was accepted\n", a_Name);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static boolean MemPoolStress_Rejects(void)
+{
+    uintptr_t storage = (uintptr_t)g_MemPoolStress_Storage;
+    uint32 block_size = MEMPOOL_BLOCK_WORDS(MEMPOOLSTRESS_BLOCK_SIZE) * 4;
+    boolean passed = TRUE;
+    void *block;
+
+    (void)MemPool_Init(&g_MemPoolStress_Pool, g_MemPoolStress_Storage, MEMPOOLSTRESS_BLOCK_SIZE, 4);
+    (void)MemPool_Init(&g_MemPoolStress_Other, g_MemPoolStress_OtherStorage, MEMPOOLSTRESS_BLOCK_SIZE, 2);
+    block = MemPool_Alloc(&g_MemPoolStress_Pool);
+
+    passed &= MemPoolStress_CheckReject("below the storage", (void *)(storage - block_size));
+    passed &= MemPoolStress_CheckReject("one word below the storage", (void *)(storage - 4));
+    passed &= MemPoolStress_CheckReject("inside a block", (void *)(storage + 4));
+    passed &= MemPoolStress_CheckReject("at the last word of a block", (void *)(storage + block_size - 4));
+    passed &= MemPoolStress_CheckReject("misaligned", (void *)(storage + 2));
+    passed &= MemPoolStress_CheckReject("past the blocks", (void *)(storage + (4 * block_size)));
+    passed &= MemPoolStress_CheckReject("from another pool", MemPool_Alloc(&g_MemPoolStress_Other));
+
+    MemPool_Free(&g_MemPoolStress_Pool, block);
+    if ((g_MemPoolStress_Pool.Used != 0) || (MemPool_Alloc(&g_MemPoolStress_Pool) != block))
+    {
+        printf("FAIL free of a block of the pool was refused\n");
+        passed = FALSE;
+    }
+    printf("free rejects: %s\n", passed ? "ok" : "failed");
+    return passed;
+}
+
+static void *MemPoolStress_Thread(void *a_Arg)
+{
+    MemPoolStress_ThreadType *thread = (MemPoolStress_ThreadType *)a_Arg;
+    uint32 *held[MEMPOOLSTRESS_HELD];
+    uint32 held_num = 0;
+    uint32 random = 0x9E3779B9UL * (thread->Id + 1);
+    uint32 pattern;
+    uint32 operation;
+    uint32 slot;
+    uint32 word;
+    uint32 *block;
+
+    for (operation = 0; operation < thread->Operations; )
+    {
+        /* Allocate while holding few blocks, free more and more often as the thread holds more */
+        if ((MemPoolStress_Random(&random) % MEMPOOLSTRESS_HELD) >= held_num)
+        {
+            operation++;
+            block = (uint32 *)MemPool_Alloc(&g_MemPoolStress_Pool);
+            if (block == NULL_PTR)
+            {
+                thread->Empty++;
+                sched_yield();                      /* Empty: let the holders run on a single core host */
+                continue;
+            }
+            if ((((uint8 *)block - (uint8 *)g_MemPoolStress_Storage) % (MEMPOOL_BLOCK_WORDS(MEMPOOLSTRESS_BLOCK_SIZE) * 4)) != 0)
+            {
+                printf("FAIL thread %u got a pointer inside a block\n", thread->Id);
+                thread->Errors++;
+                continue;
+            }
+            pattern = (thread->Id << 24) | (operation & 0x00FFFFFFUL);
+            for (word = 0; word < MEMPOOL_BLOCK_WORDS(MEMPOOLSTRESS_BLOCK_SIZE); word++)
+            {
+                block[word] = pattern;
+            }
+            held[held_num++] = block;
+        }
+        else
+        {
+            slot  = MemPoolStress_Random(&random) % held_num;
+            block = held[slot];
+            held[slot] = held[--held_num];
+            for (word = 1; word < MEMPOOL_BLOCK_WORDS(MEMPOOLSTRESS_BLOCK_SIZE); word++)
+            {
+                if (block[word] != block[0])
+                {
+                    if (thread->Errors++ < 10)
+                    {
+                        printf("FAIL thread %u: block %p overwritten while held, %08X instead of %08X\n", thread->Id,
+                               (void *)block, block[word], block[0]);
+                    }
+                    break;
+                }
+            }
+            if ((block[0] >> 24) != thread->Id)
+            {
+                if (thread->Errors++ < 10)
+                {
+                    printf("FAIL thread %u: block %p also handed to thread %u\n", thread->Id, (void *)block, block[0] >> 24);
+                }
+            }
+            MemPool_Free(&g_MemPoolStress_Pool, block);
+        }
+    }
+
+    while (held_num > 0)
+    {
+        MemPool_Free(&g_MemPoolStress_Pool, held[--held_num]);
+    }
+    return NULL_PTR;
+}
+
+/* Threads sharing a pool of the given number of blocks */
+static boolean MemPoolStress_Run(uint16 a_Blocks, uint32 a_Operations)
+{
+    MemPoolStress_ThreadType threads[MEMPOOLSTRESS_THREADS];
+    pthread_t ids[MEMPOOLSTRESS_THREADS];
+    uint8 seen[MEMPOOLSTRESS_MAX_BLOCKS] = {0};
+    MemPool_StatsType stats;
+    uint32 empty = 0;
+    uint32 errors = 0;
+    uint32 linked = 0;
+    uint32 index;
+    uint32 i;
+
+    (void)MemPool_Init(&g_MemPoolStress_Pool, g_MemPoolStress_Storage, MEMPOOLSTRESS_BLOCK_SIZE, a_Blocks);
+    for (i = 0; i < MEMPOOLSTRESS_THREADS; i++)
+    {
+        threads[i].Id         = i;
+        threads[i].Operations = a_Operations;
+        threads[i].Empty      = 0;
+        threads[i].Errors     = 0;
+        pthread_create(&ids[i], NULL_PTR, MemPoolStress_Thread, &threads[i]);
+    }
+    for (i = 0; i < MEMPOOLSTRESS_THREADS; i++)
+    {
+        pthread_join(ids[i], NULL_PTR);
+        empty  += threads[i].Empty;
+        errors += threads[i].Errors;
+    }
+
+    /* Walk the free list, every block must be on it once */
+    index = g_MemPoolStress_Pool.FreeHead & MEMPOOL_INDEX_MASK;
+    while ((index != MEMPOOL_NIL_INDEX) && (linked <= a_Blocks))
+    {
+        if ((index >= a_Blocks) || seen[index])
+        {
+            printf("FAIL free list links block %u %s\n", index, (index >= a_Blocks) ? "outside the pool" : "twice");
+            errors++;
+            break;
+        }
+        seen[index] = 1;
+        linked++;
+        index = g_MemPoolStress_Pool.Storage[index * g_MemPoolStress_Pool.BlockWords];
+    }
+    if (linked != a_Blocks)
+    {
+        printf("FAIL %u blocks on the free list out of %u\n", linked, a_Blocks);
+        errors++;
+    }
+
+    MemPool_GetStats(&g_MemPoolStress_Pool, &stats);
+    if ((stats.Used != 0) || (stats.Failures != empty) || (stats.HighWater > a_Blocks))
+    {
+        printf("FAIL statistics: %u used, %u failures for %u empty allocations, high water %u\n", stats.Used, stats.Failures,
+               empty, stats.HighWater);
+        errors++;
+    }
+
+    printf("%6u %12u %10u %10u %8u\n", a_Blocks, a_Operations * MEMPOOLSTRESS_THREADS, empty, stats.HighWater, errors);
+    return (errors == 0) ? TRUE : FALSE;
+}
+
+int main(int argc, char *argv[])
+{
+    boolean passed;
+    uint32 operations;
+    uint32 size;
+
+    operations = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : MEMPOOLSTRESS_DEFAULT_OPERATIONS;
+    if (operations == 0)
+    {
+        printf("Usage: %s [operations]\n", argv[0]);
+        return 2;
+    }
+
+    passed = MemPoolStress_Rejects();
+
+    printf("%u threads holding up to %u blocks each\n", MEMPOOLSTRESS_THREADS, MEMPOOLSTRESS_HELD);
+    printf("%6s %12s %10s %10s %8s\n", "blocks", "allocs", "empty", "high", "errors");
+    for (size = 0; size < MEMPOOLSTRESS_SIZES; size++)
+    {
+        if (!MemPoolStress_Run(g_MemPoolStress_Blocks[size], operations))
+        {
+            passed = FALSE;
+        }
+    }
+    return passed ? 0 : 1;
+}
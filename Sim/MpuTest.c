@@ -0,0 +1,235 @@
+/**************************************************************************************************************************************
+ Module      : MpuTest
+ Name        : MpuTest.c
+ Author      : Salma Hamdy
+ Description : Host unit test of the MPU region math, alignment validation and stack guard placement
+
+ Built with TM4C_SIM, the MPU registers are plain register slots of the simulator, so the test reads back the base and
+ attribute words the driver wrote. Sim_RunCases runs each case in its own child process:
+   - region rules:     Mpu_CheckRegion accepts the power of two sizes from 32 bytes aligned on their size, and only those;
+   - region encoding:  Mpu_ConfigureRegion writes the base with VALID and the region number, and the attribute word with the
+                       AP, TEX S C B, SRD and SIZE fields, against words computed by hand from the ARMv7-M layout. Invalid
+                       settings are refused without any register write;
+   - stack guards:     before Mpu_Init there is no guard. After it the guard of a stack starting at every word offset of a
+                       32-byte block is the first 32-byte block inside the stack, and the usable stack starts right above it,
+                       at most 60 bytes higher. The pointers are host pointers, so truncating them to 32 bits would fail.
+ The exit status is 1 when a check fails.
+
+ Usage: mputest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "tm4c123gh6pm_registers.h"
+#include "Mpu.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Attribute word of a stack guard: XN, no access, SRAM, SIZE 4 (32 bytes), enabled */
+#define MPUTEST_GUARD_ATTR                   0x10060009
+
+#define MPUTEST_STACK_WORDS                  64
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint32 BaseAddress;
+    uint32 SizeBytes;
+    boolean Valid;
+}MpuTest_RuleType;
+
+typedef struct
+{
+    uint8 Region;
+    Mpu_RegionConfigType Config;
+    uint32 Base;                   /* Expected base register word */
+    uint32 Attr;                   /* Expected attribute register word */
+}MpuTest_EncodingType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+static const MpuTest_RuleType g_MpuTest_Rules[] =
+{
+    {0x00000000UL, 32,           TRUE},
+    {0x20000020UL, 32,           TRUE},
+    {0x20000010UL, 32,           FALSE},           /* Base not aligned on the size */
+    {0x20000000UL, 16,           FALSE},           /* Below the minimum size */
+    {0x20000000UL, 0,            FALSE},
+    {0x20000000UL, 48,           FALSE},           /* Not a power of two */
+    {0x20000000UL, 0x8000,       TRUE},
+    {0x20004000UL, 0x8000,       FALSE},
+    {0x20008000UL, 0x8000,       TRUE},
+    {0x00000000UL, 0x40000,      TRUE},            /* 256 KB flash */
+    {0x40000000UL, 0x20000000UL, TRUE},
+    {0x80000000UL, 0x80000000UL, TRUE},            /* Largest size held by the uint32 parameter */
+    {0x40000000UL, 0x80000000UL, FALSE},
+    {0x00000000UL, 0xFFFFFFFFUL, FALSE},
+    {0x00000000UL, 0xC0000000UL, FALSE},
+};
+
+#define MPUTEST_RULES                        (sizeof(g_MpuTest_Rules) / sizeof(g_MpuTest_Rules[0]))
+
+static const MpuTest_EncodingType g_MpuTest_Encodings[] =
+{
+    /* 256 KB flash, read only, executable: AP 6, TEX S C B 0x02, SIZE 17 */
+    {0, {0x00000000UL, 0x40000,  MPU_ACCESS_READ_ONLY, MPU_MEMORY_FLASH,      0x00, FALSE}, 0x00000010, 0x06020023},
+    /* 32 KB SRAM, full access, execute never: AP 3, TEX S C B 0x06, SIZE 14 */
+    {1, {0x20000000UL, 0x8000,   MPU_ACCESS_FULL,      MPU_MEMORY_SRAM,       0x00, TRUE},  0x20000011, 0x1306001D},
+    /* Peripherals, privileged only, execute never, with the last eighth disabled: AP 1, TEX S C B 0x05, SRD 0x80, SIZE 28 */
+    {5, {0x40000000UL, 0x20000000UL, MPU_ACCESS_PRIV_RW, MPU_MEMORY_PERIPHERAL, 0x80, TRUE},  0x40000015, 0x11058039},
+    /* Smallest region, subregions not allowed: AP 5, SIZE 4 */
+    {3, {0x200001E0UL, 32,       MPU_ACCESS_PRIV_RO,   MPU_MEMORY_SRAM,       0x00, FALSE}, 0x200001F3, 0x05060009},
+    /* 256 bytes, the smallest region with subregions: SRD 0x0F, SIZE 7 */
+    {4, {0x20000100UL, 256,      MPU_ACCESS_NONE,      MPU_MEMORY_SRAM,       0x0F, FALSE}, 0x20000114, 0x00060F0F},
+};
+
+#define MPUTEST_ENCODINGS                    (sizeof(g_MpuTest_Encodings) / sizeof(g_MpuTest_Encodings[0]))
+
+static const Mpu_RegionConfigType g_MpuTest_Invalid[] =
+{
+    {0x20000010UL, 32,  MPU_ACCESS_FULL, MPU_MEMORY_SRAM, 0x00, FALSE},    /* Misaligned */
+    {0x20000000UL, 96,  MPU_ACCESS_FULL, MPU_MEMORY_SRAM, 0x00, FALSE},    /* Not a power of two */
+    {0x20000000UL, 128, MPU_ACCESS_FULL, MPU_MEMORY_SRAM, 0x01, FALSE},    /* Subregions below 256 bytes */
+};
+
+#define MPUTEST_INVALID                      (sizeof(g_MpuTest_Invalid) / sizeof(g_MpuTest_Invalid[0]))
+
+/* Stacks start at every word offset of this 32-byte aligned block */
+static uint32 g_MpuTest_Stack[MPUTEST_STACK_WORDS] __attribute__((aligned(MPU_STACK_GUARD_SIZE)));
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static boolean MpuTest_Rules(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+    uint32 rule;
+
+    (void)a_Case;
+    for (rule = 0; rule < MPUTEST_RULES; rule++)
+    {
+        if (Mpu_CheckRegion(g_MpuTest_Rules[rule].BaseAddress, g_MpuTest_Rules[rule].SizeBytes) != g_MpuTest_Rules[rule].Valid)
+        {
+            printf("FAIL region 0x%08X of 0x%X bytes %s\n", g_MpuTest_Rules[rule].BaseAddress,
+                   g_MpuTest_Rules[rule].SizeBytes, g_MpuTest_Rules[rule].Valid ? "refused" : "accepted");
+            passed = FALSE;
+        }
+    }
+    return passed;
+}
+
+static boolean MpuTest_Encoding(const Sim_CaseType *a_Case)
+{
+    const MpuTest_EncodingType *encoding;
+    boolean passed = TRUE;
+    uint32 test;
+
+    (void)a_Case;
+    for (test = 0; test < MPUTEST_ENCODINGS; test++)
+    {
+        encoding = &g_MpuTest_Encodings[test];
+        if (!Mpu_ConfigureRegion(encoding->Region, &encoding->Config))
+        {
+            printf("FAIL region %u at 0x%08X refused\n", encoding->Region, encoding->Config.BaseAddress);
+            passed = FALSE;
+            continue;
+        }
+        if ((HW_READ32(MPU_BASE_REG) != encoding->Base) || (HW_READ32(MPU_ATTR_REG) != encoding->Attr))
+        {
+            printf("FAIL region %u at 0x%08X: base 0x%08X attributes 0x%08X, expected 0x%08X 0x%08X\n", encoding->Region,
+                   encoding->Config.BaseAddress, HW_READ32(MPU_BASE_REG), HW_READ32(MPU_ATTR_REG), encoding->Base,
+                   encoding->Attr);
+            passed = FALSE;
+        }
+    }
+
+    /* Refused settings leave the registers of the last region as they are */
+    for (test = 0; test < MPUTEST_INVALID; test++)
+    {
+        if (Mpu_ConfigureRegion(0, &g_MpuTest_Invalid[test]) ||
+            (HW_READ32(MPU_BASE_REG) != g_MpuTest_Encodings[MPUTEST_ENCODINGS - 1].Base) ||
+            (HW_READ32(MPU_ATTR_REG) != g_MpuTest_Encodings[MPUTEST_ENCODINGS - 1].Attr))
+        {
+            printf("FAIL invalid region %u at 0x%08X of %u bytes was programmed\n", test, g_MpuTest_Invalid[test].BaseAddress,
+                   g_MpuTest_Invalid[test].SizeBytes);
+            passed = FALSE;
+        }
+    }
+    if (Mpu_ConfigureRegion(MPU_REGIONS, &g_MpuTest_Encodings[0].Config) || Mpu_ConfigureRegion(0, NULL_PTR))
+    {
+        printf("FAIL region number %u or a NULL configuration accepted\n", MPU_REGIONS);
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static boolean MpuTest_StackGuards(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+    uint32 *stack;
+    uint32 *usable;
+    uintptr_t guard;
+    uint32 offset;
+
+    (void)a_Case;
+    if ((Mpu_GetStackGuard(g_MpuTest_Stack) != 0) || (Mpu_GetUsableStack(&g_MpuTest_Stack[1]) != &g_MpuTest_Stack[1]))
+    {
+        printf("FAIL stack guard before Mpu_Init\n");
+        passed = FALSE;
+    }
+
+    Mpu_Init();
+    if ((HW_READ32(MPU_ATTR_REG) != MPUTEST_GUARD_ATTR) ||
+        ((HW_READ32(MPU_BASE_REG) & (MPU_BASE_VALID_MASK | MPU_BASE_REGION_MASK)) !=
+         (MPU_BASE_VALID_MASK | MPU_THREAD_STACK_GUARD_REGION)) ||
+        (HW_READ32(MPU_CTRL_REG) != (MPU_CTRL_PRIVDEFENA_MASK | MPU_CTRL_ENABLE_MASK)))
+    {
+        printf("FAIL Mpu_Init: base 0x%08X attributes 0x%08X control 0x%08X\n", HW_READ32(MPU_BASE_REG),
+               HW_READ32(MPU_ATTR_REG), HW_READ32(MPU_CTRL_REG));
+        passed = FALSE;
+    }
+
+    /* A stack starting on the block gets the block, one starting a word later gets the next one */
+    for (offset = 0; offset < (MPU_STACK_GUARD_SIZE / sizeof(uint32)); offset++)
+    {
+        stack  = &g_MpuTest_Stack[offset];
+        guard  = (uintptr_t)&g_MpuTest_Stack[(offset == 0) ? 0 : (MPU_STACK_GUARD_SIZE / sizeof(uint32))];
+        usable = Mpu_GetUsableStack(stack);
+
+        if (Mpu_GetStackGuard(stack) != ((uint32)guard | MPU_BASE_VALID_MASK | MPU_THREAD_STACK_GUARD_REGION))
+        {
+            printf("FAIL stack at word %u: guard 0x%08X, expected 0x%08X\n", offset, Mpu_GetStackGuard(stack),
+                   (uint32)guard | MPU_BASE_VALID_MASK | MPU_THREAD_STACK_GUARD_REGION);
+            passed = FALSE;
+        }
+        if ((usable != (uint32 *)(guard + MPU_STACK_GUARD_SIZE)) ||
+            (((uintptr_t)usable - (uintptr_t)stack) > ((2 * MPU_STACK_GUARD_SIZE) - sizeof(uint32))))
+        {
+            printf("FAIL stack at word %u: usable from word %ld, expected word %ld\n", offset, (long)(usable - g_MpuTest_Stack),
+                   (long)((uint32 *)(guard + MPU_STACK_GUARD_SIZE) - g_MpuTest_Stack));
+            passed = FALSE;
+        }
+    }
+    return passed;
+}
+
+static const Sim_CaseType g_MpuTest_Cases[] =
+{
+    {"region rules",    MpuTest_Rules,       NULL_PTR},
+    {"region encoding", MpuTest_Encoding,    NULL_PTR},
+    {"stack guards",    MpuTest_StackGuards, NULL_PTR},
+};
+
+#define MPUTEST_CASES                        (sizeof(g_MpuTest_Cases) / sizeof(g_MpuTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_MpuTest_Cases, MPUTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/**************************************************************************************************************************************
+ Module      : RegBench
+ Name        : RegBench.c
+ Author      : Salma Hamdy
+ Description : Host benchmark of the register reads and writes done by each SysTick and NVIC driver call
+
+ Built with TM4C_SIM and REG_TRACE, it runs every API once from the reset state of the simulator, prints the register traffic
+ and compares it with the checked-in baseline. The exit code is 1 when a call does more or fewer accesses than the baseline,
+ --update rewrites the baseline after an intended change.
+
+ Usage: regbench <baseline file> [--update]
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "tm4c123gh6pm_registers.h"
+#include "SysTick.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define REGBENCH_NAME_LENGTH                 64
+#define REGBENCH_GPIO_PORTF_IRQ_NUM          30
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    const char *Name;
+    void (*Run)(void);
+}RegBench_CaseType;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static void RegBench_SysTickInit(void)           { SysTick_Init(10); }
+static void RegBench_SysTickStartBusyWait(void)  { SysTick_StartBusyWait(1); }
+static void RegBench_SysTickHandler(void)        { SysTick_Handler(); }
+static void RegBench_SysTickStop(void)           { SysTick_Stop(); }
+static void RegBench_SysTickStart(void)          { SysTick_Start(); }
+static void RegBench_SysTickDeInit(void)         { SysTick_DeInit(); }
+static void RegBench_SysTickGetTickCount(void)   { (void)SysTick_GetTickCount(); }
+static void RegBench_NvicEnableIrq(void)         { NVIC_EnableIRQ(REGBENCH_GPIO_PORTF_IRQ_NUM); }
+static void RegBench_NvicDisableIrq(void)        { NVIC_DisableIRQ(REGBENCH_GPIO_PORTF_IRQ_NUM); }
+static void RegBench_NvicSetPriorityIrq(void)    { NVIC_SetPriorityIRQ(REGBENCH_GPIO_PORTF_IRQ_NUM, 2); }
+static void RegBench_NvicEnableException(void)   { NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE); }
+static void RegBench_NvicDisableException(void)  { NVIC_DisableException(EXCEPTION_MEM_FAULT_TYPE); }
+static void RegBench_NvicSetPrioritySysTick(void){ NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, 3); }
+static void RegBench_NvicSetPriorityPendSV(void) { NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, 7); }
+
+/* Benchmarked calls, in execution order: each one starts from the state left by the previous ones */
+static const RegBench_CaseType g_RegBench_Cases[] =
+{
+    {"SysTick_Init(10)",                            RegBench_SysTickInit},
+    {"SysTick_Handler",                             RegBench_SysTickHandler},
+    {"SysTick_Stop",                                RegBench_SysTickStop},
+    {"SysTick_Start",                               RegBench_SysTickStart},
+    {"SysTick_GetTickCount",                        RegBench_SysTickGetTickCount},
+    {"SysTick_DeInit",                              RegBench_SysTickDeInit},
+    {"SysTick_StartBusyWait(1)",                    RegBench_SysTickStartBusyWait},
+    {"NVIC_EnableIRQ(30)",                          RegBench_NvicEnableIrq},
+    {"NVIC_SetPriorityIRQ(30,2)",                   RegBench_NvicSetPriorityIrq},
+    {"NVIC_DisableIRQ(30)",                         RegBench_NvicDisableIrq},
+    {"NVIC_EnableException(MEM_FAULT)",             RegBench_NvicEnableException},
+    {"NVIC_DisableException(MEM_FAULT)",            RegBench_NvicDisableException},
+    {"NVIC_SetPriorityException(SYSTICK,3)",        RegBench_NvicSetPrioritySysTick},
+    {"NVIC_SetPriorityException(PEND_SV,7)",        RegBench_NvicSetPriorityPendSV},
+};
+
+#define REGBENCH_CASES                       (sizeof(g_RegBench_Cases) / sizeof(g_RegBench_Cases[0]))
+
+/* Reads and writes of a call in the baseline file, FALSE if the call is not listed */
+static boolean RegBench_FindBaseline(FILE *a_Baseline, const char *a_Name, uint32 *a_Reads, uint32 *a_Writes)
+{
+    char name[REGBENCH_NAME_LENGTH];
+    unsigned int reads;
+    unsigned int writes;
+
+    rewind(a_Baseline);
+    while (fscanf(a_Baseline, "%63s %u %u", name, &reads, &writes) == 3)
+    {
+        if (strcmp(name, a_Name) == 0)
+        {
+            *a_Reads  = reads;
+            *a_Writes = writes;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static void RegBench_PrintTrace(const RegTrace_StatsType *a_Stats)
+{
+    uint32 entry;
+
+    for (entry = 0; entry < a_Stats->Entries; entry++)
+    {
+        printf("    %c 0x%08X 0x%08X\n", (a_Stats->Buffer[entry].Access == REG_TRACE_READ) ? 'R' : 'W',
+               a_Stats->Buffer[entry].Address, a_Stats->Buffer[entry].Value);
+    }
+    if (a_Stats->Entries < (a_Stats->Reads + a_Stats->Writes))
+    {
+        printf("    ... %u more\n", a_Stats->Reads + a_Stats->Writes - a_Stats->Entries);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    RegTrace_StatsType stats;
+    boolean update = (argc == 3) && (strcmp(argv[2], "--update") == 0);
+    uint32 reads;
+    uint32 writes;
+    uint32 failures = 0;
+    uint32 index;
+    FILE *baseline;
+
+    if ((argc != 2) && !update)
+    {
+        printf("Usage: %s <baseline file> [--update]\n", argv[0]);
+        return 2;
+    }
+
+    baseline = fopen(argv[1], update ? "w" : "r");
+    if (baseline == NULL_PTR)
+    {
+        printf("cannot open %s\n", argv[1]);
+        return 2;
+    }
+
+    /* The calls are measured in thread mode without exceptions taken in between */
+    Disable_Exceptions();
+
+    printf("%-40s %8s %8s\n", "call", "reads", "writes");
+    for (index = 0; index < REGBENCH_CASES; index++)
+    {
+        RegTrace_Reset();
+        g_RegBench_Cases[index].Run();
+        RegTrace_GetStats(&stats);
+        printf("%-40s %8u %8u\n", g_RegBench_Cases[index].Name, stats.Reads, stats.Writes);
+
+        if (update)
+        {
+            fprintf(baseline, "%-40s %8u %8u\n", g_RegBench_Cases[index].Name, stats.Reads, stats.Writes);
+        }
+        else if (!RegBench_FindBaseline(baseline, g_RegBench_Cases[index].Name, &reads, &writes))
+        {
+            printf("  not in the baseline\n");
+            failures++;
+        }
+        else if ((reads != stats.Reads) || (writes != stats.Writes))
+        {
+            printf("  baseline %u reads / %u writes, trace:\n", reads, writes);
+            RegBench_PrintTrace(&stats);
+            failures++;
+        }
+    }
+
+    fclose(baseline);
+    if (failures != 0)
+    {
+        printf("%u calls changed their register traffic\n", failures);
+        return 1;
+    }
+    return 0;
+}
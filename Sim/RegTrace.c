@@ -0,0 +1,88 @@
+/**************************************************************************************************************************************
+ Module      : RegTrace
+ Name        : RegTrace.c
+ Author      : Salma Hamdy
+ Description : Source file for the register access trace of the host build (TM4C_SIM with REG_TRACE)
+ ***************************************************************************************************************************************/
+
+#include "RegTrace.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+static RegTrace_EntryType g_RegTrace_Buffer[REG_TRACE_BUFFER_ENTRIES];
+static uint32 g_RegTrace_Entries = 0;
+static uint32 g_RegTrace_Reads = 0;
+static uint32 g_RegTrace_Writes = 0;
+
+/***************************************************************************************************************************************
+ * Service Name: RegTrace_Log
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Address - Address of the register
+ *                  a_Access - REG_TRACE_READ or REG_TRACE_WRITE
+ *                  a_Value - Value read or written
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to count a register access and append it to the trace buffer while there is room.
+****************************************************************************************************************************************/
+void RegTrace_Log(uint32 a_Address, uint8 a_Access, uint32 a_Value)
+{
+    if (a_Access == REG_TRACE_READ)
+    {
+        g_RegTrace_Reads++;
+    }
+    else
+    {
+        g_RegTrace_Writes++;
+    }
+
+    if (g_RegTrace_Entries < REG_TRACE_BUFFER_ENTRIES)
+    {
+        g_RegTrace_Buffer[g_RegTrace_Entries].Address = a_Address;
+        g_RegTrace_Buffer[g_RegTrace_Entries].Value   = a_Value;
+        g_RegTrace_Buffer[g_RegTrace_Entries].Access  = a_Access;
+        g_RegTrace_Entries++;
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RegTrace_Reset
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty the trace buffer and clear the counters.
+****************************************************************************************************************************************/
+void RegTrace_Reset(void)
+{
+    g_RegTrace_Entries = 0;
+    g_RegTrace_Reads   = 0;
+    g_RegTrace_Writes  = 0;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: RegTrace_GetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Access counters and trace buffer since the last reset
+ * Return value: None
+ * Description: Function to read the register traffic recorded since the last RegTrace_Reset.
+****************************************************************************************************************************************/
+void RegTrace_GetStats(RegTrace_StatsType *a_Stats)
+{
+    if (a_Stats == NULL_PTR)
+    {
+        return;
+    }
+
+    a_Stats->Reads   = g_RegTrace_Reads;
+    a_Stats->Writes  = g_RegTrace_Writes;
+    a_Stats->Entries = g_RegTrace_Entries;
+    a_Stats->Buffer  = g_RegTrace_Buffer;
+}
@@ -0,0 +1,77 @@
+/***********************************************************************************************************************************
+ Module      : RegTrace
+ Name        : RegTrace.h
+ Author      : Salma Hamdy
+ Description : Header file for the register access trace of the host build (TM4C_SIM with REG_TRACE)
+ ************************************************************************************************************************************/
+
+#ifndef REGTRACE_H_
+#define REGTRACE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Entries kept in the trace buffer, the counters keep counting once it is full */
+#define REG_TRACE_BUFFER_ENTRIES             4096
+
+#define REG_TRACE_READ                       0
+#define REG_TRACE_WRITE                      1
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 Address;
+    uint32 Value;
+    uint8 Access;             /* REG_TRACE_READ or REG_TRACE_WRITE */
+}RegTrace_EntryType;
+
+typedef struct
+{
+    uint32 Reads;
+    uint32 Writes;
+    uint32 Entries;           /* Valid entries of the trace buffer */
+    const RegTrace_EntryType *Buffer;
+}RegTrace_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void RegTrace_Log(uint32 a_Address, uint8 a_Access, uint32 a_Value);
+
+void RegTrace_Reset(void);
+
+void RegTrace_GetStats(RegTrace_StatsType *a_Stats);
+
+/*******************************************************************************
+ *                         Inline Functions Definitions                        *
+ *******************************************************************************/
+
+/* Accessors behind HW_READ32 / HW_WRITE32, a_Register is the simulator slot of the register */
+static inline uint32 RegTrace_Read(volatile uint32 *a_Register)
+{
+    uint32 value = *a_Register;
+
+    RegTrace_Log(Sim_AddressOf(a_Register), REG_TRACE_READ, value);
+    return value;
+}
+
+static inline void RegTrace_Write(volatile uint32 *a_Register, uint32 a_Value)
+{
+    RegTrace_Log(Sim_AddressOf(a_Register), REG_TRACE_WRITE, a_Value);
+    *a_Register = a_Value;
+}
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* REGTRACE_H_ */
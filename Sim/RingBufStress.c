@@ -0,0 +1,310 @@
+/**************************************************************************************************************************************
+ Module      : RingBufStress
+ Name        : RingBufStress.c
+ Author      : Salma Hamdy
+ Description : Host stress test of the single-producer single-consumer ring buffer with a producer and a consumer thread
+
+ The producer thread stands for the ISR and the consumer thread for the main loop, on their own host cores when there are two,
+ so the Head and Tail handoff and the barriers of RingBuf.h are exercised with true concurrency and weak ordering where the host
+ has it. On a single core a side yields when the ring is full or empty.
+ The producer queues records of 1 to 24 payload bytes, [sequence number (4 bytes)] [length] [payload derived from both], with
+ RingBuf_Write or with RingBuf_Reserve / RingBuf_Commit in two pieces when the free space wraps. The consumer takes chunks of a
+ varying length with RingBuf_Read or RingBuf_Peek / RingBuf_Release and parses them back. Every record must come in sequence
+ order with its payload intact, so a byte lost, duplicated or overwritten at the wrap fails the test, and the ring must never
+ hold more than its size. Small rings wrap every few records. The exit status is 1 on a failure.
+
+ Build it with -pthread, and with TM4C_SIM for the 32-bit host types.
+
+ Usage: ringbufstress [records]      (records per ring size, 10^7 by default)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "RingBuf.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define RINGBUFSTRESS_DEFAULT_RECORDS        10000000UL
+#define RINGBUFSTRESS_MAX_PAYLOAD            24
+#define RINGBUFSTRESS_HEADER                 5
+#define RINGBUFSTRESS_MAX_RECORD             (RINGBUFSTRESS_HEADER + RINGBUFSTRESS_MAX_PAYLOAD)
+#define RINGBUFSTRESS_MAX_SIZE               4096
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Consumer side record parser */
+typedef struct
+{
+    uint8 Record[RINGBUFSTRESS_MAX_RECORD];
+    uint32 Fill;             /* Bytes of the record received so far */
+    uint32 Expected;         /* Sequence number of the next record */
+    uint32 Errors;
+}RingBufStress_ParserType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Ring sizes, down to less than a record so most records are split */
+static const uint32 g_RingBufStress_Sizes[] = {32, 64, 256, RINGBUFSTRESS_MAX_SIZE};
+
+#define RINGBUFSTRESS_SIZES                  (sizeof(g_RingBufStress_Sizes) / sizeof(g_RingBufStress_Sizes[0]))
+
+static uint8 g_RingBufStress_Storage[RINGBUFSTRESS_MAX_SIZE];
+static RingBuf_Type g_RingBufStress_Ring;
+static uint32 g_RingBufStress_Records;
+static volatile boolean g_RingBufStress_ProducerDone;
+static volatile boolean g_RingBufStress_ConsumerDone;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Payload length and bytes of a record, from its sequence number */
+static uint32 RingBufStress_Length(uint32 a_Sequence)
+{
+    return 1 + ((a_Sequence * 7) % RINGBUFSTRESS_MAX_PAYLOAD);
+}
+
+static uint8 RingBufStress_Byte(uint32 a_Sequence, uint32 a_Index)
+{
+    return (uint8)((a_Sequence * 2654435761UL) >> 24) ^ (uint8)(a_Index * 31);
+}
+
+static uint32 RingBufStress_Build(uint32 a_Sequence, uint8 *a_Record)
+{
+    uint32 length = RingBufStress_Length(a_Sequence);
+    uint32 i;
+
+    a_Record[0] = (uint8)a_Sequence;
+    a_Record[1] = (uint8)(a_Sequence >> 8);
+    a_Record[2] = (uint8)(a_Sequence >> 16);
+    a_Record[3] = (uint8)(a_Sequence >> 24);
+    a_Record[4] = (uint8)length;
+    for (i = 0; i < length; i++)
+    {
+        a_Record[RINGBUFSTRESS_HEADER + i] = RingBufStress_Byte(a_Sequence, i);
+    }
+    return RINGBUFSTRESS_HEADER + length;
+}
+
+/* Queue one record with the zero-copy API, in two reserve / commit pieces when the free space wraps; FALSE if it does not fit
+ * yet. Only the producer adds data, so the free space can only grow while the record is queued. */
+static boolean RingBufStress_Reserve(const uint8 *a_Record, uint32 a_Length)
+{
+    uint32 done = 0;
+    uint32 granted;
+    uint8 *region;
+    uint32 i;
+
+    if (a_Length > ((g_RingBufStress_Ring.Mask + 1) - (g_RingBufStress_Ring.Head - g_RingBufStress_Ring.Tail)))
+    {
+        return FALSE;
+    }
+
+    while (done < a_Length)
+    {
+        granted = a_Length - done;
+        region  = RingBuf_Reserve(&g_RingBufStress_Ring, &granted);
+        for (i = 0; i < granted; i++)
+        {
+            region[i] = a_Record[done + i];
+        }
+        RingBuf_Commit(&g_RingBufStress_Ring, granted);    /* The consumer may take the first piece alone */
+        done += granted;
+    }
+    return TRUE;
+}
+
+static void *RingBufStress_Producer(void *a_Arg)
+{
+    uint8 record[RINGBUFSTRESS_MAX_RECORD];
+    uint32 sequence;
+    uint32 length;
+    boolean queued;
+
+    (void)a_Arg;
+    /* The consumer gives up early only after an error, the producer must not wait for it then */
+    for (sequence = 0; (sequence < g_RingBufStress_Records) && !g_RingBufStress_ConsumerDone; sequence++)
+    {
+        length = RingBufStress_Build(sequence, record);
+        while (TRUE)
+        {
+            queued = (sequence & 1) ? RingBuf_Write(&g_RingBufStress_Ring, record, length) :
+                                      RingBufStress_Reserve(record, length);
+            if (queued || g_RingBufStress_ConsumerDone)
+            {
+                break;
+            }
+            sched_yield();                          /* Full: let the consumer run on a single core host */
+        }
+    }
+    g_RingBufStress_ProducerDone = TRUE;
+    return NULL_PTR;
+}
+
+/* Feed received bytes to the parser, a record is checked when complete */
+static void RingBufStress_Parse(RingBufStress_ParserType *a_Parser, const uint8 *a_Data, uint32 a_Length)
+{
+    uint32 sequence;
+    uint32 length;
+    uint32 i;
+
+    for (i = 0; i < a_Length; i++)
+    {
+        a_Parser->Record[a_Parser->Fill++] = a_Data[i];
+        if ((a_Parser->Fill == RINGBUFSTRESS_HEADER) && (a_Parser->Record[4] > RINGBUFSTRESS_MAX_PAYLOAD))
+        {
+            if (a_Parser->Errors++ < 10)
+            {
+                printf("FAIL record %u: length byte %u\n", a_Parser->Expected, a_Parser->Record[4]);
+            }
+            a_Parser->Record[4] = 0;                /* Check it as an empty record */
+        }
+        if ((a_Parser->Fill < RINGBUFSTRESS_HEADER) ||
+            (a_Parser->Fill < (RINGBUFSTRESS_HEADER + (uint32)a_Parser->Record[4])))
+        {
+            continue;
+        }
+
+        sequence = a_Parser->Record[0] | ((uint32)a_Parser->Record[1] << 8) | ((uint32)a_Parser->Record[2] << 16) |
+                   ((uint32)a_Parser->Record[3] << 24);
+        length = a_Parser->Record[4];
+        if ((sequence != a_Parser->Expected) || (length != RingBufStress_Length(sequence)))
+        {
+            if (a_Parser->Errors++ < 10)
+            {
+                printf("FAIL record %u: got sequence %u with %u bytes\n", a_Parser->Expected, sequence, length);
+            }
+            a_Parser->Expected = sequence;          /* Resynchronize to report the next error only */
+        }
+        else
+        {
+            for (length = 0; length < a_Parser->Record[4]; length++)
+            {
+                if (a_Parser->Record[RINGBUFSTRESS_HEADER + length] != RingBufStress_Byte(sequence, length))
+                {
+                    if (a_Parser->Errors++ < 10)
+                    {
+                        printf("FAIL record %u: payload byte %u corrupted\n", sequence, length);
+                    }
+                    break;
+                }
+            }
+        }
+        a_Parser->Expected++;
+        a_Parser->Fill = 0;
+    }
+}
+
+static void *RingBufStress_Consumer(void *a_Arg)
+{
+    RingBufStress_ParserType *parser = (RingBufStress_ParserType *)a_Arg;
+    uint8 chunk[RINGBUFSTRESS_MAX_SIZE];
+    uint32 want = 1;
+    uint32 length;
+    uint32 used;
+    uint8 *data;
+
+    /* A lost or duplicated byte shifts the records, so the consumer also stops once the producer is done and the ring is empty */
+    while ((parser->Expected < g_RingBufStress_Records) &&
+           !(g_RingBufStress_ProducerDone && (g_RingBufStress_Ring.Head == g_RingBufStress_Ring.Tail)))
+    {
+        used = g_RingBufStress_Ring.Head - g_RingBufStress_Ring.Tail;
+        if (used > (g_RingBufStress_Ring.Mask + 1))
+        {
+            if (parser->Errors++ < 10)
+            {
+                printf("FAIL ring holds %u bytes, more than its size\n", used);
+            }
+        }
+
+        /* Chunk lengths cycle through 1 .. 37 so they never line up with the records or the wrap */
+        want = (want % 37) + 1;
+        if (want & 1)
+        {
+            length = RingBuf_Read(&g_RingBufStress_Ring, chunk, want);
+            RingBufStress_Parse(parser, chunk, length);
+        }
+        else
+        {
+            data = RingBuf_Peek(&g_RingBufStress_Ring, &length);
+            if (length > want)
+            {
+                length = want;
+            }
+            RingBufStress_Parse(parser, data, length);
+            RingBuf_Release(&g_RingBufStress_Ring, length);
+        }
+        if (length == 0)
+        {
+            sched_yield();                          /* Empty: let the producer run on a single core host */
+        }
+    }
+    g_RingBufStress_ConsumerDone = TRUE;
+    return NULL_PTR;
+}
+
+/* One producer and one consumer thread over a ring of the given size */
+static boolean RingBufStress_Run(uint32 a_Size)
+{
+    RingBufStress_ParserType parser = {{0}, 0, 0, 0};
+    pthread_t producer;
+    pthread_t consumer;
+    struct timespec start;
+    struct timespec end;
+    double seconds;
+
+    (void)RingBuf_Init(&g_RingBufStress_Ring, g_RingBufStress_Storage, a_Size);
+    g_RingBufStress_ProducerDone = FALSE;
+    g_RingBufStress_ConsumerDone = FALSE;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&consumer, NULL_PTR, RingBufStress_Consumer, &parser);
+    pthread_create(&producer, NULL_PTR, RingBufStress_Producer, NULL_PTR);
+    pthread_join(producer, NULL_PTR);
+    pthread_join(consumer, NULL_PTR);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+
+    if ((parser.Expected != g_RingBufStress_Records) || (parser.Fill != 0) ||
+        (g_RingBufStress_Ring.Head != g_RingBufStress_Ring.Tail))
+    {
+        printf("FAIL %u records received, %u bytes left in the ring, %u in a partial record\n", parser.Expected,
+               g_RingBufStress_Ring.Head - g_RingBufStress_Ring.Tail, parser.Fill);
+        parser.Errors++;
+    }
+
+    printf("%6u %10u %12u %8.2f %8u\n", a_Size, parser.Expected, g_RingBufStress_Ring.Head,
+           ((double)g_RingBufStress_Ring.Head / 1e6) / seconds, parser.Errors);
+    return (parser.Errors == 0) ? TRUE : FALSE;
+}
+
+int main(int argc, char *argv[])
+{
+    boolean passed = TRUE;
+    uint32 size;
+
+    g_RingBufStress_Records = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : RINGBUFSTRESS_DEFAULT_RECORDS;
+    if (g_RingBufStress_Records == 0)
+    {
+        printf("Usage: %s [records]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%6s %10s %12s %8s %8s\n", "size", "records", "bytes", "MB/s", "errors");
+    for (size = 0; size < RINGBUFSTRESS_SIZES; size++)
+    {
+        if (!RingBufStress_Run(g_RingBufStress_Sizes[size]))
+        {
+            passed = FALSE;
+        }
+    }
+    return passed ? 0 : 1;
+}
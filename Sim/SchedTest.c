@@ -0,0 +1,330 @@
+/**************************************************************************************************************************************
+ Module      : SchedTest
+ Name        : SchedTest.c
+ Author      : Salma Hamdy
+ Description : Host test of the scheduler release timing, priority order and overrun accounting against the simulated tick
+
+ Built with TM4C_SIM, it routes the simulated 1 ms SysTick tick to Sched_Tick and runs Sched_Dispatch in the main loop as App1
+ does. Sim_RunCases runs each case in its own child process from the reset state of the simulator:
+   - release:  every task must start in the tick of its release (offset + 1 + k * period), the first one of a tick soon after
+               the tick interrupt;
+   - priority: tasks released in the same tick must run from the most urgent priority level down, whatever the registration
+               order;
+   - overrun:  a task computing for longer than its period must have every release that comes before it returns counted as an
+               overrun, and every release must be either run or counted.
+ The exit status is 1 when a case fails.
+
+ Usage: schedtest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Sched.h"
+#include "Idle.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define SCHEDTEST_TICK_MS                    1
+#define SCHEDTEST_TICK_CYCLES                16000UL      /* 1 ms at the 16 MHz PIOSC reset clock */
+#define SCHEDTEST_TICKS                      1000
+#define SCHEDTEST_MAX_LOG                    4096
+
+/* Highest accepted cycles from the tick interrupt to the start of the first task released by it */
+#define SCHEDTEST_MAX_START_CYCLES           400
+
+/* Task of the overrun case: period of 4 ticks and 6.5 ticks of work, so every run overlaps one or two releases */
+#define SCHEDTEST_OVERRUN_PERIOD             4
+#define SCHEDTEST_OVERRUN_WORK               ((SCHEDTEST_TICK_CYCLES * 13) / 2)
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Sched_PriorityType Priority;
+    uint16 PeriodTicks;
+    uint16 OffsetTicks;
+}SchedTest_TaskType;
+
+typedef struct
+{
+    Sched_PriorityType Priority;
+    uint32 StartTick;
+    uint32 EndTick;
+    uint64 StartCycles;      /* Cycles from the last tick interrupt to the start of the task */
+}SchedTest_RunType;
+
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Release case: coprime periods, offsets inside and beyond the first period */
+static const SchedTest_TaskType g_SchedTest_ReleaseTasks[] =
+{
+    {0,  5,  2},
+    {3,  3,  0},
+    {9,  7, 11},
+    {31, 1,  0},
+};
+
+/* Priority case: registered out of order, all released on the same ticks */
+static const SchedTest_TaskType g_SchedTest_PriorityTasks[] =
+{
+    {20, 10, 4},
+    {2,  10, 4},
+    {7,  10, 4},
+    {0,  20, 4},
+};
+
+static const SchedTest_TaskType *g_SchedTest_Tasks;
+static uint32 g_SchedTest_TaskCount;
+
+static SchedTest_RunType g_SchedTest_Log[SCHEDTEST_MAX_LOG];
+static uint32 g_SchedTest_LogCount = 0;
+
+/* Core cycle of the last tick interrupt */
+static volatile uint64 g_SchedTest_TickCycle = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static void SchedTest_TickTask(void)
+{
+    g_SchedTest_TickCycle = Sim_GetCycles();
+    Sched_Tick();
+}
+
+static void SchedTest_Record(Sched_PriorityType a_Priority, uint64 a_Work)
+{
+    SchedTest_RunType *run = &g_SchedTest_Log[g_SchedTest_LogCount];
+
+    run->Priority    = a_Priority;
+    run->StartTick   = SysTick_GetTickCount();
+    run->StartCycles = Sim_GetCycles() - g_SchedTest_TickCycle;
+    Sim_Compute(a_Work);
+    run->EndTick     = SysTick_GetTickCount();
+
+    if (g_SchedTest_LogCount < (SCHEDTEST_MAX_LOG - 1))
+    {
+        g_SchedTest_LogCount++;
+    }
+}
+
+/* One task function per priority level used by the cases, each records its runs */
+#define SCHEDTEST_TASK(PRIORITY) static void SchedTest_Task##PRIORITY(void) { SchedTest_Record(PRIORITY, 200); }
+SCHEDTEST_TASK(0)
+SCHEDTEST_TASK(2)
+SCHEDTEST_TASK(3)
+SCHEDTEST_TASK(7)
+SCHEDTEST_TASK(9)
+SCHEDTEST_TASK(20)
+SCHEDTEST_TASK(31)
+
+static Sched_TaskFuncType SchedTest_TaskFunc(Sched_PriorityType a_Priority)
+{
+    switch (a_Priority)
+    {
+        case 0:  return SchedTest_Task0;
+        case 2:  return SchedTest_Task2;
+        case 3:  return SchedTest_Task3;
+        case 7:  return SchedTest_Task7;
+        case 9:  return SchedTest_Task9;
+        case 20: return SchedTest_Task20;
+        case 31: return SchedTest_Task31;
+        default: return NULL_PTR;
+    }
+}
+
+static void SchedTest_OverrunTask(void)
+{
+    SchedTest_Record(0, SCHEDTEST_OVERRUN_WORK);
+}
+
+/* Start the tick and run the dispatcher until the given tick, no task is running on return */
+static void SchedTest_RunTicks(uint32 a_Ticks)
+{
+    SysTick_SetCallBack(SchedTest_TickTask);
+    SysTick_Init(SCHEDTEST_TICK_MS);
+    Idle_Init();
+    Enable_Exceptions();
+
+    while (SysTick_GetTickCount() < a_Ticks)
+    {
+        Sched_Dispatch();
+    }
+    Disable_Exceptions();
+}
+
+static void SchedTest_AddTasks(const SchedTest_TaskType *a_Tasks, uint32 a_Count)
+{
+    uint32 task;
+
+    g_SchedTest_Tasks     = a_Tasks;
+    g_SchedTest_TaskCount = a_Count;
+
+    Sched_Init();
+    for (task = 0; task < a_Count; task++)
+    {
+        (void)Sched_AddTask(a_Tasks[task].Priority, SchedTest_TaskFunc(a_Tasks[task].Priority), a_Tasks[task].PeriodTicks,
+                            a_Tasks[task].OffsetTicks);
+    }
+}
+
+static const SchedTest_TaskType *SchedTest_FindTask(Sched_PriorityType a_Priority)
+{
+    uint32 task;
+
+    for (task = 0; task < g_SchedTest_TaskCount; task++)
+    {
+        if (g_SchedTest_Tasks[task].Priority == a_Priority)
+        {
+            return &g_SchedTest_Tasks[task];
+        }
+    }
+    return NULL_PTR;
+}
+
+/* Every task runs once per release, in the tick of the release, with no overrun */
+static boolean SchedTest_Release(const Sim_CaseType *a_Case)
+{
+    const SchedTest_TaskType *task;
+    Sched_TaskStatsType stats;
+    uint32 next_release[SCHED_MAX_TASKS];
+    uint64 max_start = 0;
+    uint32 run;
+    uint32 index;
+    boolean passed = TRUE;
+
+    SchedTest_AddTasks(g_SchedTest_ReleaseTasks, sizeof(g_SchedTest_ReleaseTasks) / sizeof(g_SchedTest_ReleaseTasks[0]));
+    for (index = 0; index < g_SchedTest_TaskCount; index++)
+    {
+        next_release[g_SchedTest_Tasks[index].Priority] = g_SchedTest_Tasks[index].OffsetTicks + 1;
+    }
+
+    SchedTest_RunTicks(SCHEDTEST_TICKS);
+
+    for (run = 0; run < g_SchedTest_LogCount; run++)
+    {
+        task = SchedTest_FindTask(g_SchedTest_Log[run].Priority);
+        if (g_SchedTest_Log[run].StartTick != next_release[task->Priority])
+        {
+            printf("FAIL %s: priority %u started in tick %u, released in tick %u\n", a_Case->Name, task->Priority,
+                   g_SchedTest_Log[run].StartTick, next_release[task->Priority]);
+            passed = FALSE;
+        }
+        next_release[task->Priority] = g_SchedTest_Log[run].StartTick + task->PeriodTicks;
+
+        if (((run == 0) || (g_SchedTest_Log[run - 1].StartTick != g_SchedTest_Log[run].StartTick)) &&
+            (g_SchedTest_Log[run].StartCycles > max_start))
+        {
+            max_start = g_SchedTest_Log[run].StartCycles;
+        }
+    }
+
+    /* The run stops at the last tick, before the dispatch of its releases */
+    for (index = 0; index < g_SchedTest_TaskCount; index++)
+    {
+        task = &g_SchedTest_Tasks[index];
+        Sched_GetTaskStats(task->Priority, &stats);
+        if ((stats.Runs != (uint32)(((SCHEDTEST_TICKS - 2 - task->OffsetTicks) / task->PeriodTicks) + 1)) || (stats.Overruns != 0))
+        {
+            printf("FAIL %s: priority %u ran %u times with %u overruns\n", a_Case->Name, task->Priority, stats.Runs, stats.Overruns);
+            passed = FALSE;
+        }
+    }
+
+    if (max_start > SCHEDTEST_MAX_START_CYCLES)
+    {
+        printf("FAIL %s: the first task of a tick started %llu cycles after it\n", a_Case->Name, (unsigned long long)max_start);
+        passed = FALSE;
+    }
+    printf("release:  %u runs, first start at most %llu cycles after the tick\n", g_SchedTest_LogCount,
+           (unsigned long long)max_start);
+    return passed;
+}
+
+/* Tasks released in the same tick run from priority 0 down */
+static boolean SchedTest_Priority(const Sim_CaseType *a_Case)
+{
+    uint32 run;
+    boolean passed = TRUE;
+
+    SchedTest_AddTasks(g_SchedTest_PriorityTasks, sizeof(g_SchedTest_PriorityTasks) / sizeof(g_SchedTest_PriorityTasks[0]));
+    SchedTest_RunTicks(SCHEDTEST_TICKS);
+
+    for (run = 1; run < g_SchedTest_LogCount; run++)
+    {
+        if ((g_SchedTest_Log[run].StartTick == g_SchedTest_Log[run - 1].StartTick) &&
+            (g_SchedTest_Log[run].Priority <= g_SchedTest_Log[run - 1].Priority))
+        {
+            printf("FAIL %s: priority %u ran after priority %u in tick %u\n", a_Case->Name, g_SchedTest_Log[run].Priority,
+                   g_SchedTest_Log[run - 1].Priority, g_SchedTest_Log[run].StartTick);
+            passed = FALSE;
+        }
+    }
+
+    printf("priority: %u runs\n", g_SchedTest_LogCount);
+    return passed;
+}
+
+/* Releases that come while the task runs are overruns, and every release is run or counted */
+static boolean SchedTest_Overrun(const Sim_CaseType *a_Case)
+{
+    Sched_TaskStatsType stats;
+    uint32 expected = 0;
+    uint32 releases;
+    uint32 tick;
+    uint32 run;
+    boolean passed = TRUE;
+
+    Sched_Init();
+    (void)Sched_AddTask(0, SchedTest_OverrunTask, SCHEDTEST_OVERRUN_PERIOD, 0);
+    SchedTest_RunTicks(SCHEDTEST_TICKS);
+
+    /* Releases on ticks 1, 1 + period, ... that fall after the start of a run and up to its end */
+    for (run = 0; run < g_SchedTest_LogCount; run++)
+    {
+        for (tick = g_SchedTest_Log[run].StartTick + 1; tick <= g_SchedTest_Log[run].EndTick; tick++)
+        {
+            if (((tick - 1) % SCHEDTEST_OVERRUN_PERIOD) == 0)
+            {
+                expected++;
+            }
+        }
+    }
+    releases = ((SysTick_GetTickCount() - 1) / SCHEDTEST_OVERRUN_PERIOD) + 1;
+
+    Sched_GetTaskStats(0, &stats);
+    if ((stats.Overruns != expected) || (expected == 0))
+    {
+        printf("FAIL %s: %u overruns counted, %u releases came while the task was running\n", a_Case->Name, stats.Overruns,
+               expected);
+        passed = FALSE;
+    }
+    if ((stats.Runs + stats.Overruns) != releases)
+    {
+        printf("FAIL %s: %u runs and %u overruns for %u releases\n", a_Case->Name, stats.Runs, stats.Overruns, releases);
+        passed = FALSE;
+    }
+
+    printf("overrun:  %u releases, %u runs, %u overruns\n", releases, stats.Runs, stats.Overruns);
+    return passed;
+}
+
+static const Sim_CaseType g_SchedTest_Cases[] =
+{
+    {"release",  SchedTest_Release,  NULL_PTR},
+    {"priority", SchedTest_Priority, NULL_PTR},
+    {"overrun",  SchedTest_Overrun,  NULL_PTR},
+};
+
+#define SCHEDTEST_CASES                      (sizeof(g_SchedTest_Cases) / sizeof(g_SchedTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_SchedTest_Cases, SCHEDTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,1359 @@
+/**************************************************************************************************************************************
+ Module      : Sim
+ Name        : Sim.c
+ Author      : Salma Hamdy
+ Description : Source file for the host-side cycle-level simulator of the SysTick timer and the NVIC (TM4C_SIM builds only)
+
+ The application runs natively on the host, time is a virtual cycle clock advanced by the register accesses, the exception
+ entry / exit sequences and WFI (which jumps to the next event). The simulator is single threaded and deterministic: the same
+ binary and the same stimuli always give the same cycle counts.
+
+ Every HW_REG32 access returns a pointer to a register slot, the slot is refreshed with the simulated value before it is
+ handed out and a write is detected when the next simulator call finds a different value in it. A write of the value that
+ was just read is therefore not seen, which only matters for write-one-to-act registers written with their read value. For
+ that reason the NVIC clear-enable and clear-pending registers read as 0 here instead of the enable and pending bits, so the
+ single write-one-to-clear of the bit of an IRQ is seen even when it is the only bit set in its register.
+
+ Run time options (environment variables):
+   SIM_CYCLES         Cycles to simulate before printing the report and exiting (default 10 seconds)
+   SIM_ACCESS_CYCLES  Cost of one register access (default 2)
+   SIM_IRQ            External interrupts to pend, "irq@cycle,irq@cycle,..." (e.g. "30@8000000" presses SW2 after 0.5 s)
+   SIM_FPU_CONTEXT    1 if the thread mode code keeps an FP context active (CONTROL.FPCA), the exceptions taken from it then
+                      stack the FP state as FPCCR selects: automatic, lazy (space only) or not at all. The handlers are
+                      integer-only, they never set FPCA themselves.
+
+ The system clock follows RCC / RCC2: oscillator source, SYSDIV, bypass and the PLL with its lock time (the MOSC is the 16 MHz
+ crystal, the PLL only locks with XTAL set for it). Cycles are core cycles at the running frequency, so SIM_CYCLES and the SIM_IRQ
+ times are shorter in time at a higher clock, the report converts them with the clock history. Selecting the MOSC before it is
+ stable, the PLL before it locks or a clock above 80 MHz ends the run with an error, as the device would run out of spec. A
+ SysTick counter clocked by PIOSC / 4 (CLK_SRC clear) keeps its 4 MHz rate across these changes. Sim_SetClockFailure makes the
+ next MOSC start-up or PLL lock never complete, for the timeout paths of the clock driver.
+
+The report also gives the energy of the run from a rough supply current model: run and sleep currents growing linearly with the
+system clock, plus the PLL and the MOSC while they are powered. The figures are in the range of the data sheet tables, they are
+meant to compare two runs of the same application (fixed clock against a governor), not to predict the current of a board.
+
+ When the startup file is linked in, the exceptions are taken through its g_pfnVectors entries, so an instrumented vector
+ table (ISR_TIMING) and the default handler run exactly as on target. Without it only the application handlers below are known.
+ The NMI is pended by NMIPENDSET, it is taken even with PRIMASK or FAULTMASK set and preempts every exception but itself.
+ ***************************************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "Sim.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define SIM_DEFAULT_CYCLES                   (10 * SIM_CORE_CLOCK_HZ)
+#define SIM_DEFAULT_ACCESS_CYCLES            2
+#define SIM_NEVER                            0xFFFFFFFFFFFFFFFFULL
+#define SIM_FAILED                           (SIM_NEVER - 1)    /* Ready cycle of a powered MOSC or PLL that never gets ready */
+
+#define SIM_REGISTER_SLOTS                   1024
+#define SIM_MAX_STIMULI                      64
+
+/* Priorities: 0..7 from the 3 implemented bits, thread mode is below all of them */
+#define SIM_THREAD_PRIORITY                  8
+#define SIM_NO_EXCEPTION                     0
+
+/* Modelled registers */
+#define SIM_SYSTICK_CTRL                     0xE000E010
+#define SIM_SYSTICK_RELOAD                   0xE000E014
+#define SIM_SYSTICK_CURRENT                  0xE000E018
+#define SIM_NVIC_EN0                         0xE000E100
+#define SIM_NVIC_DIS0                        0xE000E180
+#define SIM_NVIC_PEND0                       0xE000E200
+#define SIM_NVIC_UNPEND0                     0xE000E280
+#define SIM_NVIC_PRI0                        0xE000E400
+#define SIM_NVIC_INTCTRL                     0xE000ED04
+#define SIM_NVIC_SYSPRI2                     0xE000ED1C
+#define SIM_NVIC_SYSPRI3                     0xE000ED20
+#define SIM_DWT_CTRL                         0xE0001000
+#define SIM_DWT_CYCCNT                       0xE0001004
+#define SIM_FPU_FPCC                         0xE000EF34
+#define SIM_SYSCTL_RIS                       0x400FE050
+#define SIM_SYSCTL_RCC                       0x400FE060
+#define SIM_SYSCTL_RCC2                      0x400FE070
+#define SIM_SYSCTL_PLLSTAT                   0x400FE168
+#define SIM_SYSCTL_RCGC_BASE                 0x400FE600
+#define SIM_SYSCTL_PR_BASE                   0x400FEA00
+#define SIM_SYSCTL_PR_END                    0x400FEA80
+
+#define SIM_SYSTICK_ENABLE_MASK              0x00000001
+#define SIM_SYSTICK_TICKINT_MASK             0x00000002
+#define SIM_SYSTICK_CLK_SRC_MASK             0x00000004   /* System clock, PIOSC / 4 when clear */
+#define SIM_SYSTICK_COUNTFLAG_MASK           0x00010000
+#define SIM_SYSTICK_RELOAD_MASK              0x00FFFFFF
+
+#define SIM_INTCTRL_NMIPENDSET_MASK          0x80000000
+#define SIM_INTCTRL_PENDSVSET_MASK           0x10000000
+#define SIM_INTCTRL_PENDSVCLR_MASK           0x08000000
+#define SIM_INTCTRL_PENDSTSET_MASK           0x04000000
+#define SIM_INTCTRL_PENDSTCLR_MASK           0x02000000
+#define SIM_INTCTRL_ISRPENDING_MASK          0x00400000
+#define SIM_INTCTRL_VECTPENDING_POS          12
+
+#define SIM_DWT_CYCCNTENA_MASK               0x00000001
+
+#define SIM_FPCC_ASPEN_MASK                  0x80000000
+#define SIM_FPCC_LSPEN_MASK                  0x40000000
+#define SIM_FPCC_LSPACT_MASK                 0x00000001
+#define SIM_FPCC_RESET_VALUE                 (SIM_FPCC_ASPEN_MASK | SIM_FPCC_LSPEN_MASK)
+#define SIM_CONTROL_FPCA_MASK                0x00000004
+
+#define SIM_RCC_RESET_VALUE                  0x078E3AD1   /* PIOSC, PLL bypassed and powered down, MOSC disabled */
+#define SIM_RCC2_RESET_VALUE                 0x07C06810
+#define SIM_RCC_MOSCDIS_MASK                 0x00000001
+#define SIM_RCC_OSCSRC_POS                   4
+#define SIM_RCC_XTAL_MASK                    0x000007C0
+#define SIM_RCC_XTAL_16MHZ                   0x00000540
+#define SIM_RCC_BYPASS_MASK                  0x00000800
+#define SIM_RCC_PWRDN_MASK                   0x00002000
+#define SIM_RCC_USESYSDIV_MASK               0x00400000
+#define SIM_RCC_SYSDIV_POS                   23
+#define SIM_RCC2_USERCC2_MASK                0x80000000
+#define SIM_RCC2_DIV400_MASK                 0x40000000
+#define SIM_RCC2_SYSDIV2_POS                 23
+#define SIM_RCC2_SYSDIV400_POS               22
+#define SIM_RCC2_PWRDN2_MASK                 0x00002000
+#define SIM_RCC2_BYPASS2_MASK                0x00000800
+#define SIM_RCC2_OSCSRC2_POS                 4
+#define SIM_RIS_PLLLRIS_MASK                 0x00000040
+#define SIM_RIS_MOSCPUPRIS_MASK              0x00000100
+#define SIM_PLLSTAT_LOCK_MASK                0x00000001
+
+/* Oscillator sources (OSCSRC2 encoding) and clock limits of the model */
+#define SIM_OSC_MOSC                         0
+#define SIM_OSC_PIOSC                        1
+#define SIM_OSC_PIOSC_DIV4                   2
+#define SIM_OSC_LFIOSC                       3
+#define SIM_MOSC_HZ                          16000000UL
+#define SIM_PIOSC_HZ                         16000000UL
+#define SIM_LFIOSC_HZ                        30000UL
+#define SIM_PIOSC_DIV4_HZ                    (SIM_PIOSC_HZ / 4)
+#define SIM_PLL_HZ                           400000000UL
+#define SIM_MAX_CLOCK_HZ                     80000000UL
+#define SIM_MOSC_STARTUP_CYCLES              8000         /* Crystal start-up, in cycles of the clock running meanwhile */
+#define SIM_PLL_LOCK_CYCLES                  2048
+#define SIM_NS_PER_SECOND                    1000000000ULL
+
+/* Power model: supply voltage and currents (run and sleep current at 0 Hz and per MHz, PLL and MOSC when powered) */
+#define SIM_SUPPLY_MV                        3300
+#define SIM_RUN_UA                           3000
+#define SIM_RUN_UA_PER_MHZ                   400
+#define SIM_SLEEP_UA                         1500
+#define SIM_SLEEP_UA_PER_MHZ                 150
+#define SIM_PLL_UA                           2500
+#define SIM_MOSC_UA                          400
+#define SIM_PJ_PER_NW_SECOND                 1000ULL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Sim_HandlerType)(void);
+
+typedef struct
+{
+    uint32 Address;
+    uint32 Value;
+    boolean Used;
+}Sim_SlotType;
+
+typedef struct
+{
+    uint32 Taken;
+    uint32 TailChained;         /* Entered straight from the exit of another handler */
+    uint32 LateArrivals;        /* Replaced a lower priority exception during its stacking */
+    uint32 Preemptions;         /* Entered on top of another active handler */
+    uint32 LatencyMin;          /* Cycles from pending to the first handler instruction */
+    uint32 LatencyMax;
+    uint64 LatencySum;
+}Sim_ExceptionStatsType;
+
+typedef struct
+{
+    uint8 IrqNum;
+    uint64 Cycle;
+}Sim_StimulusType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Handlers of the application, the weak references stay NULL when the application does not define them */
+extern void PendSV_Handler(void) __attribute__((weak));
+extern void SysTick_Handler(void) __attribute__((weak));
+extern void GPIOPortA_Handler(void) __attribute__((weak));
+extern void GPIOPortB_Handler(void) __attribute__((weak));
+extern void GPIOPortC_Handler(void) __attribute__((weak));
+extern void GPIOPortD_Handler(void) __attribute__((weak));
+extern void GPIOPortE_Handler(void) __attribute__((weak));
+extern void GPIOPortF_Handler(void) __attribute__((weak));
+
+/* Vector table of the startup file when it is linked in, e.g. the instrumented table of the ISR_TIMING build */
+extern void (* const g_pfnVectors[])(void) __attribute__((weak));
+
+/* Virtual clock */
+static uint64 g_Sim_Cycles = 0;
+static uint64 g_Sim_SleepCycles = 0;
+static uint64 g_Sim_CycleLimit = SIM_DEFAULT_CYCLES;
+static uint32 g_Sim_AccessCycles = SIM_DEFAULT_ACCESS_CYCLES;
+
+/* Set in the child process of a Sim_RunCases case, the end of the virtual clock then fails the case */
+static boolean g_Sim_CaseRunning = FALSE;
+
+/* Register file, the slot handed out by the last access and the value it held at that time */
+static Sim_SlotType g_Sim_Slots[SIM_REGISTER_SLOTS];
+static Sim_SlotType *g_Sim_Accessed = NULL_PTR;
+static uint32 g_Sim_AccessedValue = 0;
+
+/* Core state */
+static uint8 g_Sim_Primask = 0;
+static uint8 g_Sim_Faultmask = 0;
+
+/* SysTick: the counter is not stepped, the time of its next zero is kept instead */
+static uint32 g_Sim_SysTickCtrl = 0;
+static uint32 g_Sim_SysTickReload = 0;
+static uint32 g_Sim_SysTickStopped = 0;          /* Counter value while disabled */
+static uint32 g_Sim_SysTickCountFlag = 0;
+static uint64 g_Sim_SysTickNextZero = SIM_NEVER;
+static uint32 g_Sim_SysTickLoaded = 0;           /* Value the running period started from, a RELOAD write waits for the wrap */
+static uint64 g_Sim_SysTickPhase = 0;            /* PIOSC / 4 counter: next zero is this many 1/SIM_PIOSC_DIV4_HZ cycles later */
+
+/* NVIC */
+static uint32 g_Sim_IrqEnabled[SIM_IRQS / 32];
+static boolean g_Sim_Pending[SIM_EXCEPTIONS];
+static uint64 g_Sim_PendCycle[SIM_EXCEPTIONS];
+static uint16 g_Sim_Active[SIM_EXCEPTIONS];
+static uint8 g_Sim_ActivePriority[SIM_EXCEPTIONS];
+static uint16 g_Sim_ActiveDepth = 0;
+static Sim_ExceptionStatsType g_Sim_Stats[SIM_EXCEPTIONS];
+
+/* DWT cycle counter */
+static boolean g_Sim_DwtEnabled = FALSE;
+static uint32 g_Sim_DwtStopped = 0;
+static uint64 g_Sim_DwtBase = 0;
+
+/* FPU context stacking */
+static uint32 g_Sim_Fpcc = SIM_FPCC_RESET_VALUE;
+static boolean g_Sim_ThreadFpca = FALSE;
+static uint32 g_Sim_FpFrames = 0;               /* Frames with S0-S15 and FPSCR stacked */
+static uint32 g_Sim_LazyFrames = 0;             /* Frames with the FP space reserved, registers not stacked */
+
+/* System clock: the configuration registers, the oscillator and PLL readiness and the time at the last frequency change */
+static uint32 g_Sim_Rcc = SIM_RCC_RESET_VALUE;
+static uint32 g_Sim_Rcc2 = SIM_RCC2_RESET_VALUE;
+static uint64 g_Sim_MoscReadyCycle = SIM_NEVER;
+static uint64 g_Sim_PllLockCycle = SIM_NEVER;
+static uint32 g_Sim_PllReference = 0;            /* Oscillator and XTAL the PLL is locking or locked to */
+static boolean g_Sim_MoscFails = FALSE;
+static boolean g_Sim_PllFails = FALSE;
+static uint32 g_Sim_ClockHz = SIM_CORE_CLOCK_HZ;
+static uint64 g_Sim_ClockCycle = 0;
+static uint64 g_Sim_ClockNs = 0;
+static uint32 g_Sim_ClockChanges = 0;
+
+/* Energy of the run up to the start of the current power segment, which begins at each clock configuration change */
+static uint64 g_Sim_EnergyPj = 0;
+static uint64 g_Sim_EnergyCycle = 0;
+static uint64 g_Sim_EnergySleepCycles = 0;
+
+/* External interrupt stimuli sorted by cycle */
+static Sim_StimulusType g_Sim_Stimuli[SIM_MAX_STIMULI];
+static uint8 g_Sim_StimuliCount = 0;
+static uint8 g_Sim_NextStimulus = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static Sim_SlotType *Sim_FindSlot(uint32 a_Address)
+{
+    uint32 index = (a_Address >> 2) % SIM_REGISTER_SLOTS;
+
+    while (g_Sim_Slots[index].Used && (g_Sim_Slots[index].Address != a_Address))
+    {
+        index = (index + 1) % SIM_REGISTER_SLOTS;
+    }
+    if (!g_Sim_Slots[index].Used)
+    {
+        g_Sim_Slots[index].Used    = TRUE;
+        g_Sim_Slots[index].Address = a_Address;
+        g_Sim_Slots[index].Value   = 0;           /* Reset value of all the modelled registers */
+    }
+    return &g_Sim_Slots[index];
+}
+
+static uint32 Sim_PeekRegister(uint32 a_Address)
+{
+    return Sim_FindSlot(a_Address)->Value;
+}
+
+static void Sim_Pend(uint16 a_Exception, uint64 a_Cycle)
+{
+    if (!g_Sim_Pending[a_Exception])
+    {
+        g_Sim_Pending[a_Exception]   = TRUE;
+        g_Sim_PendCycle[a_Exception] = a_Cycle;
+    }
+}
+
+/* Group priority of an exception from the priority registers, all 3 implemented bits preempt (PRIGROUP reset value) */
+static uint8 Sim_Priority(uint16 a_Exception)
+{
+    uint16 irq;
+
+    switch (a_Exception)
+    {
+    case SIM_EXCEPTION_NMI:
+        return 0;                                   /* Fixed -2, Sim_SelectPending lets it through the masks */
+    case SIM_EXCEPTION_PENDSV:
+        return (uint8)((Sim_PeekRegister(SIM_NVIC_SYSPRI3) >> 21) & 0x7);
+    case SIM_EXCEPTION_SYSTICK:
+        return (uint8)((Sim_PeekRegister(SIM_NVIC_SYSPRI3) >> 29) & 0x7);
+    default:
+        irq = a_Exception - SIM_EXCEPTION_IRQ(0);
+        return (uint8)((Sim_PeekRegister(SIM_NVIC_PRI0 + (irq / 4) * 4) >> ((irq % 4) * 8 + 5)) & 0x7);
+    }
+}
+
+static boolean Sim_IsEnabled(uint16 a_Exception)
+{
+    uint16 irq;
+
+    if (a_Exception < SIM_EXCEPTION_IRQ(0))
+    {
+        return TRUE;                                /* PendSV and SysTick have no enable bit in the NVIC */
+    }
+    irq = a_Exception - SIM_EXCEPTION_IRQ(0);
+    return (g_Sim_IrqEnabled[irq / 32] >> (irq % 32)) & 1;
+}
+
+/* Priority of the running code, only exceptions with a lower value (more urgent) can preempt it */
+static uint8 Sim_RunningPriority(void)
+{
+    return (g_Sim_ActiveDepth == 0) ? SIM_THREAD_PRIORITY : g_Sim_ActivePriority[g_Sim_ActiveDepth - 1];
+}
+
+static uint8 Sim_ExecutionPriority(void)
+{
+    return (g_Sim_Primask || g_Sim_Faultmask) ? 0 : Sim_RunningPriority();
+}
+
+/* Most urgent pending and enabled exception above a priority, ties go to the lowest exception number */
+static uint16 Sim_SelectPending(uint8 a_Threshold)
+{
+    uint16 best = SIM_NO_EXCEPTION;
+    uint8 best_priority = a_Threshold;
+    uint16 exception;
+    uint8 priority;
+    uint16 depth;
+
+    /* The NMI is above every priority and not masked, only an active NMI holds it pending */
+    if (g_Sim_Pending[SIM_EXCEPTION_NMI])
+    {
+        for (depth = 0; (depth < g_Sim_ActiveDepth) && (g_Sim_Active[depth] != SIM_EXCEPTION_NMI); depth++)
+        {
+        }
+        if (depth == g_Sim_ActiveDepth)
+        {
+            return SIM_EXCEPTION_NMI;
+        }
+    }
+
+    for (exception = SIM_EXCEPTION_PENDSV; exception < SIM_EXCEPTIONS; exception++)
+    {
+        if (g_Sim_Pending[exception] && Sim_IsEnabled(exception))
+        {
+            priority = Sim_Priority(exception);
+            if (priority < best_priority)
+            {
+                best = exception;
+                best_priority = priority;
+            }
+        }
+    }
+    return best;
+}
+
+/* Core cycles until the counter has run a number of its clocks from the last computed zero. A PIOSC / 4 counter is not in
+ * step with the core clock, the fraction of a core cycle is carried to the next period so the periods do not drift. */
+static uint64 Sim_SysTickCycles(uint64 a_Counts)
+{
+    uint64 scaled;
+
+    if (g_Sim_SysTickCtrl & SIM_SYSTICK_CLK_SRC_MASK)
+    {
+        return a_Counts;
+    }
+    scaled = a_Counts * g_Sim_ClockHz + g_Sim_SysTickPhase;
+    g_Sim_SysTickPhase = scaled % SIM_PIOSC_DIV4_HZ;
+    return scaled / SIM_PIOSC_DIV4_HZ;
+}
+
+static uint32 Sim_SysTickValue(void)
+{
+    uint64 remaining;
+
+    if (!(g_Sim_SysTickCtrl & SIM_SYSTICK_ENABLE_MASK))
+    {
+        return g_Sim_SysTickStopped;
+    }
+    remaining = g_Sim_SysTickNextZero - g_Sim_Cycles;
+    if (!(g_Sim_SysTickCtrl & SIM_SYSTICK_CLK_SRC_MASK) && (g_Sim_SysTickNextZero > g_Sim_Cycles))
+    {
+        remaining = (remaining * SIM_PIOSC_DIV4_HZ + g_Sim_SysTickPhase + g_Sim_ClockHz - 1) / g_Sim_ClockHz;
+    }
+    return (remaining > g_Sim_SysTickLoaded) ? 0 : (uint32)remaining;
+}
+
+/* Keep the next zero of a PIOSC / 4 counter at the same time when the core clock changes, in cycles of the new clock */
+static void Sim_SysTickClockChanged(uint32 a_NewFrequencyHz)
+{
+    uint64 scaled;
+    uint64 counts;
+    uint64 fraction;
+
+    if (!(g_Sim_SysTickCtrl & SIM_SYSTICK_ENABLE_MASK) || (g_Sim_SysTickCtrl & SIM_SYSTICK_CLK_SRC_MASK) ||
+        (g_Sim_SysTickNextZero <= g_Sim_Cycles))
+    {
+        return;
+    }
+    scaled   = (g_Sim_SysTickNextZero - g_Sim_Cycles) * SIM_PIOSC_DIV4_HZ + g_Sim_SysTickPhase;
+    counts   = scaled / g_Sim_ClockHz;                         /* Counter clocks left, and the fraction of one */
+    fraction = scaled % g_Sim_ClockHz;
+    scaled   = counts * a_NewFrequencyHz + (fraction * a_NewFrequencyHz) / g_Sim_ClockHz;
+    g_Sim_SysTickNextZero = g_Sim_Cycles + scaled / SIM_PIOSC_DIV4_HZ;
+    g_Sim_SysTickPhase    = scaled % SIM_PIOSC_DIV4_HZ;
+}
+
+static uint64 Sim_NextEventCycle(void)
+{
+    uint64 next = SIM_NEVER;
+
+    if ((g_Sim_SysTickCtrl & SIM_SYSTICK_TICKINT_MASK) && (g_Sim_SysTickCtrl & SIM_SYSTICK_ENABLE_MASK))
+    {
+        next = g_Sim_SysTickNextZero;
+    }
+    if ((g_Sim_NextStimulus < g_Sim_StimuliCount) && (g_Sim_Stimuli[g_Sim_NextStimulus].Cycle < next))
+    {
+        next = g_Sim_Stimuli[g_Sim_NextStimulus].Cycle;
+    }
+    return next;
+}
+
+static void Sim_Report(void)
+{
+    uint16 exception;
+    Sim_ExceptionStatsType *stats;
+    uint64 time_ns = Sim_GetTimeNs();
+    uint64 energy_uj = Sim_GetEnergyUj();
+    uint64 power_uw = (time_ns == 0) ? 0 : (g_Sim_EnergyPj * 1000) / time_ns;
+
+    printf("sim: %llu cycles (%llu.%03llu s), %llu cycles asleep\n",
+           g_Sim_Cycles, time_ns / SIM_NS_PER_SECOND, (time_ns % SIM_NS_PER_SECOND) / 1000000, g_Sim_SleepCycles);
+    printf("sim: energy %llu.%03llu mJ, average power %llu.%03llu mW (power model)\n",
+           energy_uj / 1000, energy_uj % 1000, power_uw / 1000, power_uw % 1000);
+    if (g_Sim_ClockChanges != 0)
+    {
+        printf("sim: %u system clock changes, %u Hz at the end\n", g_Sim_ClockChanges, g_Sim_ClockHz);
+    }
+    if (g_Sim_ThreadFpca)
+    {
+        printf("sim: FP context in thread mode, FPCCR %s, %u frames with FP state stacked, %u with FP space reserved\n",
+               !(g_Sim_Fpcc & SIM_FPCC_ASPEN_MASK) ? "FP stacking disabled" :
+               (g_Sim_Fpcc & SIM_FPCC_LSPEN_MASK) ? "lazy stacking" : "automatic stacking",
+               g_Sim_FpFrames, g_Sim_LazyFrames);
+    }
+    printf("sim: exception    taken  tail-chained  late-arrival  preempting  latency min/avg/max (cycles)\n");
+
+    for (exception = SIM_EXCEPTION_NMI; exception < SIM_EXCEPTIONS; exception++)
+    {
+        stats = &g_Sim_Stats[exception];
+        if (stats->Taken != 0)
+        {
+            printf("sim: %9u %8u %13u %13u %11u  %u/%llu/%u\n", exception, stats->Taken, stats->TailChained,
+                   stats->LateArrivals, stats->Preemptions, stats->LatencyMin, stats->LatencySum / stats->Taken,
+                   stats->LatencyMax);
+        }
+    }
+}
+
+/* Energy in pJ of a number of cycles at a power in nW, split in whole seconds so the products fit 64 bits */
+static uint64 Sim_EnergyOf(uint64 a_PowerNw, uint64 a_Cycles)
+{
+    return a_PowerNw * (a_Cycles / g_Sim_ClockHz) * SIM_PJ_PER_NW_SECOND +
+           (a_PowerNw * (((a_Cycles % g_Sim_ClockHz) * SIM_NS_PER_SECOND) / g_Sim_ClockHz)) / 1000000;
+}
+
+/* Add the energy of the cycles run since the last update with the clock configuration that ran them */
+static void Sim_EnergyUpdate(void)
+{
+    uint64 cycles = g_Sim_Cycles - g_Sim_EnergyCycle;
+    uint64 sleep_cycles = g_Sim_SleepCycles - g_Sim_EnergySleepCycles;
+    uint64 mhz_ua_scale = g_Sim_ClockHz / 1000;
+    uint64 common_ua = ((g_Sim_PllLockCycle != SIM_NEVER) ? SIM_PLL_UA : 0) +
+                       ((g_Sim_MoscReadyCycle != SIM_NEVER) ? SIM_MOSC_UA : 0);
+    uint64 run_ua = SIM_RUN_UA + common_ua + (SIM_RUN_UA_PER_MHZ * mhz_ua_scale) / 1000;
+    uint64 sleep_ua = SIM_SLEEP_UA + common_ua + (SIM_SLEEP_UA_PER_MHZ * mhz_ua_scale) / 1000;
+
+    g_Sim_EnergyPj += Sim_EnergyOf(run_ua * SIM_SUPPLY_MV, cycles - sleep_cycles) +
+                      Sim_EnergyOf(sleep_ua * SIM_SUPPLY_MV, sleep_cycles);
+    g_Sim_EnergyCycle       = g_Sim_Cycles;
+    g_Sim_EnergySleepCycles = g_Sim_SleepCycles;
+}
+
+static void Sim_ClockFault(const char *a_Reason)
+{
+    printf("sim: %s at cycle %llu\n", a_Reason, g_Sim_Cycles);
+    Sim_Report();
+    exit(1);
+}
+
+/* Oscillator readiness and system clock frequency after a write to RCC or RCC2, the RCC2 fields apply once USERCC2 is set */
+static void Sim_ClockUpdate(void)
+{
+    boolean use_rcc2 = (g_Sim_Rcc2 & SIM_RCC2_USERCC2_MASK) ? TRUE : FALSE;
+    boolean div400   = (use_rcc2 && (g_Sim_Rcc2 & SIM_RCC2_DIV400_MASK)) ? TRUE : FALSE;
+    uint32 oscillator = use_rcc2 ? ((g_Sim_Rcc2 >> SIM_RCC2_OSCSRC2_POS) & 0x7) : ((g_Sim_Rcc >> SIM_RCC_OSCSRC_POS) & 0x3);
+    boolean bypass   = (use_rcc2 ? (g_Sim_Rcc2 & SIM_RCC2_BYPASS2_MASK) : (g_Sim_Rcc & SIM_RCC_BYPASS_MASK)) ? TRUE : FALSE;
+    boolean pll_on   = (use_rcc2 ? (g_Sim_Rcc2 & SIM_RCC2_PWRDN2_MASK) : (g_Sim_Rcc & SIM_RCC_PWRDN_MASK)) ? FALSE : TRUE;
+    uint32 divisor   = 1 + (div400 ? ((g_Sim_Rcc2 >> SIM_RCC2_SYSDIV400_POS) & 0x7F) :
+                            use_rcc2 ? ((g_Sim_Rcc2 >> SIM_RCC2_SYSDIV2_POS) & 0x3F) : ((g_Sim_Rcc >> SIM_RCC_SYSDIV_POS) & 0xF));
+    uint32 reference = oscillator | (g_Sim_Rcc & SIM_RCC_XTAL_MASK);
+    uint32 frequency;
+
+    Sim_EnergyUpdate();                                  /* The cycles so far ran with the previous configuration */
+
+    if (g_Sim_Rcc & SIM_RCC_MOSCDIS_MASK)
+    {
+        g_Sim_MoscReadyCycle = SIM_NEVER;
+    }
+    else if (g_Sim_MoscReadyCycle == SIM_NEVER)
+    {
+        g_Sim_MoscReadyCycle = g_Sim_MoscFails ? SIM_FAILED : (g_Sim_Cycles + SIM_MOSC_STARTUP_CYCLES);
+    }
+
+    /* The PLL (re)locks when powered up or given another reference, it needs a running 16 MHz reference with XTAL matching */
+    if (!pll_on || ((oscillator != SIM_OSC_MOSC) && (oscillator != SIM_OSC_PIOSC)) ||
+        ((g_Sim_Rcc & SIM_RCC_XTAL_MASK) != SIM_RCC_XTAL_16MHZ) ||
+        ((oscillator == SIM_OSC_MOSC) && (g_Sim_MoscReadyCycle == SIM_NEVER)))
+    {
+        g_Sim_PllLockCycle = SIM_NEVER;
+    }
+    else if (g_Sim_PllFails || ((oscillator == SIM_OSC_MOSC) && (g_Sim_MoscReadyCycle == SIM_FAILED)))
+    {
+        g_Sim_PllLockCycle = SIM_FAILED;
+    }
+    else if ((g_Sim_PllLockCycle == SIM_NEVER) || (g_Sim_PllLockCycle == SIM_FAILED) || (reference != g_Sim_PllReference))
+    {
+        g_Sim_PllLockCycle = ((oscillator == SIM_OSC_MOSC) && (g_Sim_MoscReadyCycle > g_Sim_Cycles) ?
+                              g_Sim_MoscReadyCycle : g_Sim_Cycles) + SIM_PLL_LOCK_CYCLES;
+    }
+    g_Sim_PllReference = reference;
+
+    switch (oscillator)
+    {
+    case SIM_OSC_MOSC:       frequency = SIM_MOSC_HZ;       break;
+    case SIM_OSC_PIOSC:      frequency = SIM_PIOSC_HZ;      break;
+    case SIM_OSC_PIOSC_DIV4: frequency = SIM_PIOSC_HZ / 4;  break;
+    default:                 frequency = SIM_LFIOSC_HZ;     break;
+    }
+
+    if (!bypass)
+    {
+        if (g_Sim_Cycles < g_Sim_PllLockCycle)
+        {
+            Sim_ClockFault("system clock switched to the PLL before it locked");
+        }
+        frequency = (div400 ? SIM_PLL_HZ : (SIM_PLL_HZ / 2)) / divisor;      /* SYSDIV always divides the PLL */
+    }
+    else
+    {
+        if ((oscillator == SIM_OSC_MOSC) && (g_Sim_Cycles < g_Sim_MoscReadyCycle))
+        {
+            Sim_ClockFault("system clock switched to the MOSC before it was stable");
+        }
+        if (g_Sim_Rcc & SIM_RCC_USESYSDIV_MASK)
+        {
+            frequency /= divisor;
+        }
+    }
+    if (frequency > SIM_MAX_CLOCK_HZ)
+    {
+        Sim_ClockFault("system clock above 80 MHz");
+    }
+
+    if (frequency != g_Sim_ClockHz)
+    {
+        Sim_SysTickClockChanged(frequency);
+        g_Sim_ClockNs    = Sim_GetTimeNs();
+        g_Sim_ClockCycle = g_Sim_Cycles;
+        g_Sim_ClockHz    = frequency;
+        g_Sim_ClockChanges++;
+    }
+}
+
+/* Bring the peripherals up to the virtual clock and stop the run at the cycle limit */
+static void Sim_Update(void)
+{
+    while ((g_Sim_SysTickCtrl & SIM_SYSTICK_ENABLE_MASK) && (g_Sim_SysTickReload != 0) &&
+           (g_Sim_Cycles >= g_Sim_SysTickNextZero))
+    {
+        g_Sim_SysTickCountFlag = SIM_SYSTICK_COUNTFLAG_MASK;
+        if (g_Sim_SysTickCtrl & SIM_SYSTICK_TICKINT_MASK)
+        {
+            Sim_Pend(SIM_EXCEPTION_SYSTICK, g_Sim_SysTickNextZero);
+        }
+        g_Sim_SysTickNextZero += Sim_SysTickCycles((uint64)g_Sim_SysTickReload + 1);  /* Reloaded on the clock after reaching zero */
+        g_Sim_SysTickLoaded    = g_Sim_SysTickReload;
+    }
+
+    while ((g_Sim_NextStimulus < g_Sim_StimuliCount) && (g_Sim_Cycles >= g_Sim_Stimuli[g_Sim_NextStimulus].Cycle))
+    {
+        Sim_Pend(SIM_EXCEPTION_IRQ(g_Sim_Stimuli[g_Sim_NextStimulus].IrqNum), g_Sim_Stimuli[g_Sim_NextStimulus].Cycle);
+        g_Sim_NextStimulus++;
+    }
+
+    if ((g_Sim_Cycles >= g_Sim_CycleLimit) && g_Sim_CaseRunning)
+    {
+        printf("sim: the case waits for an event that never comes\n");
+        exit(1);
+    }
+    if (g_Sim_Cycles >= g_Sim_CycleLimit)
+    {
+        Sim_Report();
+        exit(0);
+    }
+}
+
+/* Side effects of a write to a modelled register */
+static void Sim_Write(Sim_SlotType *a_Slot, uint32 a_Old)
+{
+    uint32 value = a_Slot->Value;
+    uint32 index;
+    uint32 bit;
+
+    switch (a_Slot->Address)
+    {
+    case SIM_SYSTICK_CTRL:
+        if ((value & SIM_SYSTICK_ENABLE_MASK) && !(g_Sim_SysTickCtrl & SIM_SYSTICK_ENABLE_MASK))
+        {
+            /* A zero counter loads RELOAD on the next clock without setting COUNTFLAG */
+            g_Sim_SysTickCtrl     = value & ~SIM_SYSTICK_COUNTFLAG_MASK;
+            g_Sim_SysTickPhase    = 0;
+            g_Sim_SysTickNextZero = g_Sim_Cycles + Sim_SysTickCycles((g_Sim_SysTickStopped == 0) ?
+                                    (uint64)g_Sim_SysTickReload + 1 : g_Sim_SysTickStopped);
+            g_Sim_SysTickLoaded   = (g_Sim_SysTickStopped == 0) ? g_Sim_SysTickReload : g_Sim_SysTickStopped;
+        }
+        else if (!(value & SIM_SYSTICK_ENABLE_MASK) && (g_Sim_SysTickCtrl & SIM_SYSTICK_ENABLE_MASK))
+        {
+            g_Sim_SysTickStopped = Sim_SysTickValue();
+        }
+        g_Sim_SysTickCtrl = value & ~SIM_SYSTICK_COUNTFLAG_MASK;
+        break;
+    case SIM_SYSTICK_RELOAD:
+        g_Sim_SysTickReload = value & SIM_SYSTICK_RELOAD_MASK;
+        break;
+    case SIM_SYSTICK_CURRENT:
+        /* Any write clears the counter and COUNTFLAG */
+        g_Sim_SysTickCountFlag = 0;
+        g_Sim_SysTickStopped   = 0;
+        g_Sim_SysTickPhase     = 0;
+        g_Sim_SysTickNextZero  = g_Sim_Cycles + Sim_SysTickCycles((uint64)g_Sim_SysTickReload + 1);
+        g_Sim_SysTickLoaded    = g_Sim_SysTickReload;
+        break;
+    case SIM_NVIC_INTCTRL:
+        if (value & SIM_INTCTRL_NMIPENDSET_MASK) Sim_Pend(SIM_EXCEPTION_NMI, g_Sim_Cycles);
+        if (value & SIM_INTCTRL_PENDSTSET_MASK) Sim_Pend(SIM_EXCEPTION_SYSTICK, g_Sim_Cycles);
+        if (value & SIM_INTCTRL_PENDSTCLR_MASK) g_Sim_Pending[SIM_EXCEPTION_SYSTICK] = FALSE;
+        if (value & SIM_INTCTRL_PENDSVSET_MASK) Sim_Pend(SIM_EXCEPTION_PENDSV, g_Sim_Cycles);
+        if (value & SIM_INTCTRL_PENDSVCLR_MASK) g_Sim_Pending[SIM_EXCEPTION_PENDSV] = FALSE;
+        break;
+    case SIM_DWT_CTRL:
+        if ((value & SIM_DWT_CYCCNTENA_MASK) && !g_Sim_DwtEnabled)
+        {
+            g_Sim_DwtBase = g_Sim_Cycles - g_Sim_DwtStopped;
+        }
+        else if (!(value & SIM_DWT_CYCCNTENA_MASK) && g_Sim_DwtEnabled)
+        {
+            g_Sim_DwtStopped = (uint32)(g_Sim_Cycles - g_Sim_DwtBase);
+        }
+        g_Sim_DwtEnabled = (value & SIM_DWT_CYCCNTENA_MASK) ? TRUE : FALSE;
+        break;
+    case SIM_DWT_CYCCNT:
+        g_Sim_DwtStopped = value;
+        g_Sim_DwtBase    = g_Sim_Cycles - value;
+        break;
+    case SIM_FPU_FPCC:
+        g_Sim_Fpcc = value;
+        break;
+    case SIM_SYSCTL_RCC:
+        g_Sim_Rcc = value;
+        Sim_ClockUpdate();
+        break;
+    case SIM_SYSCTL_RCC2:
+        g_Sim_Rcc2 = value;
+        Sim_ClockUpdate();
+        break;
+    default:
+        /* Set / clear enable and set / clear pending banks: only the bits written as one act */
+        if ((a_Slot->Address >= SIM_NVIC_EN0) && (a_Slot->Address < SIM_NVIC_PRI0))
+        {
+            index = (a_Slot->Address & 0x7F) / 4;
+            if (index >= (SIM_IRQS / 32))
+            {
+                break;
+            }
+            switch (a_Slot->Address & ~0x7F)
+            {
+            case SIM_NVIC_EN0:
+                g_Sim_IrqEnabled[index] |= value;
+                break;
+            case SIM_NVIC_DIS0:
+                g_Sim_IrqEnabled[index] &= ~value;
+                break;
+            case SIM_NVIC_PEND0:
+            case SIM_NVIC_UNPEND0:
+                value &= ~a_Old;                       /* The read value reflects the pending bits already set */
+                for (bit = 0; bit < 32; bit++)
+                {
+                    if (value & (1UL << bit))
+                    {
+                        if ((a_Slot->Address & ~0x7F) == SIM_NVIC_PEND0)
+                        {
+                            Sim_Pend(SIM_EXCEPTION_IRQ(index * 32 + bit), g_Sim_Cycles);
+                        }
+                        else
+                        {
+                            g_Sim_Pending[SIM_EXCEPTION_IRQ(index * 32 + bit)] = FALSE;
+                        }
+                    }
+                }
+                break;
+            }
+        }
+        break;
+    }
+}
+
+/* Value a register reads at the current cycle */
+static void Sim_Read(Sim_SlotType *a_Slot)
+{
+    uint32 index;
+    uint32 bit;
+    uint16 pending;
+
+    switch (a_Slot->Address)
+    {
+    case SIM_SYSTICK_CTRL:
+        a_Slot->Value = g_Sim_SysTickCtrl | g_Sim_SysTickCountFlag;
+        g_Sim_SysTickCountFlag = 0;                    /* COUNTFLAG is cleared by the read */
+        break;
+    case SIM_SYSTICK_RELOAD:
+        a_Slot->Value = g_Sim_SysTickReload;
+        break;
+    case SIM_SYSTICK_CURRENT:
+        a_Slot->Value = Sim_SysTickValue();
+        break;
+    case SIM_NVIC_INTCTRL:
+        pending = Sim_SelectPending(SIM_THREAD_PRIORITY + 1);
+        a_Slot->Value = (g_Sim_Pending[SIM_EXCEPTION_NMI] ? SIM_INTCTRL_NMIPENDSET_MASK : 0) |
+                        (g_Sim_Pending[SIM_EXCEPTION_PENDSV] ? SIM_INTCTRL_PENDSVSET_MASK : 0) |
+                        (g_Sim_Pending[SIM_EXCEPTION_SYSTICK] ? SIM_INTCTRL_PENDSTSET_MASK : 0) |
+                        ((pending != SIM_NO_EXCEPTION) ? SIM_INTCTRL_ISRPENDING_MASK : 0) |
+                        ((uint32)pending << SIM_INTCTRL_VECTPENDING_POS) |
+                        ((g_Sim_ActiveDepth != 0) ? g_Sim_Active[g_Sim_ActiveDepth - 1] : 0);
+        break;
+    case SIM_DWT_CYCCNT:
+        a_Slot->Value = g_Sim_DwtEnabled ? (uint32)(g_Sim_Cycles - g_Sim_DwtBase) : g_Sim_DwtStopped;
+        break;
+    case SIM_FPU_FPCC:
+        a_Slot->Value = g_Sim_Fpcc;
+        break;
+    case SIM_SYSCTL_RCC:
+        a_Slot->Value = g_Sim_Rcc;
+        break;
+    case SIM_SYSCTL_RCC2:
+        a_Slot->Value = g_Sim_Rcc2;
+        break;
+    case SIM_SYSCTL_RIS:
+        a_Slot->Value = ((g_Sim_Cycles >= g_Sim_PllLockCycle) ? SIM_RIS_PLLLRIS_MASK : 0) |
+                        ((g_Sim_Cycles >= g_Sim_MoscReadyCycle) ? SIM_RIS_MOSCPUPRIS_MASK : 0);
+        break;
+    case SIM_SYSCTL_PLLSTAT:
+        a_Slot->Value = (g_Sim_Cycles >= g_Sim_PllLockCycle) ? SIM_PLLSTAT_LOCK_MASK : 0;
+        break;
+    default:
+        if ((a_Slot->Address >= SIM_NVIC_EN0) && (a_Slot->Address < SIM_NVIC_PRI0))
+        {
+            index = (a_Slot->Address & 0x7F) / 4;
+            if (index >= (SIM_IRQS / 32))
+            {
+                a_Slot->Value = 0;
+            }
+            else if ((a_Slot->Address & ~0x7F) == SIM_NVIC_EN0)
+            {
+                a_Slot->Value = g_Sim_IrqEnabled[index];
+            }
+            else if ((a_Slot->Address & ~0x7F) != SIM_NVIC_PEND0)
+            {
+                a_Slot->Value = 0;                              /* Clear registers, see the header */
+            }
+            else
+            {
+                a_Slot->Value = 0;
+                for (bit = 0; bit < 32; bit++)
+                {
+                    if (g_Sim_Pending[SIM_EXCEPTION_IRQ(index * 32 + bit)])
+                    {
+                        a_Slot->Value |= (1UL << bit);
+                    }
+                }
+            }
+        }
+        else if ((a_Slot->Address >= SIM_SYSCTL_PR_BASE) && (a_Slot->Address < SIM_SYSCTL_PR_END))
+        {
+            /* Peripherals are ready as soon as their clock is enabled */
+            a_Slot->Value = Sim_PeekRegister(a_Slot->Address - SIM_SYSCTL_PR_BASE + SIM_SYSCTL_RCGC_BASE);
+        }
+        break;
+    }
+}
+
+/* Apply the pending write of the last handed out register, if any */
+static void Sim_Commit(void)
+{
+    Sim_SlotType *slot = g_Sim_Accessed;
+
+    g_Sim_Accessed = NULL_PTR;
+    if ((slot != NULL_PTR) && (slot->Value != g_Sim_AccessedValue))
+    {
+        Sim_Write(slot, g_Sim_AccessedValue);
+    }
+}
+
+static Sim_HandlerType Sim_Vector(uint16 a_Exception)
+{
+    switch (a_Exception)
+    {
+    case SIM_EXCEPTION_PENDSV:       return PendSV_Handler;
+    case SIM_EXCEPTION_SYSTICK:      return SysTick_Handler;
+    case SIM_EXCEPTION_IRQ(0):       return GPIOPortA_Handler;
+    case SIM_EXCEPTION_IRQ(1):       return GPIOPortB_Handler;
+    case SIM_EXCEPTION_IRQ(2):       return GPIOPortC_Handler;
+    case SIM_EXCEPTION_IRQ(3):       return GPIOPortD_Handler;
+    case SIM_EXCEPTION_IRQ(4):       return GPIOPortE_Handler;
+    case SIM_EXCEPTION_IRQ(30):      return GPIOPortF_Handler;
+    default:                         return NULL_PTR;
+    }
+}
+
+static void Sim_Execute(uint16 a_Exception)
+{
+    Sim_ExceptionStatsType *stats = &g_Sim_Stats[a_Exception];
+    Sim_HandlerType handler = (g_pfnVectors != NULL_PTR) ? g_pfnVectors[a_Exception] : Sim_Vector(a_Exception);
+    uint32 latency = (uint32)(g_Sim_Cycles - g_Sim_PendCycle[a_Exception]);
+
+    if ((stats->Taken == 0) || (latency < stats->LatencyMin))
+    {
+        stats->LatencyMin = latency;
+    }
+    if (latency > stats->LatencyMax)
+    {
+        stats->LatencyMax = latency;
+    }
+    stats->LatencySum += latency;
+    stats->Taken++;
+
+    if (handler == NULL_PTR)
+    {
+        /* No handler address to fetch from the vector table */
+        printf("sim: exception %u taken without a handler at cycle %llu\n", a_Exception, g_Sim_Cycles);
+        Sim_Report();
+        exit(1);
+    }
+
+    g_Sim_Pending[a_Exception] = FALSE;
+    g_Sim_Active[g_Sim_ActiveDepth] = a_Exception;
+    g_Sim_ActivePriority[g_Sim_ActiveDepth] = Sim_Priority(a_Exception);
+    g_Sim_ActiveDepth++;
+
+    handler();
+
+    Sim_Commit();
+    g_Sim_ActiveDepth--;
+}
+
+/* Take the pending exceptions that can preempt the running code, with late arrival and tail-chaining */
+static void Sim_Dispatch(void)
+{
+    uint16 exception = Sim_SelectPending(Sim_ExecutionPriority());
+    uint16 urgent;
+    uint32 fp_cycles = 0;
+
+    if (exception == SIM_NO_EXCEPTION)
+    {
+        return;
+    }
+
+    /* Only thread mode has an FP context, FPCA is set by the hardware only when ASPEN is set. Lazy stacking reserves the
+     * space without storing the registers, the integer-only handlers never trigger the deferred save. */
+    if ((g_Sim_ActiveDepth == 0) && g_Sim_ThreadFpca && (g_Sim_Fpcc & SIM_FPCC_ASPEN_MASK))
+    {
+        if (g_Sim_Fpcc & SIM_FPCC_LSPEN_MASK)
+        {
+            g_Sim_LazyFrames++;
+        }
+        else
+        {
+            g_Sim_FpFrames++;
+            fp_cycles = SIM_FP_STACKING_CYCLES;
+        }
+    }
+
+    /* A more urgent exception pended during the stacking is taken instead, the first one stays pending */
+    g_Sim_Cycles += SIM_STACKING_CYCLES + fp_cycles;
+    Sim_Update();
+    urgent = Sim_SelectPending(Sim_ExecutionPriority());
+    if ((urgent != exception) && (urgent != SIM_NO_EXCEPTION))
+    {
+        g_Sim_Stats[urgent].LateArrivals++;
+        exception = urgent;
+    }
+    if (g_Sim_ActiveDepth != 0)
+    {
+        g_Sim_Stats[exception].Preemptions++;
+    }
+
+    while (exception != SIM_NO_EXCEPTION)
+    {
+        Sim_Execute(exception);
+
+        /* On exit the next eligible exception is entered directly without unstacking and stacking the frame again */
+        exception = Sim_SelectPending(Sim_ExecutionPriority());
+        if (exception != SIM_NO_EXCEPTION)
+        {
+            g_Sim_Cycles += SIM_TAIL_CHAIN_CYCLES;
+            Sim_Update();
+            exception = Sim_SelectPending(Sim_ExecutionPriority());
+            g_Sim_Stats[exception].TailChained++;
+        }
+    }
+
+    g_Sim_Cycles += SIM_UNSTACKING_CYCLES + fp_cycles;
+    Sim_Update();
+}
+
+static void Sim_ParseStimuli(const char *a_Spec)
+{
+    unsigned int irq;
+    unsigned long long cycle;
+    int length;
+
+    while ((a_Spec != NULL_PTR) && (sscanf(a_Spec, "%u@%llu%n", &irq, &cycle, &length) == 2))
+    {
+        if (irq < SIM_IRQS)
+        {
+            Sim_PendIrq((uint8)irq, cycle);
+        }
+        a_Spec += length;
+        if (*a_Spec != ',')
+        {
+            break;
+        }
+        a_Spec++;
+    }
+}
+
+__attribute__((constructor)) static void Sim_Init(void)
+{
+    const char *option;
+
+    option = getenv("SIM_CYCLES");
+    if (option != NULL_PTR)
+    {
+        g_Sim_CycleLimit = strtoull(option, NULL_PTR, 0);
+    }
+    option = getenv("SIM_ACCESS_CYCLES");
+    if (option != NULL_PTR)
+    {
+        g_Sim_AccessCycles = (uint32)strtoul(option, NULL_PTR, 0);
+    }
+    Sim_ParseStimuli(getenv("SIM_IRQ"));
+    option = getenv("SIM_FPU_CONTEXT");
+    g_Sim_ThreadFpca = ((option != NULL_PTR) && (*option == '1')) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_Register
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Address - Address of the memory mapped register
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: volatile uint32* - Register slot holding the value the register reads now
+ * Description: Function behind HW_REG32 in TM4C_SIM builds. It applies the previous write, advances the virtual clock by the
+ *              access cost and takes the exceptions that became pending before handing out the register.
+****************************************************************************************************************************************/
+volatile uint32 *Sim_Register(uint32 a_Address)
+{
+    Sim_SlotType *slot;
+
+    Sim_Commit();
+    g_Sim_Cycles += g_Sim_AccessCycles;
+    Sim_Update();
+    Sim_Dispatch();
+
+    slot = Sim_FindSlot(a_Address);
+    Sim_Read(slot);
+    g_Sim_Accessed      = slot;
+    g_Sim_AccessedValue = slot->Value;
+
+    return &slot->Value;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_AddressOf
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Register - Register slot returned by Sim_Register
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Address of the simulated register
+ * Description: Function to map a register slot back to the target address, used by the register access trace.
+****************************************************************************************************************************************/
+uint32 Sim_AddressOf(volatile uint32 *a_Register)
+{
+    const Sim_SlotType *slot = (const Sim_SlotType *)((uintptr_t)a_Register - offsetof(Sim_SlotType, Value));
+
+    return slot->Address;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_SetPrimask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Value - 1 to mask the configurable exceptions (CPSID I), 0 to unmask them (CPSIE I)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function behind Enable_Exceptions / Disable_Exceptions, exceptions held pending while masked are taken on CPSIE.
+****************************************************************************************************************************************/
+void Sim_SetPrimask(uint8 a_Value)
+{
+    Sim_Commit();
+    g_Sim_Cycles++;
+    g_Sim_Primask = a_Value;
+    Sim_Update();
+    Sim_Dispatch();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_SetFaultmask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Value - 1 to mask the exceptions (CPSID F), 0 to unmask them (CPSIE F)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function behind Enable_Faults / Disable_Faults, faults are not simulated so it only masks like PRIMASK.
+****************************************************************************************************************************************/
+void Sim_SetFaultmask(uint8 a_Value)
+{
+    Sim_Commit();
+    g_Sim_Cycles++;
+    g_Sim_Faultmask = a_Value;
+    Sim_Update();
+    Sim_Dispatch();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_WaitForInterrupt
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function behind Wait_For_Interrupt. The virtual clock jumps to the next event until an exception that could
+ *              preempt the running code is pending, PRIMASK only decides whether it is taken now or after CPSIE.
+****************************************************************************************************************************************/
+void Sim_WaitForInterrupt(void)
+{
+    uint64 wake;
+
+    Sim_Commit();
+    g_Sim_Cycles++;
+    Sim_Update();
+
+    while (Sim_SelectPending(Sim_RunningPriority()) == SIM_NO_EXCEPTION)
+    {
+        wake = Sim_NextEventCycle();
+        if (wake > g_Sim_CycleLimit)
+        {
+            wake = g_Sim_CycleLimit;                   /* Nothing will ever wake the core: end the run */
+        }
+        g_Sim_SleepCycles += wake - g_Sim_Cycles;
+        g_Sim_Cycles = wake;
+        Sim_Update();
+    }
+
+    Sim_Dispatch();
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_Compute
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Cycles - Core cycles of computation
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to model code running without register accesses, for the host programs that need a given amount of
+ *              work. The exceptions that become pending meanwhile preempt it at their cycle, their time is not part of it.
+****************************************************************************************************************************************/
+void Sim_Compute(uint64 a_Cycles)
+{
+    uint64 next;
+    uint64 step;
+
+    Sim_Commit();
+
+    while (a_Cycles != 0)
+    {
+        next = Sim_NextEventCycle();
+        step = ((next > g_Sim_Cycles) && ((next - g_Sim_Cycles) < a_Cycles)) ? (next - g_Sim_Cycles) : a_Cycles;
+        g_Sim_Cycles += step;
+        a_Cycles     -= step;
+        Sim_Update();
+        Sim_Dispatch();
+    }
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_GetCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Virtual core cycles since reset
+ * Description: Function to read the virtual cycle clock.
+****************************************************************************************************************************************/
+uint64 Sim_GetCycles(void)
+{
+    return g_Sim_Cycles;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_GetSleepCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Virtual core cycles spent in WFI since reset
+ * Description: Function to read the exact sleep time, the reference of the Idle sleep accounting.
+****************************************************************************************************************************************/
+uint64 Sim_GetSleepCycles(void)
+{
+    return g_Sim_SleepCycles;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_GetTimeNs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Virtual time since reset in nanoseconds
+ * Description: Function to read the virtual time, every cycle is counted at the system clock frequency it ran at.
+****************************************************************************************************************************************/
+uint64 Sim_GetTimeNs(void)
+{
+    uint64 cycles = g_Sim_Cycles - g_Sim_ClockCycle;
+
+    return g_Sim_ClockNs + (cycles / g_Sim_ClockHz) * SIM_NS_PER_SECOND +
+           ((cycles % g_Sim_ClockHz) * SIM_NS_PER_SECOND) / g_Sim_ClockHz;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_GetEnergyUj
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Energy drawn since reset in microjoules, from the power model
+ * Description: Function to read the energy of the run, every cycle is counted at the run or sleep power of the clock
+ *              configuration it ran with.
+****************************************************************************************************************************************/
+uint64 Sim_GetEnergyUj(void)
+{
+    Sim_EnergyUpdate();
+    return g_Sim_EnergyPj / 1000000;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_SetCycleLimit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Cycles - Virtual cycle at which the report is printed and the run ends
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to override SIM_CYCLES from a host program that ends the run itself.
+****************************************************************************************************************************************/
+void Sim_SetCycleLimit(uint64 a_Cycles)
+{
+    g_Sim_CycleLimit = a_Cycles;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_SetClockFailure
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_MoscFails - TRUE if the MOSC never becomes stable once enabled
+ *                  a_PllFails - TRUE if the PLL never locks once powered up
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to make the next start of the MOSC or lock of the PLL fail, for the timeout paths of the clock driver.
+ *              An oscillator already ready stays ready, the failure applies from its next power up (or relock of the PLL).
+****************************************************************************************************************************************/
+void Sim_SetClockFailure(boolean a_MoscFails, boolean a_PllFails)
+{
+    g_Sim_MoscFails = a_MoscFails;
+    g_Sim_PllFails  = a_PllFails;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_RunCases
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Cases - Cases of the host test
+ *                  a_Count - Number of cases
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if every case passed
+ * Description: Function to run each case in its own child process. The simulator state is global, a child forked before the
+ *              first register access starts from the reset state whatever the cases before it did. The child runs without a
+ *              cycle limit and is killed after SIM_CASE_TIMEOUT_S seconds. A case fails when it returns FALSE, exits early, sleeps
+ *              with nothing left to wake the core or is killed, the parent then prints "FAIL <name>" after the messages of
+ *              the case, otherwise "<name> ok".
+****************************************************************************************************************************************/
+boolean Sim_RunCases(const Sim_CaseType *a_Cases, uint32 a_Count)
+{
+    boolean passed = TRUE;
+    uint32 test;
+    pid_t child;
+    int status;
+
+    for (test = 0; test < a_Count; test++)
+    {
+        fflush(stdout);
+        child = fork();
+        if (child == 0)
+        {
+            alarm(SIM_CASE_TIMEOUT_S);
+            Sim_SetCycleLimit(SIM_NEVER);
+            g_Sim_CaseRunning = TRUE;
+            passed = a_Cases[test].Run(&a_Cases[test]);
+            fflush(stdout);
+            _exit(passed ? 0 : 1);
+        }
+        if ((child < 0) || (waitpid(child, &status, 0) != child) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            printf("FAIL %s\n", a_Cases[test].Name);
+            passed = FALSE;
+        }
+        else
+        {
+            printf("%-24s ok\n", a_Cases[test].Name);
+        }
+    }
+
+    return passed;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_GetCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Frequency of the simulated system clock in Hz
+ * Description: Function to read the system clock selected by RCC / RCC2, each virtual cycle lasts one period of it.
+****************************************************************************************************************************************/
+uint32 Sim_GetCoreClock(void)
+{
+    return g_Sim_ClockHz;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_GetControl
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - CONTROL register of the running code
+ * Description: Function behind the CONTROL reads of the FPU driver. FPCA is set in thread mode only (SIM_FPU_CONTEXT), and only
+ *              while FPCCR lets the hardware set it, the simulated handlers never use the FPU.
+****************************************************************************************************************************************/
+uint32 Sim_GetControl(void)
+{
+    return ((g_Sim_ActiveDepth == 0) && g_Sim_ThreadFpca && (g_Sim_Fpcc & SIM_FPCC_ASPEN_MASK)) ? SIM_CONTROL_FPCA_MASK : 0;
+}
+
+/***************************************************************************************************************************************
+ * Service Name: Sim_PendIrq
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_IrqNum - Number of the IRQ from the target vector table
+ *                  a_Cycle - Virtual cycle at which the peripheral raises the interrupt
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to schedule an external interrupt, the stimuli are kept sorted by cycle. The stimuli already raised
+ *              are dropped when the table is full, so a run can schedule any number of them, SIM_MAX_STIMULI at a time.
+****************************************************************************************************************************************/
+void Sim_PendIrq(uint8 a_IrqNum, uint64 a_Cycle)
+{
+    uint8 index;
+
+    if ((g_Sim_StimuliCount == SIM_MAX_STIMULI) && (g_Sim_NextStimulus != 0))
+    {
+        for (index = g_Sim_NextStimulus; index < g_Sim_StimuliCount; index++)
+        {
+            g_Sim_Stimuli[index - g_Sim_NextStimulus] = g_Sim_Stimuli[index];
+        }
+        g_Sim_StimuliCount -= g_Sim_NextStimulus;
+        g_Sim_NextStimulus  = 0;
+    }
+    if ((a_IrqNum >= SIM_IRQS) || (g_Sim_StimuliCount == SIM_MAX_STIMULI))
+    {
+        return;
+    }
+
+    for (index = g_Sim_StimuliCount; (index > g_Sim_NextStimulus) && (g_Sim_Stimuli[index - 1].Cycle > a_Cycle); index--)
+    {
+        g_Sim_Stimuli[index] = g_Sim_Stimuli[index - 1];
+    }
+    g_Sim_Stimuli[index].IrqNum = a_IrqNum;
+    g_Sim_Stimuli[index].Cycle  = a_Cycle;
+    g_Sim_StimuliCount++;
+}
@@ -0,0 +1,103 @@
+/***********************************************************************************************************************************
+ Module      : Sim
+ Name        : Sim.h
+ Author      : Salma Hamdy
+ Description : Header file for the host-side cycle-level simulator of the SysTick timer and the NVIC (TM4C_SIM builds only)
+ ************************************************************************************************************************************/
+
+#ifndef SIM_H_
+#define SIM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Core clock of the simulated device at reset (PIOSC), RCC / RCC2 can change it */
+#define SIM_CORE_CLOCK_HZ                    16000000UL
+
+/* Cortex-M4 exception timing in core cycles (zero wait state memory) */
+#define SIM_STACKING_CYCLES                  12
+#define SIM_UNSTACKING_CYCLES                10
+#define SIM_TAIL_CHAIN_CYCLES                6
+
+/* Extra cycles to push (and to pop) S0-S15 and FPSCR when the FP context is stacked without lazy preservation */
+#define SIM_FP_STACKING_CYCLES               17
+
+/* Exception numbers of the vector table */
+#define SIM_EXCEPTION_NMI                    2
+#define SIM_EXCEPTION_PENDSV                 14
+#define SIM_EXCEPTION_SYSTICK                15
+#define SIM_EXCEPTION_IRQ(IRQ_NUM)           (16 + (IRQ_NUM))
+#define SIM_IRQS                             160
+#define SIM_EXCEPTIONS                       SIM_EXCEPTION_IRQ(SIM_IRQS)
+
+/* TI CLZ intrinsic used by the schedulers, the result is 32 for a zero argument */
+#define _norm(X)                             ((X) == 0 ? 32 : __builtin_clz(X))
+
+/* Host time a test case may run before Sim_RunCases kills it, a wait for an interrupt that never comes then fails the case */
+#define SIM_CASE_TIMEOUT_S                   60
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Case of a host test, Data points to the parameters of a table-driven case (NULL_PTR if it has none) */
+typedef struct Sim_Case
+{
+    const char *Name;
+    boolean (*Run)(const struct Sim_Case *a_Case);
+    const void *Data;
+}Sim_CaseType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Register access hook behind HW_REG32, every access costs SIM_ACCESS_CYCLES virtual cycles */
+volatile uint32 *Sim_Register(uint32 a_Address);
+
+uint32 Sim_AddressOf(volatile uint32 *a_Register);
+
+/* Instructions behind the NVIC.h macros */
+void Sim_SetPrimask(uint8 a_Value);
+
+void Sim_SetFaultmask(uint8 a_Value);
+
+void Sim_WaitForInterrupt(void);
+
+/* Virtual cycle clock, power model and external interrupt stimuli */
+void Sim_Compute(uint64 a_Cycles);
+
+uint64 Sim_GetCycles(void);
+
+uint64 Sim_GetSleepCycles(void);
+
+uint64 Sim_GetTimeNs(void);
+
+uint32 Sim_GetCoreClock(void);
+
+uint64 Sim_GetEnergyUj(void);
+
+void Sim_SetCycleLimit(uint64 a_Cycles);
+
+void Sim_PendIrq(uint8 a_IrqNum, uint64 a_Cycle);
+
+/* MOSC start-up and PLL lock failures for the clock driver tests */
+void Sim_SetClockFailure(boolean a_MoscFails, boolean a_PllFails);
+
+/* Runner of the host tests, every case starts from the reset state of the simulator */
+boolean Sim_RunCases(const Sim_CaseType *a_Cases, uint32 a_Count);
+
+/* Register behind the MRS instruction of the FPU driver */
+uint32 Sim_GetControl(void);
+
+/*******************************************************************************
+ *                                 End of File                                 *
+ *******************************************************************************/
+
+#endif /* SIM_H_ */
@@ -0,0 +1,219 @@
+/**************************************************************************************************************************************
+ Module      : SpuriousTest
+ Name        : SpuriousTest.c
+ Author      : Salma Hamdy
+ Description : Host check of the unexpected interrupt accounting of the startup file default handlers
+
+ Built with TM4C_SIM and linked with the startup file of App1 or App2, the simulator takes every exception through g_pfnVectors,
+ so the IRQs without an application handler run IntDefaultHandler and the NMI runs NmiSR as on target. Sim_RunCases runs each
+ case in its own child process from the reset state of the simulator, a default handler that spins again hangs the case until
+ it is killed:
+   - disabled IRQ:     the first IRQs, one in the middle and the last IRQ of the table are counted once, disabled and not taken
+                       again when they are pended a second time;
+   - enabled IRQ:      after Spurious_SetDisableIrq(FALSE) every occurrence is counted;
+   - NMI:              NMIPENDSET is taken with PRIMASK set and counted on vector 2, the handler returns to the caller;
+   - handled vectors:  SysTick has an application handler and is never counted;
+   - clear:            Spurious_Clear zeroes the counts and the IRQs it disabled stay disabled.
+ The exit status is 1 when a check fails.
+
+ Usage: spurioustest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Spurious.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Cycles between a stimulus and the check of its effect, long enough for the exception entry and exit */
+#define SPURIOUSTEST_SETTLE_CYCLES           1000
+
+/* NMI pend bit of the Interrupt Control and State register */
+#define SPURIOUSTEST_NMIPENDSET_MASK         0x80000000
+
+#define SPURIOUSTEST_LAST_IRQ                (SPURIOUS_VECTORS - SPURIOUS_FIRST_IRQ_VECTOR - 1)
+#define SPURIOUSTEST_NMI_VECTOR              2
+#define SPURIOUSTEST_SYSTICK_VECTOR          15
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* App1 routes GPIO Port F to the application, App2 leaves it on the default handler */
+void GPIOPortF_Handler(void)
+{
+}
+
+/* Pend an IRQ now and run until its handler has returned */
+static void SpuriousTest_Pend(uint8 a_Irq)
+{
+    Sim_PendIrq(a_Irq, Sim_GetCycles());
+    Sim_Compute(SPURIOUSTEST_SETTLE_CYCLES);
+}
+
+static boolean SpuriousTest_Expect(const char *a_What, uint8 a_Vector, uint16 a_Count, uint32 a_Total)
+{
+    uint16 count = Spurious_GetCount(a_Vector);
+    uint32 total = Spurious_GetTotal(NULL_PTR);
+
+    if ((count != a_Count) || (total != a_Total))
+    {
+        printf("FAIL %s: vector %u counted %u times, %u in all, expected %u and %u\n", a_What, a_Vector, count, total,
+               a_Count, a_Total);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static boolean SpuriousTest_DisabledIrq(const Sim_CaseType *a_Case)
+{
+    static const uint8 irqs[] = {0, 1, 5, 70, SPURIOUSTEST_LAST_IRQ};
+    boolean passed = TRUE;
+    uint8 last_vector;
+    uint32 i;
+
+    (void)a_Case;
+    Enable_Exceptions();
+    for (i = 0; i < (sizeof(irqs) / sizeof(irqs[0])); i++)
+    {
+        NVIC_EnableIRQ(irqs[i]);
+        SpuriousTest_Pend(irqs[i]);
+        passed &= SpuriousTest_Expect("first occurrence", SPURIOUS_FIRST_IRQ_VECTOR + irqs[i], 1, i + 1);
+
+        (void)Spurious_GetTotal(&last_vector);
+        if (last_vector != (SPURIOUS_FIRST_IRQ_VECTOR + irqs[i]))
+        {
+            printf("FAIL last vector %u after IRQ %u\n", last_vector, irqs[i]);
+            passed = FALSE;
+        }
+    }
+
+    /* Disabled by the first occurrence: pending them again must not reach the handler */
+    for (i = 0; i < (sizeof(irqs) / sizeof(irqs[0])); i++)
+    {
+        SpuriousTest_Pend(irqs[i]);
+        passed &= SpuriousTest_Expect("second pend", SPURIOUS_FIRST_IRQ_VECTOR + irqs[i], 1,
+                                      sizeof(irqs) / sizeof(irqs[0]));
+    }
+
+    if ((Spurious_GetCount(SPURIOUS_FIRST_IRQ_VECTOR + 2) != 0) || (Spurious_GetCount(SPURIOUS_VECTORS) != 0) ||
+        (Spurious_GetCount(0xFF) != 0))
+    {
+        printf("FAIL a vector that was not taken or is out of the table has a count\n");
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static boolean SpuriousTest_EnabledIrq(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+    uint16 occurrence;
+
+    (void)a_Case;
+    Spurious_SetDisableIrq(FALSE);
+    Enable_Exceptions();
+    NVIC_EnableIRQ(7);
+    for (occurrence = 1; occurrence <= 20; occurrence++)
+    {
+        SpuriousTest_Pend(7);
+        passed &= SpuriousTest_Expect("kept enabled", SPURIOUS_FIRST_IRQ_VECTOR + 7, occurrence, occurrence);
+    }
+    return passed;
+}
+
+static boolean SpuriousTest_Nmi(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+    uint8 last_vector;
+
+    (void)a_Case;
+    /* PRIMASK does not mask the NMI */
+    Disable_Exceptions();
+    HW_WRITE32(NVIC_SYSTEM_INTCTRL, SPURIOUSTEST_NMIPENDSET_MASK);
+    Sim_Compute(SPURIOUSTEST_SETTLE_CYCLES);
+    passed &= SpuriousTest_Expect("NMI with PRIMASK set", SPURIOUSTEST_NMI_VECTOR, 1, 1);
+
+    Enable_Exceptions();
+    HW_WRITE32(NVIC_SYSTEM_INTCTRL, SPURIOUSTEST_NMIPENDSET_MASK);
+    Sim_Compute(SPURIOUSTEST_SETTLE_CYCLES);
+    passed &= SpuriousTest_Expect("second NMI", SPURIOUSTEST_NMI_VECTOR, 2, 2);
+
+    (void)Spurious_GetTotal(&last_vector);
+    if (last_vector != SPURIOUSTEST_NMI_VECTOR)
+    {
+        printf("FAIL last vector %u after the NMI\n", last_vector);
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static boolean SpuriousTest_HandledVectors(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+
+    (void)a_Case;
+    SysTick_Init(1);
+    Enable_Exceptions();
+    while (SysTick_GetTickCount() < 10)
+    {
+        Sim_Compute(SPURIOUSTEST_SETTLE_CYCLES);
+    }
+    passed &= SpuriousTest_Expect("SysTick with a handler", SPURIOUSTEST_SYSTICK_VECTOR, 0, 0);
+
+    /* An unexpected IRQ between the ticks is still counted */
+    NVIC_EnableIRQ(3);
+    SpuriousTest_Pend(3);
+    passed &= SpuriousTest_Expect("IRQ between ticks", SPURIOUS_FIRST_IRQ_VECTOR + 3, 1, 1);
+    return passed;
+}
+
+static boolean SpuriousTest_Clear(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+    uint8 last_vector;
+
+    (void)a_Case;
+    Enable_Exceptions();
+    NVIC_EnableIRQ(12);
+    SpuriousTest_Pend(12);
+    HW_WRITE32(NVIC_SYSTEM_INTCTRL, SPURIOUSTEST_NMIPENDSET_MASK);
+    Sim_Compute(SPURIOUSTEST_SETTLE_CYCLES);
+    passed &= SpuriousTest_Expect("before the clear", SPURIOUS_FIRST_IRQ_VECTOR + 12, 1, 2);
+
+    Spurious_Clear();
+    passed &= SpuriousTest_Expect("cleared IRQ", SPURIOUS_FIRST_IRQ_VECTOR + 12, 0, 0);
+    passed &= SpuriousTest_Expect("cleared NMI", SPURIOUSTEST_NMI_VECTOR, 0, 0);
+    (void)Spurious_GetTotal(&last_vector);
+    if (last_vector != 0)
+    {
+        printf("FAIL last vector %u after the clear\n", last_vector);
+        passed = FALSE;
+    }
+
+    /* The clear does not enable the IRQ again */
+    SpuriousTest_Pend(12);
+    passed &= SpuriousTest_Expect("disabled after the clear", SPURIOUS_FIRST_IRQ_VECTOR + 12, 0, 0);
+    return passed;
+}
+
+static const Sim_CaseType g_SpuriousTest_Cases[] =
+{
+    {"disabled IRQ",    SpuriousTest_DisabledIrq,    NULL_PTR},
+    {"enabled IRQ",     SpuriousTest_EnabledIrq,     NULL_PTR},
+    {"NMI",             SpuriousTest_Nmi,            NULL_PTR},
+    {"handled vectors", SpuriousTest_HandledVectors, NULL_PTR},
+    {"clear",           SpuriousTest_Clear,          NULL_PTR},
+};
+
+#define SPURIOUSTEST_CASES                   (sizeof(g_SpuriousTest_Cases) / sizeof(g_SpuriousTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_SpuriousTest_Cases, SPURIOUSTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+/**************************************************************************************************************************************
+ Module      : SyncTest
+ Name        : SyncTest.c
+ Author      : Salma Hamdy
+ Description : Host test of the event flags and semaphore waits against the simulated tick and GPIO interrupts
+
+ Built with TM4C_SIM, the main context waits with EventFlags_Wait or Semaphore_Take while GPIO Port F interrupts scripted at
+ given cycles set the flags or give the semaphore, and the 1 ms SysTick tick advances the timeouts. Sim_RunCases runs each case in
+ its own child process from the reset state of the simulator:
+   - flags any:   the wait returns the flag set by the ISR shortly after the ISR, clears it, and sleeps in between;
+   - flags all:   the wait returns only after the ISR that sets the last requested flag, and keeps the flags;
+   - timeout:     a wait with no signal returns zero / FALSE exactly the given number of ticks later;
+   - semaphore:   every give of the ISR wakes one take, and the count ends at zero;
+   - wake window: an ISR at every cycle offset across the check of the flags must wake the wait at once, not at the next
+                  tick, so a signal between the check and the WFI is never lost.
+ The exit status is 1 when a case fails.
+
+ Usage: synctest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Idle.h"
+#include "EventFlags.h"
+#include "Semaphore.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define SYNCTEST_TICK_MS                     1
+#define SYNCTEST_TICK_CYCLES                 16000UL      /* 1 ms at the 16 MHz PIOSC reset clock */
+#define SYNCTEST_GPIO_PORTF_IRQ_NUM          30
+
+/* Highest accepted cycles from the signal in the ISR to the return of the wait, far below a tick */
+#define SYNCTEST_MAX_WAKE_CYCLES             300
+
+/* Offsets of the wake window case, from the start of the wait to well past its first WFI (only the register accesses take
+ * simulated cycles, a few before the WFI), within the 64 scripted interrupts of the simulator */
+#define SYNCTEST_WINDOW_CYCLES               48
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+static EventFlags_Type g_SyncTest_Flags;
+static Semaphore_Type g_SyncTest_Sem;
+
+/* Work of the next GPIO interrupts: flags to set, or zero to give the semaphore */
+static uint32 g_SyncTest_IsrFlags[4];
+static volatile uint32 g_SyncTest_IsrCount = 0;
+static volatile uint64 g_SyncTest_IsrCycle = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+void GPIOPortF_Handler(void)
+{
+    uint32 flags = g_SyncTest_IsrFlags[g_SyncTest_IsrCount % 4];
+
+    g_SyncTest_IsrCycle = Sim_GetCycles();
+    if (flags != 0)
+    {
+        EventFlags_Set(&g_SyncTest_Flags, flags);
+    }
+    else
+    {
+        Semaphore_Give(&g_SyncTest_Sem);
+    }
+    g_SyncTest_IsrCount++;
+}
+
+/* Tick, idle accounting and GPIO interrupt running, interrupts enabled */
+static void SyncTest_Start(void)
+{
+    SysTick_Init(SYNCTEST_TICK_MS);
+    Idle_Init();
+    NVIC_EnableIRQ(SYNCTEST_GPIO_PORTF_IRQ_NUM);
+    EventFlags_Init(&g_SyncTest_Flags);
+    Semaphore_Init(&g_SyncTest_Sem, 0);
+    Enable_Exceptions();
+}
+
+static uint64 SyncTest_SleepCycles(void)
+{
+    Idle_StatsType stats;
+
+    Idle_GetStats(&stats);
+    return stats.SleepCycles;
+}
+
+/* One flag set mid-tick satisfies a wait for any of three */
+static boolean SyncTest_FlagsAny(const Sim_CaseType *a_Case)
+{
+    uint64 start;
+    uint64 sleep;
+    uint64 wake;
+    uint32 flags;
+    boolean passed = TRUE;
+
+    SyncTest_Start();
+    g_SyncTest_IsrFlags[0] = 0x2;
+    start = Sim_GetCycles();
+    sleep = SyncTest_SleepCycles();
+    Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, start + (3 * SYNCTEST_TICK_CYCLES) + 5000);
+
+    flags = EventFlags_Wait(&g_SyncTest_Flags, 0x7, EVENTFLAGS_WAIT_ANY, TRUE, 10);
+    wake  = Sim_GetCycles() - g_SyncTest_IsrCycle;
+    sleep = SyncTest_SleepCycles() - sleep;
+
+    if ((flags != 0x2) || (g_SyncTest_Flags.Flags != 0))
+    {
+        printf("FAIL %s: returned %X, %X left set\n", a_Case->Name, flags, g_SyncTest_Flags.Flags);
+        passed = FALSE;
+    }
+    if ((g_SyncTest_IsrCount != 1) || (wake > SYNCTEST_MAX_WAKE_CYCLES))
+    {
+        printf("FAIL %s: returned %llu cycles after the ISR\n", a_Case->Name, (unsigned long long)wake);
+        passed = FALSE;
+    }
+    if (sleep < ((g_SyncTest_IsrCycle - start) * 9 / 10))
+    {
+        printf("FAIL %s: slept %llu of %llu cycles\n", a_Case->Name, (unsigned long long)sleep,
+               (unsigned long long)(g_SyncTest_IsrCycle - start));
+        passed = FALSE;
+    }
+
+    printf("flags any:   woken %llu cycles after the ISR, slept %llu of %llu cycles\n", (unsigned long long)wake,
+           (unsigned long long)sleep, (unsigned long long)(g_SyncTest_IsrCycle - start));
+    return passed;
+}
+
+/* Two flags set by two interrupts, the wait for both returns after the second one */
+static boolean SyncTest_FlagsAll(const Sim_CaseType *a_Case)
+{
+    uint64 start;
+    uint64 second;
+    uint32 flags;
+    boolean passed = TRUE;
+
+    SyncTest_Start();
+    g_SyncTest_IsrFlags[0] = 0x1;
+    g_SyncTest_IsrFlags[1] = 0x4;
+    start  = Sim_GetCycles();
+    second = start + (5 * SYNCTEST_TICK_CYCLES) + 777;
+    Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, start + SYNCTEST_TICK_CYCLES + 1234);
+    Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, second);
+
+    flags = EventFlags_Wait(&g_SyncTest_Flags, 0x5, EVENTFLAGS_WAIT_ALL, FALSE, EVENTFLAGS_WAIT_FOREVER);
+
+    if ((flags != 0x5) || (g_SyncTest_Flags.Flags != 0x5) || (g_SyncTest_IsrCount != 2))
+    {
+        printf("FAIL %s: returned %X after %u ISRs, %X set\n", a_Case->Name, flags, g_SyncTest_IsrCount,
+               g_SyncTest_Flags.Flags);
+        passed = FALSE;
+    }
+    if ((Sim_GetCycles() < second) || ((Sim_GetCycles() - g_SyncTest_IsrCycle) > SYNCTEST_MAX_WAKE_CYCLES))
+    {
+        printf("FAIL %s: returned at cycle %llu, second flag set at %llu\n", a_Case->Name,
+               (unsigned long long)(Sim_GetCycles() - start), (unsigned long long)(g_SyncTest_IsrCycle - start));
+        passed = FALSE;
+    }
+
+    printf("flags all:   returned %llu cycles after the second flag\n", (unsigned long long)(Sim_GetCycles() - g_SyncTest_IsrCycle));
+    return passed;
+}
+
+/* Waits with no signal return after exactly their timeout */
+static boolean SyncTest_Timeout(const Sim_CaseType *a_Case)
+{
+    static const uint32 timeouts[] = {0, 1, 2, 7, 25};
+    uint32 start_tick;
+    uint32 elapsed;
+    uint32 index;
+    boolean passed = TRUE;
+
+    SyncTest_Start();
+    for (index = 0; index < (sizeof(timeouts) / sizeof(timeouts[0])); index++)
+    {
+        start_tick = SysTick_GetTickCount();
+        if (EventFlags_Wait(&g_SyncTest_Flags, 0x1, EVENTFLAGS_WAIT_ANY, TRUE, timeouts[index]) != 0)
+        {
+            printf("FAIL %s: the flags wait returned flags\n", a_Case->Name);
+            passed = FALSE;
+        }
+        elapsed = SysTick_GetTickCount() - start_tick;
+        if (elapsed != timeouts[index])
+        {
+            printf("FAIL %s: the flags wait of %u ticks returned after %u\n", a_Case->Name, timeouts[index], elapsed);
+            passed = FALSE;
+        }
+
+        start_tick = SysTick_GetTickCount();
+        if (Semaphore_Take(&g_SyncTest_Sem, timeouts[index]))
+        {
+            printf("FAIL %s: the semaphore was taken\n", a_Case->Name);
+            passed = FALSE;
+        }
+        elapsed = SysTick_GetTickCount() - start_tick;
+        if (elapsed != timeouts[index])
+        {
+            printf("FAIL %s: the take of %u ticks returned after %u\n", a_Case->Name, timeouts[index], elapsed);
+            passed = FALSE;
+        }
+    }
+
+    printf("timeout:     %u timeouts checked\n", index);
+    return passed;
+}
+
+/* Each give wakes one take, a give before the take is kept in the count */
+static boolean SyncTest_Semaphore(const Sim_CaseType *a_Case)
+{
+    uint64 start;
+    uint64 wake;
+    uint64 max_wake = 0;
+    uint32 take;
+    boolean passed = TRUE;
+
+    SyncTest_Start();
+    start = Sim_GetCycles();
+    Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, start + 3000);
+    Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, start + (2 * SYNCTEST_TICK_CYCLES) + 100);
+    Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, start + (9 * SYNCTEST_TICK_CYCLES) + 9000);
+
+    for (take = 0; take < 3; take++)
+    {
+        if (!Semaphore_Take(&g_SyncTest_Sem, 20))
+        {
+            printf("FAIL %s: take %u timed out after %u gives\n", a_Case->Name, take, g_SyncTest_IsrCount);
+            passed = FALSE;
+        }
+        wake = Sim_GetCycles() - g_SyncTest_IsrCycle;
+        if ((g_SyncTest_IsrCount != (take + 1)) || (wake > SYNCTEST_MAX_WAKE_CYCLES))
+        {
+            printf("FAIL %s: take %u returned %llu cycles after give %u\n", a_Case->Name, take, (unsigned long long)wake,
+                   g_SyncTest_IsrCount);
+            passed = FALSE;
+        }
+        if (wake > max_wake)
+        {
+            max_wake = wake;
+        }
+    }
+
+    /* A give with no waiter is kept for the next take */
+    Semaphore_Give(&g_SyncTest_Sem);
+    if (!Semaphore_Take(&g_SyncTest_Sem, 0) || Semaphore_TryTake(&g_SyncTest_Sem) || (g_SyncTest_Sem.Count != 0))
+    {
+        printf("FAIL %s: count %u after the last take\n", a_Case->Name, g_SyncTest_Sem.Count);
+        passed = FALSE;
+    }
+
+    printf("semaphore:   3 takes woken at most %llu cycles after the give\n", (unsigned long long)max_wake);
+    return passed;
+}
+
+/* An ISR at each cycle offset from the start of a wait, including between its check and its WFI, wakes it at once */
+static boolean SyncTest_WakeWindow(const Sim_CaseType *a_Case)
+{
+    uint64 start;
+    uint64 wake;
+    uint64 max_wake = 0;
+    uint32 offset;
+    uint32 flags;
+    boolean passed = TRUE;
+
+    SyncTest_Start();
+    g_SyncTest_IsrFlags[0] = 0x8;
+    g_SyncTest_IsrFlags[1] = 0x8;
+    g_SyncTest_IsrFlags[2] = 0x8;
+    g_SyncTest_IsrFlags[3] = 0x8;
+
+    for (offset = 0; offset < SYNCTEST_WINDOW_CYCLES; offset++)
+    {
+        /* Start each wait just after a tick so the next tick cannot hide a lost wake-up */
+        Idle_DelayTicks(1);
+        start = Sim_GetCycles();
+        Sim_PendIrq(SYNCTEST_GPIO_PORTF_IRQ_NUM, start + offset);
+
+        flags = EventFlags_Wait(&g_SyncTest_Flags, 0x8, EVENTFLAGS_WAIT_ANY, TRUE, EVENTFLAGS_WAIT_FOREVER);
+        wake  = Sim_GetCycles() - g_SyncTest_IsrCycle;
+        if ((flags != 0x8) || (g_SyncTest_IsrCount != (offset + 1)) || (wake > SYNCTEST_MAX_WAKE_CYCLES))
+        {
+            printf("FAIL %s: ISR at offset %u woke the wait %llu cycles later\n", a_Case->Name, offset,
+                   (unsigned long long)wake);
+            passed = FALSE;
+        }
+        if (wake > max_wake)
+        {
+            max_wake = wake;
+        }
+    }
+
+    printf("wake window: %u offsets, woken at most %llu cycles after the ISR\n", offset, (unsigned long long)max_wake);
+    return passed;
+}
+
+static const Sim_CaseType g_SyncTest_Cases[] =
+{
+    {"flags any",   SyncTest_FlagsAny,   NULL_PTR},
+    {"flags all",   SyncTest_FlagsAll,   NULL_PTR},
+    {"timeout",     SyncTest_Timeout,    NULL_PTR},
+    {"semaphore",   SyncTest_Semaphore,  NULL_PTR},
+    {"wake window", SyncTest_WakeWindow, NULL_PTR},
+};
+
+#define SYNCTEST_CASES                       (sizeof(g_SyncTest_Cases) / sizeof(g_SyncTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_SyncTest_Cases, SYNCTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,352 @@
+/**************************************************************************************************************************************
+ Module      : SysTickTest
+ Name        : SysTickTest.c
+ Author      : Salma Hamdy
+ Description : Host check of the SysTick reload for both counter clocks, the 24-bit clamp and the period in core cycles
+
+ Built with TM4C_SIM, each run selects the counter clock with SysTick_SetClockSource, moves the system clock and starts a tick of
+ the given period. The RELOAD value, the CLK_SRC bit, the counter frequency and SysTick_GetPeriodCycles are compared with values
+ worked out by hand: f / 1000 * ms - 1 on the system clock, 4000 * ms - 1 on PIOSC / 4, 0xFFFFFF once the period passes 2^24
+ counter clocks, and the PIOSC / 4 period scaled to whole and fractional core cycles per counter clock. The time between two
+ ticks measured by the simulator must be that period, and a busy wait of the same length, up to a million cycles, must last it
+ within the register accesses around the counter. The last case checks the selection itself: an invalid source is refused, a source chosen after
+ SysTick_Init waits for the next one, and the PIOSC / 4 period in core cycles follows a system clock change with the same
+ reload. A tick on the system clock with PIOSC / 4 selected but not yet applied must still be rescaled by a clock change, and
+ measure its period in core cycles from the system clock. The trim of a running 1 ms tick at 16 MHz is then changed between a
+ fractional period, 16000.5 clocks that alternate two reloads, and whole ones, which must leave a single reload. Sim_RunCases runs each case in its own child process. The exit status is 1 when a check fails.
+
+ Usage: systicktest
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Clock.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Control register: counter clocked by the system clock instead of PIOSC / 4 */
+#define SYSTICKTEST_CLK_SRC_MASK             0x04
+
+/* Core cycles a busy wait may last beyond its period: the register accesses to start the counter and to see COUNT, plus a
+ * counter clock of PIOSC / 4 to the first decrement (20 cycles at 80 MHz) */
+#define SYSTICKTEST_BUSY_WAIT_OVERHEAD       64
+
+/* Longest busy wait run, the simulator polls COUNT for seconds of host time beyond it. The reload of the longer ones comes from
+ * the same computation as the tick, checked after SysTick_Init */
+#define SYSTICKTEST_BUSY_WAIT_MAX_CYCLES     1000000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Clock_SourceType Source;
+    uint32 FrequencyHz;
+    SysTick_ClockSourceType Counter;
+    uint16 PeriodMs;
+    uint32 Reload;                                       /* Expected RELOAD */
+    uint32 PeriodCycles;                                 /* Expected SysTick_GetPeriodCycles */
+}SysTickTest_RunType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The longest periods below and above 2^24 counter clocks for each source, and fractional core cycles per PIOSC / 4 clock. One
+ * run per case, in the order of g_SysTickTest_Cases */
+static const SysTickTest_RunType g_SysTickTest_Runs[] =
+{
+    {CLOCK_SOURCE_PIOSC, 16000000UL, SYSTICK_CLOCK_SYSTEM,        1,      15999,      16000},
+    {CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_SYSTEM,       10,     799999,     800000},
+    {CLOCK_SOURCE_MOSC,   8000000UL, SYSTICK_CLOCK_SYSTEM,      100,     799999,     800000},
+    {CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_SYSTEM,      209,   16719999,   16720000},
+    {CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_SYSTEM,      210, 0x00FFFFFF,   16777216},
+    {CLOCK_SOURCE_PIOSC, 16000000UL, SYSTICK_CLOCK_SYSTEM,     1048,   16767999,   16768000},
+    {CLOCK_SOURCE_PIOSC, 16000000UL, SYSTICK_CLOCK_SYSTEM,     1049, 0x00FFFFFF,   16777216},
+    {CLOCK_SOURCE_PIOSC, 16000000UL, SYSTICK_CLOCK_PIOSC_DIV4,    1,       3999,      16000},
+    {CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_PIOSC_DIV4,    1,       3999,      80000},
+    {CLOCK_SOURCE_PLL,   50000000UL, SYSTICK_CLOCK_PIOSC_DIV4,    7,      27999,     350000},
+    {CLOCK_SOURCE_PLL,   12500000UL, SYSTICK_CLOCK_PIOSC_DIV4,    3,      11999,      37500},
+    {CLOCK_SOURCE_PIOSC,  4000000UL, SYSTICK_CLOCK_PIOSC_DIV4, 4194,   16775999,   16776000},
+    {CLOCK_SOURCE_PIOSC,  4000000UL, SYSTICK_CLOCK_PIOSC_DIV4, 4195, 0x00FFFFFF,   16777216},
+};
+
+/* Trims of a running 1 ms tick at 16 MHz and the periods they give in counter clocks, the second period of a fractional one is
+ * a clock longer. The ticks waited before the change let it come after either reload of a fractional period */
+static const struct
+{
+    uint32 WaitTicks;
+    sint32 TrimPpb;
+    uint32 Period;
+    boolean Fractional;
+} g_SysTickTest_Trims[] =
+{
+    {0,   31250, 16000, TRUE},
+    {0,       0, 16000, FALSE},
+    {0,   31250, 16000, TRUE},
+    {1,       0, 16000, FALSE},
+    {0,   31250, 16000, TRUE},
+    {1, 1000000, 16016, FALSE},
+};
+
+#define SYSTICKTEST_TRIMS                    (sizeof(g_SysTickTest_Trims) / sizeof(g_SysTickTest_Trims[0]))
+
+/* Intervals checked after each trim change, an even number so the two reloads of a fractional period appear as often */
+#define SYSTICKTEST_TRIM_INTERVALS           6
+
+/* Core cycle of the last two ticks */
+static volatile uint32 g_SysTickTest_Ticks = 0;
+static uint64 g_SysTickTest_LastCycle = 0;
+static uint64 g_SysTickTest_Interval = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static void SysTickTest_TickTask(void)
+{
+    uint64 now = Sim_GetCycles();
+
+    g_SysTickTest_Interval  = now - g_SysTickTest_LastCycle;
+    g_SysTickTest_LastCycle = now;
+    g_SysTickTest_Ticks++;
+}
+
+static boolean SysTickTest_Run(const Sim_CaseType *a_Case)
+{
+    const SysTickTest_RunType *run = (const SysTickTest_RunType *)a_Case->Data;
+    uint32 counter_hz = (run->Counter == SYSTICK_CLOCK_PIOSC_DIV4) ? SYSTICK_PIOSC_DIV4_HZ : run->FrequencyHz;
+    boolean system_clock = (run->Counter == SYSTICK_CLOCK_SYSTEM) ? TRUE : FALSE;
+    boolean passed = TRUE;
+    uint64 busy_cycles;
+
+    if (!Clock_SetFrequency(run->Source, run->FrequencyHz) || !SysTick_SetClockSource(run->Counter))
+    {
+        printf("FAIL %s: clock of %u Hz or counter source refused\n", a_Case->Name, run->FrequencyHz);
+        return FALSE;
+    }
+
+    SysTick_SetCallBack(SysTickTest_TickTask);
+    SysTick_Init(run->PeriodMs);
+    if ((HW_READ32(SYSTICK_RELOAD_REG) != run->Reload) ||
+        (((HW_READ32(SYSTICK_CTRL_REG) & SYSTICKTEST_CLK_SRC_MASK) != 0) != system_clock) ||
+        (SysTick_GetCounterFrequency() != counter_hz) || (SysTick_GetPeriodCycles() != run->PeriodCycles))
+    {
+        printf("FAIL %s: reload %u, CTRL 0x%X, counter at %u Hz, %u cycles per tick, expected %u, %u Hz and %u cycles\n",
+               a_Case->Name, HW_READ32(SYSTICK_RELOAD_REG), HW_READ32(SYSTICK_CTRL_REG), SysTick_GetCounterFrequency(),
+               SysTick_GetPeriodCycles(), run->Reload, counter_hz, run->PeriodCycles);
+        passed = FALSE;
+    }
+
+    /* The interval of the third tick, the first one started with the counter */
+    Enable_Exceptions();
+    while (g_SysTickTest_Ticks < 3)
+    {
+        Wait_For_Interrupt();
+    }
+    if (g_SysTickTest_Interval != run->PeriodCycles)
+    {
+        printf("FAIL %s: ticks %llu cycles apart, expected %u\n", a_Case->Name, (unsigned long long)g_SysTickTest_Interval,
+               run->PeriodCycles);
+        passed = FALSE;
+    }
+
+    Disable_Exceptions();
+    SysTick_DeInit();
+    if (run->PeriodCycles > SYSTICKTEST_BUSY_WAIT_MAX_CYCLES)
+    {
+        return passed;
+    }
+    busy_cycles = Sim_GetCycles();
+    SysTick_StartBusyWait(run->PeriodMs);
+    busy_cycles = Sim_GetCycles() - busy_cycles;
+    if ((busy_cycles < run->PeriodCycles) || (busy_cycles > (run->PeriodCycles + SYSTICKTEST_BUSY_WAIT_OVERHEAD)))
+    {
+        printf("FAIL %s: busy wait of %llu cycles, expected %u\n", a_Case->Name, (unsigned long long)busy_cycles,
+               run->PeriodCycles);
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static boolean SysTickTest_Selection(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+
+    (void)a_Case;
+
+    if (SysTick_SetClockSource(SYSTICK_CLOCK_PIOSC_DIV4 + 1) || (SysTick_GetClockSource() != SYSTICK_CLOCK_SYSTEM))
+    {
+        printf("FAIL invalid counter source accepted\n");
+        passed = FALSE;
+    }
+
+    /* Chosen after SysTick_Init: the running counter keeps the system clock until the next SysTick_Init */
+    SysTick_Init(1);
+    (void)SysTick_SetClockSource(SYSTICK_CLOCK_PIOSC_DIV4);
+    if (!(HW_READ32(SYSTICK_CTRL_REG) & SYSTICKTEST_CLK_SRC_MASK) || (HW_READ32(SYSTICK_RELOAD_REG) != 15999))
+    {
+        printf("FAIL source applied before SysTick_Init: CTRL 0x%X reload %u\n", HW_READ32(SYSTICK_CTRL_REG),
+               HW_READ32(SYSTICK_RELOAD_REG));
+        passed = FALSE;
+    }
+    SysTick_Init(1);
+    if ((HW_READ32(SYSTICK_CTRL_REG) & SYSTICKTEST_CLK_SRC_MASK) || (HW_READ32(SYSTICK_RELOAD_REG) != 3999))
+    {
+        printf("FAIL source not applied by SysTick_Init: CTRL 0x%X reload %u\n", HW_READ32(SYSTICK_CTRL_REG),
+               HW_READ32(SYSTICK_RELOAD_REG));
+        passed = FALSE;
+    }
+
+    /* Same reload at every system clock, the period in core cycles follows it */
+    Enable_Exceptions();
+    if (!Clock_SetFrequency(CLOCK_SOURCE_PLL, 50000000UL) || (HW_READ32(SYSTICK_RELOAD_REG) != 3999) ||
+        (SysTick_GetPeriodCycles() != 50000))
+    {
+        printf("FAIL PIOSC / 4 at 50 MHz: reload %u, %u cycles per tick\n", HW_READ32(SYSTICK_RELOAD_REG),
+               SysTick_GetPeriodCycles());
+        passed = FALSE;
+    }
+    if (!Clock_SetFrequency(CLOCK_SOURCE_PIOSC, 2000000UL) || (HW_READ32(SYSTICK_RELOAD_REG) != 3999) ||
+        (SysTick_GetPeriodCycles() != 2000))
+    {
+        printf("FAIL PIOSC / 4 at 2 MHz: reload %u, %u cycles per tick\n", HW_READ32(SYSTICK_RELOAD_REG),
+               SysTick_GetPeriodCycles());
+        passed = FALSE;
+    }
+    return passed;
+}
+
+static boolean SysTickTest_PendingSource(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+
+    (void)a_Case;
+
+    /* 1 ms on the 16 MHz system clock, PIOSC / 4 chosen for the next SysTick_Init, then the system clock is raised */
+    SysTick_SetCallBack(SysTickTest_TickTask);
+    SysTick_Init(1);
+    (void)SysTick_SetClockSource(SYSTICK_CLOCK_PIOSC_DIV4);
+    Enable_Exceptions();
+    if (!Clock_SetFrequency(CLOCK_SOURCE_PLL, 80000000UL))
+    {
+        printf("FAIL clock of 80 MHz refused\n");
+        return FALSE;
+    }
+
+    if (!(HW_READ32(SYSTICK_CTRL_REG) & SYSTICKTEST_CLK_SRC_MASK) || (HW_READ32(SYSTICK_RELOAD_REG) != 79999) ||
+        (SysTick_GetCounterFrequency() != 80000000UL) || (SysTick_GetPeriodCycles() != 80000) ||
+        (SysTick_GetClockSource() != SYSTICK_CLOCK_PIOSC_DIV4))
+    {
+        printf("FAIL pending PIOSC / 4 at 80 MHz: CTRL 0x%X, reload %u, counter at %u Hz, %u cycles per tick, source %u\n",
+               HW_READ32(SYSTICK_CTRL_REG), HW_READ32(SYSTICK_RELOAD_REG), SysTick_GetCounterFrequency(),
+               SysTick_GetPeriodCycles(), SysTick_GetClockSource());
+        passed = FALSE;
+    }
+
+    /* The interval of the third tick after the change, the first one ends the period in progress */
+    g_SysTickTest_Ticks = 0;
+    while (g_SysTickTest_Ticks < 3)
+    {
+        Wait_For_Interrupt();
+    }
+    if (g_SysTickTest_Interval != 80000)
+    {
+        printf("FAIL pending PIOSC / 4 at 80 MHz: ticks %llu cycles apart, expected 80000\n",
+               (unsigned long long)g_SysTickTest_Interval);
+        passed = FALSE;
+    }
+    return passed;
+}
+
+/* Wait for the next tick and return its interval */
+static uint64 SysTickTest_NextInterval(void)
+{
+    uint32 ticks = g_SysTickTest_Ticks;
+
+    while (g_SysTickTest_Ticks == ticks)
+    {
+        Wait_For_Interrupt();
+    }
+    return g_SysTickTest_Interval;
+}
+
+static boolean SysTickTest_TrimChange(const Sim_CaseType *a_Case)
+{
+    boolean passed = TRUE;
+    uint64 interval;
+    uint64 sum;
+    uint32 trim;
+    uint32 tick;
+
+    (void)a_Case;
+
+    SysTick_SetCallBack(SysTickTest_TickTask);
+    SysTick_Init(1);
+    Enable_Exceptions();
+    for (trim = 0; trim < SYSTICKTEST_TRIMS; trim++)
+    {
+        /* Half a period in, the period in progress and the next one may still have the old length */
+        for (tick = 0; tick < g_SysTickTest_Trims[trim].WaitTicks; tick++)
+        {
+            (void)SysTickTest_NextInterval();
+        }
+        Sim_Compute(8000);
+        (void)SysTick_SetTrim(g_SysTickTest_Trims[trim].TrimPpb);
+        (void)SysTickTest_NextInterval();
+        (void)SysTickTest_NextInterval();
+
+        sum = 0;
+        for (tick = 0; tick < SYSTICKTEST_TRIM_INTERVALS; tick++)
+        {
+            interval = SysTickTest_NextInterval();
+            sum     += interval;
+            if ((interval != g_SysTickTest_Trims[trim].Period) &&
+                (!g_SysTickTest_Trims[trim].Fractional || (interval != (g_SysTickTest_Trims[trim].Period + 1))))
+            {
+                printf("FAIL trim %d ppb: ticks %llu cycles apart, reload %u\n", g_SysTickTest_Trims[trim].TrimPpb,
+                       (unsigned long long)interval, HW_READ32(SYSTICK_RELOAD_REG));
+                passed = FALSE;
+            }
+        }
+        if (sum != (SYSTICKTEST_TRIM_INTERVALS * g_SysTickTest_Trims[trim].Period) +
+                   (g_SysTickTest_Trims[trim].Fractional ? (SYSTICKTEST_TRIM_INTERVALS / 2) : 0))
+        {
+            printf("FAIL trim %d ppb: %u ticks last %llu cycles\n", g_SysTickTest_Trims[trim].TrimPpb, SYSTICKTEST_TRIM_INTERVALS,
+                   (unsigned long long)sum);
+            passed = FALSE;
+        }
+    }
+    return passed;
+}
+
+static const Sim_CaseType g_SysTickTest_Cases[] =
+{
+    {"16MHz 1ms",              SysTickTest_Run,           &g_SysTickTest_Runs[0]},
+    {"80MHz 10ms",             SysTickTest_Run,           &g_SysTickTest_Runs[1]},
+    {"8MHz MOSC 100ms",        SysTickTest_Run,           &g_SysTickTest_Runs[2]},
+    {"80MHz 209ms",            SysTickTest_Run,           &g_SysTickTest_Runs[3]},
+    {"80MHz 210ms clamp",      SysTickTest_Run,           &g_SysTickTest_Runs[4]},
+    {"16MHz 1048ms",           SysTickTest_Run,           &g_SysTickTest_Runs[5]},
+    {"16MHz 1049ms clamp",     SysTickTest_Run,           &g_SysTickTest_Runs[6]},
+    {"PIOSC/4 1ms at 16MHz",   SysTickTest_Run,           &g_SysTickTest_Runs[7]},
+    {"PIOSC/4 1ms at 80MHz",   SysTickTest_Run,           &g_SysTickTest_Runs[8]},
+    {"PIOSC/4 7ms at 50MHz",   SysTickTest_Run,           &g_SysTickTest_Runs[9]},
+    {"PIOSC/4 3ms at 12.5MHz", SysTickTest_Run,           &g_SysTickTest_Runs[10]},
+    {"PIOSC/4 4194ms",         SysTickTest_Run,           &g_SysTickTest_Runs[11]},
+    {"PIOSC/4 4195ms clamp",   SysTickTest_Run,           &g_SysTickTest_Runs[12]},
+    {"source selection",       SysTickTest_Selection,     NULL_PTR},
+    {"pending source",         SysTickTest_PendingSource, NULL_PTR},
+    {"trim change",            SysTickTest_TrimChange,    NULL_PTR},
+};
+
+#define SYSTICKTEST_CASES                    (sizeof(g_SysTickTest_Cases) / sizeof(g_SysTickTest_Cases[0]))
+
+int main(void)
+{
+    return Sim_RunCases(g_SysTickTest_Cases, SYSTICKTEST_CASES) ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+/**************************************************************************************************************************************
+ Module      : TickSim
+ Name        : TickSim.c
+ Author      : Salma Hamdy
+ Description : Host simulation of the SysTick tick drift with fractional periods
+
+ Built with TM4C_SIM, it runs the SysTick tick for a number of ticks with periods that are not a whole number of counter clocks:
+ a trimmed crystal or PIOSC, from the system clock or PIOSC / 4. The callback records the core cycle of every tick and compares
+ it with the exact tick time floor(n * f * (10^9 + trim) * ms / 10^12) counter clocks, computed on 128 bits. The error of a tick
+ must not change over the run: the interrupt latency is constant in the simulator, so any change is time gained or lost by the
+ reload sequence. The exit status is 1 when it changes. The drift of a single integer reload, what the driver did before the
+ phase accumulator, is printed for comparison.
+
+ Usage: ticksim [ticks]      (ticks of each run, 10^8 by default)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Clock.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define TICKSIM_DEFAULT_TICKS                100000000UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    const char *Name;
+    Clock_SourceType Source;
+    uint32 FrequencyHz;
+    SysTick_ClockSourceType Counter;
+    sint32 TrimPpb;
+    uint16 PeriodMs;
+}TickSim_RunType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The core clock is a multiple of the counter clock, so a counter clock is a whole number of simulated cycles */
+static const TickSim_RunType g_TickSim_Runs[] =
+{
+    {"80MHz exact",      CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_SYSTEM,         0,  1},
+    {"80MHz +12.345ppm", CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_SYSTEM,     12345,  1},
+    {"50MHz -0.7ppm",    CLOCK_SOURCE_PLL,   50000000UL, SYSTICK_CLOCK_SYSTEM,      -700,  1},
+    {"16MHz +31ppb",     CLOCK_SOURCE_MOSC,  16000000UL, SYSTICK_CLOCK_SYSTEM,        31, 10},
+    {"PIOSC/4 -1.23%",   CLOCK_SOURCE_PLL,   80000000UL, SYSTICK_CLOCK_PIOSC_DIV4, -12345678, 1},
+    {"PIOSC/4 +3ppb",    CLOCK_SOURCE_PIOSC, 16000000UL, SYSTICK_CLOCK_PIOSC_DIV4,     3,  7},
+};
+
+#define TICKSIM_RUNS                         (sizeof(g_TickSim_Runs) / sizeof(g_TickSim_Runs[0]))
+
+static const TickSim_RunType *g_TickSim_Run;
+static uint32 g_TickSim_CyclesPerCount = 1;
+
+/* Core cycle of the first tick, error of the second tick and extreme errors of the run, in core cycles */
+static uint64 g_TickSim_StartCycle = 0;
+static sint64 g_TickSim_FirstError = 0;
+static sint64 g_TickSim_MinError = 0;
+static sint64 g_TickSim_MaxError = 0;
+static volatile uint32 g_TickSim_Ticks = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Exact counter clocks from the start of the tick to its n-th interrupt */
+static uint64 TickSim_ExactCounts(uint64 a_Ticks)
+{
+    unsigned __int128 per_second = (unsigned __int128)g_TickSim_Run->FrequencyHz;
+
+    if (g_TickSim_Run->Counter == SYSTICK_CLOCK_PIOSC_DIV4)
+    {
+        per_second = SYSTICK_PIOSC_DIV4_HZ;
+    }
+    return (uint64)((a_Ticks * per_second * (unsigned __int128)(1000000000LL + g_TickSim_Run->TrimPpb) * g_TickSim_Run->PeriodMs) /
+                    (unsigned __int128)1000000000000ULL);
+}
+
+static void TickSim_TickTask(void)
+{
+    uint64 now = Sim_GetCycles();
+    sint64 error;
+
+    g_TickSim_Ticks++;
+    if (g_TickSim_Ticks == 1)
+    {
+        g_TickSim_StartCycle = now;
+        return;
+    }
+
+    error = (sint64)(now - g_TickSim_StartCycle) -
+            (sint64)((TickSim_ExactCounts(g_TickSim_Ticks) - TickSim_ExactCounts(1)) * g_TickSim_CyclesPerCount);
+    if (g_TickSim_Ticks == 2)
+    {
+        g_TickSim_FirstError = error;
+        g_TickSim_MinError   = error;
+        g_TickSim_MaxError   = error;
+    }
+    else if (error < g_TickSim_MinError)
+    {
+        g_TickSim_MinError = error;
+    }
+    else if (error > g_TickSim_MaxError)
+    {
+        g_TickSim_MaxError = error;
+    }
+}
+
+/* One run in the child process, the exit status is 1 if the tick error changed */
+static int TickSim_Run(const TickSim_RunType *a_Run, uint32 a_Ticks)
+{
+    uint32 counter_hz = (a_Run->Counter == SYSTICK_CLOCK_PIOSC_DIV4) ? SYSTICK_PIOSC_DIV4_HZ : a_Run->FrequencyHz;
+    uint64 exact = 0;
+    uint64 integer = 0;
+    sint64 integer_drift_ns;
+    double days;
+
+    g_TickSim_Run = a_Run;
+    g_TickSim_CyclesPerCount = a_Run->FrequencyHz / counter_hz;
+    Sim_SetCycleLimit(0xFFFFFFFFFFFFFFFFULL);
+
+    (void)Clock_SetFrequency(a_Run->Source, a_Run->FrequencyHz);
+    (void)SysTick_SetClockSource(a_Run->Counter);
+    (void)SysTick_SetTrim(a_Run->TrimPpb);
+    SysTick_SetCallBack(TickSim_TickTask);
+    SysTick_Init(a_Run->PeriodMs);
+    Enable_Exceptions();
+
+    while (g_TickSim_Ticks < a_Ticks)
+    {
+        Wait_For_Interrupt();
+    }
+
+    /* Time the true clock runs for the ticks counted by the old single reload of (f / 1000) * ms counter clocks */
+    exact   = TickSim_ExactCounts(a_Ticks);
+    integer = (uint64)a_Ticks * (counter_hz / 1000) * a_Run->PeriodMs;
+    integer_drift_ns = (sint64)(((double)(sint64)(integer - exact) * 1e9) / ((double)counter_hz * (1.0 + (a_Run->TrimPpb / 1e9))));
+    days = ((double)a_Ticks * a_Run->PeriodMs) / 86400000.0;
+
+    printf("%-17s %10u %8.2f %10lld %6lld %6lld %14lld %10.3f\n", a_Run->Name, a_Ticks, days,
+           (long long)g_TickSim_FirstError, (long long)(g_TickSim_MinError - g_TickSim_FirstError),
+           (long long)(g_TickSim_MaxError - g_TickSim_FirstError), (long long)integer_drift_ns,
+           (double)integer_drift_ns / ((double)a_Ticks * a_Run->PeriodMs));
+    fflush(stdout);
+
+    return (g_TickSim_MinError == g_TickSim_MaxError) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 ticks = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : TICKSIM_DEFAULT_TICKS;
+    boolean passed = TRUE;
+    uint32 run;
+    pid_t child;
+    int status;
+
+    if (ticks < 2)
+    {
+        printf("Usage: %s [ticks]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%-17s %10s %8s %10s %6s %6s %14s %10s\n", "run", "ticks", "days", "error", "min", "max", "1-reload ns",
+           "ppm");
+    fflush(stdout);
+
+    /* The simulator state is global, each run starts from the reset state in a child process */
+    for (run = 0; run < TICKSIM_RUNS; run++)
+    {
+        child = fork();
+        if (child == 0)
+        {
+            exit(TickSim_Run(&g_TickSim_Runs[run], ticks));
+        }
+        if ((waitpid(child, &status, 0) != child) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            printf("FAIL %s: the tick error changed\n", g_TickSim_Runs[run].Name);
+            fflush(stdout);
+            passed = FALSE;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
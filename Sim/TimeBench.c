@@ -0,0 +1,267 @@
+/**************************************************************************************************************************************
+ Module      : TimeBench
+ Name        : TimeBench.c
+ Author      : Salma Hamdy
+ Description : Host check of the TimeConv error bound against exact 128-bit arithmetic and benchmark against 64-bit division
+
+ Built with TM4C_SIM, it moves the system clock through PIOSC, MOSC and PLL frequencies, with the SysTick counter on the system
+ clock and on PIOSC / 4, and lets the TimeConv listener recompute the scales. Every scale is applied to all values below 2^bits,
+ to the 32-bit edges (2^k - 1, 2^k, 2^k + 1) and to pseudo-random 32-bit values. The result must be the exact floor(value * ratio)
+ computed on 128 bits, or one above it, and exactly the floor when the fraction of the ratio is a multiple of 2^-32. The exit
+ status is 1 when a result is outside the bound. The benchmark then converts cycles to nanoseconds with the scale and with the
+ 64-bit division it replaces. Host timings only show the relative cost, on the Cortex M4 the division is a library call.
+
+ Usage: timebench [bits]      (exhaustive range of the check, 2^20 values by default, 32 checks every 32-bit value)
+ ***************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "SysTick.h"
+#include "Clock.h"
+#include "TimeConv.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define TIMEBENCH_DEFAULT_BITS               20
+#define TIMEBENCH_RANDOM_VALUES              (1UL << 20)
+#define TIMEBENCH_BENCH_VALUES               (1UL << 26)
+#define TIMEBENCH_BENCH_STEP                 2654435761UL       /* Spreads the benchmark values over 32 bits */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Clock_SourceType Source;
+    uint32 FrequencyHz;
+}TimeBench_ClockType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Exact ratios at the governor points and the reset clock, periodic fractions at 12.5, 3.125 MHz and the low oscillator divisions */
+static const TimeBench_ClockType g_TimeBench_Clocks[] =
+{
+    {CLOCK_SOURCE_PIOSC, 16000000UL},
+    {CLOCK_SOURCE_PLL,   80000000UL},
+    {CLOCK_SOURCE_PLL,   50000000UL},
+    {CLOCK_SOURCE_PLL,   40000000UL},
+    {CLOCK_SOURCE_PLL,   25000000UL},
+    {CLOCK_SOURCE_PLL,   16000000UL},
+    {CLOCK_SOURCE_PLL,   12500000UL},
+    {CLOCK_SOURCE_PLL,    3125000UL},
+    {CLOCK_SOURCE_MOSC,   2000000UL},
+    {CLOCK_SOURCE_MOSC,   8000000UL},
+    {CLOCK_SOURCE_PIOSC,  1000000UL},
+    {CLOCK_SOURCE_PIOSC,   250000UL},
+};
+
+#define TIMEBENCH_CLOCKS                     (sizeof(g_TimeBench_Clocks) / sizeof(g_TimeBench_Clocks[0]))
+
+static uint32 g_TimeBench_Random = 0x12345678UL;
+
+/* Values checked per conversion and results one above the exact floor */
+static uint64 g_TimeBench_Checked = 0;
+static uint64 g_TimeBench_Above = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* xorshift32 */
+static uint32 TimeBench_Random(void)
+{
+    g_TimeBench_Random ^= g_TimeBench_Random << 13;
+    g_TimeBench_Random ^= g_TimeBench_Random >> 17;
+    g_TimeBench_Random ^= g_TimeBench_Random << 5;
+    return g_TimeBench_Random;
+}
+
+static uint64 TimeBench_NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
+}
+
+/* Check one value, TRUE if the result is within the bound */
+static boolean TimeBench_CheckValue(const TimeConv_ScaleType *a_Scale, uint32 a_Numerator, uint32 a_Denominator,
+                                    boolean a_Exact, uint32 a_Value)
+{
+    unsigned __int128 exact = ((unsigned __int128)a_Value * a_Numerator) / a_Denominator;
+    unsigned __int128 result = TimeConv_Apply(a_Scale, a_Value);
+
+    g_TimeBench_Checked++;
+    if (result == exact)
+    {
+        return TRUE;
+    }
+    if ((result == (exact + 1)) && !a_Exact)
+    {
+        g_TimeBench_Above++;
+        return TRUE;
+    }
+    printf("FAIL %s x %u/%u: value %u gives %llu, exact %llu\n", a_Exact ? "exact" : "rounded", a_Numerator, a_Denominator,
+           a_Value, (unsigned long long)result, (unsigned long long)exact);
+    return FALSE;
+}
+
+/* Check one scale against its ratio, TRUE if every value is within the bound */
+static boolean TimeBench_CheckScale(const char *a_Name, const TimeConv_ScaleType *a_Scale, uint32 a_Numerator,
+                                    uint32 a_Denominator, uint8 a_Bits)
+{
+    boolean exact = (((uint64)(a_Numerator % a_Denominator) << TIMECONV_FRACTION_BITS) % a_Denominator) == 0;
+    uint64 limit = 1ULL << a_Bits;
+    uint64 checked = g_TimeBench_Checked;
+    uint64 above = g_TimeBench_Above;
+    uint64 value;
+    uint32 index;
+    uint8 bit;
+
+    for (value = 0; value < limit; value++)
+    {
+        if (!TimeBench_CheckValue(a_Scale, a_Numerator, a_Denominator, exact, (uint32)value))
+        {
+            return FALSE;
+        }
+    }
+
+    for (bit = 1; bit <= 32; bit++)
+    {
+        value = 1ULL << bit;
+        if (!TimeBench_CheckValue(a_Scale, a_Numerator, a_Denominator, exact, (uint32)(value - 1)) ||
+            ((bit < 32) && !TimeBench_CheckValue(a_Scale, a_Numerator, a_Denominator, exact, (uint32)value)) ||
+            ((bit < 32) && !TimeBench_CheckValue(a_Scale, a_Numerator, a_Denominator, exact, (uint32)(value + 1))))
+        {
+            return FALSE;
+        }
+    }
+
+    for (index = 0; index < TIMEBENCH_RANDOM_VALUES; index++)
+    {
+        if (!TimeBench_CheckValue(a_Scale, a_Numerator, a_Denominator, exact, TimeBench_Random()))
+        {
+            return FALSE;
+        }
+    }
+
+    printf("  %-13s %10u / %-10u %-7s %10llu values %9llu above\n", a_Name, a_Numerator, a_Denominator,
+           exact ? "exact" : "rounded", g_TimeBench_Checked - checked, g_TimeBench_Above - above);
+    return TRUE;
+}
+
+/* Check every scale at the running clocks */
+static boolean TimeBench_CheckClocks(uint8 a_Bits)
+{
+    uint32 core_hz    = Clock_GetFrequency();
+    uint32 counter_hz = SysTick_GetCounterFrequency();
+
+    printf("core %u Hz, SysTick counter %u Hz\n", core_hz, counter_hz);
+    return TimeBench_CheckScale("cycles->ns", &g_TimeConv_CyclesToNs, TIMECONV_NS_PER_S, core_hz, a_Bits) &&
+           TimeBench_CheckScale("cycles->us", &g_TimeConv_CyclesToUs, TIMECONV_US_PER_S, core_hz, a_Bits) &&
+           TimeBench_CheckScale("ns->cycles", &g_TimeConv_NsToCycles, core_hz, TIMECONV_NS_PER_S, a_Bits) &&
+           TimeBench_CheckScale("us->cycles", &g_TimeConv_UsToCycles, core_hz, TIMECONV_US_PER_S, a_Bits) &&
+           TimeBench_CheckScale("counts->ns", &g_TimeConv_CountsToNs, TIMECONV_NS_PER_S, counter_hz, a_Bits) &&
+           TimeBench_CheckScale("us->counts", &g_TimeConv_UsToCounts, counter_hz, TIMECONV_US_PER_S, a_Bits);
+}
+
+/* Cycles to nanoseconds over the same values with the scale and with a 64-bit division */
+static void TimeBench_Benchmark(void)
+{
+    volatile uint32 divisor = Clock_GetFrequency();
+    uint64 sum_scale = 0;
+    uint64 sum_divide = 0;
+    uint64 start;
+    uint64 scale_ns;
+    uint64 divide_ns;
+    uint32 index;
+
+    start = TimeBench_NowNs();
+    for (index = 0; index < TIMEBENCH_BENCH_VALUES; index++)
+    {
+        sum_scale += TimeConv_CyclesToNs((uint32)(index * TIMEBENCH_BENCH_STEP));
+    }
+    scale_ns = TimeBench_NowNs() - start;
+
+    start = TimeBench_NowNs();
+    for (index = 0; index < TIMEBENCH_BENCH_VALUES; index++)
+    {
+        sum_divide += ((uint64)(uint32)(index * TIMEBENCH_BENCH_STEP) * TIMECONV_NS_PER_S) / divisor;
+    }
+    divide_ns = TimeBench_NowNs() - start;
+
+    printf("benchmark at %u Hz, %lu cycles to ns conversions: scale %.2f ns each, 64-bit division %.2f ns each (sums %llu %llu)\n",
+           (uint32)divisor, TIMEBENCH_BENCH_VALUES, (double)scale_ns / TIMEBENCH_BENCH_VALUES,
+           (double)divide_ns / TIMEBENCH_BENCH_VALUES, (unsigned long long)sum_scale, (unsigned long long)sum_divide);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 bits = (argc > 1) ? (uint32)strtoul(argv[1], NULL_PTR, 0) : TIMEBENCH_DEFAULT_BITS;
+    TimeConv_ScaleType reset_scales[6];
+    boolean passed = TRUE;
+    uint32 clock;
+    uint8 source;
+
+    if (bits > 32)
+    {
+        printf("Usage: %s [bits]\n", argv[0]);
+        return 2;
+    }
+
+    /* The static scales must be the ones computed for the reset clock */
+    reset_scales[0] = g_TimeConv_CyclesToNs;
+    reset_scales[1] = g_TimeConv_CyclesToUs;
+    reset_scales[2] = g_TimeConv_NsToCycles;
+    reset_scales[3] = g_TimeConv_UsToCycles;
+    reset_scales[4] = g_TimeConv_CountsToNs;
+    reset_scales[5] = g_TimeConv_UsToCounts;
+    TimeConv_Init();
+    if ((reset_scales[0].Integer != g_TimeConv_CyclesToNs.Integer) || (reset_scales[0].Fraction != g_TimeConv_CyclesToNs.Fraction) ||
+        (reset_scales[1].Integer != g_TimeConv_CyclesToUs.Integer) || (reset_scales[1].Fraction != g_TimeConv_CyclesToUs.Fraction) ||
+        (reset_scales[2].Integer != g_TimeConv_NsToCycles.Integer) || (reset_scales[2].Fraction != g_TimeConv_NsToCycles.Fraction) ||
+        (reset_scales[3].Integer != g_TimeConv_UsToCycles.Integer) || (reset_scales[3].Fraction != g_TimeConv_UsToCycles.Fraction) ||
+        (reset_scales[4].Integer != g_TimeConv_CountsToNs.Integer) || (reset_scales[4].Fraction != g_TimeConv_CountsToNs.Fraction) ||
+        (reset_scales[5].Integer != g_TimeConv_UsToCounts.Integer) || (reset_scales[5].Fraction != g_TimeConv_UsToCounts.Fraction))
+    {
+        printf("FAIL static scales differ from the ones computed at reset\n");
+        passed = FALSE;
+    }
+
+    for (source = SYSTICK_CLOCK_SYSTEM; passed && (source <= SYSTICK_CLOCK_PIOSC_DIV4); source++)
+    {
+        /* The counter clock is latched by SysTick_StartBusyWait and read at initialization, the system clock changes reach the
+         * scales through the listener */
+        (void)SysTick_SetClockSource(source);
+        SysTick_StartBusyWait(1);
+        TimeConv_Init();
+
+        for (clock = 0; passed && (clock < TIMEBENCH_CLOCKS); clock++)
+        {
+            if (!Clock_SetFrequency(g_TimeBench_Clocks[clock].Source, g_TimeBench_Clocks[clock].FrequencyHz))
+            {
+                printf("FAIL clock %u Hz not reached\n", g_TimeBench_Clocks[clock].FrequencyHz);
+                passed = FALSE;
+            }
+            else
+            {
+                passed = TimeBench_CheckClocks((uint8)bits);
+            }
+        }
+    }
+
+    if (!passed)
+    {
+        return 1;
+    }
+    printf("PASS %llu values, %llu one above the exact floor\n", (unsigned long long)g_TimeBench_Checked,
+           (unsigned long long)g_TimeBench_Above);
+
+    (void)Clock_SetFrequency(CLOCK_SOURCE_PLL, CLOCK_MAX_HZ);
+    TimeBench_Benchmark();
+    return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Decoder of the App3 benchmark result block.
+
+Reads a binary file holding a Bench_BlockType (bench.bin written by the host build, or a
+memory dump saved by the debugger at g_Bench_Block), locates the block by its magic word,
+checks it and prints min / median / max cycles and microseconds of every benchmark.
+
+Usage: bench_parse.py <binary file> [--csv]
+"""
+
+import struct
+import sys
+
+BENCH_BLOCK_MAGIC = 0x48434E42
+BENCH_BLOCK_VERSION = 1
+HEADER_WORDS = 5
+RESULT_WORDS = 5
+
+# Bench_IdType in App3/Bench.h, the order is part of the block format
+BENCH_NAMES = [
+    'SysTick_Init',
+    'SysTick_Start',
+    'SysTick_Stop',
+    'SysTick_SetCallBack',
+    'SysTick_Handler dispatch',
+    'NVIC_EnableIRQ',
+    'NVIC_DisableIRQ',
+    'NVIC_SetPriorityIRQ',
+    'NVIC_EnableException',
+    'NVIC_SetPriorityException',
+    'SysTick ISR entry to callback',
+]
+
+
+def find_block(data):
+    magic = struct.pack('<I', BENCH_BLOCK_MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset % 4 == 0 and len(data) >= offset + HEADER_WORDS * 4:
+            version, count = struct.unpack_from('<II', data, offset + 4)
+            words = HEADER_WORDS + count * RESULT_WORDS + 1
+            if version == BENCH_BLOCK_VERSION and len(data) >= offset + words * 4:
+                block = struct.unpack_from('<%dI' % words, data, offset)
+                if sum(block) & 0xFFFFFFFF == 0:
+                    return block
+        offset = data.find(magic, offset + 1)
+    sys.exit('no valid benchmark block (magic, version and checksum) in the input')
+
+
+def main():
+    if len(sys.argv) not in (2, 3) or (len(sys.argv) == 3 and sys.argv[2] != '--csv'):
+        sys.exit(__doc__)
+    with open(sys.argv[1], 'rb') as dump:
+        block = find_block(dump.read())
+
+    _, _, count, clock_hz, overhead = block[:HEADER_WORDS]
+    csv = len(sys.argv) == 3
+    if csv:
+        print('name,samples,min_cycles,median_cycles,max_cycles')
+    else:
+        print('core clock %d Hz, measurement overhead %d cycles (subtracted)' % (clock_hz, overhead))
+        print('%-30s %8s %8s %8s %8s %10s' % ('benchmark', 'samples', 'min', 'median', 'max', 'median us'))
+
+    for index in range(count):
+        bench_id, samples, low, median, high = block[HEADER_WORDS + index * RESULT_WORDS:
+                                                     HEADER_WORDS + (index + 1) * RESULT_WORDS]
+        name = BENCH_NAMES[bench_id] if bench_id < len(BENCH_NAMES) else 'benchmark %d' % bench_id
+        if csv:
+            print('%s,%d,%d,%d,%d' % (name, samples, low, median, high))
+        else:
+            print('%-30s %8d %8d %8d %8d %10.3f' % (name, samples, low, median, high, median * 1e6 / clock_hz))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""Cyclic executive frame table generator.
+
+Reads a schedule table of (task, period in ms, WCET budget in us) entries, computes the
+hyperperiod and the largest valid frame size, places every job of the hyperperiod in a
+frame before its deadline and writes CyclicExec_Cfg.h / CyclicExec_Cfg.c for the
+SysTick-driven dispatcher in CyclicExec.c.
+
+Frame size constraints (Baker & Shaw):
+  1. f >= max(WCET)                      every job fits in one frame
+  2. f divides the hyperperiod           the table repeats every hyperperiod
+  3. 2f - gcd(f, p) <= p for each task   a full frame lies between release and deadline
+The frame is also one SysTick period, so it must fit in the 24-bit counter at the counter clock.
+
+Usage: cyclic_exec_gen.py <schedule table> <output directory> [--counter-hz <Hz>]
+
+  --counter-hz    SysTick counter clock the executive runs at: the highest system clock used, or 4000000
+                  for PIOSC / 4 (default 16000000, the PIOSC reset clock)
+"""
+
+import math
+import os
+import sys
+
+# SysTick_Init takes a uint16 millisecond count and a period is at most 2^24 counter clocks
+MAX_PERIOD_MS = 0xFFFF
+COUNTER_RANGE = 1 << 24
+DEFAULT_COUNTER_HZ = 16000000
+
+
+def max_frame_ms(counter_hz):
+    """Longest frame in whole milliseconds that fits in the counter, 1048 ms at 16 MHz and 209 ms at 80 MHz."""
+    return min(MAX_PERIOD_MS, COUNTER_RANGE * 1000 // counter_hz)
+
+
+def parse_table(path):
+    tasks = []
+    with open(path) as table:
+        for line_num, line in enumerate(table, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            if len(fields) != 3:
+                sys.exit('%s:%d: expected "<task> <period_ms> <wcet_us>"' % (path, line_num))
+            name, period_ms, wcet_us = fields[0], int(fields[1]), int(fields[2])
+            if period_ms <= 0 or wcet_us <= 0:
+                sys.exit('%s:%d: period and WCET must be positive' % (path, line_num))
+            tasks.append((name, period_ms, wcet_us))
+    if not tasks:
+        sys.exit('%s: empty schedule table' % path)
+    return tasks
+
+
+def hyperperiod(tasks):
+    h = 1
+    for _, period_ms, _ in tasks:
+        h = h * period_ms // math.gcd(h, period_ms)
+    return h
+
+
+def frame_size(tasks, h, counter_hz=DEFAULT_COUNTER_HZ):
+    max_wcet_us = max(wcet_us for _, _, wcet_us in tasks)
+    for f in range(min(h, max_frame_ms(counter_hz)), 0, -1):
+        if h % f != 0 or f * 1000 < max_wcet_us:
+            continue
+        if all(2 * f - math.gcd(f, period_ms) <= period_ms for _, period_ms, _ in tasks):
+            return f
+    sys.exit('no valid frame size up to %d ms at %d Hz: split the longest task or relax the periods' %
+             (max_frame_ms(counter_hz), counter_hz))
+
+
+def place_jobs(tasks, h, f):
+    """Earliest-deadline-first packing of the jobs of one hyperperiod into frames."""
+    jobs = []
+    for index, (name, period_ms, wcet_us) in enumerate(tasks):
+        for release in range(0, h, period_ms):
+            jobs.append((release + period_ms, release, index, name, wcet_us))
+
+    frames = []
+    pending = sorted(jobs)
+    for frame in range(h // f):
+        start, end = frame * f, (frame + 1) * f
+        budget_us = f * 1000
+        placed = []
+        for job in list(pending):
+            deadline, release, _, name, wcet_us = job
+            if release <= start and wcet_us <= budget_us:
+                budget_us -= wcet_us
+                placed.append(job)
+                pending.remove(job)
+        for deadline, _, _, name, _ in placed:
+            if end > deadline:
+                sys.exit('%s misses its deadline at %d ms' % (name, deadline))
+        frames.append(placed)
+
+    if pending:
+        sys.exit('%d jobs do not fit in the hyperperiod, first one: %s' % (len(pending), pending[0][3]))
+    return frames
+
+
+def write_crlf(path, lines):
+    with open(path, 'w', newline='\r\n') as out:
+        out.write('\n'.join(lines) + '\n')
+
+
+def generate(tasks, h, f, frames, out_dir, table_name, counter_hz=DEFAULT_COUNTER_HZ):
+    task_names = sorted(set(name for name, _, _ in tasks))
+    header = [
+        '/***********************************************************************************************************************************',
+        ' Module      : CyclicExec',
+        ' Name        : CyclicExec_Cfg.h',
+        ' Author      : Generated by Tools/cyclic_exec_gen.py from %s, do not edit' % table_name,
+        ' Description : Static frame table configuration of the time-triggered cyclic executive',
+        ' ************************************************************************************************************************************/',
+        '',
+        '#ifndef CYCLICEXEC_CFG_H_',
+        '#define CYCLICEXEC_CFG_H_',
+        '',
+        '#define CYCLIC_EXEC_HYPERPERIOD_MS           %d' % h,
+        '#define CYCLIC_EXEC_FRAME_MS                 %d' % f,
+        '#define CYCLIC_EXEC_FRAME_COUNT              %d' % len(frames),
+        '#define CYCLIC_EXEC_JOB_COUNT                %d' % sum(len(jobs) for jobs in frames),
+        '',
+        '/* Highest SysTick counter clock the frame was sized for, CyclicExec_Start refuses a faster one */',
+        '#define CYCLIC_EXEC_COUNTER_HZ               %dUL' % counter_hz,
+        '',
+        '/* Tasks of the schedule table */',
+    ]
+    header += ['void %s(void);' % name for name in task_names]
+    header += ['', '#endif /* CYCLICEXEC_CFG_H_ */']
+
+    source = [
+        '/**************************************************************************************************************************************',
+        ' Module      : CyclicExec',
+        ' Name        : CyclicExec_Cfg.c',
+        ' Author      : Generated by Tools/cyclic_exec_gen.py from %s, do not edit' % table_name,
+        ' Description : Static frame table of the time-triggered cyclic executive',
+        ' ***************************************************************************************************************************************/',
+        '',
+        '#include "CyclicExec.h"',
+        '',
+        '/*',
+        ' * Task                 Period(ms)  WCET(us)',
+    ]
+    source += [' * %-20s %10d  %8d' % (name, period_ms, wcet_us) for name, period_ms, wcet_us in tasks]
+    source += [
+        ' *',
+        ' * Hyperperiod %d ms, frame %d ms, worst frame load %d us' %
+        (h, f, max(sum(job[4] for job in jobs) for jobs in frames)),
+        ' */',
+        '',
+        '/* Jobs of all the frames in dispatch order */',
+        'const CyclicExec_TaskFuncType g_CyclicExec_Jobs[CYCLIC_EXEC_JOB_COUNT] =',
+        '{',
+    ]
+    for index, jobs in enumerate(frames):
+        for job in jobs:
+            source.append('    %-30s /* Frame %d */' % (job[3] + ',', index))
+    source += [
+        '};',
+        '',
+        '/* Index of the first job of each frame, the extra entry closes the last frame */',
+        'const uint16 g_CyclicExec_FrameStart[CYCLIC_EXEC_FRAME_COUNT + 1] =',
+        '{',
+    ]
+    start = 0
+    starts = []
+    for jobs in frames:
+        starts.append(start)
+        start += len(jobs)
+    starts.append(start)
+    source.append('    ' + ', '.join(str(s) for s in starts))
+    source += [
+        '};',
+        '',
+        '/* WCET budget of each frame in microseconds */',
+        'const uint32 g_CyclicExec_FrameBudgetUs[CYCLIC_EXEC_FRAME_COUNT] =',
+        '{',
+        '    ' + ', '.join(str(sum(job[4] for job in jobs)) for jobs in frames),
+        '};',
+    ]
+
+    write_crlf(os.path.join(out_dir, 'CyclicExec_Cfg.h'), header)
+    write_crlf(os.path.join(out_dir, 'CyclicExec_Cfg.c'), source)
+
+
+def main():
+    args = sys.argv[1:]
+    counter_hz = DEFAULT_COUNTER_HZ
+    if '--counter-hz' in args:
+        index = args.index('--counter-hz')
+        counter_hz = int(args[index + 1], 0)
+        del args[index:index + 2]
+    if len(args) != 2 or counter_hz <= 0:
+        sys.exit(__doc__)
+    tasks = parse_table(args[0])
+    h = hyperperiod(tasks)
+    f = frame_size(tasks, h, counter_hz)
+    frames = place_jobs(tasks, h, f)
+    generate(tasks, h, f, frames, args[1], os.path.basename(args[0]), counter_hz)
+    print('hyperperiod %d ms, frame %d ms, %d frames' % (h, f, len(frames)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Decoder of the App2 fault capture crash record.
+
+Reads a binary file holding a Fault_RecordType (a memory dump saved by the debugger at
+g_Fault_Record, or the bytes returned by Fault_GetRecord), locates the record by its magic
+word, checks it and prints the faulting context with the decoded fault status registers.
+
+Usage: fault_decode.py <binary file>
+"""
+
+import struct
+import sys
+
+FAULT_RECORD_MAGIC = 0x544C4146
+FAULT_RECORD_VERSION = 1
+
+# Fault_RecordType in App2/Fault.h, the order is part of the record format
+FIELDS = ['Magic', 'Version', 'Count', 'Vector', 'ExcReturn', 'Flags', 'StackPointer',
+          'R0', 'R1', 'R2', 'R3', 'R12', 'LR', 'PC', 'xPSR',
+          'CFSR', 'HFSR', 'MMFAR', 'BFAR', 'Checksum']
+
+FLAG_PSP = 0x1
+FLAG_FP_FRAME = 0x2
+FLAG_NO_FRAME = 0x4
+
+VECTORS = {3: 'HardFault', 4: 'MemManage', 5: 'BusFault', 6: 'UsageFault'}
+
+# Configurable Fault Status register: MMFSR (bits 0-7), BFSR (bits 8-15), UFSR (bits 16-31)
+CFSR_BITS = [
+    (0, 'IACCVIOL', 'MemManage: instruction fetch from a no-execute or protected region'),
+    (1, 'DACCVIOL', 'MemManage: data access to a protected region'),
+    (3, 'MUNSTKERR', 'MemManage: unstacking on exception return'),
+    (4, 'MSTKERR', 'MemManage: stacking on exception entry (stack overflow into a guard?)'),
+    (5, 'MLSPERR', 'MemManage: lazy FP state preservation'),
+    (7, 'MMARVALID', 'MMFAR holds the faulting address'),
+    (8, 'IBUSERR', 'BusFault: instruction prefetch'),
+    (9, 'PRECISERR', 'BusFault: precise data access, PC is the faulting instruction'),
+    (10, 'IMPRECISERR', 'BusFault: imprecise data access, PC is after the faulting store'),
+    (11, 'UNSTKERR', 'BusFault: unstacking on exception return'),
+    (12, 'STKERR', 'BusFault: stacking on exception entry (stack pointer out of SRAM?)'),
+    (13, 'LSPERR', 'BusFault: lazy FP state preservation'),
+    (15, 'BFARVALID', 'BFAR holds the faulting address'),
+    (16, 'UNDEFINSTR', 'UsageFault: undefined instruction'),
+    (17, 'INVSTATE', 'UsageFault: invalid EPSR state (call to an even address?)'),
+    (18, 'INVPC', 'UsageFault: invalid EXC_RETURN on exception return'),
+    (19, 'NOCP', 'UsageFault: coprocessor access with the FPU disabled'),
+    (24, 'UNALIGNED', 'UsageFault: unaligned access'),
+    (25, 'DIVBYZERO', 'UsageFault: division by zero'),
+]
+
+HFSR_BITS = [
+    (1, 'VECTTBL', 'vector table read on exception processing'),
+    (30, 'FORCED', 'escalated configurable fault (disabled or masked handler)'),
+    (31, 'DEBUGEVT', 'debug event'),
+]
+
+
+def find_record(data):
+    magic = struct.pack('<I', FAULT_RECORD_MAGIC)
+    size = len(FIELDS) * 4
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset % 4 == 0 and len(data) >= offset + size:
+            words = struct.unpack_from('<%dI' % len(FIELDS), data, offset)
+            if words[1] == FAULT_RECORD_VERSION and sum(words) & 0xFFFFFFFF == 0:
+                return dict(zip(FIELDS, words))
+        offset = data.find(magic, offset + 1)
+    sys.exit('no valid crash record (magic, version and checksum) in the input')
+
+
+def print_bits(name, value, bits):
+    print('%-6s 0x%08X' % (name, value))
+    for bit, label, meaning in bits:
+        if value & (1 << bit):
+            print('       %-12s %s' % (label, meaning))
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    with open(sys.argv[1], 'rb') as dump:
+        record = find_record(dump.read())
+
+    vector = record['Vector']
+    flags = record['Flags']
+    exc_return = record['ExcReturn']
+    print('%s (exception %d), fault %d since power-on' %
+          (VECTORS.get(vector, 'exception'), vector, record['Count']))
+    print('EXC_RETURN 0x%08X: return to %s mode, %s stack, %s frame' %
+          (exc_return, 'thread' if exc_return & 0x8 else 'handler',
+           'process (PSP)' if flags & FLAG_PSP else 'main (MSP)',
+           'extended (FPU)' if flags & FLAG_FP_FRAME else 'basic'))
+
+    if flags & FLAG_NO_FRAME:
+        print('stacking failed, no frame captured, SP was 0x%08X' % record['StackPointer'])
+    else:
+        print('PC   0x%08X    LR   0x%08X    SP   0x%08X    xPSR 0x%08X' %
+              (record['PC'], record['LR'], record['StackPointer'], record['xPSR']))
+        print('R0   0x%08X    R1   0x%08X    R2   0x%08X    R3   0x%08X    R12  0x%08X' %
+              (record['R0'], record['R1'], record['R2'], record['R3'], record['R12']))
+        if record['xPSR'] & 0x1FF:
+            print('faulted in handler mode, exception %d was active' % (record['xPSR'] & 0x1FF))
+
+    print_bits('CFSR', record['CFSR'], CFSR_BITS)
+    print_bits('HFSR', record['HFSR'], HFSR_BITS)
+    if record['CFSR'] & (1 << 7):
+        print('MMFAR  0x%08X' % record['MMFAR'])
+    if record['CFSR'] & (1 << 15):
+        print('BFAR   0x%08X' % record['BFAR'])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""ISR timing trampoline table generator.
+
+Reads g_pfnVectors from the CCS startup file and writes IsrTiming_Vectors.h, the instrumented
+vector table used by ISR_TIMING builds. Every handler entry gets an ISR_TIMING_TRAMPOLINE that
+times it with the DWT cycle counter, the handlers themselves are not changed.
+
+Entries that are kept as they are:
+  - the initial stack pointer and the reserved (0) entries
+  - handlers that cannot run behind a C call: ResetISR never returns, PendSV_Handler returns
+    through the EXC_RETURN value in LR and the fault handlers inspect the stacked frame
+  - any handler given with --exclude
+
+Usage: isr_timing_gen.py <startup file> <output header> [--exclude <handler> ...]
+"""
+
+import os
+import re
+import sys
+
+DEFAULT_EXCLUDED = {'ResetISR', 'NmiSR', 'FaultISR', 'PendSV_Handler'}
+
+# Entries of the TM4C123GH6PM table, ISR_TIMING_VECTORS in IsrTiming.h
+VECTORS = 155
+
+
+def parse_vectors(path):
+    with open(path) as source:
+        text = source.read()
+    match = re.search(r'g_pfnVectors\[\]\)\(void\)\s*=\s*\{(.*?)\};', text, re.S)
+    if not match:
+        sys.exit('%s: g_pfnVectors table not found' % path)
+
+    entries = []
+    for line in match.group(1).splitlines():
+        code, _, comment = line.partition('//')
+        code, comment = code.strip(), comment.strip()
+        if code:
+            for item in code.split(','):
+                if item.strip():
+                    entries.append([item.strip(), comment])
+        elif comment and entries and not entries[-1][1]:
+            entries[-1][1] = comment
+    if len(entries) != VECTORS:
+        sys.exit('%s: %d vector table entries, expected %d' % (path, len(entries), VECTORS))
+    return entries
+
+
+def is_handler(entry):
+    return re.fullmatch(r'[A-Za-z_]\w*', entry) is not None
+
+
+def write_crlf(path, lines):
+    with open(path, 'w', newline='\r\n') as out:
+        out.write('\n'.join(lines) + '\n')
+
+
+def generate(entries, excluded, out_path, startup_name):
+    wrapped = [(index, name) for index, (name, _) in enumerate(entries)
+               if index != 0 and is_handler(name) and name not in excluded]
+
+    lines = [
+        '/***********************************************************************************************************************************',
+        ' Module      : IsrTiming',
+        ' Name        : IsrTiming_Vectors.h',
+        ' Author      : Generated by Tools/isr_timing_gen.py from %s, do not edit' % startup_name,
+        ' Description : Instrumented vector table of the ISR_TIMING build, included by the startup file in place of g_pfnVectors',
+        ' ************************************************************************************************************************************/',
+        '',
+        '#ifndef ISRTIMING_VECTORS_H_',
+        '#define ISRTIMING_VECTORS_H_',
+        '',
+        '#include "IsrTiming.h"',
+        '',
+        '/* Not instrumented: %s */' % ', '.join(sorted(excluded)),
+        '',
+        '/* Timing trampolines, one per instrumented vector */',
+    ]
+    lines += ['ISR_TIMING_TRAMPOLINE(IsrTiming_Vector%d, %d, %s)' % (index, index, name) for index, name in wrapped]
+    lines += [
+        '',
+        '#pragma DATA_SECTION(g_pfnVectors, ".intvecs")',
+        'void (* const g_pfnVectors[])(void) =',
+        '{',
+    ]
+    trampolines = dict(wrapped)
+    for index, (name, comment) in enumerate(entries):
+        entry = ('IsrTiming_Vector%d' % index) if index in trampolines else name
+        if index < len(entries) - 1:
+            entry += ','
+        if not comment:
+            lines.append('    ' + entry)
+        elif len(entry) < 40:
+            lines.append('    %-40s// %s' % (entry, comment))
+        else:
+            lines += ['    ' + entry, '    %-40s// %s' % ('', comment)]
+    lines += [
+        '};',
+        '',
+        '#endif /* ISRTIMING_VECTORS_H_ */',
+    ]
+
+    write_crlf(out_path, lines)
+    return len(wrapped)
+
+
+def main():
+    args = sys.argv[1:]
+    excluded = set(DEFAULT_EXCLUDED)
+    if '--exclude' in args:
+        position = args.index('--exclude')
+        excluded.update(args[position + 1:])
+        args = args[:position]
+    if len(args) != 2:
+        sys.exit(__doc__)
+    entries = parse_vectors(args[0])
+    count = generate(entries, excluded, args[1], os.path.basename(args[0]))
+    print('%d of %d vectors instrumented' % (count, len(entries)))
+
+
+if __name__ == '__main__':
+    main()
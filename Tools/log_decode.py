@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Decoder of the binary trace log (App1/Log.c).
+
+The records hold only a format id, a DWT timestamp and raw 32-bit arguments. The text
+comes from the LOG_FORMAT table of Log_Formats.h, the position in the table is the id.
+
+Input is either a memory dump of g_Log saved by the debugger (located by its magic word,
+the records between Tail and Head are decoded) or, with --stream, the words copied out by
+Log_Drain back to back.
+
+Usage: log_decode.py <Log_Formats.h> <binary file> [--stream] [--clock HZ]
+"""
+
+import re
+import struct
+import sys
+
+LOG_MAGIC = 0x474F4C54
+LOG_RECORD_MARK = 0xA5
+LOG_HEADER_WORDS = 5            # Magic, Words, Head, Tail, Dropped
+DEFAULT_CLOCK_HZ = 16000000
+
+FORMAT_ENTRY = re.compile(r'^\s*LOG_FORMAT\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', re.M)
+CONVERSION = re.compile(r'%([-0 #]*\d*)([udxXc%])')
+
+
+def load_formats(path):
+    with open(path) as table:
+        return [(name, bytes(text, 'utf-8').decode('unicode_escape')) for name, text in FORMAT_ENTRY.findall(table.read())]
+
+
+def render(text, args):
+    """printf with raw 32-bit words, %d reinterprets the word as signed."""
+    values = iter(args)
+
+    def convert(match):
+        flags, kind = match.groups()
+        if kind == '%':
+            return '%'
+        value = next(values, 0)
+        if kind == 'd':
+            value = value - (1 << 32) if value & 0x80000000 else value
+        elif kind == 'u':
+            kind = 'd'
+        elif kind == 'c':
+            value = chr(value & 0xFF)
+        return ('%' + flags + kind) % value
+    return CONVERSION.sub(convert, text)
+
+
+def records_from_stream(words):
+    index = 0
+    while index + 2 <= len(words):
+        header = words[index]
+        if header & 0xFF != LOG_RECORD_MARK:
+            sys.exit('corrupted record header 0x%08X at word %d' % (header, index))
+        count = (header >> 8) & 0xF
+        yield header >> 16, words[index + 1], words[index + 2:index + 2 + count]
+        index += 2 + count
+
+
+def records_from_dump(data):
+    offset = data.find(struct.pack('<I', LOG_MAGIC))
+    while offset >= 0 and offset % 4 != 0:
+        offset = data.find(struct.pack('<I', LOG_MAGIC), offset + 1)
+    if offset < 0:
+        sys.exit('g_Log not found in the dump (magic word missing)')
+    _, size, head, tail, dropped = struct.unpack_from('<5I', data, offset)
+    ring = struct.unpack_from('<%dI' % size, data, offset + LOG_HEADER_WORDS * 4)
+
+    words = [ring[(tail + i) % size] for i in range((head - tail) & 0xFFFFFFFF)]
+    complete = []
+    index = 0
+    while index < len(words) and words[index] & 0xFF == LOG_RECORD_MARK:
+        length = 2 + ((words[index] >> 8) & 0xF)
+        complete.extend(words[index:index + length])
+        index += length
+    if index < len(words):
+        print('(%d words reserved but not committed at the time of the dump)' % (len(words) - index))
+    if dropped:
+        print('(%d records dropped, the log was full)' % dropped)
+    return records_from_stream(complete)
+
+
+def main():
+    args = sys.argv[1:]
+    stream = '--stream' in args
+    clock_hz = DEFAULT_CLOCK_HZ
+    if '--clock' in args:
+        clock_hz = int(args[args.index('--clock') + 1])
+        del args[args.index('--clock'):args.index('--clock') + 2]
+    args = [arg for arg in args if arg != '--stream']
+    if len(args) != 2:
+        sys.exit(__doc__)
+
+    formats = load_formats(args[0])
+    with open(args[1], 'rb') as dump:
+        data = dump.read()
+
+    if stream:
+        records = records_from_stream(struct.unpack('<%dI' % (len(data) // 4), data[:len(data) // 4 * 4]))
+    else:
+        records = records_from_dump(data)
+
+    elapsed = 0
+    previous = None
+    for format_id, timestamp, values in records:
+        if previous is not None:
+            elapsed += (timestamp - previous) & 0xFFFFFFFF     # The 32-bit cycle counter wraps around
+        previous = timestamp
+        if format_id < len(formats):
+            text = render(formats[format_id][1], values)
+        else:
+            text = 'unknown format %d %s' % (format_id, ' '.join('0x%08X' % v for v in values))
+        print('%14.6f  %s' % (elapsed / clock_hz, text))
+
+
+if __name__ == '__main__':
+    main()
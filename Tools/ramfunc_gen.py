@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""SRAM function placement generator.
+
+Reads a list of function names and writes, for the TI ARM toolchain:
+  RamFunc.cmd    linker command fragment giving every function its own output section, loaded in
+                 FLASH and run from SRAM, with one record per function in the g_RamFunc_CopyTable
+                 copy table (uncompressed, so RamFunc_CopyIn can copy it with a plain loop)
+  RamFunc_Cfg.h  number of relocated functions
+  RamFunc_Cfg.c  names and addresses of the functions, used by RamFunc_GetInfo for the report
+
+The sources must be compiled with --gen_func_subsections=on so each function is in its own
+.text:<name> input section. The linker resolves every reference (vector table entries, calls) to
+the SRAM run address and adds the long-branch trampolines needed between FLASH and SRAM.
+
+Usage: ramfunc_gen.py <function list> <output directory>
+"""
+
+import os
+import re
+import sys
+
+IDENTIFIER_RE = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+
+
+def parse_list(path):
+    functions = []
+    with open(path) as table:
+        for line_num, line in enumerate(table, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            if not IDENTIFIER_RE.match(line):
+                sys.exit('%s:%d: expected one function name per line' % (path, line_num))
+            if line in functions:
+                sys.exit('%s:%d: %s is listed twice' % (path, line_num, line))
+            functions.append(line)
+    if not functions:
+        sys.exit('%s: empty function list' % path)
+    return functions
+
+
+def write_crlf(path, lines):
+    with open(path, 'w', newline='\r\n') as out:
+        out.write('\n'.join(lines) + '\n')
+
+
+def linker_fragment(functions, list_name):
+    width = max(len(name) for name in functions)
+    lines = [
+        '/* Generated by Tools/ramfunc_gen.py from %s, do not edit' % list_name,
+        ' *',
+        ' * Add this file to the linker command files of the project and compile with --gen_func_subsections=on.',
+        ' * Every function is loaded in FLASH and runs from SRAM, RamFunc_CopyIn (called by ResetISR before _c_int00)',
+        ' * copies it using the records of g_RamFunc_CopyTable. */',
+        '',
+        'SECTIONS',
+        '{',
+    ]
+    for name in functions:
+        lines.append('    %-*s : { *(.text:%s) } load = FLASH, run = SRAM, '
+                     'table(g_RamFunc_CopyTable, compression = off)' % (width + 9, '.ramfunc:' + name, name))
+    lines += [
+        '',
+        '    /* Copy tables */',
+        '    .ovly : > FLASH',
+        '}',
+    ]
+    return lines
+
+
+def config_header(functions, list_name):
+    return [
+        '/***********************************************************************************************************************************',
+        ' Module      : RamFunc',
+        ' Name        : RamFunc_Cfg.h',
+        ' Author      : Generated by Tools/ramfunc_gen.py from %s, do not edit' % list_name,
+        ' Description : Functions placed in SRAM by RamFunc.cmd',
+        ' ************************************************************************************************************************************/',
+        '',
+        '#ifndef RAMFUNC_CFG_H_',
+        '#define RAMFUNC_CFG_H_',
+        '',
+        '#define RAMFUNC_COUNT                        %d' % len(functions),
+        '',
+        '#endif /* RAMFUNC_CFG_H_ */',
+    ]
+
+
+def config_source(functions, list_name):
+    source = [
+        '/**************************************************************************************************************************************',
+        ' Module      : RamFunc',
+        ' Name        : RamFunc_Cfg.c',
+        ' Author      : Generated by Tools/ramfunc_gen.py from %s, do not edit' % list_name,
+        ' Description : Names and addresses of the functions placed in SRAM by RamFunc.cmd',
+        ' ***************************************************************************************************************************************/',
+        '',
+        '#include "RamFunc.h"',
+        '',
+        '/* Only the addresses are used, the real prototypes do not matter here */',
+    ]
+    source += ['extern void %s(void);' % name for name in functions]
+    source += [
+        '',
+        'const RamFunc_EntryType g_RamFunc_Entries[RAMFUNC_COUNT] =',
+        '{',
+    ]
+    source += ['    { "%s", (RamFunc_AddressType)%s },' % (name, name) for name in functions]
+    source += ['};']
+    return source
+
+
+def generate(functions, out_dir, list_name):
+    write_crlf(os.path.join(out_dir, 'RamFunc.cmd'), linker_fragment(functions, list_name))
+    write_crlf(os.path.join(out_dir, 'RamFunc_Cfg.h'), config_header(functions, list_name))
+    write_crlf(os.path.join(out_dir, 'RamFunc_Cfg.c'), config_source(functions, list_name))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    functions = parse_list(sys.argv[1])
+    generate(functions, sys.argv[2], os.path.basename(sys.argv[1]))
+    print('%d functions placed in SRAM' % len(functions))
+
+
+if __name__ == '__main__':
+    main()
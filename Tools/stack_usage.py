@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""Worst-case stack depth analysis with nested exceptions.
+
+Combines the per-function stack usage and call graph of GCC (-fstack-usage .su files and
+-fcallgraph-info=su .ci files) with a configuration table that lists the entry points, the
+exception handlers with their NVIC priority, the indirect calls (callbacks) and the stack use of
+the assembly functions. For every root it prints the deepest call chain, then the worst-case
+main stack depth: the deepest thread-mode root plus one handler per preemption level, each with
+its exception frame, as a handler can only be preempted by a strictly more urgent priority.
+
+Configuration table lines (# starts a comment):
+  main    <function>                     thread-mode root running on the main stack
+  thread  <function>                     kernel thread, reported on its own process stack
+  isr     <function>  <priority>         handler; the priority is a number or a #define name
+  call    <caller>    <callee>           indirect call the compiler cannot see
+  stack   <function>  <bytes>            frame of a function without compiler data (assembly)
+
+Usage: stack_usage.py <config table> <.su/.ci files or directories> [-D<dir> ...] [--basic-frames]
+                      [--stack-size <bytes>]
+  -D<dir>         directory searched for the #define names of the priorities (default: config dir)
+  --basic-frames  exception frames without FPU state (32 bytes instead of 104)
+  --stack-size    main stack size, exit code 1 when the worst case does not fit
+"""
+
+import os
+import re
+import sys
+
+# Exception frame pushed by the hardware, plus the alignment word it may add (xPSR bit 9)
+BASIC_FRAME_BYTES = 32 + 4
+EXTENDED_FRAME_BYTES = 104 + 4
+
+# Kernel software frame saved by PendSV_Handler: R4-R11, EXC_RETURN and S16-S31
+KERNEL_SW_FRAME_BYTES = 36 + 64
+
+NODE_RE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE_RE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+SIZE_RE = re.compile(r'\\n(\d+) bytes \(([a-z,]+)\)')
+DEFINE_RE = re.compile(r'^\s*#define\s+(\w+)\s+\(?\s*(\d+)\s*\)?\s*(?:/[*/].*)?$')
+
+
+def bare(title):
+    return title.rsplit(':', 1)[-1]
+
+
+def input_files(paths):
+    for path in paths:
+        if os.path.isdir(path):
+            for root, _, names in os.walk(path):
+                for name in sorted(names):
+                    if name.endswith(('.su', '.ci')):
+                        yield os.path.join(root, name)
+        else:
+            yield path
+
+
+def parse_inputs(paths, sizes, qualifiers, edges):
+    for path in input_files(paths):
+        with open(path) as data:
+            text = data.read()
+        if path.endswith('.su'):
+            # file:line:column:function<TAB>bytes<TAB>static|dynamic|dynamic,bounded
+            for line in text.splitlines():
+                fields = line.split('\t')
+                if len(fields) == 3:
+                    name = bare(fields[0])
+                    sizes[name] = int(fields[1])
+                    qualifiers[name] = fields[2]
+        else:
+            # Static functions are titled "file:function", they are matched by name like in the .su files
+            for title, label in NODE_RE.findall(text):
+                match = SIZE_RE.search(label)
+                if match:
+                    sizes[bare(title)] = int(match.group(1))
+                    qualifiers[bare(title)] = match.group(2)
+            for source, target in EDGE_RE.findall(text):
+                edges.setdefault(bare(source), set()).add(bare(target))
+
+
+def parse_defines(directory):
+    defines = {}
+    for name in sorted(os.listdir(directory)):
+        if name.endswith(('.c', '.h')):
+            with open(os.path.join(directory, name)) as source:
+                for line in source:
+                    match = DEFINE_RE.match(line)
+                    if match:
+                        defines[match.group(1)] = int(match.group(2))
+    return defines
+
+
+def parse_config(path, defines):
+    roots, isrs, calls, frames = [], [], [], {}
+    with open(path) as table:
+        for line_num, line in enumerate(table, 1):
+            fields = line.split('#', 1)[0].split()
+            if not fields:
+                continue
+            kind, args = fields[0], fields[1:]
+            if kind in ('main', 'thread') and len(args) == 1:
+                roots.append((kind, args[0]))
+            elif kind == 'isr' and len(args) == 2:
+                prio = args[1]
+                if not prio.lstrip('-').isdigit():
+                    if prio not in defines:
+                        sys.exit('%s:%d: unknown priority %s' % (path, line_num, prio))
+                    prio = defines[prio]
+                isrs.append((args[0], int(prio)))
+            elif kind == 'call' and len(args) == 2:
+                calls.append((args[0], args[1]))
+            elif kind == 'stack' and len(args) == 2:
+                frames[args[0]] = int(args[1])
+            else:
+                sys.exit('%s:%d: unexpected line "%s"' % (path, line_num, line.strip()))
+    return roots, isrs, calls, frames
+
+
+class CallGraph:
+    def __init__(self, sizes, qualifiers, edges):
+        self.sizes = sizes
+        self.qualifiers = qualifiers
+        self.edges = edges
+        self.depths = {}
+        self.warnings = set()
+
+    def depth(self, func, path=()):
+        """Deepest stack use of func and its callees, with the call chain."""
+        if func in path:
+            self.warnings.add('recursion through %s, the chain is cut there' % func)
+            return 0, []
+        if func in self.depths:
+            return self.depths[func]
+        if func == '__indirect_call':
+            self.warnings.add('unresolved indirect call in %s, add a "call" line' % path[-1])
+            return 0, []
+        own = self.sizes.get(func)
+        if own is None:
+            self.warnings.add('no stack data for %s, counted as 0 bytes' % func)
+            own = 0
+        elif 'dynamic' in self.qualifiers.get(func, 'static'):
+            self.warnings.add('%s has a %s frame' % (func, self.qualifiers[func]))
+        best, chain = 0, []
+        for callee in sorted(self.edges.get(func, ())):
+            callee_depth, callee_chain = self.depth(callee, path + (func,))
+            if callee_depth > best:
+                best, chain = callee_depth, callee_chain
+        self.depths[func] = (own + best, [(func, own)] + chain)
+        return self.depths[func]
+
+
+def format_chain(chain):
+    return ' -> '.join('%s(%d)' % (func, own) for func, own in chain)
+
+
+def main():
+    args = sys.argv[1:]
+    basic_frames = '--basic-frames' in args
+    args = [arg for arg in args if arg != '--basic-frames']
+    stack_size = None
+    if '--stack-size' in args:
+        index = args.index('--stack-size')
+        stack_size = int(args[index + 1], 0)
+        del args[index:index + 2]
+    define_dirs = [arg[2:] for arg in args if arg.startswith('-D')]
+    args = [arg for arg in args if not arg.startswith('-D')]
+    if len(args) < 2:
+        sys.exit(__doc__)
+
+    config = args[0]
+    defines = {}
+    for directory in define_dirs or [os.path.dirname(config) or '.']:
+        defines.update(parse_defines(directory))
+    roots, isrs, calls, frames = parse_config(config, defines)
+
+    sizes, qualifiers, edges = {}, {}, {}
+    parse_inputs(args[1:], sizes, qualifiers, edges)
+    sizes.update(frames)
+    for caller, callee in calls:
+        targets = edges.setdefault(caller, set())
+        targets.discard('__indirect_call')
+        targets.add(callee)
+
+    graph = CallGraph(sizes, qualifiers, edges)
+    frame_bytes = BASIC_FRAME_BYTES if basic_frames else EXTENDED_FRAME_BYTES
+
+    print('Thread mode roots:')
+    main_depth = 0
+    for kind, func in roots:
+        depth, chain = graph.depth(func)
+        if kind == 'main':
+            main_depth = max(main_depth, depth)
+            print('  %-24s %5d  %s' % (func, depth, format_chain(chain)))
+        else:
+            total = depth + frame_bytes + KERNEL_SW_FRAME_BYTES
+            print('  %-24s %5d  process stack %d with the switch frames  %s' %
+                  (func, depth, total, format_chain(chain)))
+
+    # The deepest handler of each priority level, levels nest from the least to the most urgent
+    levels = {}
+    print('Exception handlers (frame %d bytes):' % frame_bytes)
+    for func, prio in isrs:
+        depth, chain = graph.depth(func)
+        print('  %-24s %5d  priority %d  %s' % (func, depth, prio, format_chain(chain)))
+        if prio not in levels or depth > levels[prio][1]:
+            levels[prio] = (func, depth)
+
+    total = main_depth
+    print('Worst-case main stack:')
+    print('  %-24s %5d' % ('thread mode', main_depth))
+    for prio in sorted(levels, reverse=True):
+        func, depth = levels[prio]
+        total += frame_bytes + depth
+        print('  %-24s %5d  priority %d nested on the levels above' % (func, frame_bytes + depth, prio))
+    print('  %-24s %5d bytes' % ('total', total))
+
+    for warning in sorted(graph.warnings):
+        print('warning: %s' % warning)
+
+    if stack_size is not None:
+        print('main stack %d bytes, margin %d bytes' % (stack_size, stack_size - total))
+        if total > stack_size:
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
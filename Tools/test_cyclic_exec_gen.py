@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Host test of the cyclic executive frame placement of cyclic_exec_gen.py.
+
+For several task sets it checks the chosen frame against the Baker & Shaw constraints and the 24-bit
+SysTick counter at the given counter clock, then that every job of the hyperperiod is placed exactly
+once, in a frame that starts at or after its release and ends by its deadline, without overloading
+the frame. Infeasible sets must be rejected. The generated tables are parsed back and compared with
+the placement.
+
+Usage: test_cyclic_exec_gen.py
+"""
+
+import math
+import os
+import re
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import cyclic_exec_gen as gen
+
+# (name, [(task, period ms, WCET us)], counter Hz, expected frame ms)
+TASK_SETS = [
+    ('leds at 16 MHz', [('Leds_RotateTask', 1000, 50)], 16000000, 1000),
+    ('leds at 80 MHz', [('Leds_RotateTask', 1000, 50)], 80000000, 200),
+    ('leds at PIOSC/4', [('Leds_RotateTask', 1000, 50)], 4000000, 1000),
+    ('textbook', [('T1', 4, 1000), ('T2', 5, 1800), ('T3', 20, 1000), ('T4', 20, 2000)], 16000000, 2),
+    ('harmonic', [('Fast', 10, 2000), ('Mid', 20, 3000), ('Slow', 40, 5000)], 80000000, 10),
+    ('long frame', [('Control', 100, 20000), ('Logger', 2000, 70000)], 16000000, 100),
+    ('same task twice', [('Sample', 25, 3000), ('Sample', 50, 1000), ('Report', 100, 4000)], 50000000, 25),
+]
+
+# (name, [(task, period ms, WCET us)], counter Hz)
+INFEASIBLE_SETS = [
+    ('overloaded', [('A', 5, 3000), ('B', 10, 5000)], 16000000),
+    ('WCET above the counter at 80 MHz', [('Slow', 2000, 300000)], 80000000),
+    ('no frame between release and deadline', [('A', 3, 2500), ('B', 4, 2500)], 16000000),
+]
+
+
+def run_generator(tasks, counter_hz):
+    h = gen.hyperperiod(tasks)
+    f = gen.frame_size(tasks, h, counter_hz)
+    return h, f, gen.place_jobs(tasks, h, f)
+
+
+class FramePlacementTest(unittest.TestCase):
+
+    def check_placement(self, tasks, counter_hz, h, f, frames):
+        self.assertEqual(h % f, 0)
+        self.assertLessEqual(f * counter_hz, gen.COUNTER_RANGE * 1000)
+        self.assertGreaterEqual(f * 1000, max(wcet_us for _, _, wcet_us in tasks))
+        for _, period_ms, _ in tasks:
+            self.assertLessEqual(2 * f - math.gcd(f, period_ms), period_ms)
+        self.assertEqual(len(frames), h // f)
+
+        placed = {}
+        for index, jobs in enumerate(frames):
+            start, end = index * f, (index + 1) * f
+            self.assertLessEqual(sum(job[4] for job in jobs), f * 1000, 'frame %d overloaded' % index)
+            for deadline, release, task, _, _ in jobs:
+                self.assertLessEqual(release, start)
+                self.assertLessEqual(end, deadline)
+                self.assertNotIn((task, release), placed)
+                placed[(task, release)] = index
+
+        expected = set((task, release) for task, (_, period_ms, _) in enumerate(tasks)
+                       for release in range(0, h, period_ms))
+        self.assertEqual(set(placed), expected)
+
+    def check_tables(self, tasks, counter_hz, h, f, frames):
+        with tempfile.TemporaryDirectory() as out_dir:
+            gen.generate(tasks, h, f, frames, out_dir, 'test', counter_hz)
+            with open(os.path.join(out_dir, 'CyclicExec_Cfg.h')) as header:
+                defines = dict(re.findall(r'#define (CYCLIC_EXEC_\w+)\s+(\d+)', header.read()))
+            with open(os.path.join(out_dir, 'CyclicExec_Cfg.c')) as source:
+                text = source.read()
+
+        self.assertEqual(int(defines['CYCLIC_EXEC_HYPERPERIOD_MS']), h)
+        self.assertEqual(int(defines['CYCLIC_EXEC_FRAME_MS']), f)
+        self.assertEqual(int(defines['CYCLIC_EXEC_FRAME_COUNT']), len(frames))
+        self.assertEqual(int(defines['CYCLIC_EXEC_COUNTER_HZ']), counter_hz)
+
+        jobs = re.findall(r'^    (\w+),\s+/\* Frame (\d+) \*/', text, re.M)
+        self.assertEqual(jobs, [(job[3], str(index)) for index, frame in enumerate(frames) for job in frame])
+        starts = re.search(r'g_CyclicExec_FrameStart\[[^]]*\] =\s*\{\s*([\d, ]+)\s*\}', text).group(1)
+        self.assertEqual([int(start) for start in starts.split(',')],
+                         [sum(len(frame) for frame in frames[:index]) for index in range(len(frames) + 1)])
+
+    def test_task_sets(self):
+        for name, tasks, counter_hz, frame_ms in TASK_SETS:
+            with self.subTest(name):
+                h, f, frames = run_generator(tasks, counter_hz)
+                self.assertEqual(f, frame_ms)
+                self.check_placement(tasks, counter_hz, h, f, frames)
+                self.check_tables(tasks, counter_hz, h, f, frames)
+
+    def test_infeasible_sets(self):
+        for name, tasks, counter_hz in INFEASIBLE_SETS:
+            with self.subTest(name), self.assertRaises(SystemExit):
+                run_generator(tasks, counter_hz)
+
+    def test_counter_bound(self):
+        self.assertEqual(gen.max_frame_ms(16000000), 1048)
+        self.assertEqual(gen.max_frame_ms(80000000), 209)
+        self.assertEqual(gen.max_frame_ms(4000000), 4194)
+        self.assertEqual(gen.max_frame_ms(1000), 0xFFFF)
+
+
+if __name__ == '__main__':
+    unittest.main()
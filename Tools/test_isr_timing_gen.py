@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Host test of the instrumented vector table generation of isr_timing_gen.py.
+
+The table is generated from the App1 startup file and parsed back: every handler entry but the
+initial stack pointer, the reserved entries and the excluded handlers (ResetISR, NmiSR, FaultISR,
+PendSV_Handler and any --exclude one) must be replaced by its own trampoline, whose vector number is
+its position in the table and which calls the handler of that position. The other entries must be
+left as they are. The file must be CRLF like the rest of App1, a startup file without a complete
+table must be rejected and the committed App1/IsrTiming_Vectors.h must match a regeneration. The
+statistics gathered by the trampolines are checked in the simulator by Sim/IsrTimingTest.c.
+
+Usage: test_isr_timing_gen.py
+"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import isr_timing_gen as gen
+
+ROOT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+APP1_DIR = os.path.join(ROOT_DIR, 'App1')
+STARTUP = os.path.join(APP1_DIR, 'tm4c123gh6pm_startup_ccs.c')
+
+# Positions of the handlers of the App1 table
+EXCLUDED_POSITIONS = {'ResetISR': 1, 'NmiSR': 2, 'FaultISR': 3, 'PendSV_Handler': 14}
+WRAPPED_POSITIONS = {'SysTick_Handler': 15, 'GPIOPortF_Handler': 46}
+
+TRAMPOLINE_RE = re.compile(r'^ISR_TIMING_TRAMPOLINE\(IsrTiming_Vector(\d+), (\d+), (\w+)\)$', re.M)
+
+
+def read_binary(path):
+    with open(path, 'rb') as data:
+        return data.read()
+
+
+def parse_output(path):
+    """Trampolines as {position: handler} and the table entries in order."""
+    data = read_binary(path)
+    text = data.decode().replace('\r\n', '\n')
+    trampolines = {}
+    for name_position, position, handler in TRAMPOLINE_RE.findall(text):
+        assert name_position == position, 'IsrTiming_Vector%s is given vector %s' % (name_position, position)
+        trampolines[int(position)] = handler
+
+    table = text[text.index('g_pfnVectors[])(void) =\n{\n') + len('g_pfnVectors[])(void) =\n{\n'):text.index('\n};')]
+    entries = [line.partition('//')[0].strip().rstrip(',') for line in table.splitlines()]
+    return data, trampolines, [entry for entry in entries if entry]
+
+
+class VectorTableTest(unittest.TestCase):
+
+    def check_table(self, entries, excluded, out_path):
+        data, trampolines, table = parse_output(out_path)
+        self.assertEqual(data.count(b'\n'), data.count(b'\r\n'), 'IsrTiming_Vectors.h is not CRLF')
+        self.assertEqual(len(table), gen.VECTORS)
+
+        for position, (name, _) in enumerate(entries):
+            with self.subTest(position=position, handler=name):
+                if position != 0 and gen.is_handler(name) and name not in excluded:
+                    self.assertEqual(table[position], 'IsrTiming_Vector%d' % position)
+                    self.assertEqual(trampolines.pop(position), name)
+                else:
+                    self.assertEqual(table[position], name)
+        self.assertEqual(trampolines, {}, 'trampolines outside the table')
+
+    def test_app1_startup(self):
+        entries = gen.parse_vectors(STARTUP)
+        self.assertEqual(len(entries), gen.VECTORS)
+        for name, position in list(EXCLUDED_POSITIONS.items()) + list(WRAPPED_POSITIONS.items()):
+            self.assertEqual(entries[position][0], name)
+
+        with tempfile.TemporaryDirectory() as out_dir:
+            out_path = os.path.join(out_dir, 'IsrTiming_Vectors.h')
+            count = gen.generate(entries, gen.DEFAULT_EXCLUDED, out_path, os.path.basename(STARTUP))
+            self.check_table(entries, gen.DEFAULT_EXCLUDED, out_path)
+
+            _, trampolines, table = parse_output(out_path)
+            self.assertEqual(count, len(trampolines))
+            for name, position in EXCLUDED_POSITIONS.items():
+                self.assertEqual(table[position], name)
+            for name, position in WRAPPED_POSITIONS.items():
+                self.assertEqual(trampolines[position], name)
+            self.assertEqual(table[0], '(void (*)(void))((uintptr_t)&__STACK_TOP)')
+
+            self.assertEqual(read_binary(out_path), read_binary(os.path.join(APP1_DIR, 'IsrTiming_Vectors.h')),
+                             'App1/IsrTiming_Vectors.h is out of date, regenerate it')
+
+    def test_exclude_option(self):
+        entries = gen.parse_vectors(STARTUP)
+        with tempfile.TemporaryDirectory() as out_dir:
+            out_path = os.path.join(out_dir, 'IsrTiming_Vectors.h')
+            result = subprocess.run([sys.executable, os.path.join(ROOT_DIR, 'Tools', 'isr_timing_gen.py'), STARTUP,
+                                     out_path, '--exclude', 'SysTick_Handler', 'IntDefaultHandler'],
+                                    stdout=subprocess.PIPE, universal_newlines=True)
+            self.assertEqual(result.returncode, 0)
+            self.assertEqual(result.stdout.strip(), '1 of %d vectors instrumented' % gen.VECTORS)
+
+            excluded = gen.DEFAULT_EXCLUDED | {'SysTick_Handler', 'IntDefaultHandler'}
+            self.check_table(entries, excluded, out_path)
+            self.assertEqual(parse_output(out_path)[1], {46: 'GPIOPortF_Handler'})
+
+    def test_invalid_startup(self):
+        with open(STARTUP) as source:
+            text = source.read()
+        entry = '    IntDefaultHandler,                      // GPIO Port A\n'
+        self.assertIn(entry, text)
+
+        for name, startup in (('no table', text.replace('g_pfnVectors', 'g_pfnOtherTable')),
+                              ('entry missing', text.replace(entry, '')),
+                              ('entry added', text.replace(entry, entry * 2))):
+            with self.subTest(name), tempfile.TemporaryDirectory() as out_dir, self.assertRaises(SystemExit):
+                path = os.path.join(out_dir, 'startup.c')
+                with open(path, 'w') as source:
+                    source.write(startup)
+                gen.parse_vectors(path)
+
+
+if __name__ == '__main__':
+    unittest.main()
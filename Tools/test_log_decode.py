@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Host round trip of the trace log, from App1/Log.c to the text of log_decode.py.
+
+Sim/LogTest.c is built with the host simulator and logs 110 records of 0 to 4 arguments, 1 ms apart,
+across the 32-bit wrap of the DWT counter and until the ring is full. Its Log_Drain output and its
+dump of g_Log, which holds the ring across the end of the buffer, are decoded with log_decode.py and
+compared line by line with a model of the ring worked out here: which records fit, how many are
+dropped, their text and their time from the first record of each file. The render() conversions are
+checked on their own.
+
+Usage: test_log_decode.py
+"""
+
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import log_decode
+
+ROOT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+FORMATS = os.path.join(ROOT_DIR, 'App1', 'Log_Formats.h')
+
+# Sequence of Sim/LogTest.c
+RECORDS = 110
+FIRST_BATCH = 40
+BUFFER_WORDS = 256
+UNKNOWN_ID = 3                  # LOG_FORMATS, the first id past the table
+STEP_S = 0.001
+
+
+def record_args(record):
+    return [0x80000000 | (record << 8) | index for index in range(record % 5)]
+
+
+def record_text(record):
+    args = record_args(record)
+    if record % 5 == 1:
+        return 'SW2 pressed at tick %u' % args[0]
+    if record % 5 == 3:
+        return 'cpu load isr %u thread %u idle %u per mille' % tuple(args)
+    return 'unknown format %d %s' % (UNKNOWN_ID, ' '.join('0x%08X' % arg for arg in args))
+
+
+def model():
+    """Records kept in each batch and the records dropped, the first batch is drained before the second."""
+    head = tail = 0
+    batches = ([], [])
+    dropped = []
+    for record in range(RECORDS):
+        if record == FIRST_BATCH:
+            tail = head
+        words = 2 + record % 5
+        if head + words - tail > BUFFER_WORDS:
+            dropped.append(record)
+        else:
+            head += words
+            batches[record >= FIRST_BATCH].append(record)
+    return batches, dropped
+
+
+def expected_lines(records):
+    return ['%14.6f  %s' % ((record - records[0]) * STEP_S, record_text(record)) for record in records]
+
+
+class RenderTest(unittest.TestCase):
+
+    def test_conversions(self):
+        self.assertEqual(log_decode.render('%d %5u %04x %X %c %%', [0xFFFFFFFF, 7, 0xAB, 0xBEEF, 0x41]),
+                         '-1     7 00ab BEEF A %')
+        self.assertEqual(log_decode.render('%u and %u', [3]), '3 and 0')
+
+    def test_formats(self):
+        names = [name for name, _ in log_decode.load_formats(FORMATS)]
+        self.assertEqual(names[1:UNKNOWN_ID], ['LOG_SW2_PRESSED', 'LOG_CPU_LOAD'])
+        self.assertEqual(len(names), UNKNOWN_ID)
+
+
+@unittest.skipUnless(shutil.which('gcc'), 'no host compiler')
+class RoundTripTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.dir = tempfile.TemporaryDirectory()
+        program = os.path.join(cls.dir.name, 'logtest')
+        cls.drained = os.path.join(cls.dir.name, 'drained.bin')
+        cls.dump = os.path.join(cls.dir.name, 'g_Log.bin')
+        build = subprocess.run(['gcc', '-std=gnu99', '-Wall', '-Wextra', '-Werror', '-DTM4C_SIM',
+                                '-I' + os.path.join(ROOT_DIR, 'Sim'), '-I' + os.path.join(ROOT_DIR, 'App1'),
+                                os.path.join(ROOT_DIR, 'Sim', 'LogTest.c'), os.path.join(ROOT_DIR, 'App1', 'Log.c'),
+                                os.path.join(ROOT_DIR, 'Sim', 'Sim.c'), '-o', program],
+                               stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        if build.returncode != 0:
+            raise AssertionError(build.stdout)
+        result = subprocess.run([program, cls.drained, cls.dump], stdout=subprocess.PIPE, universal_newlines=True)
+        if result.returncode != 0:
+            raise AssertionError(result.stdout)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.dir.cleanup()
+
+    def decode(self, *options):
+        result = subprocess.run([sys.executable, os.path.join(ROOT_DIR, 'Tools', 'log_decode.py'), FORMATS] +
+                                list(options), stdout=subprocess.PIPE, universal_newlines=True)
+        self.assertEqual(result.returncode, 0)
+        return result.stdout.splitlines()
+
+    def test_model(self):
+        (first, second), dropped = model()
+        self.assertTrue(dropped, 'the ring never fills')
+        self.assertGreater(second[-1], dropped[0], 'no record fits after the first drop')
+        self.assertGreater(sum(2 + record % 5 for record in first + second), BUFFER_WORDS, 'the ring does not wrap')
+
+    def test_dump(self):
+        (_, second), dropped = model()
+        self.assertEqual(self.decode(self.dump),
+                         ['(%d records dropped, the log was full)' % len(dropped)] + expected_lines(second))
+
+    def test_stream(self):
+        (first, second), _ = model()
+        self.assertEqual(self.decode(self.drained, '--stream'), expected_lines(first + second))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Host test of the copy table generation of ramfunc_gen.py.
+
+For several function lists it checks that the linker fragment gives every function, in list order, its
+own output section loaded in FLASH, run from SRAM and recorded uncompressed in g_RamFunc_CopyTable,
+that RamFunc_Cfg.h counts them and that RamFunc_Cfg.c lists their names and addresses in the same order,
+the order of the copy records. The files must be CRLF like the rest of App1. Malformed lists must be
+rejected, the committed App1 files must match a regeneration from RamFunc_List.txt, and the generated
+RamFunc_Cfg.c must compile with the host build of RamFunc.c.
+
+Usage: test_ramfunc_gen.py
+"""
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import ramfunc_gen as gen
+
+ROOT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+APP1_DIR = os.path.join(ROOT_DIR, 'App1')
+
+# (name, list file text, expected functions)
+FUNCTION_LISTS = [
+    ('one function', 'SysTick_Handler\n', ['SysTick_Handler']),
+    ('comments and blank lines', '# Tick\nSysTick_Handler   # vector\n\n  Sched_Tick\n', ['SysTick_Handler', 'Sched_Tick']),
+    ('order kept', 'Zeta\nAlpha\n_Mid_1\n', ['Zeta', 'Alpha', '_Mid_1']),
+]
+
+# (name, list file text)
+INVALID_LISTS = [
+    ('empty', '# nothing\n\n'),
+    ('listed twice', 'Sched_Tick\nSysTick_Handler\nSched_Tick\n'),
+    ('two names on a line', 'SysTick_Handler Sched_Tick\n'),
+    ('not an identifier', '1stHandler\n'),
+]
+
+SECTION_RE = re.compile(r'^    \.ramfunc:(\w+)\s+: \{ \*\(\.text:(\w+)\) \} load = FLASH, run = SRAM, '
+                        r'table\(g_RamFunc_CopyTable, compression = off\)$', re.M)
+
+
+def read_binary(path):
+    with open(path, 'rb') as data:
+        return data.read()
+
+
+class CopyTableTest(unittest.TestCase):
+
+    def generate(self, text, out_dir):
+        list_path = os.path.join(out_dir, 'RamFunc_List.txt')
+        with open(list_path, 'w') as table:
+            table.write(text)
+        functions = gen.parse_list(list_path)
+        gen.generate(functions, out_dir, 'RamFunc_List.txt')
+        return functions
+
+    def check_outputs(self, functions, out_dir):
+        files = {}
+        for name in ('RamFunc.cmd', 'RamFunc_Cfg.h', 'RamFunc_Cfg.c'):
+            data = read_binary(os.path.join(out_dir, name))
+            self.assertEqual(data.count(b'\n'), data.count(b'\r\n'), '%s is not CRLF' % name)
+            files[name] = data.decode().replace('\r\n', '\n')
+
+        sections = SECTION_RE.findall(files['RamFunc.cmd'])
+        self.assertEqual(sections, [(name, name) for name in functions])
+        self.assertEqual(files['RamFunc.cmd'].count('g_RamFunc_CopyTable'), len(functions) + 1)
+        self.assertIn('.ovly : > FLASH', files['RamFunc.cmd'])
+
+        count = re.search(r'#define RAMFUNC_COUNT\s+(\d+)', files['RamFunc_Cfg.h']).group(1)
+        self.assertEqual(int(count), len(functions))
+
+        entries = re.findall(r'^    \{ "(\w+)", \(RamFunc_AddressType\)(\w+) \},$', files['RamFunc_Cfg.c'], re.M)
+        self.assertEqual(entries, [(name, name) for name in functions])
+        self.assertEqual(re.findall(r'^extern void (\w+)\(void\);$', files['RamFunc_Cfg.c'], re.M), functions)
+
+    def test_function_lists(self):
+        for name, text, expected in FUNCTION_LISTS:
+            with self.subTest(name), tempfile.TemporaryDirectory() as out_dir:
+                self.assertEqual(self.generate(text, out_dir), expected)
+                self.check_outputs(expected, out_dir)
+
+    def test_invalid_lists(self):
+        for name, text in INVALID_LISTS:
+            with self.subTest(name), tempfile.TemporaryDirectory() as out_dir, self.assertRaises(SystemExit):
+                self.generate(text, out_dir)
+
+    def test_app1_files(self):
+        functions = gen.parse_list(os.path.join(APP1_DIR, 'RamFunc_List.txt'))
+        with tempfile.TemporaryDirectory() as out_dir:
+            gen.generate(functions, out_dir, 'RamFunc_List.txt')
+            self.check_outputs(functions, out_dir)
+            for name in ('RamFunc.cmd', 'RamFunc_Cfg.h', 'RamFunc_Cfg.c'):
+                self.assertEqual(read_binary(os.path.join(out_dir, name)), read_binary(os.path.join(APP1_DIR, name)),
+                                 'App1/%s is out of date, regenerate it' % name)
+
+    @unittest.skipUnless(shutil.which('gcc'), 'no host compiler')
+    def test_host_build(self):
+        with tempfile.TemporaryDirectory() as out_dir:
+            functions = self.generate('SysTick_Handler\nSched_Tick\nGPIOPortF_Handler\n', out_dir)
+            stubs = os.path.join(out_dir, 'stubs.c')
+            with open(stubs, 'w') as source:
+                source.write(''.join('void %s(void) {}\n' % name for name in functions))
+                source.write('int main(void) { return 0; }\n')
+            result = subprocess.run(['gcc', '-std=gnu99', '-Wall', '-Wextra', '-Werror', '-DTM4C_SIM',
+                                     '-I' + out_dir, '-I' + APP1_DIR, '-I' + os.path.join(ROOT_DIR, 'Sim'),
+                                     os.path.join(out_dir, 'RamFunc_Cfg.c'), os.path.join(APP1_DIR, 'RamFunc.c'),
+                                     stubs, '-o', os.path.join(out_dir, 'ramfunc')],
+                                    stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+            self.assertEqual(result.returncode, 0, result.stdout)
+
+
+if __name__ == '__main__':
+    unittest.main()
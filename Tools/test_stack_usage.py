@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Host test of the worst-case stack depth of stack_usage.py on a sample call graph.
+
+The sample has a thread-mode root, a kernel thread, two handler priorities, one of them given by a
+#define, an indirect call resolved by a "call" line, an assembly frame and a static function titled
+"file:function" in the .ci file. The deepest chain of every root, the process stack of the thread
+and the worst-case main stack with extended and basic exception frames are compared with the values
+worked out by hand below, as is the exit code of --stack-size. The recursion, unresolved indirect
+call and dynamic frame warnings are checked on small graphs, and the App1 table is parsed with the
+App1 priorities.
+
+Usage: test_stack_usage.py
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import stack_usage
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+
+SAMPLE_CONFIG = """\
+main    main
+thread  Worker
+isr     SysTick_Handler     SAMPLE_SYSTICK_PRIORITY
+isr     GPIOPortF_Handler   5
+isr     IntDefaultHandler   5
+call    SysTick_Handler     Tick_Task
+stack   Atomic_FetchAdd     8
+"""
+
+SAMPLE_HEADER = """\
+#define SAMPLE_SYSTICK_PRIORITY    (3)    /* Above the GPIO handler */
+"""
+
+SAMPLE_SU = """\
+main.c:10:5:main\t16\tstatic
+main.c:20:13:App_Init\t40\tstatic
+main.c:30:13:App_Loop\t24\tstatic
+uart.c:5:6:Uart_Send\t32\tstatic
+tick.c:3:6:SysTick_Handler\t8\tstatic
+tick.c:9:6:Tick_Task\t56\tstatic
+gpio.c:3:6:GPIOPortF_Handler\t16\tstatic
+gpio.c:8:13:Button_Debounce\t24\tstatic
+startup.c:50:13:IntDefaultHandler\t0\tstatic
+thread.c:3:6:Worker\t64\tstatic
+"""
+
+# Uart_Format only has .ci data, under its static "file:function" title
+SAMPLE_CI = r"""graph: { title: "sample"
+node: { title: "main" label: "main\nmain.c:10:5\n16 bytes (static)" }
+node: { title: "uart.c:Uart_Format" label: "Uart_Format\nuart.c:40:13\n120 bytes (static)" }
+edge: { sourcename: "main" targetname: "App_Init" label: "main.c:12:5" }
+edge: { sourcename: "main" targetname: "App_Loop" label: "main.c:13:5" }
+edge: { sourcename: "App_Init" targetname: "Uart_Send" label: "main.c:22:5" }
+edge: { sourcename: "App_Loop" targetname: "uart.c:Uart_Format" label: "main.c:32:9" }
+edge: { sourcename: "uart.c:Uart_Format" targetname: "Atomic_FetchAdd" label: "uart.c:45:5" }
+edge: { sourcename: "SysTick_Handler" targetname: "__indirect_call" label: "tick.c:5:5" }
+edge: { sourcename: "GPIOPortF_Handler" targetname: "Button_Debounce" label: "gpio.c:5:5" }
+edge: { sourcename: "Button_Debounce" targetname: "Uart_Send" label: "gpio.c:10:5" }
+edge: { sourcename: "Worker" targetname: "uart.c:Uart_Format" label: "thread.c:6:9" }
+}
+"""
+
+# Deepest chains: Uart_Format 120 + Atomic_FetchAdd 8 = 128, main 16 + App_Loop 24 + 128 = 168,
+# SysTick_Handler 8 + Tick_Task 56 = 64, GPIOPortF_Handler 16 + Button_Debounce 24 + Uart_Send 32 = 72,
+# Worker 64 + 128 = 192 plus the 108-byte exception frame and the 100-byte kernel frame
+EXPECTED_DEPTHS = {
+    'main': (168, ['main', 'App_Loop', 'Uart_Format', 'Atomic_FetchAdd']),
+    'Worker': (192, ['Worker', 'Uart_Format', 'Atomic_FetchAdd']),
+    'SysTick_Handler': (64, ['SysTick_Handler', 'Tick_Task']),
+    'GPIOPortF_Handler': (72, ['GPIOPortF_Handler', 'Button_Debounce', 'Uart_Send']),
+    'IntDefaultHandler': (0, ['IntDefaultHandler']),
+}
+EXPECTED_PROCESS_STACK = 192 + 108 + 100
+
+# main, then the priority 5 level (GPIOPortF_Handler) with SysTick_Handler at priority 3 nested on it
+EXPECTED_TOTAL_EXTENDED = 168 + (108 + 72) + (108 + 64)
+EXPECTED_TOTAL_BASIC = 168 + (36 + 72) + (36 + 64)
+
+
+class StackUsageTest(unittest.TestCase):
+
+    def setUp(self):
+        self.dir = tempfile.TemporaryDirectory()
+        for name, text in (('Stack_Config.txt', SAMPLE_CONFIG), ('sample.h', SAMPLE_HEADER),
+                           ('sample.su', SAMPLE_SU), ('sample.ci', SAMPLE_CI)):
+            with open(os.path.join(self.dir.name, name), 'w') as sample:
+                sample.write(text)
+        self.config = os.path.join(self.dir.name, 'Stack_Config.txt')
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def run_tool(self, *options):
+        return subprocess.run([sys.executable, os.path.join(TOOLS_DIR, 'stack_usage.py'), self.config,
+                               self.dir.name] + list(options), stdout=subprocess.PIPE, universal_newlines=True)
+
+    def test_chains(self):
+        defines = stack_usage.parse_defines(self.dir.name)
+        roots, isrs, calls, frames = stack_usage.parse_config(self.config, defines)
+        self.assertIn(('SysTick_Handler', 3), isrs)
+
+        sizes, qualifiers, edges = {}, {}, {}
+        stack_usage.parse_inputs([self.dir.name], sizes, qualifiers, edges)
+        sizes.update(frames)
+        for caller, callee in calls:
+            edges[caller].discard('__indirect_call')
+            edges[caller].add(callee)
+
+        graph = stack_usage.CallGraph(sizes, qualifiers, edges)
+        for func, (depth, chain) in EXPECTED_DEPTHS.items():
+            with self.subTest(func):
+                result = graph.depth(func)
+                self.assertEqual(result[0], depth)
+                self.assertEqual([name for name, _ in result[1]], chain)
+        self.assertEqual(graph.warnings, set())
+
+    def test_worst_case(self):
+        result = self.run_tool()
+        self.assertEqual(result.returncode, 0)
+        lines = result.stdout.splitlines()
+        self.assertIn('total %d bytes' % EXPECTED_TOTAL_EXTENDED, ' '.join(lines[-1].split()))
+        self.assertIn('process stack %d' % EXPECTED_PROCESS_STACK, result.stdout)
+        self.assertNotIn('warning', result.stdout)
+
+        result = self.run_tool('--basic-frames')
+        self.assertIn('total %d bytes' % EXPECTED_TOTAL_BASIC, ' '.join(result.stdout.splitlines()[-1].split()))
+
+    def test_stack_size(self):
+        self.assertEqual(self.run_tool('--stack-size', str(EXPECTED_TOTAL_EXTENDED)).returncode, 0)
+        self.assertEqual(self.run_tool('--stack-size', str(EXPECTED_TOTAL_EXTENDED - 1)).returncode, 1)
+        self.assertEqual(self.run_tool('--basic-frames', '--stack-size', '0x200').returncode, 0)
+
+    def test_warnings(self):
+        graph = stack_usage.CallGraph({'A': 8, 'B': 16}, {'B': 'dynamic'}, {'A': {'B'}, 'B': {'A', 'C'}})
+        self.assertEqual(graph.depth('A')[0], 24)
+        self.assertEqual(graph.warnings, {'recursion through A, the chain is cut there',
+                                          'no stack data for C, counted as 0 bytes',
+                                          'B has a dynamic frame'})
+
+        graph = stack_usage.CallGraph({'Handler': 8}, {}, {'Handler': {'__indirect_call'}})
+        self.assertEqual(graph.depth('Handler')[0], 8)
+        self.assertEqual(graph.warnings, {'unresolved indirect call in Handler, add a "call" line'})
+
+    def test_app1_table(self):
+        app1 = os.path.join(os.path.dirname(TOOLS_DIR), 'App1')
+        roots, isrs, _, _ = stack_usage.parse_config(os.path.join(app1, 'Stack_Config.txt'),
+                                                     stack_usage.parse_defines(app1))
+        self.assertEqual(roots, [('main', 'main')])
+        self.assertEqual(len(isrs), 3)
+
+
+if __name__ == '__main__':
+    unittest.main()